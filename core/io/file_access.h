@@ -233,6 +233,14 @@ public:
 
 	virtual void close() = 0;
 
+	// Maps the whole file in memory, read only, so that get_mapped_range() can return pointers to its content.
+	// Only implemented by some platforms, for files opened with `READ`.
+	virtual Error map_to_memory() { return ERR_UNAVAILABLE; }
+	// Returns a pointer to `p_length` bytes of the file content starting at `p_position`, without copying them,
+	// or `nullptr` if the file is not mapped in memory or the range is out of the file. The pointer is valid until the file is closed.
+	// The file must not be truncated while the pointer is used: reading past its new end crashes the process on some platforms.
+	virtual const uint8_t *get_mapped_range(uint64_t p_position, uint64_t p_length) const { return nullptr; }
+
 	virtual bool file_exists(const String &p_name) = 0; ///< return true if a file exists
 
 	virtual Error reopen(const String &p_path, int p_mode_flags); ///< does not change the AccessType
@@ -32,6 +32,10 @@
 
 #include "core/math/math_funcs_binary.h"
 
+bool FileAccessCompressed::CachedBlockKey::operator==(const CachedBlockKey &p_key) const {
+	return compressed_hash == p_key.compressed_hash && mode == p_key.mode && compressed.size() == p_key.compressed.size() && memcmp(compressed.ptr(), p_key.compressed.ptr(), compressed.size()) == 0;
+}
+
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
 	magic = (magic + "    ").substr(0, 4);
@@ -40,6 +44,178 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 	block_size = p_block_size;
 }
 
+void FileAccessCompressed::set_read_ahead(uint32_t p_blocks) {
+	_clear_read_ahead_blocks();
+	read_ahead = p_blocks;
+}
+
+void FileAccessCompressed::clear_block_cache() {
+	MutexLock lock(block_cache_mutex);
+	block_cache.clear();
+}
+
+uint32_t FileAccessCompressed::get_block_cache_size() {
+	MutexLock lock(block_cache_mutex);
+	return block_cache.get_size();
+}
+
+uint32_t FileAccessCompressed::_get_block_size(uint32_t p_block) const {
+	return p_block == read_block_count - 1 ? read_total % block_size : block_size;
+}
+
+Vector<uint8_t> FileAccessCompressed::_read_compressed_block(uint32_t p_block) const {
+	Vector<uint8_t> compressed;
+	compressed.resize(read_blocks[p_block].csize);
+	f->seek(read_blocks[p_block].offset);
+	f->get_buffer(compressed.ptrw(), compressed.size());
+	return compressed;
+}
+
+bool FileAccessCompressed::_get_cached_block(const Vector<uint8_t> &p_compressed, uint32_t p_size, Vector<uint8_t> &r_data) const {
+	if (p_size > BLOCK_CACHE_MAX_BLOCK_SIZE) {
+		return false;
+	}
+
+	CachedBlockKey key;
+	key.compressed = p_compressed;
+	key.mode = cmode;
+	key.compressed_hash = hash_murmur3_buffer(p_compressed.ptr(), p_compressed.size());
+
+	MutexLock lock(block_cache_mutex);
+	const Vector<uint8_t> *data = block_cache.getptr(key);
+	if (!data || data->size() != p_size) {
+		return false;
+	}
+	r_data = *data;
+	return true;
+}
+
+void FileAccessCompressed::_cache_block(const Vector<uint8_t> &p_compressed, const Vector<uint8_t> &p_data) const {
+	if (p_data.size() > BLOCK_CACHE_MAX_BLOCK_SIZE) {
+		return;
+	}
+
+	CachedBlockKey key;
+	key.compressed = p_compressed;
+	key.mode = cmode;
+	key.compressed_hash = hash_murmur3_buffer(p_compressed.ptr(), p_compressed.size());
+
+	MutexLock lock(block_cache_mutex);
+	block_cache.insert(key, p_data);
+}
+
+bool FileAccessCompressed::_load_block(uint32_t p_block) const {
+	const uint32_t size = _get_block_size(p_block);
+	Vector<uint8_t> data;
+	// Blocks streamed sequentially are rarely read again, caching them would only evict the blocks of other files.
+	const bool cache = p_block == 0 || p_block != read_block + 1;
+
+	bool read_ahead_found = false;
+	for (ReadAheadBlock &block : read_ahead_blocks) {
+		if (block.block != p_block) {
+			continue;
+		}
+		_wait_read_ahead_block(block);
+		block.block = UINT32_MAX;
+		if (block.failed) {
+			return false;
+		}
+		data = block.data;
+		if (cache) {
+			_cache_block(block.compressed, data);
+		}
+		block.compressed.clear();
+		block.data.clear();
+		read_ahead_found = true;
+		break;
+	}
+
+	if (!read_ahead_found) {
+		const Vector<uint8_t> compressed = _read_compressed_block(p_block);
+		if (!_get_cached_block(compressed, size, data)) {
+			data.resize(size);
+			if (size > 0 && Compression::decompress(data.ptrw(), size, compressed.ptr(), compressed.size(), cmode) == -1) {
+				return false;
+			}
+			if (cache) {
+				_cache_block(compressed, data);
+			}
+		}
+	}
+
+	read_data = data;
+	read_block = p_block;
+	read_block_size = size;
+	read_pos = 0;
+	return true;
+}
+
+void FileAccessCompressed::_read_ahead_blocks(uint32_t p_block) const {
+	if (read_ahead == 0 || !WorkerThreadPool::get_singleton()) {
+		return;
+	}
+
+	const uint32_t last_block = MIN(p_block + read_ahead, read_block_count - 1);
+	if (last_block <= p_block) {
+		return;
+	}
+	if (read_ahead_blocks.is_empty()) {
+		read_ahead_blocks.resize(read_ahead);
+	}
+
+	// The compressed data is read here, as the file can't be shared with the tasks, which only decompress it.
+	for (uint32_t i = p_block + 1; i <= last_block; i++) {
+		ReadAheadBlock *free_block = nullptr;
+		bool scheduled = false;
+		for (ReadAheadBlock &block : read_ahead_blocks) {
+			if (block.block == i) {
+				scheduled = true;
+				break;
+			}
+			if (!free_block && (block.block <= p_block || block.block > last_block)) {
+				free_block = &block;
+			}
+		}
+		if (scheduled) {
+			continue;
+		}
+		if (!free_block) {
+			break;
+		}
+
+		_wait_read_ahead_block(*free_block);
+		free_block->block = i;
+		free_block->size = _get_block_size(i);
+		free_block->mode = cmode;
+		free_block->compressed = _read_compressed_block(i);
+		free_block->failed = false;
+		if (_get_cached_block(free_block->compressed, free_block->size, free_block->data)) {
+			continue;
+		}
+		free_block->task_id = WorkerThreadPool::get_singleton()->add_native_task(&FileAccessCompressed::_decompress_block_task, free_block, false, "Decompress file block");
+	}
+}
+
+void FileAccessCompressed::_wait_read_ahead_block(ReadAheadBlock &p_block) const {
+	if (p_block.task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(p_block.task_id);
+		p_block.task_id = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+void FileAccessCompressed::_clear_read_ahead_blocks() const {
+	for (ReadAheadBlock &block : read_ahead_blocks) {
+		_wait_read_ahead_block(block);
+	}
+	read_ahead_blocks.clear();
+}
+
+void FileAccessCompressed::_decompress_block_task(void *p_block) {
+	ReadAheadBlock *block = static_cast<ReadAheadBlock *>(p_block);
+	block->data.resize(block->size);
+	block->failed = block->size > 0 && Compression::decompress(block->data.ptrw(), block->size, block->compressed.ptr(), block->compressed.size(), block->mode) == -1;
+}
+
 Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	f = p_base;
 	cmode = (Compression::Mode)f->get_32();
@@ -51,30 +227,24 @@ Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	read_total = f->get_32();
 	uint32_t bc = (read_total / block_size) + 1;
 	uint64_t acc_ofs = f->get_position() + bc * 4;
-	uint32_t max_bs = 0;
 	for (uint32_t i = 0; i < bc; i++) {
 		ReadBlock rb;
 		rb.offset = acc_ofs;
 		rb.csize = f->get_32();
 		acc_ofs += rb.csize;
-		max_bs = MAX(max_bs, rb.csize);
 		read_blocks.push_back(rb);
 	}
 
-	comp_buffer.resize(max_bs);
-	buffer.resize(block_size);
-	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
 	at_end = false;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
 
-	const int64_t ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
-	read_block = 0;
-	read_pos = 0;
+	if (!_load_block(0)) {
+		return ERR_FILE_CORRUPT;
+	}
+	_read_ahead_blocks(0);
 
-	return ret == -1 ? ERR_FILE_CORRUPT : OK;
+	return OK;
 }
 
 Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags) {
@@ -159,7 +329,8 @@ void FileAccessCompressed::_close() {
 		f->seek_end();
 		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
 	} else {
-		comp_buffer.clear();
+		_clear_read_ahead_blocks();
+		read_data.clear();
 		read_blocks.clear();
 	}
 	buffer.clear();
@@ -203,12 +374,7 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 			read_eof = false;
 			uint32_t block_idx = p_position / block_size;
 			if (block_idx != read_block) {
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				const int64_t ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				ERR_FAIL_COND_MSG(!_load_block(block_idx), "Compressed file is corrupt.");
 			}
 
 			read_pos = p_position % block_size;
@@ -270,7 +436,7 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 	while (true) {
 		// Copy over as much of our current block as possible.
 		const uint32_t copied_bytes_count = MIN(p_length - dst_idx, read_block_size - read_pos);
-		memcpy(p_dst + dst_idx, read_ptr + read_pos, copied_bytes_count);
+		memcpy(p_dst + dst_idx, read_data.ptr() + read_pos, copied_bytes_count);
 		dst_idx += copied_bytes_count;
 		read_pos += copied_bytes_count;
 
@@ -280,11 +446,8 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		}
 
 		// We're not done yet; try reading the next block.
-		read_block++;
-
-		if (read_block >= read_block_count) {
+		if (read_block + 1 >= read_block_count) {
 			// We're done! We read back the whole file.
-			read_block--;
 			at_end = true;
 			if (dst_idx + 1 < p_length) {
 				read_eof = true;
@@ -292,12 +455,9 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 			return dst_idx;
 		}
 
-		// Read the next block of compressed data.
-		f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-		const int64_t ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-		ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-		read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-		read_pos = 0;
+		// Read the next block, and start decompressing the ones after it as the file is read sequentially.
+		ERR_FAIL_COND_V_MSG(!_load_block(read_block + 1), -1, "Compressed file is corrupt.");
+		_read_ahead_blocks(read_block);
 	}
 
 	return p_length;
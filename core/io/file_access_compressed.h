@@ -32,9 +32,25 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/lru.h"
 
 class FileAccessCompressed : public FileAccess {
 	GDSOFTCLASS(FileAccessCompressed, FileAccess);
+
+public:
+	static constexpr uint32_t DEFAULT_BLOCK_SIZE = 65536;
+	static constexpr uint32_t DEFAULT_READ_AHEAD = 4;
+
+private:
+	// Number of blocks kept in the cache shared by all the compressed files.
+	// Only the first block of the files and the blocks reached by seeking are cached, blocks streamed sequentially are not.
+	static constexpr uint32_t BLOCK_CACHE_CAPACITY = 64;
+	// Larger blocks are not cached, to bound the memory used by the cache.
+	static constexpr uint32_t BLOCK_CACHE_MAX_BLOCK_SIZE = 262144;
+
 	Compression::Mode cmode = Compression::MODE_ZSTD;
 	bool writing = false;
 	uint64_t write_pos = 0;
@@ -50,8 +66,8 @@ class FileAccessCompressed : public FileAccess {
 		uint64_t offset;
 	};
 
-	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr = nullptr;
+	// Decompressed content of the current block.
+	mutable Vector<uint8_t> read_data;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
 	mutable uint32_t read_block_size = 0;
@@ -59,14 +75,56 @@ class FileAccessCompressed : public FileAccess {
 	Vector<ReadBlock> read_blocks;
 	uint64_t read_total = 0;
 
+	// A block following the current one, decompressed on the WorkerThreadPool while the current one is read.
+	struct ReadAheadBlock {
+		uint32_t block = UINT32_MAX;
+		uint32_t size = 0;
+		Compression::Mode mode = Compression::MODE_ZSTD;
+		Vector<uint8_t> compressed;
+		Vector<uint8_t> data;
+		bool failed = false;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	uint32_t read_ahead = DEFAULT_READ_AHEAD;
+	mutable LocalVector<ReadAheadBlock> read_ahead_blocks;
+
+	// Decompressed blocks are cached by their compressed content, so that the cache never returns outdated data.
+	struct CachedBlockKey {
+		Vector<uint8_t> compressed;
+		Compression::Mode mode = Compression::MODE_ZSTD;
+		uint32_t compressed_hash = 0;
+
+		static uint32_t hash(const CachedBlockKey &p_key) { return p_key.compressed_hash; }
+		bool operator==(const CachedBlockKey &p_key) const;
+	};
+
+	static inline BinaryMutex block_cache_mutex;
+	static inline LRUCache<CachedBlockKey, Vector<uint8_t>, CachedBlockKey> block_cache{ BLOCK_CACHE_CAPACITY };
+
 	String magic = "GCMP";
 	mutable Vector<uint8_t> buffer;
 	Ref<FileAccess> f;
 
+	uint32_t _get_block_size(uint32_t p_block) const;
+	Vector<uint8_t> _read_compressed_block(uint32_t p_block) const;
+	bool _get_cached_block(const Vector<uint8_t> &p_compressed, uint32_t p_size, Vector<uint8_t> &r_data) const;
+	void _cache_block(const Vector<uint8_t> &p_compressed, const Vector<uint8_t> &p_data) const;
+	bool _load_block(uint32_t p_block) const;
+	void _read_ahead_blocks(uint32_t p_block) const;
+	void _wait_read_ahead_block(ReadAheadBlock &p_block) const;
+	void _clear_read_ahead_blocks() const;
+	static void _decompress_block_task(void *p_block);
+
 	void _close();
 
 public:
-	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
+	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = DEFAULT_BLOCK_SIZE);
+	// Number of blocks following the current one that are decompressed in advance on the WorkerThreadPool when reading sequentially. Zero disables it.
+	void set_read_ahead(uint32_t p_blocks);
+
+	static void clear_block_cache();
+	static uint32_t get_block_cache_size();
 
 	Error open_after_magic(Ref<FileAccess> p_base);
 
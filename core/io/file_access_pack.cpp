@@ -370,11 +370,23 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		}
 	}
 
+	if (!sparse_bundle) {
+		// Map the pack in memory when the platform supports it, so that the files don't need their own handle and reads don't go through the file system.
+		// Otherwise, the files are read with their own handle of the pack.
+		Ref<FileAccess> mapped_pack = FileAccess::open(p_path, FileAccess::READ);
+		if (mapped_pack.is_valid() && mapped_pack->map_to_memory() == OK) {
+			mapped_packs[p_path] = mapped_pack;
+		} else {
+			mapped_packs.erase(p_path);
+		}
+	}
+
 	return true;
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file, const Vector<uint8_t> &p_decryption_key) {
-	Ref<FileAccess> file(memnew(FileAccessPack(p_path, *p_file, p_decryption_key)));
+	const Ref<FileAccess> *mapped_pack = mapped_packs.getptr(p_file->pack);
+	Ref<FileAccess> file(memnew(FileAccessPack(p_path, *p_file, p_decryption_key, mapped_pack ? *mapped_pack : Ref<FileAccess>())));
 
 	if (PackedData::get_singleton()->has_delta_patches(p_path)) {
 		Ref<FileAccessPatched> file_patched;
@@ -449,7 +461,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped_data) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -483,12 +497,17 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
+	const uint64_t read_pos = pos;
 	pos += to_read;
 
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (mapped_data) {
+		memcpy(p_dst, mapped_data + read_pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
@@ -497,7 +516,9 @@ void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (!mapped_data) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -521,11 +542,38 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped_data = nullptr;
+}
+
+Error FileAccessPack::map_to_memory() {
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_OPEN, "File must be opened before use.");
+
+	// Only the content of packs mapped when they were opened can be accessed directly.
+	return mapped_data ? OK : ERR_UNAVAILABLE;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Vector<uint8_t> &p_decryption_key) {
+const uint8_t *FileAccessPack::get_mapped_range(uint64_t p_position, uint64_t p_length) const {
+	if (!mapped_data || p_position > pf.size || p_length > pf.size - p_position) {
+		return nullptr;
+	}
+	return mapped_data + p_position;
+}
+
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Vector<uint8_t> &p_decryption_key, const Ref<FileAccess> &p_mapped_pack) {
 	path = p_path;
 	pf = p_file;
+	pos = 0;
+	eof = false;
+
+	if (!pf.bundle && !pf.encrypted && p_mapped_pack.is_valid()) {
+		mapped_data = p_mapped_pack->get_mapped_range(pf.offset, pf.size);
+		if (mapped_data) {
+			f = p_mapped_pack;
+			off = pf.offset;
+			return;
+		}
+	}
+
 	if (pf.bundle) {
 		String simplified_path = p_path.simplify_path();
 		String path_to_load = simplified_path;
@@ -166,6 +166,10 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	// Read only handles of the packs mapped in memory, shared by all the files opened from them.
+	// Packs must not be modified while they are loaded, see FileAccess::get_mapped_range().
+	HashMap<String, Ref<FileAccess>> mapped_packs;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset, const Vector<uint8_t> &p_decryption_key = Vector<uint8_t>()) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file, const Vector<uint8_t> &p_decryption_key = Vector<uint8_t>()) override;
@@ -189,6 +193,10 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	// Content of the file when the pack is mapped in memory, in which case `f` is the shared handle of the pack and is only kept open.
+	// The pack size is only checked when the file is opened, reads don't check it again as that would cost a system call each.
+	const uint8_t *mapped_data = nullptr;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
@@ -228,7 +236,10 @@ public:
 
 	virtual void close() override;
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Vector<uint8_t> &p_decryption_key = Vector<uint8_t>());
+	virtual Error map_to_memory() override;
+	virtual const uint8_t *get_mapped_range(uint64_t p_position, uint64_t p_length) const override;
+
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Vector<uint8_t> &p_decryption_key = Vector<uint8_t>(), const Ref<FileAccess> &p_mapped_pack = Ref<FileAccess>());
 };
 
 int64_t PackedData::get_size(const String &p_path) {
@@ -30,6 +30,7 @@
 
 #include "json.h"
 
+#include "core/io/json_reader.h"
 #include "core/io/resource_loader.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
@@ -583,6 +584,36 @@ Error JSON::parse(const String &p_json_string, bool p_keep_text) {
 	return err;
 }
 
+Error JSON::parse_buffer(const Vector<uint8_t> &p_json_buffer, bool p_keep_text) {
+	// Parses the UTF-8 bytes directly, without converting the whole text to a `String` first.
+	Ref<JSONReader> reader;
+	reader.instantiate();
+	reader->open_buffer(p_json_buffer);
+
+	Variant value;
+	Error err = reader->read_value(value);
+	if (err == OK) {
+		// Only whitespace may follow the value.
+		err = reader->read();
+		if (err == ERR_FILE_EOF) {
+			err = OK;
+		}
+	}
+
+	if (err == OK) {
+		data = value;
+		err_line = 0;
+	} else {
+		data = Variant();
+		err_str = reader->get_error_message();
+		err_line = reader->get_error_line();
+	}
+	if (p_keep_text) {
+		text = String::utf8((const char *)p_json_buffer.ptr(), p_json_buffer.size());
+	}
+	return err;
+}
+
 String JSON::get_parsed_text() const {
 	return text;
 }
@@ -606,6 +637,7 @@ void JSON::_bind_methods() {
 	ClassDB::bind_static_method("JSON", D_METHOD("stringify", "data", "indent", "sort_keys", "full_precision"), &JSON::stringify, DEFVAL(""), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_static_method("JSON", D_METHOD("parse_string", "json_string"), &JSON::parse_string);
 	ClassDB::bind_method(D_METHOD("parse", "json_text", "keep_text"), &JSON::parse, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("parse_buffer", "json_buffer", "keep_text"), &JSON::parse_buffer, DEFVAL(false));
 
 	ClassDB::bind_method(D_METHOD("get_data"), &JSON::get_data);
 	ClassDB::bind_method(D_METHOD("set_data", "data"), &JSON::set_data);
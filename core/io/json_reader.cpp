@@ -0,0 +1,634 @@
+/**************************************************************************/
+/*  json_reader.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_reader.h"
+
+#include "core/io/file_access.h"
+#include "core/object/class_db.h"
+
+// Strings and whitespace are scanned eight bytes at a time (SWAR), only falling
+// back to byte-by-byte processing around quotes and escapes.
+
+static constexpr uint64_t SWAR_ONES = 0x0101010101010101ULL;
+static constexpr uint64_t SWAR_HIGHS = 0x8080808080808080ULL;
+
+static _FORCE_INLINE_ uint64_t _swar_load(const uint8_t *p_ptr) {
+	uint64_t word;
+	memcpy(&word, p_ptr, sizeof(uint64_t));
+	return word;
+}
+
+static _FORCE_INLINE_ bool _swar_has_byte(uint64_t p_word, uint8_t p_byte) {
+	const uint64_t x = p_word ^ (SWAR_ONES * p_byte);
+	return ((x - SWAR_ONES) & ~x & SWAR_HIGHS) != 0;
+}
+
+// Returns the first '"' or '\' at or after `p_ptr`, or `p_end`.
+static _FORCE_INLINE_ const uint8_t *_scan_string(const uint8_t *p_ptr, const uint8_t *p_end) {
+	while (p_end - p_ptr >= 8) {
+		const uint64_t word = _swar_load(p_ptr);
+		if (_swar_has_byte(word, '"') || _swar_has_byte(word, '\\')) {
+			break;
+		}
+		p_ptr += 8;
+	}
+	while (p_ptr < p_end && *p_ptr != '"' && *p_ptr != '\\') {
+		p_ptr++;
+	}
+	return p_ptr;
+}
+
+static String _utf8_to_string(const uint8_t *p_utf8, int p_len) {
+	String str;
+	if (p_len >= 3 && p_utf8[0] == 0xef && p_utf8[1] == 0xbb && p_utf8[2] == 0xbf) {
+		// `append_utf8()` would drop a leading U+FEFF as a byte order mark.
+		str += char32_t(0xfeff);
+		p_utf8 += 3;
+		p_len -= 3;
+	}
+	str.append_utf8((const char *)p_utf8, p_len);
+	return str;
+}
+
+static _FORCE_INLINE_ void _append_bytes(LocalVector<uint8_t> &r_utf8, const uint8_t *p_from, const uint8_t *p_to) {
+	const uint32_t size = r_utf8.size();
+	r_utf8.resize(size + (p_to - p_from));
+	memcpy(r_utf8.ptr() + size, p_from, p_to - p_from);
+}
+
+static void _append_codepoint(LocalVector<uint8_t> &r_utf8, char32_t p_char) {
+	if (p_char < 0x80) {
+		r_utf8.push_back(p_char);
+	} else if (p_char < 0x800) {
+		r_utf8.push_back(0xc0 | (p_char >> 6));
+		r_utf8.push_back(0x80 | (p_char & 0x3f));
+	} else if (p_char < 0x10000) {
+		r_utf8.push_back(0xe0 | (p_char >> 12));
+		r_utf8.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_utf8.push_back(0x80 | (p_char & 0x3f));
+	} else {
+		r_utf8.push_back(0xf0 | (p_char >> 18));
+		r_utf8.push_back(0x80 | ((p_char >> 12) & 0x3f));
+		r_utf8.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_utf8.push_back(0x80 | (p_char & 0x3f));
+	}
+}
+
+static bool _parse_hex4(const uint8_t *p_ptr, char32_t &r_value) {
+	r_value = 0;
+	for (int i = 0; i < 4; i++) {
+		const uint8_t c = p_ptr[i];
+		char32_t v;
+		if (is_digit(c)) {
+			v = c - '0';
+		} else if (c >= 'a' && c <= 'f') {
+			v = c - 'a' + 10;
+		} else if (c >= 'A' && c <= 'F') {
+			v = c - 'A' + 10;
+		} else {
+			return false;
+		}
+		r_value = (r_value << 4) | v;
+	}
+	return true;
+}
+
+Error JSONReader::_set_error(const String &p_message, Error p_error) {
+	error = p_error;
+	err_str = p_message;
+	err_ptr = ptr;
+	token_type = TOKEN_NONE;
+	return p_error;
+}
+
+void JSONReader::_skip_whitespace() {
+	static constexpr uint64_t SPACES = SWAR_ONES * ' ';
+	static constexpr uint64_t TABS = SWAR_ONES * '\t';
+
+	while (ptr < end) {
+		if (end - ptr >= 8) {
+			const uint64_t word = _swar_load(ptr);
+			if (word == SPACES || word == TABS) {
+				ptr += 8;
+				continue;
+			}
+		}
+		if (*ptr > 32) {
+			return;
+		}
+		ptr++;
+	}
+}
+
+Error JSONReader::_read_string(String &r_string) {
+	// `ptr` is right after the opening quote.
+	const uint8_t *run = ptr;
+	bool escaped = false;
+
+	while (true) {
+		ptr = _scan_string(ptr, end);
+		if (ptr == end) {
+			return _set_error("Unterminated string");
+		}
+		if (*ptr == '"') {
+			break;
+		}
+
+		// Escaped characters are decoded into the scratch buffer, along with the text before them.
+		if (!escaped) {
+			scratch.clear();
+			escaped = true;
+		}
+		_append_bytes(scratch, run, ptr);
+
+		ptr++;
+		if (ptr == end) {
+			return _set_error("Unterminated string");
+		}
+
+		char32_t res = 0;
+		switch (*ptr) {
+			case 'b':
+				res = 8;
+				break;
+			case 't':
+				res = 9;
+				break;
+			case 'n':
+				res = 10;
+				break;
+			case 'f':
+				res = 12;
+				break;
+			case 'r':
+				res = 13;
+				break;
+			case 'u': {
+				if (end - ptr < 5) {
+					return _set_error("Unterminated string");
+				}
+				if (!_parse_hex4(ptr + 1, res)) {
+					return _set_error("Malformed hex constant in string");
+				}
+				ptr += 4;
+
+				if ((res & 0xfffffc00) == 0xd800) {
+					if (end - ptr < 7 || ptr[1] != '\\' || ptr[2] != 'u') {
+						return _set_error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+					}
+					char32_t trail;
+					if (!_parse_hex4(ptr + 3, trail)) {
+						return _set_error("Malformed hex constant in string");
+					}
+					if ((trail & 0xfffffc00) != 0xdc00) {
+						return _set_error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+					}
+					res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+					ptr += 6;
+				} else if ((res & 0xfffffc00) == 0xdc00) {
+					return _set_error("Invalid UTF-16 sequence in string, unpaired trail surrogate");
+				}
+			} break;
+			case '"':
+			case '\\':
+			case '/': {
+				res = *ptr;
+			} break;
+			default: {
+				return _set_error("Invalid escape sequence");
+			}
+		}
+
+		_append_codepoint(scratch, res);
+		ptr++;
+		run = ptr;
+	}
+
+	if (escaped) {
+		_append_bytes(scratch, run, ptr);
+		r_string = _utf8_to_string(scratch.ptr(), scratch.size());
+	} else {
+		r_string = _utf8_to_string(run, ptr - run);
+	}
+
+	ptr++; // Closing quote.
+	return OK;
+}
+
+Error JSONReader::_read_number(Variant &r_value) {
+	// Fast path for plain integers that are exactly representable as a double.
+	const bool negative = *ptr == '-';
+	const uint8_t *digits = ptr + (negative ? 1 : 0);
+	const uint8_t *p = digits;
+	int64_t integer = 0;
+	while (p < end && is_digit(*p) && p - digits < 15) {
+		integer = integer * 10 + (*p - '0');
+		p++;
+	}
+	if (p > digits && (p == end || (!is_digit(*p) && *p != '.' && *p != 'e' && *p != 'E'))) {
+		r_value = negative ? -double(integer) : double(integer);
+		ptr = p;
+		return OK;
+	}
+
+	// Copy the number to a null-terminated buffer for `String::to_float()`.
+	p = ptr;
+	while (p < end && (is_digit(*p) || *p == '-' || *p == '+' || *p == '.' || *p == 'e' || *p == 'E')) {
+		p++;
+	}
+	const int64_t len = p - ptr;
+	char small[64];
+	LocalVector<char> large;
+	char *number = small;
+	if (len >= (int64_t)sizeof(small)) {
+		large.resize(len + 1);
+		number = large.ptr();
+	}
+	memcpy(number, ptr, len);
+	number[len] = 0;
+
+	const char *number_end = nullptr;
+	const double result = String::to_float(number, &number_end);
+	if (number_end == number) {
+		return _set_error("Malformed number");
+	}
+	ptr += number_end - number;
+	r_value = result;
+	return OK;
+}
+
+Error JSONReader::_read_identifier(Variant &r_value) {
+	const uint8_t *start = ptr;
+	while (ptr < end && is_ascii_alphabet_char(*ptr)) {
+		ptr++;
+	}
+	const int64_t len = ptr - start;
+
+	if (len == 4 && memcmp(start, "true", 4) == 0) {
+		r_value = true;
+	} else if (len == 5 && memcmp(start, "false", 5) == 0) {
+		r_value = false;
+	} else if (len == 4 && memcmp(start, "null", 4) == 0) {
+		r_value = Variant();
+	} else {
+		ptr = start;
+		return _set_error(vformat("Expected 'true', 'false', or 'null', got '%s'", String::ascii(Span<char>((const char *)start, len))));
+	}
+	return OK;
+}
+
+Error JSONReader::_read_value_token() {
+	if (scopes.size() > Variant::MAX_RECURSION_DEPTH) {
+		return _set_error("JSON structure is too deep", ERR_OUT_OF_MEMORY);
+	}
+	if (ptr == end) {
+		return _set_error("Expected value, got 'EOF'");
+	}
+
+	switch (*ptr) {
+		case '{':
+		case '[': {
+			Scope scope;
+			scope.is_object = *ptr == '{';
+			scopes.push_back(scope);
+			token_type = scope.is_object ? TOKEN_OBJECT_BEGIN : TOKEN_ARRAY_BEGIN;
+			ptr++;
+			return OK;
+		}
+		case '"': {
+			ptr++;
+			String str;
+			RETURN_IF_ERROR(_read_string(str));
+			value = str;
+		} break;
+		case '}':
+		case ']':
+		case ':':
+		case ',': {
+			return _set_error(vformat("Expected value, got '%s'", String::chr(*ptr)));
+		}
+		default: {
+			if (*ptr == '-' || is_digit(*ptr)) {
+				RETURN_IF_ERROR(_read_number(value));
+			} else if (is_ascii_alphabet_char(*ptr)) {
+				RETURN_IF_ERROR(_read_identifier(value));
+			} else {
+				return _set_error("Unexpected character");
+			}
+		}
+	}
+
+	token_type = TOKEN_VALUE;
+	return OK;
+}
+
+Error JSONReader::read() {
+	if (error != OK) {
+		return error;
+	}
+
+	_skip_whitespace();
+
+	if (scopes.is_empty()) {
+		if (!root_read) {
+			root_read = true;
+			return _read_value_token();
+		}
+		if (ptr < end) {
+			return _set_error("Expected 'EOF'");
+		}
+		token_type = TOKEN_NONE;
+		return ERR_FILE_EOF;
+	}
+
+	Scope &scope = scopes[scopes.size() - 1];
+	if (scope.is_object && !scope.at_key) {
+		scope.at_key = true;
+		scope.need_comma = true;
+		return _read_value_token();
+	}
+
+	// A trailing comma before the closing bracket is tolerated, as in `JSON.parse()`.
+	const uint8_t close = scope.is_object ? '}' : ']';
+	while (true) {
+		if (ptr == end) {
+			return _set_error(scope.is_object ? "Expected '}'" : "Expected ']'");
+		}
+		if (*ptr == close) {
+			ptr++;
+			token_type = scope.is_object ? TOKEN_OBJECT_END : TOKEN_ARRAY_END;
+			scopes.resize(scopes.size() - 1);
+			return OK;
+		}
+		if (!scope.need_comma) {
+			break;
+		}
+		if (*ptr != ',') {
+			return _set_error(scope.is_object ? "Expected '}' or ','" : "Expected ','");
+		}
+		ptr++;
+		scope.need_comma = false;
+		_skip_whitespace();
+	}
+
+	if (!scope.is_object) {
+		scope.need_comma = true;
+		return _read_value_token();
+	}
+
+	if (*ptr != '"') {
+		return _set_error("Expected key");
+	}
+	ptr++;
+	RETURN_IF_ERROR(_read_string(key));
+	_skip_whitespace();
+	if (ptr == end || *ptr != ':') {
+		return _set_error("Expected ':'");
+	}
+	ptr++;
+	scope.at_key = false;
+	token_type = TOKEN_KEY;
+	return OK;
+}
+
+Error JSONReader::_read_container(Variant &r_value) {
+	if (token_type == TOKEN_ARRAY_BEGIN) {
+		Array array;
+		while (true) {
+			RETURN_IF_ERROR(read());
+			if (token_type == TOKEN_ARRAY_END) {
+				break;
+			}
+			if (token_type == TOKEN_VALUE) {
+				array.push_back(value);
+			} else {
+				Variant element;
+				RETURN_IF_ERROR(_read_container(element));
+				array.push_back(element);
+			}
+		}
+		r_value = array;
+	} else {
+		Dictionary dictionary;
+		while (true) {
+			RETURN_IF_ERROR(read());
+			if (token_type == TOKEN_OBJECT_END) {
+				break;
+			}
+			const String entry_key = key;
+			RETURN_IF_ERROR(read());
+			if (token_type == TOKEN_VALUE) {
+				dictionary[entry_key] = value;
+			} else {
+				Variant entry;
+				RETURN_IF_ERROR(_read_container(entry));
+				dictionary[entry_key] = entry;
+			}
+		}
+		r_value = dictionary;
+	}
+	return OK;
+}
+
+Error JSONReader::read_value(Variant &r_value) {
+	RETURN_IF_ERROR(read());
+	if (token_type == TOKEN_KEY) {
+		RETURN_IF_ERROR(read());
+	}
+
+	switch (token_type) {
+		case TOKEN_VALUE: {
+			r_value = value;
+		} break;
+		case TOKEN_OBJECT_BEGIN:
+		case TOKEN_ARRAY_BEGIN: {
+			// Keep the key of this value, not the last one found inside of it.
+			const String value_key = key;
+			RETURN_IF_ERROR(_read_container(r_value));
+			key = value_key;
+		} break;
+		default: {
+			r_value = Variant();
+		} break;
+	}
+	return OK;
+}
+
+Variant JSONReader::_read_value_bind() {
+	Variant ret;
+	read_value(ret);
+	return ret;
+}
+
+Error JSONReader::skip_section() {
+	if (error != OK) {
+		return error;
+	}
+	if (token_type != TOKEN_OBJECT_BEGIN && token_type != TOKEN_ARRAY_BEGIN) {
+		return OK;
+	}
+
+	// Only match brackets and skip strings until the end of the section; the skipped content is not validated further.
+	int nesting = 1;
+	while (ptr < end) {
+		switch (*ptr) {
+			case '"': {
+				ptr++;
+				while (true) {
+					ptr = _scan_string(ptr, end);
+					if (ptr == end) {
+						return _set_error("Unterminated string");
+					}
+					if (*ptr == '"') {
+						break;
+					}
+					// Skip the escaped character.
+					ptr++;
+					if (ptr < end) {
+						ptr++;
+					}
+				}
+			} break;
+			case '{':
+			case '[': {
+				nesting++;
+			} break;
+			case '}':
+			case ']': {
+				nesting--;
+				if (nesting == 0) {
+					// Let `read()` validate and consume the closing bracket.
+					return read();
+				}
+			} break;
+			default:
+				break;
+		}
+		ptr++;
+	}
+
+	return read();
+}
+
+uint64_t JSONReader::get_offset() const {
+	return ptr - begin;
+}
+
+int JSONReader::get_error_line() const {
+	if (error == OK || !err_ptr) {
+		return 0;
+	}
+	int line = 0;
+	for (const uint8_t *p = begin; p < err_ptr; p++) {
+		if (*p == '\n') {
+			line++;
+		}
+	}
+	return line;
+}
+
+void JSONReader::_set_data(const uint8_t *p_data, size_t p_size) {
+	begin = p_data;
+	end = p_data + p_size;
+
+	// A null byte ends the document, as it does for `JSON.parse()`.
+	if (p_size > 0) {
+		const uint8_t *null_byte = (const uint8_t *)memchr(p_data, 0, p_size);
+		if (null_byte) {
+			end = null_byte;
+		}
+	}
+	if (end - begin >= 3 && begin[0] == 0xef && begin[1] == 0xbb && begin[2] == 0xbf) {
+		begin += 3;
+	}
+	ptr = begin;
+}
+
+Error JSONReader::open(const String &p_path) {
+	Error err;
+	Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_path, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot open file '%s'.", p_path));
+	return open_buffer(data);
+}
+
+Error JSONReader::open_buffer(const Vector<uint8_t> &p_buffer) {
+	close();
+	buffer = p_buffer;
+	_set_data(buffer.ptr(), buffer.size());
+	return OK;
+}
+
+Error JSONReader::_open_buffer(const uint8_t *p_buffer, size_t p_size) {
+	close();
+	_set_data(p_buffer, p_size);
+	return OK;
+}
+
+void JSONReader::close() {
+	buffer.clear();
+	begin = nullptr;
+	end = nullptr;
+	ptr = nullptr;
+	scopes.clear();
+	scratch.clear();
+	root_read = false;
+	token_type = TOKEN_NONE;
+	key = String();
+	value = Variant();
+	error = OK;
+	err_str = String();
+	err_ptr = nullptr;
+}
+
+void JSONReader::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("open", "path"), &JSONReader::open);
+	ClassDB::bind_method(D_METHOD("open_buffer", "buffer"), &JSONReader::open_buffer);
+	ClassDB::bind_method(D_METHOD("close"), &JSONReader::close);
+
+	ClassDB::bind_method(D_METHOD("read"), &JSONReader::read);
+	ClassDB::bind_method(D_METHOD("read_value"), &JSONReader::_read_value_bind);
+	ClassDB::bind_method(D_METHOD("skip_section"), &JSONReader::skip_section);
+
+	ClassDB::bind_method(D_METHOD("get_token_type"), &JSONReader::get_token_type);
+	ClassDB::bind_method(D_METHOD("get_key"), &JSONReader::get_key);
+	ClassDB::bind_method(D_METHOD("get_value"), &JSONReader::get_value);
+	ClassDB::bind_method(D_METHOD("get_depth"), &JSONReader::get_depth);
+	ClassDB::bind_method(D_METHOD("get_offset"), &JSONReader::get_offset);
+	ClassDB::bind_method(D_METHOD("get_error_line"), &JSONReader::get_error_line);
+	ClassDB::bind_method(D_METHOD("get_error_message"), &JSONReader::get_error_message);
+
+	BIND_ENUM_CONSTANT(TOKEN_NONE);
+	BIND_ENUM_CONSTANT(TOKEN_OBJECT_BEGIN);
+	BIND_ENUM_CONSTANT(TOKEN_OBJECT_END);
+	BIND_ENUM_CONSTANT(TOKEN_ARRAY_BEGIN);
+	BIND_ENUM_CONSTANT(TOKEN_ARRAY_END);
+	BIND_ENUM_CONSTANT(TOKEN_KEY);
+	BIND_ENUM_CONSTANT(TOKEN_VALUE);
+}
@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*  json_reader.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/type_info.h"
+#include "core/variant/variant.h"
+
+// Pull parser reading JSON directly from UTF-8 bytes. Values are reported one
+// token at a time, so large documents can be walked without building the
+// whole Dictionary/Array tree. Accepts the same dialect as JSON::parse().
+class JSONReader : public RefCounted {
+	GDCLASS(JSONReader, RefCounted);
+
+public:
+	enum TokenType {
+		TOKEN_NONE,
+		TOKEN_OBJECT_BEGIN,
+		TOKEN_OBJECT_END,
+		TOKEN_ARRAY_BEGIN,
+		TOKEN_ARRAY_END,
+		TOKEN_KEY,
+		TOKEN_VALUE,
+	};
+
+private:
+	struct Scope {
+		bool is_object = false;
+		bool need_comma = false;
+		bool at_key = true;
+	};
+
+	Vector<uint8_t> buffer;
+	const uint8_t *begin = nullptr;
+	const uint8_t *end = nullptr;
+	const uint8_t *ptr = nullptr;
+
+	LocalVector<Scope> scopes;
+	LocalVector<uint8_t> scratch;
+	bool root_read = false;
+
+	TokenType token_type = TOKEN_NONE;
+	String key;
+	Variant value;
+
+	Error error = OK;
+	String err_str;
+	const uint8_t *err_ptr = nullptr;
+
+	Error _set_error(const String &p_message, Error p_error = ERR_PARSE_ERROR);
+	void _skip_whitespace();
+	Error _read_string(String &r_string);
+	Error _read_number(Variant &r_value);
+	Error _read_identifier(Variant &r_value);
+	Error _read_value_token();
+	Error _read_container(Variant &r_value);
+	void _set_data(const uint8_t *p_data, size_t p_size);
+
+	Variant _read_value_bind();
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error open(const String &p_path);
+	Error open_buffer(const Vector<uint8_t> &p_buffer);
+	// The data is not copied, it must outlive the reader (or the next open call).
+	Error _open_buffer(const uint8_t *p_buffer, size_t p_size);
+	void close();
+
+	Error read();
+	Error read_value(Variant &r_value);
+	Error skip_section();
+
+	_FORCE_INLINE_ TokenType get_token_type() const { return token_type; }
+	_FORCE_INLINE_ String get_key() const { return key; }
+	_FORCE_INLINE_ Variant get_value() const { return value; }
+	_FORCE_INLINE_ int get_depth() const { return scopes.size(); }
+	uint64_t get_offset() const;
+
+	int get_error_line() const;
+	_FORCE_INLINE_ String get_error_message() const { return err_str; }
+};
+
+VARIANT_ENUM_CAST(JSONReader::TokenType);
@@ -35,6 +35,7 @@
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
 #include "core/variant/container_type_validate.h"
+#include "core/variant/variant_internal.h"
 
 #include <climits>
 #include <cstdio>
@@ -177,7 +178,29 @@ static Error _decode_container_type(const uint8_t *&p_buffer, int &r_left, int *
 	ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Invalid container type kind."); // Future proofing.
 }
 
-Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
+// Returns the packed array of `r_variant` to decode into, keeping its memory when decoding in place.
+template <typename T>
+static Vector<T> &_get_packed_array_target(Variant &r_variant, bool p_in_place) {
+	if (!p_in_place || r_variant.get_type() != GetTypeInfo<Vector<T>>::VARIANT_TYPE) {
+		r_variant = Vector<T>();
+	}
+	return VariantInternalAccessor<Vector<T>>::get(&r_variant);
+}
+
+// Returns the untyped container held by `r_variant` to decode into in place, if any.
+template <typename T>
+static T *_get_container_target(Variant &r_variant) {
+	if (r_variant.get_type() != GetTypeInfo<T>::VARIANT_TYPE) {
+		return nullptr;
+	}
+	T *container = &VariantInternalAccessor<T>::get(&r_variant);
+	if (container->is_typed() || container->is_read_only()) {
+		return nullptr;
+	}
+	return container;
+}
+
+static Error _decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth, bool p_in_place) {
 	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Variant is too deep. Bailing.");
 	const uint8_t *buf = p_buffer;
 	int len = p_len;
@@ -737,7 +760,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 						Variant value;
 						int used;
-						RETURN_IF_ERROR(decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1));
+						RETURN_IF_ERROR(_decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1, false));
 
 						buf += used;
 						len -= used;
@@ -806,7 +829,11 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			}
 
 			Dictionary dict;
-			if (key_type.builtin_type != Variant::NIL || value_type.builtin_type != Variant::NIL) {
+			Dictionary *target = p_in_place && key_type.builtin_type == Variant::NIL && value_type.builtin_type == Variant::NIL ? _get_container_target<Dictionary>(r_variant) : nullptr;
+			if (target) {
+				// Keeps the memory of the hash table.
+				target->clear();
+			} else if (key_type.builtin_type != Variant::NIL || value_type.builtin_type != Variant::NIL) {
 				dict.set_typed(key_type, value_type);
 			}
 
@@ -814,7 +841,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				Variant key, value;
 
 				int used;
-				Error err = decode_variant(key, buf, len, &used, p_allow_objects, p_depth + 1);
+				Error err = _decode_variant(key, buf, len, &used, p_allow_objects, p_depth + 1, false);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 
 				buf += used;
@@ -823,7 +850,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += used;
 				}
 
-				err = decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1);
+				err = _decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1, false);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 
 				buf += used;
@@ -832,10 +859,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += used;
 				}
 
-				dict[key] = value;
+				if (target) {
+					(*target)[key] = value;
+				} else {
+					dict[key] = value;
+				}
 			}
 
-			r_variant = dict;
+			if (!target) {
+				r_variant = dict;
+			}
 
 		} break;
 		case Variant::ARRAY: {
@@ -859,6 +892,24 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				(*r_len) += 4; // Size of count number.
 			}
 
+			Array *target = p_in_place && type.builtin_type == Variant::NIL ? _get_container_target<Array>(r_variant) : nullptr;
+			if (target) {
+				// Each element takes at least 4 bytes.
+				ERR_FAIL_COND_V(count > len / 4, ERR_INVALID_DATA);
+				target->resize(count);
+				for (int i = 0; i < count; i++) {
+					int used = 0;
+					Error err = _decode_variant((*target)[i], buf, len, &used, p_allow_objects, p_depth + 1, true);
+					ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
+					buf += used;
+					len -= used;
+					if (r_len) {
+						(*r_len) += used;
+					}
+				}
+				break;
+			}
+
 			Array array;
 			if (type.builtin_type != Variant::NIL) {
 				array.set_typed(type);
@@ -867,7 +918,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			for (int i = 0; i < count; i++) {
 				int used = 0;
 				Variant elem;
-				Error err = decode_variant(elem, buf, len, &used, p_allow_objects, p_depth + 1);
+				Error err = _decode_variant(elem, buf, len, &used, p_allow_objects, p_depth + 1, false);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 				buf += used;
 				len -= used;
@@ -889,18 +940,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			len -= 4;
 			ERR_FAIL_COND_V(count < 0 || count > len, ERR_INVALID_DATA);
 
-			Vector<uint8_t> data;
+			Vector<uint8_t> &data = _get_packed_array_target<uint8_t>(r_variant, p_in_place);
 
+			data.resize(count);
 			if (count) {
-				data.resize(count);
 				uint8_t *w = data.ptrw();
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = buf[i];
 				}
 			}
 
-			r_variant = data;
-
 			if (r_len) {
 				if (count % 4) {
 					(*r_len) += 4 - count % 4;
@@ -917,17 +966,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 4, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 > len, ERR_INVALID_DATA);
 
-			Vector<int32_t> data;
+			Vector<int32_t> &data = _get_packed_array_target<int32_t>(r_variant, p_in_place);
 
+			data.resize(count);
 			if (count) {
 				//const int *rbuf = (const int *)buf;
-				data.resize(count);
 				int32_t *w = data.ptrw();
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint32(&buf[i * 4]);
 				}
 			}
-			r_variant = Variant(data);
 			if (r_len) {
 				(*r_len) += 4 + count * sizeof(int32_t);
 			}
@@ -941,17 +989,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 8 > len, ERR_INVALID_DATA);
 
-			Vector<int64_t> data;
+			Vector<int64_t> &data = _get_packed_array_target<int64_t>(r_variant, p_in_place);
 
+			data.resize(count);
 			if (count) {
 				//const int *rbuf = (const int *)buf;
-				data.resize(count);
 				int64_t *w = data.ptrw();
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_uint64(&buf[i * 8]);
 				}
 			}
-			r_variant = Variant(data);
 			if (r_len) {
 				(*r_len) += 4 + count * sizeof(int64_t);
 			}
@@ -965,17 +1012,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 4, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 > len, ERR_INVALID_DATA);
 
-			Vector<float> data;
+			Vector<float> &data = _get_packed_array_target<float>(r_variant, p_in_place);
 
+			data.resize(count);
 			if (count) {
 				//const float *rbuf = (const float *)buf;
-				data.resize(count);
 				float *w = data.ptrw();
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_float(&buf[i * 4]);
 				}
 			}
-			r_variant = data;
 
 			if (r_len) {
 				(*r_len) += 4 + count * sizeof(float);
@@ -990,16 +1036,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 8 > len, ERR_INVALID_DATA);
 
-			Vector<double> data;
+			Vector<double> &data = _get_packed_array_target<double>(r_variant, p_in_place);
 
+			data.resize(count);
 			if (count) {
-				data.resize(count);
 				double *w = data.ptrw();
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_double(&buf[i * 8]);
 				}
 			}
-			r_variant = data;
 
 			if (r_len) {
 				(*r_len) += 4 + count * sizeof(double);
@@ -1010,23 +1055,22 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
 			int32_t count = decode_uint32(buf);
 
-			Vector<String> strings;
 			buf += 4;
 			len -= 4;
+			// Each string takes at least 4 bytes.
+			ERR_FAIL_COND_V(count < 0 || count > len / 4, ERR_INVALID_DATA);
 
 			if (r_len) {
 				(*r_len) += 4; // Size of count number.
 			}
 
+			Vector<String> &strings = _get_packed_array_target<String>(r_variant, p_in_place);
+			strings.resize(count);
+			String *w = strings.ptrw();
 			for (int32_t i = 0; i < count; i++) {
-				String str;
-				RETURN_IF_ERROR(_decode_string(buf, len, r_len, str));
-
-				strings.push_back(str);
+				RETURN_IF_ERROR(_decode_string(buf, len, r_len, w[i]));
 			}
 
-			r_variant = strings;
-
 		} break;
 		case Variant::PACKED_VECTOR2_ARRAY: {
 			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
@@ -1034,7 +1078,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			buf += 4;
 			len -= 4;
 
-			Vector<Vector2> varray;
+			Vector<Vector2> &varray = _get_packed_array_target<Vector2>(r_variant, p_in_place);
 
 			if (header & HEADER_DATA_FLAG_64) {
 				ERR_FAIL_MUL_OF(count, sizeof(double) * 2, ERR_INVALID_DATA);
@@ -1044,8 +1088,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += 4; // Size of count number.
 				}
 
+				varray.resize(count);
 				if (count) {
-					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
 					for (int32_t i = 0; i < count; i++) {
@@ -1069,8 +1113,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += 4; // Size of count number.
 				}
 
+				varray.resize(count);
 				if (count) {
-					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
 					for (int32_t i = 0; i < count; i++) {
@@ -1085,7 +1129,6 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					}
 				}
 			}
-			r_variant = varray;
 
 		} break;
 		case Variant::PACKED_VECTOR3_ARRAY: {
@@ -1094,7 +1137,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			buf += 4;
 			len -= 4;
 
-			Vector<Vector3> varray;
+			Vector<Vector3> &varray = _get_packed_array_target<Vector3>(r_variant, p_in_place);
 
 			if (header & HEADER_DATA_FLAG_64) {
 				ERR_FAIL_MUL_OF(count, sizeof(double) * 3, ERR_INVALID_DATA);
@@ -1104,8 +1147,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += 4; // Size of count number.
 				}
 
+				varray.resize(count);
 				if (count) {
-					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
 					for (int32_t i = 0; i < count; i++) {
@@ -1130,8 +1173,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += 4; // Size of count number.
 				}
 
+				varray.resize(count);
 				if (count) {
-					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
 					for (int32_t i = 0; i < count; i++) {
@@ -1149,7 +1192,6 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					buf += adv;
 				}
 			}
-			r_variant = varray;
 
 		} break;
 		case Variant::PACKED_COLOR_ARRAY: {
@@ -1161,14 +1203,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 4 * 4, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 * 4 > len, ERR_INVALID_DATA);
 
-			Vector<Color> carray;
+			Vector<Color> &carray = _get_packed_array_target<Color>(r_variant, p_in_place);
 
 			if (r_len) {
 				(*r_len) += 4; // Size of count number.
 			}
 
+			carray.resize(count);
 			if (count) {
-				carray.resize(count);
 				Color *w = carray.ptrw();
 
 				for (int32_t i = 0; i < count; i++) {
@@ -1186,8 +1228,6 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				}
 			}
 
-			r_variant = carray;
-
 		} break;
 
 		case Variant::PACKED_VECTOR4_ARRAY: {
@@ -1196,7 +1236,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			buf += 4;
 			len -= 4;
 
-			Vector<Vector4> varray;
+			Vector<Vector4> &varray = _get_packed_array_target<Vector4>(r_variant, p_in_place);
 
 			if (header & HEADER_DATA_FLAG_64) {
 				ERR_FAIL_MUL_OF(count, sizeof(double) * 4, ERR_INVALID_DATA);
@@ -1206,8 +1246,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += 4; // Size of count number.
 				}
 
+				varray.resize(count);
 				if (count) {
-					varray.resize(count);
 					Vector4 *w = varray.ptrw();
 
 					for (int32_t i = 0; i < count; i++) {
@@ -1233,8 +1273,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += 4; // Size of count number.
 				}
 
+				varray.resize(count);
 				if (count) {
-					varray.resize(count);
 					Vector4 *w = varray.ptrw();
 
 					for (int32_t i = 0; i < count; i++) {
@@ -1253,7 +1293,6 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					buf += adv;
 				}
 			}
-			r_variant = varray;
 
 		} break;
 		default: {
@@ -1264,6 +1303,10 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 	return OK;
 }
 
+Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
+	return _decode_variant(r_variant, p_buffer, p_len, r_len, p_allow_objects, p_depth, false);
+}
+
 static void _encode_string(const String &p_string, uint8_t *&p_buffer, int &r_len) {
 	CharString utf8 = p_string.utf8();
 
@@ -2085,6 +2128,223 @@ Error encode_variant(const Variant &p_variant, uint8_t *p_buffer, int &r_len, bo
 	return OK;
 }
 
+static int64_t _get_string_size_bound(const String &p_string) {
+	// Length, up to 4 UTF-8 bytes per character, and padding.
+	return 4 + int64_t(p_string.length()) * 4 + 3;
+}
+
+static int64_t _get_container_type_size(const ContainerType &p_type, bool p_full_objects) {
+	uint8_t *buf = nullptr;
+	int len = 0;
+	if (_encode_container_type(p_type, buf, len, p_full_objects) != OK) {
+		return -1;
+	}
+	return len;
+}
+
+// Returns an upper bound of the size written by `encode_variant()`, without allocating memory,
+// or -1 when it cannot be known without encoding the Variant (objects encoded with their properties).
+static int64_t _get_encoded_size_bound(const Variant &p_variant, bool p_full_objects, int p_depth) {
+	if (p_depth > Variant::MAX_RECURSION_DEPTH) {
+		return -1;
+	}
+
+	// Header.
+	int64_t size = 4;
+
+	switch (p_variant.get_type()) {
+		case Variant::NIL:
+		case Variant::CALLABLE: {
+		} break;
+		case Variant::BOOL: {
+			size += 4;
+		} break;
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::RID: {
+			size += 8;
+		} break;
+		case Variant::STRING: {
+			size += _get_string_size_bound(*VariantInternal::get_string(&p_variant));
+		} break;
+		case Variant::STRING_NAME: {
+			size += _get_string_size_bound(p_variant.operator String());
+		} break;
+		case Variant::NODE_PATH: {
+			const NodePath &np = *VariantInternal::get_node_path(&p_variant);
+			size += 12;
+			for (int i = 0; i < np.get_name_count(); i++) {
+				size += _get_string_size_bound(np.get_name(i));
+			}
+			for (int i = 0; i < np.get_subname_count(); i++) {
+				size += _get_string_size_bound(np.get_subname(i));
+			}
+		} break;
+		case Variant::VECTOR2I: {
+			size += 2 * 4;
+		} break;
+		case Variant::VECTOR3I: {
+			size += 3 * 4;
+		} break;
+		case Variant::RECT2I:
+		case Variant::VECTOR4I:
+		case Variant::COLOR: {
+			size += 4 * 4;
+		} break;
+		case Variant::VECTOR2: {
+			size += 2 * sizeof(real_t);
+		} break;
+		case Variant::VECTOR3: {
+			size += 3 * sizeof(real_t);
+		} break;
+		case Variant::RECT2:
+		case Variant::VECTOR4:
+		case Variant::PLANE:
+		case Variant::QUATERNION: {
+			size += 4 * sizeof(real_t);
+		} break;
+		case Variant::TRANSFORM2D:
+		case Variant::AABB: {
+			size += 6 * sizeof(real_t);
+		} break;
+		case Variant::BASIS: {
+			size += 9 * sizeof(real_t);
+		} break;
+		case Variant::TRANSFORM3D: {
+			size += 12 * sizeof(real_t);
+		} break;
+		case Variant::PROJECTION: {
+			size += 16 * sizeof(real_t);
+		} break;
+		case Variant::OBJECT: {
+			if (p_full_objects && p_variant.get_validated_object()) {
+				return -1;
+			}
+			size += 8;
+		} break;
+		case Variant::SIGNAL: {
+			const Signal &signal = *VariantInternal::get_signal(&p_variant);
+			size += _get_string_size_bound(signal.get_name()) + 8;
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary &dict = *VariantInternal::get_dictionary(&p_variant);
+			const int64_t key_type_size = _get_container_type_size(dict.get_key_type(), p_full_objects);
+			const int64_t value_type_size = _get_container_type_size(dict.get_value_type(), p_full_objects);
+			if (key_type_size < 0 || value_type_size < 0) {
+				return -1;
+			}
+			size += key_type_size + value_type_size + 4;
+			for (const KeyValue<Variant, Variant> &kv : dict) {
+				const int64_t key_size = _get_encoded_size_bound(kv.key, p_full_objects, p_depth + 1);
+				const int64_t value_size = _get_encoded_size_bound(kv.value, p_full_objects, p_depth + 1);
+				if (key_size < 0 || value_size < 0) {
+					return -1;
+				}
+				size += key_size + value_size;
+			}
+		} break;
+		case Variant::ARRAY: {
+			const Array &array = *VariantInternal::get_array(&p_variant);
+			const int64_t type_size = _get_container_type_size(array.get_element_type(), p_full_objects);
+			if (type_size < 0) {
+				return -1;
+			}
+			size += type_size + 4;
+			for (const Variant &elem : array) {
+				const int64_t elem_size = _get_encoded_size_bound(elem, p_full_objects, p_depth + 1);
+				if (elem_size < 0) {
+					return -1;
+				}
+				size += elem_size;
+			}
+		} break;
+		case Variant::PACKED_BYTE_ARRAY: {
+			size += 4 + VariantInternal::get_byte_array(&p_variant)->size() + 3;
+		} break;
+		case Variant::PACKED_INT32_ARRAY: {
+			size += 4 + VariantInternal::get_int32_array(&p_variant)->size() * int64_t(4);
+		} break;
+		case Variant::PACKED_INT64_ARRAY: {
+			size += 4 + VariantInternal::get_int64_array(&p_variant)->size() * int64_t(8);
+		} break;
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			size += 4 + VariantInternal::get_float32_array(&p_variant)->size() * int64_t(4);
+		} break;
+		case Variant::PACKED_FLOAT64_ARRAY: {
+			size += 4 + VariantInternal::get_float64_array(&p_variant)->size() * int64_t(8);
+		} break;
+		case Variant::PACKED_STRING_ARRAY: {
+			size += 4;
+			for (const String &str : *VariantInternal::get_string_array(&p_variant)) {
+				// Also includes the null terminator.
+				size += _get_string_size_bound(str) + 1;
+			}
+		} break;
+		case Variant::PACKED_VECTOR2_ARRAY: {
+			size += 4 + VariantInternal::get_vector2_array(&p_variant)->size() * int64_t(2 * sizeof(real_t));
+		} break;
+		case Variant::PACKED_VECTOR3_ARRAY: {
+			size += 4 + VariantInternal::get_vector3_array(&p_variant)->size() * int64_t(3 * sizeof(real_t));
+		} break;
+		case Variant::PACKED_COLOR_ARRAY: {
+			size += 4 + VariantInternal::get_color_array(&p_variant)->size() * int64_t(4 * 4);
+		} break;
+		case Variant::PACKED_VECTOR4_ARRAY: {
+			size += 4 + VariantInternal::get_vector4_array(&p_variant)->size() * int64_t(4 * sizeof(real_t));
+		} break;
+		default: {
+			return -1;
+		}
+	}
+
+	return size;
+}
+
+Error VariantEncoder::encode(const Variant &p_variant, bool p_full_objects, int p_max_size) {
+	int len = 0;
+	int64_t bound = _get_encoded_size_bound(p_variant, p_full_objects, 0);
+	if (bound < 0 || bound > p_max_size) {
+		// Measure the exact size instead, the bound may be too loose to fit.
+		Error err = encode_variant(p_variant, nullptr, len, p_full_objects);
+		ERR_FAIL_COND_V(err != OK, err);
+		if (len > p_max_size) {
+			return ERR_OUT_OF_MEMORY;
+		}
+		bound = len;
+	}
+	ERR_FAIL_COND_V(bound > INT_MAX - size, ERR_OUT_OF_MEMORY);
+
+	if (buffer.size() < size + bound) {
+		ERR_FAIL_COND_V(buffer.resize(size + bound) != OK, ERR_OUT_OF_MEMORY);
+	}
+	Error err = encode_variant(p_variant, buffer.ptrw() + size, len, p_full_objects);
+	ERR_FAIL_COND_V(err != OK, err);
+	DEV_ASSERT(len <= bound);
+	size += len;
+	return OK;
+}
+
+Error VariantDecoder::decode(Variant &r_variant, bool p_allow_objects) {
+	int len = 0;
+	Error err = _decode_variant(r_variant, buffer + position, size - position, &len, p_allow_objects, 0, true);
+	ERR_FAIL_COND_V(err != OK, err);
+	position += len;
+	return OK;
+}
+
+Error VariantDecoder::decode_bytes(Span<uint8_t> &r_bytes) {
+	const int left = size - position;
+	ERR_FAIL_COND_V(left < 8, ERR_INVALID_DATA);
+	const uint8_t *buf = buffer + position;
+	ERR_FAIL_COND_V((decode_uint32(buf) & HEADER_TYPE_MASK) != Variant::PACKED_BYTE_ARRAY, ERR_INVALID_DATA);
+	const int32_t count = decode_uint32(buf + 4);
+	ERR_FAIL_COND_V(count < 0 || count > left - 8, ERR_INVALID_DATA);
+	r_bytes = Span<uint8_t>(buf + 8, count);
+	// Skip the padding too.
+	position += MIN(8 + count + (4 - count % 4) % 4, left);
+	return OK;
+}
+
 Vector<float> vector3_to_float32_array(const Vector3 *p_vecs, size_t p_count) {
 	// We always allocate a new array, and we don't `memcpy()`.
 	// We also don't consider returning a pointer to the passed vectors when `sizeof(real_t) == 4`.
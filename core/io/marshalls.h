@@ -222,4 +222,47 @@ public:
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
 
+// Encodes Variants one after another into a buffer that keeps its memory between uses.
+// Each Variant is written in a single pass after reserving an upper bound of its encoded size,
+// instead of being encoded once to measure it and once more to write it.
+class VariantEncoder {
+	Vector<uint8_t> buffer;
+	int size = 0;
+
+public:
+	// Fails with `ERR_OUT_OF_MEMORY` before allocating anything if the Variant would encode to more than `p_max_size` bytes.
+	Error encode(const Variant &p_variant, bool p_full_objects = false, int p_max_size = INT_MAX);
+
+	// Forgets the encoded data, keeping the memory for the next Variants.
+	void clear() { size = 0; }
+	// Forgets the encoded data and frees the memory.
+	void reset() {
+		buffer.clear();
+		size = 0;
+	}
+	const uint8_t *get_data() const { return buffer.ptr(); }
+	int get_size() const { return size; }
+};
+
+// Decodes Variants one after another from a buffer.
+// A Variant passed to `decode()` that already holds an untyped Array or Dictionary, or a packed array,
+// of the decoded type is updated in place so that its memory is reused. As Arrays and Dictionaries are
+// shared by reference, every reference to them will see the new content.
+class VariantDecoder {
+	const uint8_t *buffer = nullptr;
+	int size = 0;
+	int position = 0;
+
+public:
+	Error decode(Variant &r_variant, bool p_allow_objects = false);
+	// Reads an encoded PackedByteArray without copying it. The bytes point into the decoded buffer.
+	Error decode_bytes(Span<uint8_t> &r_bytes);
+
+	int get_position() const { return position; }
+	int get_available_bytes() const { return size - position; }
+
+	VariantDecoder(const uint8_t *p_buffer, int p_size) :
+			buffer(p_buffer), size(p_size) {}
+};
+
 Vector<float> vector3_to_float32_array(const Vector3 *p_vecs, size_t p_count);
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/extension/ext_wrappers.gen.h"
+#include "core/io/marshalls.h"
 #include "core/io/stream_peer.h"
 #include "core/object/gdvirtual.gen.h"
 #include "core/templates/ring_buffer.h"
@@ -50,7 +51,7 @@ class PacketPeer : public RefCounted {
 	mutable Error last_get_error = OK;
 
 	int encode_buffer_max_size = 8 * 1024 * 1024;
-	Vector<uint8_t> encode_buffer;
+	VariantEncoder encode_buffer;
 
 public:
 	virtual int get_available_packet_count() const = 0;
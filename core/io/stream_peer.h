@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/extension/ext_wrappers.gen.h"
+#include "core/io/marshalls.h"
 #include "core/object/gdvirtual.gen.h"
 #include "core/object/ref_counted.h"
 #include "core/variant/native_ptr.h"
@@ -50,6 +51,8 @@ protected:
 
 	bool big_endian = false;
 
+	VariantEncoder encode_buffer;
+
 public:
 	virtual Error put_data(const uint8_t *p_data, int p_bytes) = 0; ///< put a whole chunk of data, blocking until it sent
 	virtual Error put_partial_data(const uint8_t *p_data, int p_bytes, int &r_sent) = 0; ///< put as much data as possible, without blocking.
@@ -33,6 +33,7 @@
 
 #include "core/math/geometry_3d.h"
 #include "core/object/class_db.h"
+#include "core/object/worker_thread_pool.h"
 
 int64_t AStar3D::get_available_point_id() const {
 	if (points.has(last_free_id)) {
@@ -57,15 +58,20 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 		pt->id = p_id;
 		pt->pos = p_pos;
 		pt->weight_scale = p_weight_scale;
-		pt->prev_point = nullptr;
-		pt->open_pass = 0;
-		pt->closed_pass = 0;
 		pt->enabled = true;
+		if (free_scratch_indices.is_empty()) {
+			pt->scratch_index = scratch_size++;
+		} else {
+			pt->scratch_index = free_scratch_indices[free_scratch_indices.size() - 1];
+			free_scratch_indices.remove_at(free_scratch_indices.size() - 1);
+		}
+		pt->bvh_id = point_bvh.insert(AABB(p_pos, Vector3()), pt);
 		points.insert_new(p_id, pt);
 	} else {
 		Point *found_pt = *point_entry;
 		found_pt->pos = p_pos;
 		found_pt->weight_scale = p_weight_scale;
+		_update_point_leaves(found_pt);
 	}
 }
 
@@ -81,6 +87,37 @@ void AStar3D::set_point_position(int64_t p_id, const Vector3 &p_pos) {
 	ERR_FAIL_COND_MSG(!point_entry, vformat("Can't set point's position. Point with id: %d doesn't exist.", p_id));
 
 	(*point_entry)->pos = p_pos;
+	_update_point_leaves(*point_entry);
+}
+
+void AStar3D::_update_point_leaves(Point *p_point) {
+	// Reinsert rather than DynamicBVH::update(), which ignores approximately equal boxes.
+	// Closest queries rely on leaf volumes matching the point positions exactly.
+	point_bvh.remove(p_point->bvh_id);
+	p_point->bvh_id = point_bvh.insert(AABB(p_point->pos, Vector3()), p_point);
+
+	for (int i = 0; i < 2; i++) {
+		const AHashMap<int64_t, Point *> &connected = i == 0 ? p_point->neighbors : p_point->unlinked_neighbours;
+		for (const KeyValue<int64_t, Point *> &kv : connected) {
+			HashSet<Segment, Segment>::Iterator element = segments.find(Segment(p_point->id, kv.key));
+			if (!element) {
+				continue;
+			}
+			SegmentLeaf *leaf = element->leaf;
+			segment_bvh.remove(leaf->bvh_id);
+			leaf->bvh_id = segment_bvh.insert(AABB(leaf->from_point->pos, Vector3()).expand(leaf->to_point->pos), leaf);
+		}
+	}
+}
+
+void AStar3D::_erase_segment(const Segment &p_segment) {
+	HashSet<Segment, Segment>::Iterator element = segments.find(p_segment);
+	if (!element) {
+		return;
+	}
+	segment_bvh.remove(element->leaf->bvh_id);
+	memdelete(element->leaf);
+	segments.remove(element);
 }
 
 real_t AStar3D::get_point_weight_scale(int64_t p_id) const {
@@ -104,21 +141,21 @@ void AStar3D::remove_point(int64_t p_id) {
 	Point *p = *point_entry;
 
 	for (KeyValue<int64_t, Point *> &kv : p->neighbors) {
-		Segment s(p_id, kv.key);
-		segments.erase(s);
+		_erase_segment(Segment(p_id, kv.key));
 
 		kv.value->neighbors.erase(p->id);
 		kv.value->unlinked_neighbours.erase(p->id);
 	}
 
 	for (KeyValue<int64_t, Point *> &kv : p->unlinked_neighbours) {
-		Segment s(p_id, kv.key);
-		segments.erase(s);
+		_erase_segment(Segment(p_id, kv.key));
 
 		kv.value->neighbors.erase(p->id);
 		kv.value->unlinked_neighbours.erase(p->id);
 	}
 
+	point_bvh.remove(p->bvh_id);
+	free_scratch_indices.push_back(p->scratch_index);
 	memdelete(p);
 	points.erase(p_id);
 	last_free_id = p_id;
@@ -156,7 +193,13 @@ void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool p_bidirection
 			a->unlinked_neighbours.erase(b->id);
 			b->unlinked_neighbours.erase(a->id);
 		}
+		s.leaf = element->leaf;
 		segments.remove(element);
+	} else {
+		s.leaf = memnew(SegmentLeaf);
+		s.leaf->from_point = p_id < p_with_id ? a : b;
+		s.leaf->to_point = p_id < p_with_id ? b : a;
+		s.leaf->bvh_id = segment_bvh.insert(AABB(a->pos, Vector3()).expand(b->pos), s.leaf);
 	}
 
 	segments.insert(s);
@@ -195,9 +238,12 @@ void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool p_bidirect
 			}
 		}
 
-		segments.remove(element);
 		if (s.direction != Segment::NONE) {
+			s.leaf = element->leaf;
+			segments.remove(element);
 			segments.insert(s);
+		} else {
+			_erase_segment(s);
 		}
 	}
 }
@@ -242,8 +288,15 @@ void AStar3D::clear() {
 	for (KeyValue<int64_t, Point *> &kv : points) {
 		memdelete(kv.value);
 	}
+	for (const Segment &E : segments) {
+		memdelete(E.leaf);
+	}
 	segments.clear();
 	points.clear();
+	point_bvh.clear();
+	segment_bvh.clear();
+	scratch_size = 0;
+	free_scratch_indices.clear();
 }
 
 int64_t AStar3D::get_point_count() const {
@@ -260,56 +313,74 @@ void AStar3D::reserve_space(int64_t p_num_nodes) {
 }
 
 int64_t AStar3D::get_closest_point(const Vector3 &p_point, bool p_include_disabled) const {
-	int64_t closest_id = -1;
-	real_t closest_dist = 1e20;
-
-	for (const KeyValue<int64_t, Point *> &kv : points) {
-		if (!p_include_disabled && !kv.value->enabled) {
-			continue; // Disabled points should not be considered.
-		}
+	struct ClosestPointQuery {
+		Vector3 point;
+		bool include_disabled = false;
+		int64_t closest_id = -1;
+		real_t closest_dist = 1e20;
+
+		_FORCE_INLINE_ real_t operator()(void *p_data) {
+			const Point *pt = static_cast<const Point *>(p_data);
+			if (!include_disabled && !pt->enabled) {
+				return closest_dist; // Disabled points should not be considered.
+			}
 
-		// Keep the closest point's ID, and in case of multiple closest IDs,
-		// the smallest one (makes it deterministic).
-		real_t d = p_point.distance_squared_to(kv.value->pos);
-		int64_t id = kv.key;
-		if (d <= closest_dist) {
-			if (d == closest_dist && id > closest_id) { // Keep lowest ID.
-				continue;
+			// Keep the closest point's ID, and in case of multiple closest IDs,
+			// the smallest one (makes it deterministic).
+			real_t d = point.distance_squared_to(pt->pos);
+			if (d <= closest_dist) {
+				if (d == closest_dist && pt->id > closest_id) { // Keep lowest ID.
+					return closest_dist;
+				}
+				closest_dist = d;
+				closest_id = pt->id;
 			}
-			closest_dist = d;
-			closest_id = id;
+			return closest_dist;
 		}
-	}
+	} query;
 
-	return closest_id;
+	query.point = p_point;
+	query.include_disabled = p_include_disabled;
+	point_bvh.closest_query(p_point, query.closest_dist, query);
+
+	return query.closest_id;
 }
 
 Vector3 AStar3D::get_closest_position_in_segment(const Vector3 &p_point) const {
-	real_t closest_dist = 1e20;
-	Vector3 closest_point;
-
-	for (const Segment &E : segments) {
-		const Point *from_point = *points.getptr(E.key.first);
-		const Point *to_point = *points.getptr(E.key.second);
+	struct ClosestSegmentQuery {
+		Vector3 point;
+		Vector3 closest_point;
+		real_t closest_dist = 1e20;
+		Pair<int64_t, int64_t> closest_key = { INT64_MAX, INT64_MAX };
+
+		_FORCE_INLINE_ real_t operator()(void *p_data) {
+			const SegmentLeaf *leaf = static_cast<const SegmentLeaf *>(p_data);
+			if (!(leaf->from_point->enabled && leaf->to_point->enabled)) {
+				return closest_dist;
+			}
 
-		if (!(from_point->enabled && to_point->enabled)) {
-			continue;
+			Vector3 p = Geometry3D::get_closest_point_to_segment(point, leaf->from_point->pos, leaf->to_point->pos);
+			real_t d = point.distance_squared_to(p);
+			// Tree traversal order is arbitrary, so break ties on the segment's IDs.
+			const Pair<int64_t, int64_t> key(leaf->from_point->id, leaf->to_point->id);
+			if (d < closest_dist || (d == closest_dist && key < closest_key)) {
+				closest_point = p;
+				closest_dist = d;
+				closest_key = key;
+			}
+			return closest_dist;
 		}
+	} query;
 
-		Vector3 p = Geometry3D::get_closest_point_to_segment(p_point, from_point->pos, to_point->pos);
-		real_t d = p_point.distance_squared_to(p);
-		if (d < closest_dist) {
-			closest_point = p;
-			closest_dist = d;
-		}
-	}
+	query.point = p_point;
+	segment_bvh.closest_query(p_point, query.closest_dist, query);
 
-	return closest_point;
+	return query.closest_point;
 }
 
-bool AStar3D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path) {
-	last_closest_point = nullptr;
-	pass++;
+bool AStar3D::_solve(SolveContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path) {
+	r_context.last_closest_point = nullptr;
+	r_context.pass++;
 
 	if (!p_begin_point->enabled) {
 		return false;
@@ -323,21 +394,36 @@ bool AStar3D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_part
 
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
+	if (r_context.scratch.size() < scratch_size) {
+		r_context.scratch.resize(scratch_size);
+	}
+	PointScratch *scratch = r_context.scratch.ptr();
+	const uint64_t pass = r_context.pass;
+
+	LocalVector<Point *> &open_list = r_context.open_list;
+	open_list.clear();
 	SortArray<Point *, SortPoints> sorter;
+	sorter.compare.scratch = scratch;
 
-	p_begin_point->g_score = 0;
-	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	p_begin_point->abs_g_score = 0;
-	p_begin_point->abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	PointScratch &begin_scratch = scratch[p_begin_point->scratch_index];
+	begin_scratch.g_score = 0;
+	begin_scratch.f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	begin_scratch.abs_g_score = 0;
+	begin_scratch.abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
 	open_list.push_back(p_begin_point);
 
 	while (!open_list.is_empty()) {
 		Point *p = open_list[0]; // The currently processed point.
+		PointScratch &ps = scratch[p->scratch_index];
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
-			last_closest_point = p;
+		if (r_context.last_closest_point == nullptr) {
+			r_context.last_closest_point = p;
+		} else {
+			const PointScratch &closest = scratch[r_context.last_closest_point->scratch_index];
+			if (closest.abs_f_score > ps.abs_f_score || (closest.abs_f_score >= ps.abs_f_score && closest.abs_g_score > ps.abs_g_score)) {
+				r_context.last_closest_point = p;
+			}
 		}
 
 		if (p == p_end_point) {
@@ -347,12 +433,13 @@ bool AStar3D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_part
 
 		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
 		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		ps.closed_pass = pass; // Mark the point as closed.
 
 		for (const KeyValue<int64_t, Point *> &kv : p->neighbors) {
 			Point *e = kv.value; // The neighbor point.
+			PointScratch &es = scratch[e->scratch_index];
 
-			if (!e->enabled || e->closed_pass == pass) {
+			if (!e->enabled || es.closed_pass == pass) {
 				continue;
 			}
 
@@ -363,23 +450,23 @@ bool AStar3D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_part
 				}
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
+			real_t tentative_g_score = ps.g_score + _compute_cost(p->id, e->id) * e->weight_scale;
 
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
+			if (es.open_pass != pass) { // The point wasn't inside the open list.
+				es.open_pass = pass;
 				open_list.push_back(e);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= es.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			es.prev_point = p;
+			es.g_score = tentative_g_score;
+			es.f_score = es.g_score + _estimate_cost(e->id, p_end_point->id);
+			es.abs_g_score = tentative_g_score;
+			es.abs_f_score = es.f_score - es.g_score;
 
 			if (new_point) { // The position of the new points is already known.
 				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
@@ -438,21 +525,23 @@ Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	bool found_route = _solve(solve_context, begin_point, end_point, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+		if (!p_allow_partial_path || solve_context.last_closest_point == nullptr) {
 			return Vector<Vector3>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_point = solve_context.last_closest_point;
 	}
 
+	const PointScratch *scratch = solve_context.scratch.ptr();
+
 	Point *p = end_point;
 	int64_t pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = scratch[p->scratch_index].prev_point;
 	}
 
 	Vector<Vector3> path;
@@ -465,7 +554,7 @@ Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 		int64_t idx = pc - 1;
 		while (p2 != begin_point) {
 			w[idx--] = p2->pos;
-			p2 = p2->prev_point;
+			p2 = scratch[p2->scratch_index].prev_point;
 		}
 
 		w[0] = p2->pos; // Assign first
@@ -475,6 +564,10 @@ Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 }
 
 Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+	return _get_id_path(solve_context, p_from_id, p_to_id, p_allow_partial_path);
+}
+
+Vector<int64_t> AStar3D::_get_id_path(SolveContext &r_context, int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
 	Point **a_entry = points.getptr(p_from_id);
 	ERR_FAIL_COND_V_MSG(!a_entry, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
 	Point *a = *a_entry;
@@ -486,21 +579,23 @@ Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	bool found_route = _solve(r_context, begin_point, end_point, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+		if (!p_allow_partial_path || r_context.last_closest_point == nullptr) {
 			return Vector<int64_t>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_point = r_context.last_closest_point;
 	}
 
+	const PointScratch *scratch = r_context.scratch.ptr();
+
 	Point *p = end_point;
 	int64_t pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = scratch[p->scratch_index].prev_point;
 	}
 
 	Vector<int64_t> path;
@@ -513,7 +608,7 @@ Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 		int64_t idx = pc - 1;
 		while (p != begin_point) {
 			w[idx--] = p->id;
-			p = p->prev_point;
+			p = scratch[p->scratch_index].prev_point;
 		}
 
 		w[0] = p->id; // Assign first
@@ -522,6 +617,40 @@ Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 	return path;
 }
 
+void AStar3D::_get_id_paths_task(uint32_t p_index, BatchSolve *p_batch) {
+	// Pool threads get their own context, the calling thread (index -1) uses the first one.
+	SolveContext &context = p_batch->contexts[WorkerThreadPool::get_singleton()->get_thread_index() + 1];
+	p_batch->paths[p_index] = _get_id_path(context, p_batch->from_ids[p_index], p_batch->to_ids[p_index], p_batch->allow_partial_path);
+}
+
+TypedArray<PackedInt64Array> AStar3D::get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path) {
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), TypedArray<PackedInt64Array>(), vformat("Can't get id paths. Got %d start points but %d end points.", p_from_ids.size(), p_to_ids.size()));
+
+	BatchSolve batch;
+	batch.from_ids = p_from_ids.ptr();
+	batch.to_ids = p_to_ids.ptr();
+	batch.allow_partial_path = p_allow_partial_path;
+	batch.paths.resize(p_from_ids.size());
+
+	// Script and extension callbacks aren't safe to call from several threads at once, so solve those on the calling thread.
+	if (neighbor_filter_enabled || get_script_instance() || GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) || GDVIRTUAL_IS_OVERRIDDEN(_compute_cost) || p_from_ids.size() < 2) {
+		for (uint32_t i = 0; i < batch.paths.size(); i++) {
+			batch.paths[i] = _get_id_path(solve_context, batch.from_ids[i], batch.to_ids[i], p_allow_partial_path);
+		}
+	} else {
+		batch.contexts.resize(WorkerThreadPool::get_singleton()->get_thread_count() + 1);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AStar3D::_get_id_paths_task, &batch, batch.paths.size(), -1, true, SNAME("AStar3DGetIdPaths"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	TypedArray<PackedInt64Array> paths;
+	paths.resize(batch.paths.size());
+	for (uint32_t i = 0; i < batch.paths.size(); i++) {
+		paths[i] = batch.paths[i];
+	}
+	return paths;
+}
+
 bool AStar3D::is_neighbor_filter_enabled() const {
 	return neighbor_filter_enabled;
 }
@@ -578,6 +707,7 @@ void AStar3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStar3D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStar3D::get_id_path, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids", "allow_partial_path"), &AStar3D::get_id_paths, DEFVAL(false));
 
 	GDVIRTUAL_BIND(_filter_neighbor, "from_id", "neighbor_id")
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "end_id")
@@ -732,21 +862,23 @@ Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 	AStar3D::Point *begin_point = a;
 	AStar3D::Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	bool found_route = _solve(astar.solve_context, begin_point, end_point, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || astar.last_closest_point == nullptr) {
+		if (!p_allow_partial_path || astar.solve_context.last_closest_point == nullptr) {
 			return Vector<Vector2>();
 		}
 
 		// Use closest point instead.
-		end_point = astar.last_closest_point;
+		end_point = astar.solve_context.last_closest_point;
 	}
 
+	const AStar3D::PointScratch *scratch = astar.solve_context.scratch.ptr();
+
 	AStar3D::Point *p = end_point;
 	int64_t pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = scratch[p->scratch_index].prev_point;
 	}
 
 	Vector<Vector2> path;
@@ -759,7 +891,7 @@ Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 		int64_t idx = pc - 1;
 		while (p2 != begin_point) {
 			w[idx--] = Vector2(p2->pos.x, p2->pos.y);
-			p2 = p2->prev_point;
+			p2 = scratch[p2->scratch_index].prev_point;
 		}
 
 		w[0] = Vector2(p2->pos.x, p2->pos.y); // Assign first
@@ -769,6 +901,10 @@ Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 }
 
 Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+	return _get_id_path(astar.solve_context, p_from_id, p_to_id, p_allow_partial_path);
+}
+
+Vector<int64_t> AStar2D::_get_id_path(AStar3D::SolveContext &r_context, int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
 	AStar3D::Point **a_entry = astar.points.getptr(p_from_id);
 	ERR_FAIL_COND_V_MSG(!a_entry, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
 	AStar3D::Point *a = *a_entry;
@@ -780,21 +916,23 @@ Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 	AStar3D::Point *begin_point = a;
 	AStar3D::Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	bool found_route = _solve(r_context, begin_point, end_point, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || astar.last_closest_point == nullptr) {
+		if (!p_allow_partial_path || r_context.last_closest_point == nullptr) {
 			return Vector<int64_t>();
 		}
 
 		// Use closest point instead.
-		end_point = astar.last_closest_point;
+		end_point = r_context.last_closest_point;
 	}
 
+	const AStar3D::PointScratch *scratch = r_context.scratch.ptr();
+
 	AStar3D::Point *p = end_point;
 	int64_t pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = scratch[p->scratch_index].prev_point;
 	}
 
 	Vector<int64_t> path;
@@ -807,7 +945,7 @@ Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 		int64_t idx = pc - 1;
 		while (p != begin_point) {
 			w[idx--] = p->id;
-			p = p->prev_point;
+			p = scratch[p->scratch_index].prev_point;
 		}
 
 		w[0] = p->id; // Assign first
@@ -816,9 +954,43 @@ Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 	return path;
 }
 
-bool AStar2D::_solve(AStar3D::Point *p_begin_point, AStar3D::Point *p_end_point, bool p_allow_partial_path) {
-	astar.last_closest_point = nullptr;
-	astar.pass++;
+void AStar2D::_get_id_paths_task(uint32_t p_index, AStar3D::BatchSolve *p_batch) {
+	// Pool threads get their own context, the calling thread (index -1) uses the first one.
+	AStar3D::SolveContext &context = p_batch->contexts[WorkerThreadPool::get_singleton()->get_thread_index() + 1];
+	p_batch->paths[p_index] = _get_id_path(context, p_batch->from_ids[p_index], p_batch->to_ids[p_index], p_batch->allow_partial_path);
+}
+
+TypedArray<PackedInt64Array> AStar2D::get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path) {
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), TypedArray<PackedInt64Array>(), vformat("Can't get id paths. Got %d start points but %d end points.", p_from_ids.size(), p_to_ids.size()));
+
+	AStar3D::BatchSolve batch;
+	batch.from_ids = p_from_ids.ptr();
+	batch.to_ids = p_to_ids.ptr();
+	batch.allow_partial_path = p_allow_partial_path;
+	batch.paths.resize(p_from_ids.size());
+
+	// Script and extension callbacks aren't safe to call from several threads at once, so solve those on the calling thread.
+	if (astar.neighbor_filter_enabled || get_script_instance() || GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) || GDVIRTUAL_IS_OVERRIDDEN(_compute_cost) || p_from_ids.size() < 2) {
+		for (uint32_t i = 0; i < batch.paths.size(); i++) {
+			batch.paths[i] = _get_id_path(astar.solve_context, batch.from_ids[i], batch.to_ids[i], p_allow_partial_path);
+		}
+	} else {
+		batch.contexts.resize(WorkerThreadPool::get_singleton()->get_thread_count() + 1);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AStar2D::_get_id_paths_task, &batch, batch.paths.size(), -1, true, SNAME("AStar2DGetIdPaths"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	TypedArray<PackedInt64Array> paths;
+	paths.resize(batch.paths.size());
+	for (uint32_t i = 0; i < batch.paths.size(); i++) {
+		paths[i] = batch.paths[i];
+	}
+	return paths;
+}
+
+bool AStar2D::_solve(AStar3D::SolveContext &r_context, AStar3D::Point *p_begin_point, AStar3D::Point *p_end_point, bool p_allow_partial_path) {
+	r_context.last_closest_point = nullptr;
+	r_context.pass++;
 
 	if (!p_begin_point->enabled) {
 		return false;
@@ -832,21 +1004,36 @@ bool AStar2D::_solve(AStar3D::Point *p_begin_point, AStar3D::Point *p_end_point,
 
 	bool found_route = false;
 
-	LocalVector<AStar3D::Point *> open_list;
+	if (r_context.scratch.size() < astar.scratch_size) {
+		r_context.scratch.resize(astar.scratch_size);
+	}
+	AStar3D::PointScratch *scratch = r_context.scratch.ptr();
+	const uint64_t pass = r_context.pass;
+
+	LocalVector<AStar3D::Point *> &open_list = r_context.open_list;
+	open_list.clear();
 	SortArray<AStar3D::Point *, AStar3D::SortPoints> sorter;
+	sorter.compare.scratch = scratch;
 
-	p_begin_point->g_score = 0;
-	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	p_begin_point->abs_g_score = 0;
-	p_begin_point->abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	AStar3D::PointScratch &begin_scratch = scratch[p_begin_point->scratch_index];
+	begin_scratch.g_score = 0;
+	begin_scratch.f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	begin_scratch.abs_g_score = 0;
+	begin_scratch.abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
 	open_list.push_back(p_begin_point);
 
 	while (!open_list.is_empty()) {
 		AStar3D::Point *p = open_list[0]; // The currently processed point.
+		AStar3D::PointScratch &ps = scratch[p->scratch_index];
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (astar.last_closest_point == nullptr || astar.last_closest_point->abs_f_score > p->abs_f_score || (astar.last_closest_point->abs_f_score >= p->abs_f_score && astar.last_closest_point->abs_g_score > p->abs_g_score)) {
-			astar.last_closest_point = p;
+		if (r_context.last_closest_point == nullptr) {
+			r_context.last_closest_point = p;
+		} else {
+			const AStar3D::PointScratch &closest = scratch[r_context.last_closest_point->scratch_index];
+			if (closest.abs_f_score > ps.abs_f_score || (closest.abs_f_score >= ps.abs_f_score && closest.abs_g_score > ps.abs_g_score)) {
+				r_context.last_closest_point = p;
+			}
 		}
 
 		if (p == p_end_point) {
@@ -856,12 +1043,13 @@ bool AStar2D::_solve(AStar3D::Point *p_begin_point, AStar3D::Point *p_end_point,
 
 		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
 		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = astar.pass; // Mark the point as closed.
+		ps.closed_pass = pass; // Mark the point as closed.
 
 		for (KeyValue<int64_t, AStar3D::Point *> &kv : p->neighbors) {
 			AStar3D::Point *e = kv.value; // The neighbor point.
+			AStar3D::PointScratch &es = scratch[e->scratch_index];
 
-			if (!e->enabled || e->closed_pass == astar.pass) {
+			if (!e->enabled || es.closed_pass == pass) {
 				continue;
 			}
 
@@ -872,23 +1060,23 @@ bool AStar2D::_solve(AStar3D::Point *p_begin_point, AStar3D::Point *p_end_point,
 				}
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
+			real_t tentative_g_score = ps.g_score + _compute_cost(p->id, e->id) * e->weight_scale;
 
 			bool new_point = false;
 
-			if (e->open_pass != astar.pass) { // The point wasn't inside the open list.
-				e->open_pass = astar.pass;
+			if (es.open_pass != pass) { // The point wasn't inside the open list.
+				es.open_pass = pass;
 				open_list.push_back(e);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= es.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			es.prev_point = p;
+			es.g_score = tentative_g_score;
+			es.f_score = es.g_score + _estimate_cost(e->id, p_end_point->id);
+			es.abs_g_score = tentative_g_score;
+			es.abs_f_score = es.f_score - es.g_score;
 
 			if (new_point) { // The position of the new points is already known.
 				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
@@ -933,6 +1121,7 @@ void AStar2D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStar2D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStar2D::get_id_path, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids", "allow_partial_path"), &AStar2D::get_id_paths, DEFVAL(false));
 
 	GDVIRTUAL_BIND(_filter_neighbor, "from_id", "neighbor_id")
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "end_id")
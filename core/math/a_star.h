@@ -30,9 +30,11 @@
 
 #pragma once
 
+#include "core/math/dynamic_bvh.h"
 #include "core/object/gdvirtual.gen.h"
 #include "core/object/ref_counted.h"
 #include "core/templates/a_hash_map.h"
+#include "core/variant/typed_array.h"
 
 /**
 	A* pathfinding algorithm.
@@ -44,6 +46,7 @@ class AStar3D : public RefCounted {
 
 	struct Point {
 		int64_t id = 0;
+		uint32_t scratch_index = 0; // Slot of this point in SolveContext::scratch.
 		Vector3 pos;
 		real_t weight_scale = 0;
 		bool enabled = false;
@@ -51,7 +54,12 @@ class AStar3D : public RefCounted {
 		AHashMap<int64_t, Point *> neighbors = 4u;
 		AHashMap<int64_t, Point *> unlinked_neighbours = 4u;
 
-		// Used for pathfinding.
+		// Used for closest point queries.
+		DynamicBVH::ID bvh_id;
+	};
+
+	// Used for pathfinding, kept out of Point so that several searches can run on the same graph at once.
+	struct PointScratch {
 		Point *prev_point = nullptr;
 		real_t g_score = 0;
 		real_t f_score = 0;
@@ -63,20 +71,47 @@ class AStar3D : public RefCounted {
 		real_t abs_f_score = 0;
 	};
 
+	struct SolveContext {
+		LocalVector<PointScratch> scratch;
+		LocalVector<Point *> open_list;
+		uint64_t pass = 1;
+		Point *last_closest_point = nullptr;
+	};
+
 	struct SortPoints {
+		const PointScratch *scratch = nullptr;
+
 		_FORCE_INLINE_ bool operator()(const Point *p_left, const Point *p_right) const { // Returns true when the Point A is worse than Point B.
-			if (p_left->f_score > p_right->f_score) {
+			const PointScratch &left = scratch[p_left->scratch_index];
+			const PointScratch &right = scratch[p_right->scratch_index];
+			if (left.f_score > right.f_score) {
 				return true;
-			} else if (p_left->f_score < p_right->f_score) {
+			} else if (left.f_score < right.f_score) {
 				return false;
 			} else {
-				return p_left->g_score < p_right->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return left.g_score < right.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
 
+	struct BatchSolve {
+		const int64_t *from_ids = nullptr;
+		const int64_t *to_ids = nullptr;
+		bool allow_partial_path = false;
+		LocalVector<SolveContext> contexts; // One per pool thread, plus one for the calling thread.
+		LocalVector<Vector<int64_t>> paths;
+	};
+
+	struct SegmentLeaf {
+		Point *from_point = nullptr;
+		Point *to_point = nullptr;
+		DynamicBVH::ID bvh_id;
+	};
+
 	struct Segment {
 		Pair<int64_t, int64_t> key;
+		// Not part of the key, carried over when the segment's direction changes.
+		SegmentLeaf *leaf = nullptr;
 
 		enum {
 			NONE = 0,
@@ -106,14 +141,25 @@ class AStar3D : public RefCounted {
 	};
 
 	mutable int64_t last_free_id = 0;
-	uint64_t pass = 1;
 
 	AHashMap<int64_t, Point *> points;
 	HashSet<Segment, Segment> segments;
-	Point *last_closest_point = nullptr;
 	bool neighbor_filter_enabled = false;
 
-	bool _solve(Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path);
+	uint32_t scratch_size = 0;
+	LocalVector<uint32_t> free_scratch_indices;
+	SolveContext solve_context; // Used by the single path queries.
+
+	// Spatial indices kept in sync with points and segments, so closest queries don't scan everything.
+	DynamicBVH point_bvh;
+	DynamicBVH segment_bvh;
+
+	void _update_point_leaves(Point *p_point);
+	void _erase_segment(const Segment &p_segment);
+
+	bool _solve(SolveContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path);
+	Vector<int64_t> _get_id_path(SolveContext &r_context, int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path);
+	void _get_id_paths_task(uint32_t p_index, BatchSolve *p_batch);
 
 protected:
 	static void _bind_methods();
@@ -164,6 +210,7 @@ public:
 
 	Vector<Vector3> get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
 	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
+	TypedArray<PackedInt64Array> get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path = false);
 
 	~AStar3D();
 };
@@ -172,7 +219,9 @@ class AStar2D : public RefCounted {
 	GDCLASS(AStar2D, RefCounted);
 	AStar3D astar;
 
-	bool _solve(AStar3D::Point *p_begin_point, AStar3D::Point *p_end_point, bool p_allow_partial_path);
+	bool _solve(AStar3D::SolveContext &r_context, AStar3D::Point *p_begin_point, AStar3D::Point *p_end_point, bool p_allow_partial_path);
+	Vector<int64_t> _get_id_path(AStar3D::SolveContext &r_context, int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path);
+	void _get_id_paths_task(uint32_t p_index, AStar3D::BatchSolve *p_batch);
 
 protected:
 	static void _bind_methods();
@@ -223,4 +272,5 @@ public:
 
 	Vector<Vector2> get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
 	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
+	TypedArray<PackedInt64Array> get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path = false);
 };
@@ -32,6 +32,7 @@
 #include "a_star_grid_2d.compat.inc"
 
 #include "core/object/class_db.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/variant/typed_array.h"
 
 static real_t heuristic_euclidean(const Vector2i &p_from, const Vector2i &p_to) {
@@ -155,7 +156,7 @@ void AStarGrid2D::update() {
 				default:
 					break;
 			}
-			line.push_back(Point(Vector2i(x, y), v));
+			line.push_back(Point(Vector2i(x, y), v, (y - region.position.y) * region.size.x + x - region.position.x));
 			solid_mask.push_back(false);
 		}
 		solid_mask.push_back(true);
@@ -270,7 +271,8 @@ void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weig
 	}
 }
 
-AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
+AStarGrid2D::Point *AStarGrid2D::_jump(const SolveContext &p_context, Point *p_from, Point *p_to) {
+	Point *end = p_context.end;
 	int32_t from_x = p_from->id.x;
 	int32_t from_y = p_from->id.y;
 
@@ -282,7 +284,7 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 
 	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
 		if (dx == 0 || dy == 0) {
-			return _forced_successor(to_x, to_y, dx, dy);
+			return _forced_successor(p_context, to_x, to_y, dx, dy);
 		}
 
 		while (_is_walkable(to_x, to_y) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || _is_walkable(to_x, to_y - dy) || _is_walkable(to_x - dx, to_y))) {
@@ -294,7 +296,7 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
-			if (_forced_successor(to_x + dx, to_y, dx, 0) != nullptr || _forced_successor(to_x, to_y + dy, 0, dy) != nullptr) {
+			if (_forced_successor(p_context, to_x + dx, to_y, dx, 0) != nullptr || _forced_successor(p_context, to_x, to_y + dy, 0, dy) != nullptr) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
@@ -304,7 +306,7 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 
 	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
 		if (dx == 0 || dy == 0) {
-			return _forced_successor(from_x, from_y, dx, dy, true);
+			return _forced_successor(p_context, from_x, from_y, dx, dy, true);
 		}
 
 		while (_is_walkable(to_x, to_y) && _is_walkable(to_x, to_y - dy) && _is_walkable(to_x - dx, to_y)) {
@@ -316,7 +318,7 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
-			if (_forced_successor(to_x, to_y, dx, 0) != nullptr || _forced_successor(to_x, to_y, 0, dy) != nullptr) {
+			if (_forced_successor(p_context, to_x, to_y, dx, 0) != nullptr || _forced_successor(p_context, to_x, to_y, 0, dy) != nullptr) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
@@ -326,7 +328,7 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 
 	} else { // DIAGONAL_MODE_NEVER
 		if (dy == 0) {
-			return _forced_successor(from_x, from_y, dx, 0, true);
+			return _forced_successor(p_context, from_x, from_y, dx, 0, true);
 		}
 
 		while (_is_walkable(to_x, to_y)) {
@@ -338,7 +340,7 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
-			if (_forced_successor(to_x, to_y, 1, 0, true) != nullptr || _forced_successor(to_x, to_y, -1, 0, true) != nullptr) {
+			if (_forced_successor(p_context, to_x, to_y, 1, 0, true) != nullptr || _forced_successor(p_context, to_x, to_y, -1, 0, true) != nullptr) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
@@ -349,7 +351,9 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 	return nullptr;
 }
 
-AStarGrid2D::Point *AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive) {
+AStarGrid2D::Point *AStarGrid2D::_forced_successor(const SolveContext &p_context, int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive) {
+	Point *end = p_context.end;
+
 	// Remembering previous results can improve performance.
 	bool l_prev = false, r_prev = false, l = false, r = false;
 
@@ -492,9 +496,9 @@ void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 	}
 }
 
-bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path) {
-	last_closest_point = nullptr;
-	pass++;
+bool AStarGrid2D::_solve(SolveContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path) {
+	r_context.last_closest_point = nullptr;
+	r_context.pass++;
 
 	if (_get_solid_unchecked(p_begin_point->id)) {
 		return false;
@@ -508,23 +512,39 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_
 
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
-	LocalVector<Point *> nbors;
+	const uint32_t point_count = region.size.x * region.size.y;
+	if (r_context.scratch.size() < point_count) {
+		r_context.scratch.resize(point_count);
+	}
+	PointScratch *scratch = r_context.scratch.ptr();
+	const uint64_t pass = r_context.pass;
 
-	p_begin_point->g_score = 0;
-	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	p_begin_point->abs_g_score = 0;
-	p_begin_point->abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	LocalVector<Point *> &open_list = r_context.open_list;
+	open_list.clear();
+	SortArray<Point *, SortPoints> sorter;
+	sorter.compare.scratch = scratch;
+	LocalVector<Point *> &nbors = r_context.nbors;
+
+	PointScratch &begin_scratch = scratch[p_begin_point->scratch_index];
+	begin_scratch.g_score = 0;
+	begin_scratch.f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	begin_scratch.abs_g_score = 0;
+	begin_scratch.abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
 	open_list.push_back(p_begin_point);
-	end = p_end_point;
+	r_context.end = p_end_point;
 
 	while (!open_list.is_empty()) {
 		Point *p = open_list[0]; // The currently processed point.
+		PointScratch &ps = scratch[p->scratch_index];
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
-			last_closest_point = p;
+		if (r_context.last_closest_point == nullptr) {
+			r_context.last_closest_point = p;
+		} else {
+			const PointScratch &closest = scratch[r_context.last_closest_point->scratch_index];
+			if (closest.abs_f_score > ps.abs_f_score || (closest.abs_f_score >= ps.abs_f_score && closest.abs_g_score > ps.abs_g_score)) {
+				r_context.last_closest_point = p;
+			}
 		}
 
 		if (p == p_end_point) {
@@ -534,7 +554,7 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_
 
 		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
 		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		ps.closed_pass = pass; // Mark the point as closed.
 
 		nbors.clear();
 		_get_nbors(p, nbors);
@@ -544,34 +564,35 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_
 
 			if (jumping_enabled) {
 				// TODO: Make it works with weight_scale.
-				e = _jump(p, e);
-				if (!e || e->closed_pass == pass) {
+				e = _jump(r_context, p, e);
+				if (!e || scratch[e->scratch_index].closed_pass == pass) {
 					continue;
 				}
 			} else {
-				if (_get_solid_unchecked(e->id) || e->closed_pass == pass) {
+				if (_get_solid_unchecked(e->id) || scratch[e->scratch_index].closed_pass == pass) {
 					continue;
 				}
 				weight_scale = e->weight_scale;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * weight_scale;
+			PointScratch &es = scratch[e->scratch_index];
+			real_t tentative_g_score = ps.g_score + _compute_cost(p->id, e->id) * weight_scale;
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
+			if (es.open_pass != pass) { // The point wasn't inside the open list.
+				es.open_pass = pass;
 				open_list.push_back(e);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= es.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
+			es.prev_point = p;
+			es.g_score = tentative_g_score;
+			es.f_score = es.g_score + _estimate_cost(e->id, p_end_point->id);
 
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			es.abs_g_score = tentative_g_score;
+			es.abs_f_score = es.f_score - es.g_score;
 
 			if (new_point) { // The position of the new points is already known.
 				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
@@ -646,21 +667,23 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	Point *begin_point = _get_point(p_from_id.x, p_from_id.y);
 	Point *end_point = _get_point(p_to_id.x, p_to_id.y);
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	bool found_route = _solve(solve_context, begin_point, end_point, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+		if (!p_allow_partial_path || solve_context.last_closest_point == nullptr) {
 			return Vector<Vector2>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_point = solve_context.last_closest_point;
 	}
 
+	const PointScratch *scratch = solve_context.scratch.ptr();
+
 	Point *p = end_point;
 	int32_t pc = 1;
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = scratch[p->scratch_index].prev_point;
 	}
 
 	Vector<Vector2> path;
@@ -673,7 +696,7 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 		int32_t idx = pc - 1;
 		while (p != begin_point) {
 			w[idx--] = p->pos;
-			p = p->prev_point;
+			p = scratch[p->scratch_index].prev_point;
 		}
 
 		w[0] = p->pos;
@@ -684,46 +707,110 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 
 TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const Vector2i &p_to_id, bool p_allow_partial_path) {
 	ERR_FAIL_COND_V_MSG(dirty, TypedArray<Vector2i>(), "Grid is not initialized. Call the update method.");
-	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
-	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
+
+	const Vector<Vector2i> id_path = _get_id_path(solve_context, p_from_id, p_to_id, p_allow_partial_path);
+	TypedArray<Vector2i> path;
+	path.resize(id_path.size());
+	for (int i = 0; i < id_path.size(); i++) {
+		path[i] = id_path[i];
+	}
+	return path;
+}
+
+Vector<Vector2i> AStarGrid2D::_get_id_path(SolveContext &r_context, const Vector2i &p_from_id, const Vector2i &p_to_id, bool p_allow_partial_path) {
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), Vector<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), Vector<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
 	Point *begin_point = _get_point(p_from_id.x, p_from_id.y);
 	Point *end_point = _get_point(p_to_id.x, p_to_id.y);
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	bool found_route = _solve(r_context, begin_point, end_point, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
-			return TypedArray<Vector2i>();
+		if (!p_allow_partial_path || r_context.last_closest_point == nullptr) {
+			return Vector<Vector2i>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_point = r_context.last_closest_point;
 	}
 
+	const PointScratch *scratch = r_context.scratch.ptr();
+
 	Point *p = end_point;
 	int32_t pc = 1;
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = scratch[p->scratch_index].prev_point;
 	}
 
-	TypedArray<Vector2i> path;
+	Vector<Vector2i> path;
 	path.resize(pc);
 
 	{
+		Vector2i *w = path.ptrw();
+
 		p = end_point;
 		int32_t idx = pc - 1;
 		while (p != begin_point) {
-			path[idx--] = p->id;
-			p = p->prev_point;
+			w[idx--] = p->id;
+			p = scratch[p->scratch_index].prev_point;
 		}
 
-		path[0] = p->id;
+		w[0] = p->id;
 	}
 
 	return path;
 }
 
+void AStarGrid2D::_get_id_paths_task(uint32_t p_index, BatchSolve *p_batch) {
+	// Pool threads get their own context, the calling thread (index -1) uses the first one.
+	SolveContext &context = p_batch->contexts[WorkerThreadPool::get_singleton()->get_thread_index() + 1];
+	p_batch->paths[p_index] = _get_id_path(context, p_batch->from_ids[p_index], p_batch->to_ids[p_index], p_batch->allow_partial_path);
+}
+
+TypedArray<Array> AStarGrid2D::get_id_paths(const TypedArray<Vector2i> &p_from_ids, const TypedArray<Vector2i> &p_to_ids, bool p_allow_partial_path) {
+	ERR_FAIL_COND_V_MSG(dirty, TypedArray<Array>(), "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), TypedArray<Array>(), vformat("Can't get id paths. Got %d start points but %d end points.", p_from_ids.size(), p_to_ids.size()));
+
+	LocalVector<Vector2i> from_ids;
+	LocalVector<Vector2i> to_ids;
+	from_ids.resize(p_from_ids.size());
+	to_ids.resize(p_to_ids.size());
+	for (int i = 0; i < p_from_ids.size(); i++) {
+		from_ids[i] = p_from_ids[i];
+		to_ids[i] = p_to_ids[i];
+	}
+
+	BatchSolve batch;
+	batch.from_ids = from_ids.ptr();
+	batch.to_ids = to_ids.ptr();
+	batch.allow_partial_path = p_allow_partial_path;
+	batch.paths.resize(from_ids.size());
+
+	// Script and extension callbacks aren't safe to call from several threads at once, so solve those on the calling thread.
+	if (get_script_instance() || GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) || GDVIRTUAL_IS_OVERRIDDEN(_compute_cost) || from_ids.size() < 2) {
+		for (uint32_t i = 0; i < batch.paths.size(); i++) {
+			batch.paths[i] = _get_id_path(solve_context, from_ids[i], to_ids[i], p_allow_partial_path);
+		}
+	} else {
+		batch.contexts.resize(WorkerThreadPool::get_singleton()->get_thread_count() + 1);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AStarGrid2D::_get_id_paths_task, &batch, batch.paths.size(), -1, true, SNAME("AStarGrid2DGetIdPaths"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	TypedArray<Array> paths;
+	paths.resize(batch.paths.size());
+	for (uint32_t i = 0; i < batch.paths.size(); i++) {
+		TypedArray<Vector2i> path;
+		path.resize(batch.paths[i].size());
+		for (int j = 0; j < batch.paths[i].size(); j++) {
+			path[j] = batch.paths[i][j];
+		}
+		paths[i] = path;
+	}
+	return paths;
+}
+
 void AStarGrid2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_region", "region"), &AStarGrid2D::set_region);
 	ClassDB::bind_method(D_METHOD("get_region"), &AStarGrid2D::get_region);
@@ -759,6 +846,7 @@ void AStarGrid2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_point_data_in_region", "region"), &AStarGrid2D::get_point_data_in_region);
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStarGrid2D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStarGrid2D::get_id_path, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids", "allow_partial_path"), &AStarGrid2D::get_id_paths, DEFVAL(false));
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "end_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
@@ -78,8 +78,16 @@ private:
 
 		Vector2 pos;
 		real_t weight_scale = 1.0;
+		uint32_t scratch_index = 0; // Slot of this point in SolveContext::scratch.
 
-		// Used for pathfinding.
+		Point() {}
+
+		Point(const Vector2i &p_id, const Vector2 &p_pos, uint32_t p_scratch_index) :
+				id(p_id), pos(p_pos), scratch_index(p_scratch_index) {}
+	};
+
+	// Per-search state of a point, kept apart from the grid so several searches can run at once.
+	struct PointScratch {
 		Point *prev_point = nullptr;
 		real_t g_score = 0;
 		real_t f_score = 0;
@@ -89,31 +97,44 @@ private:
 		// Used for getting last_closest_point.
 		real_t abs_g_score = 0;
 		real_t abs_f_score = 0;
+	};
 
-		Point() {}
-
-		Point(const Vector2i &p_id, const Vector2 &p_pos) :
-				id(p_id), pos(p_pos) {}
+	struct SolveContext {
+		LocalVector<PointScratch> scratch;
+		LocalVector<Point *> open_list;
+		LocalVector<Point *> nbors;
+		uint64_t pass = 1;
+		Point *end = nullptr;
+		Point *last_closest_point = nullptr;
 	};
 
 	struct SortPoints {
+		const PointScratch *scratch = nullptr;
+
 		_FORCE_INLINE_ bool operator()(const Point *p_left, const Point *p_right) const { // Returns true when the Point A is worse than Point B.
-			if (p_left->f_score > p_right->f_score) {
+			const PointScratch &left = scratch[p_left->scratch_index];
+			const PointScratch &right = scratch[p_right->scratch_index];
+			if (left.f_score > right.f_score) {
 				return true;
-			} else if (p_left->f_score < p_right->f_score) {
+			} else if (left.f_score < right.f_score) {
 				return false;
 			} else {
-				return p_left->g_score < p_right->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return left.g_score < right.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
 
+	struct BatchSolve {
+		const Vector2i *from_ids = nullptr;
+		const Vector2i *to_ids = nullptr;
+		bool allow_partial_path = false;
+		LocalVector<SolveContext> contexts; // One per pool thread, plus one for the calling thread.
+		LocalVector<Vector<Vector2i>> paths;
+	};
+
 	LocalVector<bool> solid_mask;
 	LocalVector<LocalVector<Point>> points;
-	Point *end = nullptr;
-	Point *last_closest_point = nullptr;
-
-	uint64_t pass = 1;
+	SolveContext solve_context; // Used by the single path queries.
 
 private: // Internal routines.
 	_FORCE_INLINE_ size_t _to_mask_index(int32_t p_x, int32_t p_y) const {
@@ -156,9 +177,11 @@ private: // Internal routines.
 	}
 
 	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
-	Point *_jump(Point *p_from, Point *p_to);
-	bool _solve(Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path);
-	Point *_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive = false);
+	Point *_jump(const SolveContext &p_context, Point *p_from, Point *p_to);
+	bool _solve(SolveContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path);
+	Point *_forced_successor(const SolveContext &p_context, int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive = false);
+	Vector<Vector2i> _get_id_path(SolveContext &r_context, const Vector2i &p_from_id, const Vector2i &p_to_id, bool p_allow_partial_path);
+	void _get_id_paths_task(uint32_t p_index, BatchSolve *p_batch);
 
 protected:
 	static void _bind_methods();
@@ -224,6 +247,7 @@ public:
 	TypedArray<Dictionary> get_point_data_in_region(const Rect2i &p_region) const;
 	Vector<Vector2> get_point_path(const Vector2i &p_from, const Vector2i &p_to, bool p_allow_partial_path = false);
 	TypedArray<Vector2i> get_id_path(const Vector2i &p_from, const Vector2i &p_to, bool p_allow_partial_path = false);
+	TypedArray<Array> get_id_paths(const TypedArray<Vector2i> &p_from_ids, const TypedArray<Vector2i> &p_to_ids, bool p_allow_partial_path = false);
 };
 
 VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode);
@@ -115,6 +115,10 @@ private:
 					(max.z != p_b.max.z));
 		}
 
+		_FORCE_INLINE_ real_t get_distance_squared_to(const Vector3 &p_point) const {
+			return (p_point - p_point.clamp(min, max)).length_squared();
+		}
+
 		_FORCE_INLINE_ real_t get_proximity_to(const Volume &p_b) const {
 			const Vector3 d = (min + max) - (p_b.min + p_b.max);
 			return (Math::abs(d.x) + Math::abs(d.y) + Math::abs(d.z));
@@ -317,6 +321,9 @@ public:
 	_FORCE_INLINE_ void convex_query(const Plane *p_planes, int p_plane_count, const Vector3 *p_points, int p_point_count, QueryResult &r_result);
 	template <typename QueryResult>
 	_FORCE_INLINE_ void ray_query(const Vector3 &p_from, const Vector3 &p_to, QueryResult &r_result);
+	// Visits leaves nearest-first, r_result returns the squared distance past which subtrees are skipped.
+	template <typename QueryResult>
+	_FORCE_INLINE_ void closest_query(const Vector3 &p_point, real_t p_max_distance_squared, QueryResult &r_result) const;
 
 	void set_index(uint32_t p_index);
 	uint32_t get_index() const;
@@ -480,3 +487,48 @@ void DynamicBVH::ray_query(const Vector3 &p_from, const Vector3 &p_to, QueryResu
 		}
 	} while (depth > 0);
 }
+
+template <typename QueryResult>
+void DynamicBVH::closest_query(const Vector3 &p_point, real_t p_max_distance_squared, QueryResult &r_result) const {
+	if (!bvh_root) {
+		return;
+	}
+
+	real_t max_distance_squared = p_max_distance_squared;
+
+	const Node **alloca_stack = (const Node **)alloca(ALLOCA_STACK_SIZE * sizeof(const Node *));
+	const Node **stack = alloca_stack;
+	stack[0] = bvh_root;
+	int32_t depth = 1;
+	int32_t threshold = ALLOCA_STACK_SIZE - 2;
+
+	LocalVector<const Node *> aux_stack; //only used in rare occasions when you run out of alloca memory because tree is too unbalanced. Should correct itself over time.
+
+	do {
+		depth--;
+		const Node *n = stack[depth];
+		// Strictly greater, so leaves tied with the current best are still reported.
+		if (n->volume.get_distance_squared_to(p_point) > max_distance_squared) {
+			continue;
+		}
+		if (n->is_internal()) {
+			if (depth > threshold) {
+				if (aux_stack.is_empty()) {
+					aux_stack.resize(ALLOCA_STACK_SIZE * 2);
+					memcpy(aux_stack.ptr(), alloca_stack, ALLOCA_STACK_SIZE * sizeof(const Node *));
+					alloca_stack = nullptr;
+				} else {
+					aux_stack.resize(aux_stack.size() * 2);
+				}
+				stack = aux_stack.ptr();
+				threshold = aux_stack.size() - 2;
+			}
+			// Push the farther child first so the nearer one is visited first and tightens the bound.
+			const bool first_is_nearer = n->children[0]->volume.get_distance_squared_to(p_point) <= n->children[1]->volume.get_distance_squared_to(p_point);
+			stack[depth++] = n->children[first_is_nearer ? 1 : 0];
+			stack[depth++] = n->children[first_is_nearer ? 0 : 1];
+		} else {
+			max_distance_squared = r_result(n->data);
+		}
+	} while (depth > 0);
+}
@@ -185,4 +185,16 @@ constexpr T get_num_bits(T p_x) {
 	return floor_log2(p_x);
 }
 
+// Returns the number of bits set in an integer.
+constexpr uint32_t count_set_bits(uint64_t p_x) {
+#if defined(__GNUC__)
+	return __builtin_popcountll(p_x);
+#else
+	p_x = p_x - ((p_x >> 1) & 0x5555555555555555);
+	p_x = (p_x & 0x3333333333333333) + ((p_x >> 2) & 0x3333333333333333);
+	p_x = (p_x + (p_x >> 4)) & 0x0f0f0f0f0f0f0f0f;
+	return (p_x * 0x0101010101010101) >> 56;
+#endif
+}
+
 } //namespace Math
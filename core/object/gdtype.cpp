@@ -41,6 +41,7 @@ GDType::GDType(const GDType *p_super_type, StringName p_name) :
 		for (const StringName &ancestor_name : super_type->name_hierarchy) {
 			name_hierarchy.push_back(ancestor_name);
 		}
+		callp_overridden = super_type->callp_overridden;
 	}
 }
 
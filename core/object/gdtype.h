@@ -67,6 +67,10 @@ protected:
 	AHashMap<StringName, const MethodInfo *> signal_map;
 	AHashMap<StringName, const MethodInfo *> self_signal_map;
 
+	/// Whether the class or one of its ancestors overrides `Object::callp()`,
+	/// which may then handle methods before `ClassDB` does.
+	bool callp_overridden = false;
+
 public:
 	GDType(const GDType *p_super_type, StringName p_name);
 	~GDType();
@@ -82,6 +86,9 @@ public:
 	}
 	const Vector<StringName> &get_name_hierarchy() const { return name_hierarchy; }
 
+	bool is_callp_overridden() const { return callp_overridden; }
+	void set_callp_overridden() { callp_overridden = true; }
+
 	void bind_integer_constant(const StringName &p_enum, const StringName &p_name, int64_t p_constant, bool p_is_bitfield = false);
 	const AHashMap<StringName, int64_t> &get_integer_constant_map(bool p_no_inheritance = false) const { return p_no_inheritance ? self_constant_map : constant_map; }
 	const AHashMap<StringName, const EnumInfo *> &get_enum_map(bool p_no_inheritance = false) const { return p_no_inheritance ? self_enum_map : enum_map; }
@@ -56,13 +56,130 @@
 		mutex.unlock(); \
 	}
 
+struct ThreadQueueCacheEntry {
+	uint64_t queue_id = 0;
+	CallQueue *queue = nullptr;
+};
+
+static thread_local ThreadQueueCacheEntry thread_queue_cache[4];
+
+SafeNumeric<uint64_t> CallQueue::last_queue_id;
+
+CallQueue *CallQueue::_get_target_queue() {
+	if (likely(!thread_buffers_enabled) || this == MessageQueue::thread_singleton || Thread::get_caller_id() == flush_thread_id) {
+		return this;
+	}
+	return _get_thread_queue();
+}
+
+CallQueue *CallQueue::_get_thread_queue() {
+	ThreadQueueCacheEntry &entry = thread_queue_cache[queue_id % std_size(thread_queue_cache)];
+	if (likely(entry.queue_id == queue_id)) {
+		return entry.queue;
+	}
+
+	const Thread::ID caller_id = Thread::get_caller_id();
+	CallQueue *queue = nullptr;
+	{
+		MutexLock lock(mutex);
+		ThreadQueue *idle_queue = nullptr;
+		for (ThreadQueue &thread_queue : thread_queues) {
+			if (thread_queue.thread_id == caller_id) {
+				thread_queue.idle = false;
+				queue = thread_queue.queue;
+				break;
+			}
+			if (thread_queue.idle && !idle_queue) {
+				idle_queue = &thread_queue;
+			}
+		}
+		if (!queue && idle_queue) {
+			// Take over the queue of a thread that stopped sending messages.
+			idle_queue->thread_id = caller_id;
+			idle_queue->idle = false;
+			queue = idle_queue->queue;
+		}
+		if (!queue) {
+			queue = memnew(CallQueue(allocator, max_pages, error_text));
+			queue->budget_queue = this;
+			thread_queues.push_back({ caller_id, queue });
+			has_thread_queues.set();
+		}
+	}
+
+	entry.queue_id = queue_id;
+	entry.queue = queue;
+	return queue;
+}
+
+bool CallQueue::_merge_thread_queues() {
+	bool merged = false;
+	for (ThreadQueue &thread_queue : thread_queues) {
+		CallQueue *queue = thread_queue.queue;
+		MutexLock lock(queue->mutex);
+
+		for (uint32_t i = 0; i < queue->pages_used; i++) {
+			if (queue->page_bytes[i] == 0) {
+				continue;
+			}
+
+			_ensure_first_page();
+			if (page_bytes[pages_used - 1] != 0) {
+				if (pages_used == page_bytes.size()) {
+					pages.push_back(allocator->alloc());
+					page_bytes.push_back(0);
+				}
+				_set_pages_used(pages_used + 1);
+			}
+
+			// Take the page as is, and give an empty one back in exchange.
+			SWAP(pages[pages_used - 1], queue->pages[i]);
+			page_bytes[pages_used - 1] = queue->page_bytes[i];
+			queue->page_bytes[i] = 0;
+			thread_queue.merged = true;
+			merged = true;
+		}
+
+		if (queue->pages_used > 1) {
+			queue->_set_pages_used(1);
+		}
+	}
+	return merged;
+}
+
+void CallQueue::_recycle_thread_queues() {
+	for (ThreadQueue &thread_queue : thread_queues) {
+		if (thread_queue.merged) {
+			// Threads keep pushing into the queue they used before it went idle.
+			thread_queue.idle = false;
+		} else if (!thread_queue.idle) {
+			CallQueue *queue = thread_queue.queue;
+			MutexLock lock(queue->mutex);
+			if (!queue->has_messages()) {
+				queue->_release_pages();
+				thread_queue.idle = true;
+			}
+		}
+		thread_queue.merged = false;
+	}
+}
+
+void CallQueue::_release_pages() {
+	for (Page *page : pages) {
+		allocator->free(page);
+	}
+	pages.clear();
+	page_bytes.clear();
+	_set_pages_used(0);
+}
+
 void CallQueue::_add_page() {
 	if (pages_used == page_bytes.size()) {
 		pages.push_back(allocator->alloc());
 		page_bytes.push_back(0);
 	}
 	page_bytes[pages_used] = 0;
-	pages_used++;
+	_set_pages_used(pages_used + 1);
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -82,6 +199,11 @@ Error CallQueue::push_set(Object *p_object, const StringName &p_prop, const Vari
 }
 
 Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
+	CallQueue *target = _get_target_queue();
+	if (target != this) {
+		return target->push_callablep(p_callable, p_args, p_argcount, p_show_error);
+	}
+
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
@@ -91,7 +213,7 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 	_ensure_first_page();
 
 	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+		if (_is_out_of_pages()) {
 			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
 			statistics();
 			UNLOCK_MUTEX;
@@ -132,13 +254,18 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
+	CallQueue *target = _get_target_queue();
+	if (target != this) {
+		return target->push_set(p_id, p_prop, p_value);
+	}
+
 	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
 	_ensure_first_page();
 
 	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+		if (_is_out_of_pages()) {
 			String type;
 			if (ObjectDB::get_instance(p_id)) {
 				type = ObjectDB::get_instance(p_id)->get_class();
@@ -173,13 +300,18 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
+	CallQueue *target = _get_target_queue();
+	if (target != this) {
+		return target->push_notification(p_id, p_notification);
+	}
+
 	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
 	_ensure_first_page();
 
 	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+		if (_is_out_of_pages()) {
 			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
 			statistics();
 			UNLOCK_MUTEX;
@@ -224,15 +356,19 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 Error CallQueue::flush() {
 	LOCK_MUTEX;
 
-	if (pages.is_empty()) {
-		// Never allocated
+	if (flushing) {
 		UNLOCK_MUTEX;
-		return OK; // Do nothing.
+		return ERR_BUSY;
 	}
 
-	if (flushing) {
+	if (has_thread_queues.is_set()) {
+		_merge_thread_queues();
+	}
+
+	if (pages.is_empty()) {
+		// Never allocated
 		UNLOCK_MUTEX;
-		return ERR_BUSY;
+		return OK; // Do nothing.
 	}
 
 	flushing = true;
@@ -240,63 +376,73 @@ Error CallQueue::flush() {
 	uint32_t i = 0;
 	uint32_t offset = 0;
 
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
+	do {
+		while (i < pages_used && offset < page_bytes[i]) {
+			Page *page = pages[i];
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+			//lock on each iteration, so a call can re-add itself to the message queue
 
-		Message *message = (Message *)&page->data[offset];
+			Message *message = (Message *)&page->data[offset];
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
+			uint32_t advance = sizeof(Message);
+			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+				advance += sizeof(Variant) * message->args;
+			}
 
-		//pre-advance so this function is reentrant
-		offset += advance;
+			//pre-advance so this function is reentrant
+			offset += advance;
 
-		Object *target = message->callable.get_object();
+			flushed_messages++;
+			flushed_bytes += advance;
 
-		UNLOCK_MUTEX;
+			Object *target = message->callable.get_object();
 
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
-				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
-				}
-			} break;
-		}
+			UNLOCK_MUTEX;
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
+			switch (message->type & FLAG_MASK) {
+				case TYPE_CALL: {
+					if (target || (message->type & FLAG_NULL_IS_OK)) {
+						Variant *args = (Variant *)(message + 1);
+						_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+					}
+				} break;
+				case TYPE_NOTIFICATION: {
+					if (target) {
+						target->notification(message->notification);
+					}
+				} break;
+				case TYPE_SET: {
+					if (target) {
+						Variant *arg = (Variant *)(message + 1);
+						target->set(message->callable.get_method(), *arg);
+					}
+				} break;
+			}
+
+			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+				Variant *args = (Variant *)(message + 1);
+				for (int k = 0; k < message->args; k++) {
+					args[k].~Variant();
+				}
 			}
-		}
 
-		message->~Message();
+			message->~Message();
 
-		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
+			LOCK_MUTEX;
+			if (offset == page_bytes[i]) {
+				i++;
+				offset = 0;
+			}
 		}
-	}
+		// Messages other threads pushed in the meantime are flushed as well.
+	} while (has_thread_queues.is_set() && _merge_thread_queues());
 
 	page_bytes[0] = 0;
-	pages_used = 1;
+	_set_pages_used(1);
+
+	if (has_thread_queues.is_set()) {
+		_recycle_thread_queues();
+	}
 
 	flushing = false;
 	UNLOCK_MUTEX;
@@ -306,6 +452,10 @@ Error CallQueue::flush() {
 void CallQueue::clear() {
 	LOCK_MUTEX;
 
+	for (const ThreadQueue &thread_queue : thread_queues) {
+		thread_queue.queue->clear();
+	}
+
 	if (pages.is_empty()) {
 		UNLOCK_MUTEX;
 		return; // Nothing to clear.
@@ -338,7 +488,7 @@ void CallQueue::clear() {
 		}
 	}
 
-	pages_used = 1;
+	_set_pages_used(1);
 	page_bytes[0] = 0;
 
 	UNLOCK_MUTEX;
@@ -444,18 +594,51 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
-		return false;
+	if (pages_used > 1 || (pages_used == 1 && page_bytes[0] != 0)) {
+		return true;
 	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
-		return false;
+
+	if (has_thread_queues.is_set()) {
+		MutexLock lock(mutex);
+		for (const ThreadQueue &thread_queue : thread_queues) {
+			if (thread_queue.queue->has_messages()) {
+				return true;
+			}
+		}
 	}
 
-	return true;
+	return false;
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	int usage = pages.size() * PAGE_SIZE_BYTES;
+	if (has_thread_queues.is_set()) {
+		MutexLock lock(mutex);
+		for (const ThreadQueue &thread_queue : thread_queues) {
+			usage += thread_queue.queue->get_max_buffer_usage();
+		}
+	}
+	return usage;
+}
+
+void CallQueue::set_thread_buffers_enabled(bool p_enabled) {
+	LOCK_MUTEX;
+	thread_buffers_enabled = p_enabled;
+	flush_thread_id = Thread::get_caller_id();
+	UNLOCK_MUTEX;
+}
+
+bool CallQueue::is_thread_buffers_enabled() const {
+	return thread_buffers_enabled;
+}
+
+void CallQueue::update_frame_statistics() {
+	LOCK_MUTEX;
+	frame_flushed_messages = flushed_messages;
+	frame_flushed_bytes = flushed_bytes;
+	flushed_messages = 0;
+	flushed_bytes = 0;
+	UNLOCK_MUTEX;
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -472,6 +655,9 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 
 CallQueue::~CallQueue() {
 	clear();
+	for (const ThreadQueue &thread_queue : thread_queues) {
+		memdelete(thread_queue.queue);
+	}
 	// Let go of pages.
 	for (uint32_t i = 0; i < pages.size(); i++) {
 		allocator->free(pages[i]);
@@ -507,6 +693,10 @@ MessageQueue::MessageQueue() :
 				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
+
+	if (bool(GLOBAL_DEF_RST("memory/limits/message_queue/thread_buffers", false))) {
+		set_thread_buffers_enabled(true);
+	}
 }
 
 MessageQueue::~MessageQueue() {
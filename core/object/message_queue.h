@@ -32,8 +32,10 @@
 
 #include "core/object/object_id.h"
 #include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
 class Object;
@@ -65,7 +67,7 @@ private:
 		FLAG_MASK = FLAG_NULL_IS_OK - 1,
 	};
 
-	Mutex mutex;
+	mutable Mutex mutex;
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
@@ -76,6 +78,34 @@ private:
 	uint32_t pages_used = 0;
 	bool flushing = false;
 
+	// Thread queues count their pages against the `max_pages` of the queue they are merged into.
+	CallQueue *budget_queue = this;
+	SafeNumeric<uint32_t> budget_pages_used;
+
+	// With thread buffers enabled, every thread other than the one flushing pushes into its own queue,
+	// so producers don't contend on `mutex`. Those are merged into this one when flushing, which keeps
+	// the order of the messages sent by each thread but not between threads.
+	// A queue that gets no messages between two flushes releases its pages and can be taken over by
+	// another thread, so threads that exit don't keep theirs around.
+	struct ThreadQueue {
+		Thread::ID thread_id;
+		CallQueue *queue = nullptr;
+		bool merged = false; // Since the previous flush.
+		bool idle = false;
+	};
+
+	static SafeNumeric<uint64_t> last_queue_id;
+	const uint64_t queue_id = last_queue_id.increment();
+	bool thread_buffers_enabled = false;
+	Thread::ID flush_thread_id = Thread::UNASSIGNED_ID;
+	LocalVector<ThreadQueue> thread_queues;
+	SafeFlag has_thread_queues;
+
+	uint64_t flushed_messages = 0;
+	uint64_t flushed_bytes = 0;
+	uint64_t frame_flushed_messages = 0;
+	uint64_t frame_flushed_bytes = 0;
+
 #ifdef DEV_ENABLED
 	bool is_current_thread_override = false;
 #endif
@@ -89,15 +119,34 @@ private:
 		};
 	};
 
+	_FORCE_INLINE_ void _set_pages_used(uint32_t p_pages_used) {
+		if (p_pages_used > pages_used) {
+			budget_queue->budget_pages_used.add(p_pages_used - pages_used);
+		} else if (p_pages_used < pages_used) {
+			budget_queue->budget_pages_used.sub(pages_used - p_pages_used);
+		}
+		pages_used = p_pages_used;
+	}
+
+	_FORCE_INLINE_ bool _is_out_of_pages() const {
+		return budget_queue->budget_pages_used.get() >= max_pages;
+	}
+
 	_FORCE_INLINE_ void _ensure_first_page() {
 		if (unlikely(pages.is_empty())) {
 			pages.push_back(allocator->alloc());
 			page_bytes.push_back(0);
-			pages_used = 1;
+			_set_pages_used(1);
 		}
 	}
 
 	void _add_page();
+	void _release_pages();
+
+	CallQueue *_get_target_queue();
+	CallQueue *_get_thread_queue();
+	bool _merge_thread_queues();
+	void _recycle_thread_queues();
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -143,6 +192,16 @@ public:
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
 
+	// Merges the messages other threads push into per-thread buffers, see `thread_queues`.
+	// Must be called from the thread that flushes the queue.
+	void set_thread_buffers_enabled(bool p_enabled);
+	bool is_thread_buffers_enabled() const;
+
+	// Publishes the number of messages and bytes flushed since the previous call, usually once per frame.
+	void update_frame_statistics();
+	uint64_t get_frame_flushed_messages() const { return frame_flushed_messages; }
+	uint64_t get_frame_flushed_bytes() const { return frame_flushed_bytes; }
+
 	CallQueue(Allocator *p_custom_allocator = nullptr, uint32_t p_max_pages = 8192, const String &p_error_text = String());
 	virtual ~CallQueue();
 };
@@ -264,6 +264,9 @@ private: \
 			return *gdtype; \
 		} \
 		gdtype = memnew(GDType(&super_type::get_gdtype_static(), StringName(#m_class))); \
+		if constexpr (!std::is_same_v<decltype(&m_class::callp), decltype(&::Object::callp)>) { \
+			gdtype->set_callp_overridden(); \
+		} \
 		m_class::autorelease_gdtype(&gdtype); \
 		initialized = true; \
 		return *gdtype; \
@@ -706,6 +709,9 @@ public:
 	void get_method_list(List<MethodInfo> *p_list) const;
 	Variant callv(const StringName &p_method, const Array &p_args);
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	// Calls a method already resolved through `ClassDB` for this object, as `callp()` does once it found it.
+	// Callers must check that neither a script instance nor a `callp()` override handles the method first.
+	Variant callp_method_bind(MethodBind *p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	virtual Variant call_const(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
 	template <typename... VarArgs>
@@ -48,6 +48,57 @@ void WorkerThreadPool::Task::free_template_userdata() {
 	memdelete(btu);
 }
 
+bool WorkerThreadPool::TaskDeque::push(Task *p_task) {
+	int64_t b = bottom.load(std::memory_order_relaxed);
+	int64_t t = top.load(std::memory_order_acquire);
+	if (b - t >= (int64_t)CAPACITY) {
+		return false;
+	}
+	buffer[b & (CAPACITY - 1)].store(p_task, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	bottom.store(b + 1, std::memory_order_relaxed);
+	return true;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::TaskDeque::pop() {
+	int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+	bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t t = top.load(std::memory_order_relaxed);
+
+	if (t > b) {
+		// Empty.
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Task *task = buffer[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+	if (t == b) {
+		// Last element, race against thieves for it.
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			task = nullptr;
+		}
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+	return task;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::TaskDeque::steal() {
+	int64_t t = top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t b = bottom.load(std::memory_order_acquire);
+
+	if (t >= b) {
+		return nullptr;
+	}
+
+	Task *task = buffer[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+	if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		return nullptr; // Lost the race against the owner or another thief.
+	}
+	return task;
+}
+
 WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 
 #ifdef THREADS_ENABLED
@@ -90,9 +141,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	bool low_priority = p_task->low_priority;
 #endif
 
+	LocalVector<Task *> released_tasks; // Dependent tasks that can run now.
+
 	if (p_task->group) {
 		// Handling a group
-		bool do_post = false;
+		bool do_post = p_task->group->max == 0; // Empty group that had to wait for dependencies.
 
 		while (true) {
 			uint32_t work_index = p_task->group->index.postincrement();
@@ -122,7 +175,10 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 		if (do_post) {
 			p_task->group->done_semaphore.post();
+			task_mutex.lock();
 			p_task->group->completed.set_to(true);
+			_release_dependents(p_task->group->dependents, released_tasks);
+			task_mutex.unlock();
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
@@ -150,6 +206,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		task_mutex.lock();
 		p_task->completed = true;
 		p_task->pool_thread_index = -1;
+		_release_dependents(p_task->dependents, released_tasks);
 		if (p_task->waiting_user) {
 			p_task->done_semaphore.post(p_task->waiting_user);
 		}
@@ -181,6 +238,10 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 	MessageQueue::set_thread_singleton_override(call_queue_backup);
 #endif
+
+	if (!released_tasks.is_empty()) {
+		_post_released_tasks(released_tasks);
+	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
@@ -188,8 +249,13 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Tasks this thread posted itself are the hottest in cache, and popping them needs no lock.
+		Task *task_to_process = thread_data->task_deque.pop();
+		if (!task_to_process && !thread_data->pool->task_queue_pending.load(std::memory_order_relaxed)) {
+			// Nothing in the shared queue, which takes precedence; stealing needs no lock either.
+			task_to_process = thread_data->pool->_steal_task(thread_data);
+		}
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -202,17 +268,23 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 				thread_data->signaled = false;
 
-				if (!thread_data->pool->task_queue.first()) {
-					// There wasn't a task available yet.
-					// Let's wait for the next notification, then recheck.
-					thread_data->cond_var.wait(lock);
-					continue;
+				if (thread_data->pool->task_queue.first()) {
+					// Got a task to process! Remove it from the queue, then break into the task handling section.
+					task_to_process = thread_data->pool->task_queue.first()->self();
+					thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
+					thread_data->pool->task_queue_pending.store(thread_data->pool->task_queue.first() != nullptr, std::memory_order_relaxed);
+					break;
 				}
 
-				// Got a task to process! Remove it from the queue, then break into the task handling section.
-				task_to_process = thread_data->pool->task_queue.first()->self();
-				thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
-				break;
+				task_to_process = thread_data->pool->_steal_task_or_set_idle(thread_data);
+				if (task_to_process) {
+					break;
+				}
+
+				// There wasn't a task available yet.
+				// Let's wait for the next notification, then recheck.
+				thread_data->cond_var.wait(lock);
+				thread_data->pool->_clear_idle(thread_data);
 			}
 		}
 
@@ -244,8 +316,6 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 	uint32_t to_process = 0;
 	uint32_t to_promote = 0;
 
-	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
-
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
@@ -260,7 +330,11 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 			to_promote++;
 		}
 	}
+	if (to_process) {
+		task_queue_pending.store(true, std::memory_order_relaxed);
+	}
 
+	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 	_notify_threads(caller_pool_thread, to_process, to_promote);
 }
 
@@ -328,11 +402,122 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+// Must be called with the task mutex held.
+// Returns the pool thread calling, if the tasks being posted can go to its deque.
+WorkerThreadPool::ThreadData *WorkerThreadPool::_get_deque_owner(bool p_high_priority, bool p_pump_task) {
+	// Pump tasks always use the shared queue so the rules about which threads may run them keep working.
+	// Outside the normal runlevel, the shared queue is used so shutdown can account for every task.
+	if (!p_high_priority || p_pump_task || runlevel != RUNLEVEL_NORMAL) {
+		return nullptr;
+	}
+	int *thread_index = thread_ids.getptr(Thread::get_caller_id());
+	return thread_index ? &threads[*thread_index] : nullptr;
+}
+
+// Must be called from the owner thread, without the task mutex held.
+void WorkerThreadPool::_push_to_deque(ThreadData *p_owner, Task **p_tasks, uint32_t p_count) {
+	uint32_t pushed = 0;
+	for (; pushed < p_count; pushed++) {
+		p_tasks[pushed]->low_priority = false;
+		if (!p_owner->task_deque.push(p_tasks[pushed])) {
+			break;
+		}
+	}
+
+	if (pushed < p_count) {
+		// The deque is full, the rest goes to the shared queue.
+		MutexLock<BinaryMutex> lock(task_mutex);
+		_post_tasks(p_tasks + pushed, p_count - pushed, true, lock, false);
+	}
+
+	if (pushed) {
+		_notify_idle_threads(p_owner, pushed);
+	}
+}
+
+// Must be called without the task mutex held.
+void WorkerThreadPool::_notify_idle_threads(const ThreadData *p_current_thread_data, uint32_t p_count) {
+	// Pairs with the fence in _steal_task_or_set_idle(): either this sees the thread about to sleep,
+	// or that thread sees the tasks just pushed.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (idle_thread_count.load(std::memory_order_relaxed) == 0) {
+		return;
+	}
+
+	MutexLock<BinaryMutex> lock(task_mutex);
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 0;
+			i < thread_count && p_count;
+			i++, notify_index = (notify_index + 1) % thread_count) {
+		ThreadData &th = threads[notify_index];
+		if (!th.idle || th.signaled || &th == p_current_thread_data) {
+			continue;
+		}
+		th.cond_var.notify_one();
+		th.signaled = true;
+		p_count--;
+	}
+}
+
+// Can be called with or without the task mutex held.
+WorkerThreadPool::Task *WorkerThreadPool::_steal_task(const ThreadData *p_thief) {
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		TaskDeque &victim = threads[(p_thief->index + i) % thread_count].task_deque;
+		while (!victim.is_empty()) {
+			Task *task = victim.steal();
+			if (task) {
+				return task;
+			}
+		}
+	}
+	return nullptr;
+}
+
+// Must be called with the task mutex held, right before waiting on the condition variable.
+// If there's nothing to steal, the thread is left flagged as idle so pushers wake it up.
+WorkerThreadPool::Task *WorkerThreadPool::_steal_task_or_set_idle(ThreadData *p_thread_data) {
+	if (!p_thread_data->idle) {
+		p_thread_data->idle = true;
+		idle_thread_count.fetch_add(1, std::memory_order_relaxed);
+	}
+	// Pairs with the fence in _notify_idle_threads().
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	Task *task = _steal_task(p_thread_data);
+	if (task) {
+		_clear_idle(p_thread_data);
+	}
+	return task;
+}
+
+// Must be called with the task mutex held.
+void WorkerThreadPool::_clear_idle(ThreadData *p_thread_data) {
+	if (p_thread_data->idle) {
+		p_thread_data->idle = false;
+		idle_thread_count.fetch_sub(1, std::memory_order_relaxed);
+	}
+}
+
+// Whether there are high priority tasks waiting to be picked up, either in the shared queue or in any deque.
+bool WorkerThreadPool::_has_queued_tasks() const {
+	if (task_queue.first()) {
+		return true;
+	}
+	for (const ThreadData &th : threads) {
+		if (!th.task_deque.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
 		low_priority_task_queue.remove(low_priority_task_queue.first());
 		task_queue.add_last(&low_prio_task->task_elem);
+		task_queue_pending.store(true, std::memory_order_relaxed);
 		low_priority_threads_used++;
 		return true;
 	} else {
@@ -340,44 +525,154 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+// Must be called with the task mutex held.
+bool WorkerThreadPool::_are_dependencies_valid(Span<TaskID> p_dependencies) const {
+	for (const TaskID &id : p_dependencies) {
+		if (!tasks.has(id) && !groups.has(id)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Must be called with the task mutex held.
+bool WorkerThreadPool::_has_pending_dependencies(Span<TaskID> p_dependencies) const {
+	for (const TaskID &id : p_dependencies) {
+		const Task *const *taskp = tasks.getptr(id);
+		if (taskp) {
+			if (!(*taskp)->completed) {
+				return true;
+			}
+		} else if (!groups[id]->completed.is_set()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Must be called with the task mutex held. Dependencies are assumed to be valid.
+void WorkerThreadPool::_add_dependencies(Task **p_tasks, uint32_t p_count, Span<TaskID> p_dependencies) {
+	for (const TaskID &id : p_dependencies) {
+		LocalVector<Task *> *dependents = nullptr;
+		Task **taskp = tasks.getptr(id);
+		if (taskp) {
+			if (!(*taskp)->completed) {
+				dependents = &(*taskp)->dependents;
+			}
+		} else {
+			Group *group = groups[id];
+			if (!group->completed.is_set()) {
+				dependents = &group->dependents;
+			}
+		}
+
+		if (dependents) {
+			for (uint32_t i = 0; i < p_count; i++) {
+				p_tasks[i]->pending_dependencies++;
+				dependents->push_back(p_tasks[i]);
+			}
+		}
+	}
+}
+
+// Must be called with the task mutex held.
+void WorkerThreadPool::_release_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_ready) {
+	for (Task *dependent : p_dependents) {
+		DEV_ASSERT(dependent->pending_dependencies > 0);
+		dependent->pending_dependencies--;
+		if (dependent->pending_dependencies == 0) {
+			r_ready.push_back(dependent);
+		}
+	}
+	p_dependents.clear();
+}
+
+void WorkerThreadPool::_post_released_tasks(const LocalVector<Task *> &p_tasks) {
+	LocalVector<Task *> to_push;
+	ThreadData *deque_owner = nullptr;
+	{
+		MutexLock<BinaryMutex> lock(task_mutex);
+		deque_owner = _get_deque_owner(true, false);
+		for (Task *task : p_tasks) {
+			if (deque_owner && !task->low_priority) {
+				to_push.push_back(task);
+				continue;
+			}
+			Task *to_post = task;
+			_post_tasks(&to_post, 1, !task->low_priority, lock, false);
+		}
+	}
+
+	if (!to_push.is_empty()) {
+		_push_to_deque(deque_owner, to_push.ptr(), to_push.size());
+	}
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task) {
-	MutexLock<BinaryMutex> lock(task_mutex);
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task, Span<TaskID> p_dependencies) {
+	Task *task = nullptr;
+	TaskID id = INVALID_TASK_ID;
+	ThreadData *deque_owner = nullptr;
+	{
+		MutexLock<BinaryMutex> lock(task_mutex);
 
-	// Get a free task
-	Task *task = task_allocator.alloc();
-	TaskID id = last_task++;
-	task->self = id;
-	task->callable = p_callable;
-	task->native_func = p_func;
-	task->native_func_userdata = p_userdata;
-	task->description = p_description;
-	task->template_userdata = p_template_userdata;
-	task->is_pump_task = p_pump_task;
-	tasks.insert(id, task);
+		if (unlikely(!_are_dependencies_valid(p_dependencies))) {
+			if (p_template_userdata) {
+				memdelete(p_template_userdata);
+			}
+			ERR_FAIL_V_MSG(INVALID_TASK_ID, "Invalid Task or Group ID in dependencies.");
+		}
+
+		// Get a free task
+		task = task_allocator.alloc();
+		id = last_task++;
+		task->self = id;
+		task->callable = p_callable;
+		task->native_func = p_func;
+		task->native_func_userdata = p_userdata;
+		task->description = p_description;
+		task->template_userdata = p_template_userdata;
+		task->is_pump_task = p_pump_task;
+		tasks.insert(id, task);
+
+		if (p_dependencies.size() && _has_pending_dependencies(p_dependencies)) {
+			// Will be posted once the last dependency completes.
+			DEV_ASSERT(!p_pump_task);
+			task->low_priority = !p_high_priority;
+			_add_dependencies(&task, 1, p_dependencies);
+			return id;
+		}
 
 #ifdef THREADS_ENABLED
-	if (p_pump_task) {
-		pump_task_count++;
-		int thread_count = get_thread_count();
-		if (pump_task_count >= thread_count) {
-			print_verbose(vformat("A greater number of dedicated threads were requested (%d) than threads available (%d). Please increase the number of available worker task threads. Recovering this session by spawning more worker task threads.", pump_task_count + 1, thread_count)); // +1 because we want to keep a Thread without any pump tasks free.
+		if (p_pump_task) {
+			pump_task_count++;
+			int thread_count = get_thread_count();
+			if (pump_task_count >= thread_count) {
+				print_verbose(vformat("A greater number of dedicated threads were requested (%d) than threads available (%d). Please increase the number of available worker task threads. Recovering this session by spawning more worker task threads.", pump_task_count + 1, thread_count)); // +1 because we want to keep a Thread without any pump tasks free.
+
+				// Re-sizing implies relocation, which is not supported for this array.
+				CRASH_COND_MSG(thread_count + 1 > (int)threads.get_capacity(), "Reserve trick for worker thread pool failed. Crashing.");
+				threads.resize_initialized(thread_count + 1);
+				threads[thread_count].index = thread_count;
+				threads[thread_count].pool = this;
+				threads[thread_count].thread.start(&WorkerThreadPool::_thread_function, &threads[thread_count]);
+				thread_ids.insert(threads[thread_count].thread.get_id(), thread_count);
+			}
+		}
+#endif
 
-			// Re-sizing implies relocation, which is not supported for this array.
-			CRASH_COND_MSG(thread_count + 1 > (int)threads.get_capacity(), "Reserve trick for worker thread pool failed. Crashing.");
-			threads.resize_initialized(thread_count + 1);
-			threads[thread_count].index = thread_count;
-			threads[thread_count].pool = this;
-			threads[thread_count].thread.start(&WorkerThreadPool::_thread_function, &threads[thread_count]);
-			thread_ids.insert(threads[thread_count].thread.get_id(), thread_count);
+		deque_owner = _get_deque_owner(p_high_priority, p_pump_task);
+		if (!deque_owner) {
+			_post_tasks(&task, 1, p_high_priority, lock, p_pump_task);
+			return id;
 		}
 	}
-#endif
 
-	_post_tasks(&task, 1, p_high_priority, lock, p_pump_task);
+	// Posting to the deque of the calling pool thread doesn't need the task mutex.
+	_push_to_deque(deque_owner, &task, 1);
 
 	return id;
 }
@@ -390,6 +685,18 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task_bind(const Callable &p_actio
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, false);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_after(void (*p_func)(void *), void *p_userdata, Span<TaskID> p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, false, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_after(const Callable &p_action, Span<TaskID> p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, false, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_after_bind(const Callable &p_action, const PackedInt64Array &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, false, p_dependencies);
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	MutexLock task_lock(task_mutex);
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -518,7 +825,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = _has_queued_tasks() ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -536,16 +843,24 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (p_caller_pool_thread->pool->task_queue.first()) {
+			// Deques never hold pump tasks, so they are always fine to take.
+			task_to_process = p_caller_pool_thread->task_deque.pop();
+
+			if (!task_to_process && p_caller_pool_thread->pool->task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				if ((p_task == ThreadData::YIELDING || p_caller_pool_thread->has_pump_task == true) && task_to_process->is_pump_task) {
 					task_to_process = nullptr;
 					_notify_threads(p_caller_pool_thread, 1, 0);
 				} else {
 					task_queue.remove(task_queue.first());
+					task_queue_pending.store(task_queue.first() != nullptr, std::memory_order_relaxed);
 				}
 			}
 
+			if (!task_to_process) {
+				task_to_process = _steal_task_or_set_idle(p_caller_pool_thread);
+			}
+
 			if (!task_to_process) {
 				p_caller_pool_thread->awaited_task = p_task;
 
@@ -557,6 +872,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				p_caller_pool_thread->cond_var.wait(lock);
 
 				p_caller_pool_thread->awaited_task = nullptr;
+				_clear_idle(p_caller_pool_thread);
 			}
 		}
 
@@ -589,7 +905,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!_has_queued_tasks() && !low_priority_task_queue.first()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -652,47 +968,80 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	td.cond_var.notify_one();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
 	}
 
-	MutexLock<BinaryMutex> lock(task_mutex);
+	Task **tasks_posted = nullptr;
+	GroupID id = INVALID_TASK_ID;
+	ThreadData *deque_owner = nullptr;
+	{
+		MutexLock<BinaryMutex> lock(task_mutex);
 
-	Group *group = group_allocator.alloc();
-	GroupID id = last_task++;
-	group->max = p_elements;
-	group->self = id;
+		if (unlikely(!_are_dependencies_valid(p_dependencies))) {
+			if (p_template_userdata) {
+				memdelete(p_template_userdata);
+			}
+			ERR_FAIL_V_MSG(INVALID_TASK_ID, "Invalid Task or Group ID in dependencies.");
+		}
 
-	Task **tasks_posted = nullptr;
-	if (p_elements == 0) {
-		// Should really not call it with zero Elements, but at least it should work.
-		group->completed.set_to(true);
-		group->done_semaphore.post();
-		group->tasks_used = 0;
-		p_tasks = 0;
-		memdelete(p_template_userdata);
+		bool has_pending_dependencies = p_dependencies.size() && _has_pending_dependencies(p_dependencies);
+		if (p_elements == 0 && has_pending_dependencies) {
+			// Even if there's nothing to process, completion must wait for the dependencies.
+			p_tasks = 1;
+		}
 
-	} else {
-		group->tasks_used = p_tasks;
-		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
-		for (int i = 0; i < p_tasks; i++) {
-			Task *task = task_allocator.alloc();
-			task->native_group_func = p_func;
-			task->native_func_userdata = p_userdata;
-			task->description = p_description;
-			task->group = group;
-			task->callable = p_callable;
-			task->template_userdata = p_template_userdata;
-			tasks_posted[i] = task;
-			// No task ID is used.
+		Group *group = group_allocator.alloc();
+		id = last_task++;
+		group->max = p_elements;
+		group->self = id;
+
+		if (p_elements == 0 && !has_pending_dependencies) {
+			// Should really not call it with zero Elements, but at least it should work.
+			group->completed.set_to(true);
+			group->done_semaphore.post();
+			group->tasks_used = 0;
+			p_tasks = 0;
+			memdelete(p_template_userdata);
+
+		} else {
+			group->tasks_used = p_tasks;
+			tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
+			for (int i = 0; i < p_tasks; i++) {
+				Task *task = task_allocator.alloc();
+				task->native_group_func = p_func;
+				task->native_func_userdata = p_userdata;
+				task->description = p_description;
+				task->group = group;
+				task->callable = p_callable;
+				task->template_userdata = p_template_userdata;
+				tasks_posted[i] = task;
+				// No task ID is used.
+			}
+		}
+
+		groups[id] = group;
+
+		if (has_pending_dependencies) {
+			// Will be posted once the last dependency completes.
+			for (int i = 0; i < p_tasks; i++) {
+				tasks_posted[i]->low_priority = !p_high_priority;
+			}
+			_add_dependencies(tasks_posted, p_tasks, p_dependencies);
+			return id;
 		}
-	}
 
-	groups[id] = group;
+		deque_owner = p_tasks ? _get_deque_owner(p_high_priority, false) : nullptr;
+		if (!deque_owner) {
+			_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false);
+			return id;
+		}
+	}
 
-	_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false);
+	// Posting to the deque of the calling pool thread doesn't need the task mutex.
+	_push_to_deque(deque_owner, tasks_posted, p_tasks);
 
 	return id;
 }
@@ -705,6 +1054,18 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_after(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, Span<TaskID> p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task_after(const Callable &p_action, int p_elements, Span<TaskID> p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task_after_bind(const Callable &p_action, int p_elements, const PackedInt64Array &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	MutexLock task_lock(task_mutex);
 	const Group *const *groupp = groups.getptr(p_group);
@@ -890,7 +1251,10 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
 	ClassDB::bind_method(D_METHOD("get_caller_task_id"), &WorkerThreadPool::get_caller_task_id);
 
+	ClassDB::bind_method(D_METHOD("add_task_after", "action", "dependencies", "high_priority", "description"), &WorkerThreadPool::add_task_after_bind, DEFVAL(false), DEFVAL(String()));
+
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_group_task_after", "action", "elements", "dependencies", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task_after_bind, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
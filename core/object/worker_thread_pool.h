@@ -69,6 +69,7 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		LocalVector<Task *> dependents; // Tasks to release when the group completes.
 	};
 
 	struct Task {
@@ -89,6 +90,8 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		uint32_t pending_dependencies = 0; // Posted only once this reaches zero.
+		LocalVector<Task *> dependents; // Tasks to release when this one completes.
 
 		void free_template_userdata();
 		Task() :
@@ -98,6 +101,25 @@ private:
 				task_elem(this) {}
 	};
 
+	// Chase-Lev work-stealing deque. The owner thread pushes and pops at the bottom (LIFO),
+	// other threads steal from the top (FIFO), all without taking the task mutex.
+	// As a consequence, high priority tasks posted from a pool thread are run newest-first by that
+	// thread, while threads stealing from it take the oldest ones first.
+	struct TaskDeque {
+		static const uint32_t CAPACITY = 256; // Power of two. When full, tasks go to the shared queue.
+
+		std::atomic<int64_t> top = 0;
+		std::atomic<int64_t> bottom = 0;
+		std::atomic<Task *> buffer[CAPACITY] = {};
+
+		bool push(Task *p_task);
+		Task *pop();
+		Task *steal();
+		_FORCE_INLINE_ bool is_empty() const {
+			return bottom.load(std::memory_order_acquire) <= top.load(std::memory_order_acquire);
+		}
+	};
+
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
 
@@ -119,17 +141,20 @@ private:
 		bool pre_exited_languages : 1;
 		bool exited_languages : 1;
 		bool has_pump_task : 1; // Threads can only have one pump task.
+		bool idle : 1; // About to wait or waiting on the condition variable, with all deques found empty.
 		Task *current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		TaskDeque task_deque; // High priority tasks posted by this thread.
 
 		ThreadData() :
 				signaled(false),
 				yield_is_over(false),
 				pre_exited_languages(false),
 				exited_languages(false),
-				has_pump_task(false) {}
+				has_pump_task(false),
+				idle(false) {}
 	};
 
 	TightLocalVector<ThreadData> threads;
@@ -168,6 +193,8 @@ private:
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
+	std::atomic<uint32_t> idle_thread_count = 0; // Threads with ThreadData::idle set. Read without the lock by deque pushers.
+	std::atomic<bool> task_queue_pending = false; // Whether task_queue has tasks. Read without the lock by pool threads.
 
 	uint64_t last_task = 1;
 	int pump_task_count = 0;
@@ -183,6 +210,14 @@ private:
 
 	bool _try_promote_low_priority_task();
 
+	ThreadData *_get_deque_owner(bool p_high_priority, bool p_pump_task);
+	void _push_to_deque(ThreadData *p_owner, Task **p_tasks, uint32_t p_count);
+	void _notify_idle_threads(const ThreadData *p_current_thread_data, uint32_t p_count);
+	Task *_steal_task(const ThreadData *p_thief);
+	Task *_steal_task_or_set_idle(ThreadData *p_thread_data);
+	void _clear_idle(ThreadData *p_thread_data);
+	bool _has_queued_tasks() const;
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -194,8 +229,14 @@ private:
 	static thread_local UnlockableLocks unlockable_locks[MAX_UNLOCKABLE_LOCKS];
 #endif
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false, Span<TaskID> p_dependencies = Span<TaskID>());
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies = Span<TaskID>());
+
+	bool _are_dependencies_valid(Span<TaskID> p_dependencies) const;
+	bool _has_pending_dependencies(Span<TaskID> p_dependencies) const;
+	void _add_dependencies(Task **p_tasks, uint32_t p_count, Span<TaskID> p_dependencies);
+	void _release_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_ready);
+	void _post_released_tasks(const LocalVector<Task *> &p_tasks);
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -246,6 +287,20 @@ public:
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String(), bool p_pump_task = false);
 	TaskID add_task_bind(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Like the above, but the task is only queued once all the tasks and groups in p_dependencies have completed.
+	template <typename C, typename M, typename U>
+	TaskID add_template_task_after(C *p_instance, M p_method, U p_userdata, Span<TaskID> p_dependencies, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, false, p_dependencies);
+	}
+	TaskID add_native_task_after(void (*p_func)(void *), void *p_userdata, Span<TaskID> p_dependencies, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_task_after(const Callable &p_action, Span<TaskID> p_dependencies, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_task_after_bind(const Callable &p_action, const PackedInt64Array &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
@@ -263,6 +318,20 @@ public:
 	}
 	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
+	// Like the above, but the group only starts once all the tasks and groups in p_dependencies have completed.
+	template <typename C, typename M, typename U>
+	GroupID add_template_group_task_after(C *p_instance, M p_method, U p_userdata, int p_elements, Span<TaskID> p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+	}
+	GroupID add_native_group_task_after(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, Span<TaskID> p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_group_task_after(const Callable &p_action, int p_elements, Span<TaskID> p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_group_task_after_bind(const Callable &p_action, int p_elements, const PackedInt64Array &p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
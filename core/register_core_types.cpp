@@ -48,10 +48,12 @@
 #include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "core/io/dtls_server.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/http_client.h"
 #include "core/io/image_loader.h"
 #include "core/io/image_resource_format.h"
 #include "core/io/json.h"
+#include "core/io/json_reader.h"
 #include "core/io/json_resource_format.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
@@ -277,6 +279,7 @@ void register_core_types() {
 
 	GDREGISTER_CLASS(XMLParser);
 	GDREGISTER_CLASS(JSON);
+	GDREGISTER_CLASS(JSONReader);
 	GDREGISTER_CLASS(RegExMatch);
 	GDREGISTER_CLASS(RegEx);
 
@@ -489,6 +492,7 @@ void unregister_core_types() {
 	}
 
 	ResourceLoader::finalize();
+	FileAccessCompressed::clear_block_cache();
 
 	ClassDB::cleanup_defaults();
 	memdelete(_time);
@@ -35,6 +35,9 @@
 #include "core/string/ustring.h"
 
 #include <fcntl.h>
+#if !defined(WEB_ENABLED)
+#include <sys/mman.h>
+#endif
 #include <sys/stat.h>
 #include <sys/types.h>
 #if !defined(__FreeBSD__) && !defined(__OpenBSD__) && !defined(__NetBSD__) && !defined(WEB_ENABLED)
@@ -195,11 +198,24 @@ Error FileAccessUnix::open_internal(const String &p_path, int p_mode_flags) {
 	return OK;
 }
 
+void FileAccessUnix::_unmap() {
+	if (!mapped_data) {
+		return;
+	}
+
+#if !defined(WEB_ENABLED)
+	munmap(const_cast<uint8_t *>(mapped_data), mapped_length);
+#endif
+	mapped_data = nullptr;
+	mapped_length = 0;
+}
+
 void FileAccessUnix::_close() {
 	if (!f) {
 		return;
 	}
 
+	_unmap();
 	fclose(f);
 	f = nullptr;
 
@@ -624,6 +640,48 @@ void FileAccessUnix::close() {
 	_close();
 }
 
+Error FileAccessUnix::map_to_memory() {
+	ERR_FAIL_NULL_V_MSG(f, ERR_FILE_CANT_OPEN, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(flags != READ, ERR_UNAVAILABLE, "Only files opened with READ can be mapped in memory.");
+
+#if defined(WEB_ENABLED)
+	return ERR_UNAVAILABLE;
+#else
+	if (mapped_data) {
+		return OK;
+	}
+
+	struct stat st = {};
+	if (fstat(fileno(f), &st) != 0 || st.st_size <= 0 || uint64_t(st.st_size) > uint64_t(SIZE_MAX)) {
+		// Empty files can't be mapped, and large files may not fit in the address space.
+		return ERR_UNAVAILABLE;
+	}
+
+	void *data = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fileno(f), 0);
+	if (data == MAP_FAILED) {
+		return ERR_UNAVAILABLE;
+	}
+
+	mapped_data = static_cast<const uint8_t *>(data);
+	mapped_length = st.st_size;
+	return OK;
+#endif
+}
+
+const uint8_t *FileAccessUnix::get_mapped_range(uint64_t p_position, uint64_t p_length) const {
+	if (!mapped_data || p_position > mapped_length || p_length > mapped_length - p_position) {
+		return nullptr;
+	}
+	// Reading the pages of a mapping past the end of the file raises SIGBUS, so don't hand out ranges
+	// of a file that was truncated since it was mapped. This only checks the size when the range is requested:
+	// callers that keep the pointer, like FileAccessPack, still crash if the file is truncated afterwards.
+	struct stat st = {};
+	if (fstat(fileno(f), &st) != 0 || uint64_t(st.st_size) < p_position + p_length) {
+		return nullptr;
+	}
+	return mapped_data + p_position;
+}
+
 FileAccessUnix::CloseNotificationFunc FileAccessUnix::close_notification_func = nullptr;
 
 FileAccessUnix::~FileAccessUnix() {
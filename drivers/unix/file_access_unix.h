@@ -46,6 +46,10 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	const uint8_t *mapped_data = nullptr;
+	uint64_t mapped_length = 0;
+
+	void _unmap();
 	void _close();
 
 #if defined(TOOLS_ENABLED)
@@ -97,6 +101,9 @@ public:
 
 	virtual void close() override;
 
+	virtual Error map_to_memory() override;
+	virtual const uint8_t *get_mapped_range(uint64_t p_position, uint64_t p_length) const override;
+
 	FileAccessUnix() {}
 	virtual ~FileAccessUnix();
 };
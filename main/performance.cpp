@@ -135,6 +135,8 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_FLUSHED_MESSAGES);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_FLUSHED_BYTES);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 
 	BIND_ENUM_CONSTANT(MONITOR_TYPE_QUANTITY);
@@ -230,6 +232,8 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("message_queue/flushed_messages"),
+		PNAME("message_queue/flushed_bytes"),
 	};
 	static_assert(std_size(names) == MONITOR_MAX);
 
@@ -454,6 +458,10 @@ double Performance::get_monitor(Monitor p_monitor) const {
 		case NAVIGATION_3D_OBSTACLE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+		case MESSAGE_QUEUE_FLUSHED_MESSAGES:
+			return MessageQueue::get_main_singleton()->get_frame_flushed_messages();
+		case MESSAGE_QUEUE_FLUSHED_BYTES:
+			return MessageQueue::get_main_singleton()->get_frame_flushed_bytes();
 
 		default: {
 		}
@@ -527,6 +535,8 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 #endif // _3D_DISABLED
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
@@ -122,6 +122,8 @@ public:
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
 #endif // _3D_DISABLED
+		MESSAGE_QUEUE_FLUSHED_MESSAGES,
+		MESSAGE_QUEUE_FLUSHED_BYTES,
 		MONITOR_MAX
 	};
 
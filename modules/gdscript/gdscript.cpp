@@ -2325,6 +2325,7 @@ void GDScriptLanguage::profiling_start() {
 		elem->self()->profile.frame_call_count.set(0);
 		elem->self()->profile.frame_self_time.set(0);
 		elem->self()->profile.frame_total_time.set(0);
+		elem->self()->profile.dispatch_count.set(0);
 		elem->self()->profile.last_frame_call_count = 0;
 		elem->self()->profile.last_frame_self_time = 0;
 		elem->self()->profile.last_frame_total_time = 0;
@@ -175,6 +175,46 @@ void GDScriptByteCodeGenerator::write_start(GDScript *p_script, const StringName
 	function->_argument_count = 0;
 }
 
+void GDScriptByteCodeGenerator::fuse_superinstructions() {
+	// A superinstruction only replaces the opcode of the first instruction in a sequence, the
+	// following instructions are kept as they are. This keeps all the addresses unchanged, and
+	// jumps landing inside a fused sequence still run the remaining instructions one by one.
+	int *code = opcodes.ptrw();
+	const uint32_t instruction_count = instruction_starts.size();
+
+	for (uint32_t i = 0; i + 1 < instruction_count; i++) {
+		int &opcode = code[instruction_starts[i]];
+		const int next_opcode = code[instruction_starts[i + 1]];
+
+		switch (opcode) {
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+				if (next_opcode == GDScriptFunction::OPCODE_JUMP_IF) {
+					opcode = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF;
+				} else if (next_opcode == GDScriptFunction::OPCODE_JUMP_IF_NOT) {
+					opcode = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+				}
+			} break;
+			case GDScriptFunction::OPCODE_GET_MEMBER: {
+				if (next_opcode == GDScriptFunction::OPCODE_OPERATOR_VALIDATED && i + 2 < instruction_count && code[instruction_starts[i + 2]] == GDScriptFunction::OPCODE_SET_MEMBER) {
+					opcode = GDScriptFunction::OPCODE_GET_MEMBER_OPERATOR_VALIDATED_SET_MEMBER;
+				}
+			} break;
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN: {
+				if (next_opcode == GDScriptFunction::OPCODE_ASSIGN) {
+					opcode = GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN_ASSIGN;
+				}
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_ARRAY: {
+				if (next_opcode == GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN) {
+					opcode = GDScriptFunction::OPCODE_ITERATE_ARRAY_ASSIGN_TYPED_BUILTIN;
+				}
+			} break;
+			default:
+				break;
+		}
+	}
+}
+
 GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 #ifdef DEBUG_ENABLED
 	if (!used_temporaries.is_empty()) {
@@ -183,6 +223,8 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 #endif
 	append_opcode(GDScriptFunction::OPCODE_END);
 
+	fuse_superinstructions();
+
 	for (int i = 0; i < temporaries.size(); i++) {
 		int stack_index = i + max_locals + GDScriptFunction::FIXED_ADDRESSES_MAX;
 		for (int j = 0; j < temporaries[i].bytecode_indices.size(); j++) {
@@ -395,6 +437,14 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	if (inline_cache_count) {
+		function->inline_caches = memnew_arr(GDScriptFunction::InlineCache, inline_cache_count);
+		function->_inline_caches_count = inline_cache_count;
+	} else {
+		function->inline_caches = nullptr;
+		function->_inline_caches_count = 0;
+	}
+
 	if (GDScriptLanguage::get_singleton()->should_track_locals()) {
 		function->stack_debug = stack_debug;
 	}
@@ -880,6 +930,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append(inline_cache_count++);
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1093,6 +1144,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 		append(Address());
 		append(p_arguments.size());
 		append(p_function_name);
+		append(inline_cache_count++);
 	} else {
 		append_opcode_and_argcount(GDScriptFunction::OPCODE_CALL_RETURN, 2 + p_arguments.size());
 		for (int i = 0; i < p_arguments.size(); i++) {
@@ -1103,6 +1155,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 		append(ct.target);
 		append(p_arguments.size());
 		append(p_function_name);
+		append(inline_cache_count++);
 		ct.cleanup();
 	}
 }
@@ -1129,6 +1182,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1363,6 +1417,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 		append(Address());
 		append(p_arguments.size());
 		append(p_function_name);
+		append(inline_cache_count++);
 	} else {
 		append_opcode_and_argcount(GDScriptFunction::OPCODE_CALL_RETURN, 2 + p_arguments.size());
 		for (int i = 0; i < p_arguments.size(); i++) {
@@ -1373,6 +1428,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 		append(ct.target);
 		append(p_arguments.size());
 		append(p_function_name);
+		append(inline_cache_count++);
 		ct.cleanup();
 	}
 }
@@ -1387,6 +1443,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -129,7 +129,9 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 7 + _pointer_size;
 			} break;
-			case OPCODE_OPERATOR_VALIDATED: {
+			case OPCODE_OPERATOR_VALIDATED:
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
 				text += "validated operator ";
 
 				text += DADDR(3);
@@ -330,7 +332,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -352,7 +354,8 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 3;
 			} break;
-			case OPCODE_GET_MEMBER: {
+			case OPCODE_GET_MEMBER:
+			case OPCODE_GET_MEMBER_OPERATOR_VALIDATED_SET_MEMBER: {
 				text += "get_member ";
 				text += DADDR(1);
 				text += " = ";
@@ -709,7 +712,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -835,7 +838,8 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr = 4 + argc;
 			} break;
 
-			case OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN: {
+			case OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+			case OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN_ASSIGN: {
 				int instr_var_args = _code_ptr[++ip];
 				text += "call method-bind validated (return) ";
 				MethodBind *method = _methods_ptr[_code_ptr[ip + 2 + instr_var_args]];
@@ -1211,6 +1215,17 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr += 5;
 			} break;
 				DISASSEMBLE_ITERATE_TYPES(DISASSEMBLE_ITERATE);
+			case OPCODE_ITERATE_ARRAY_ASSIGN_TYPED_BUILTIN: {
+				text += "for-loop (typed ARRAY) ";
+				text += DADDR(3);
+				text += " in ";
+				text += DADDR(2);
+				text += " counter ";
+				text += DADDR(1);
+				text += " end ";
+				text += itos(_code_ptr[ip + 4]);
+				incr += 5;
+			} break;
 			case OPCODE_ITERATE_RANGE: {
 				text += "for-loop ";
 				text += DADDR(4);
@@ -1324,6 +1339,18 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			} break;
 		}
 
+		switch (opcode) {
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+			case OPCODE_GET_MEMBER_OPERATOR_VALIDATED_SET_MEMBER:
+			case OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN_ASSIGN:
+			case OPCODE_ITERATE_ARRAY_ASSIGN_TYPED_BUILTIN: {
+				text += " (fused with next)";
+			} break;
+			default:
+				break;
+		}
+
 		ip += incr;
 		if (text.get_string_length() > 0) {
 			print_line(text.as_string());
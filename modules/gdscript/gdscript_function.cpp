@@ -151,6 +151,61 @@ bool GDScriptDataType::is_type(const Variant &p_variant, bool p_allow_implicit_c
 
 /////////////////////
 
+static MethodBind *_resolve_method(const GDType *p_type, const StringName &p_method) {
+	if (p_method == CoreStringName(free_)) {
+		return nullptr;
+	}
+	if (p_type->is_callp_overridden()) {
+		return nullptr; // `callp()` may handle the method before ClassDB does.
+	}
+	return ClassDB::get_method(p_type->get_name(), p_method);
+}
+
+static MethodBind *_resolve_property_getter(const StringName &p_class, const StringName &p_property) {
+	bool valid = false;
+	if (ClassDB::get_property_index(p_class, p_property, &valid) != -1 || !valid) {
+		return nullptr; // Not a property, or an indexed one.
+	}
+	// `ClassDB::get_property()` also finds methods, signals and constants along the way, leave those to it.
+	if (ClassDB::has_method(p_class, p_property) || ClassDB::has_signal(p_class, p_property) || ClassDB::has_integer_constant(p_class, p_property)) {
+		return nullptr;
+	}
+	const StringName getter = ClassDB::get_property_getter(p_class, p_property);
+	if (getter == StringName()) {
+		return nullptr;
+	}
+	return ClassDB::get_method(p_class, getter);
+}
+
+MethodBind *GDScriptFunction::InlineCache::resolve(const GDType *p_type, const StringName &p_name, bool p_getter) {
+	if (entries[MAX_ENTRIES - 1].claimed.load(std::memory_order_relaxed)) {
+		return nullptr; // Megamorphic, keep using the generic path.
+	}
+
+	MethodBind *method = nullptr;
+	const StringName &class_name = p_type->get_name();
+	if (ClassDB::class_exists(class_name)) {
+		// Extension classes can be unloaded, so their methods are never cached.
+		const ClassDB::APIType api = ClassDB::get_api_type(class_name);
+		if (api == ClassDB::API_CORE || api == ClassDB::API_EDITOR) {
+			method = p_getter ? _resolve_property_getter(class_name, p_name) : _resolve_method(p_type, p_name);
+		}
+	}
+
+	for (Entry &entry : entries) {
+		if (entry.type.load(std::memory_order_acquire) == p_type) {
+			return entry.method; // Resolved by another thread in the meantime.
+		}
+		if (!entry.claimed.exchange(true, std::memory_order_acq_rel)) {
+			// Threads racing on the same type may each add an entry, which only wastes one.
+			entry.method = method;
+			entry.type.store(p_type, std::memory_order_release);
+			break;
+		}
+	}
+	return method;
+}
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
@@ -240,6 +295,10 @@ GDScriptFunction::~GDScriptFunction() {
 		memdelete(lambdas[i]);
 	}
 
+	if (inline_caches) {
+		memdelete_arr(inline_caches);
+	}
+
 	for (int i = 0; i < argument_types.size(); i++) {
 		argument_types.write[i].script_type_ref = Ref<Script>();
 	}
@@ -40,6 +40,8 @@
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class GDScriptInstance;
 class GDScript;
 
@@ -304,6 +306,12 @@ public:
 		OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY,
 		OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY,
 		OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY,
+		// Superinstructions, fused from common sequences by the bytecode generator.
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
+		OPCODE_GET_MEMBER_OPERATOR_VALIDATED_SET_MEMBER,
+		OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN_ASSIGN,
+		OPCODE_ITERATE_ARRAY_ASSIGN_TYPED_BUILTIN,
 		OPCODE_ASSERT,
 		OPCODE_BREAKPOINT,
 		OPCODE_LINE,
@@ -382,6 +390,41 @@ private:
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
 
+	// Native methods resolved for the receiver types seen by one untyped call or property access
+	// (`OPCODE_CALL` and `OPCODE_GET_NAMED`). Entries are only ever appended, so the VM can probe them
+	// without locking. A thread claims an entry before filling it, so sites don't share any lock.
+	struct InlineCache {
+		static constexpr int MAX_ENTRIES = 4;
+
+		struct Entry {
+			std::atomic<bool> claimed{ false };
+			std::atomic<const GDType *> type{ nullptr }; // Set once `method` is written.
+			MethodBind *method = nullptr; // `nullptr` if the generic path must be used for this type.
+		};
+
+		Entry entries[MAX_ENTRIES];
+
+		MethodBind *resolve(const GDType *p_type, const StringName &p_name, bool p_getter);
+
+		// Returns the method to call for `p_object`, or `nullptr` if the generic path must be used.
+		// The caller must make sure that `p_object` has no script instance.
+		_FORCE_INLINE_ MethodBind *get_method(const Object *p_object, const StringName &p_name, bool p_getter) {
+			const GDType *type = &p_object->get_gdtype();
+			for (const Entry &entry : entries) {
+				const GDType *entry_type = entry.type.load(std::memory_order_acquire);
+				if (entry_type == type) {
+					return entry.method;
+				}
+				if (entry_type == nullptr) {
+					break;
+				}
+			}
+			return resolve(type, p_name, p_getter);
+		}
+	};
+
+	InlineCache *inline_caches = nullptr;
+
 	int _code_size = 0;
 	int _default_arg_count = 0;
 	int _constant_count = 0;
@@ -399,6 +442,7 @@ private:
 	int _gds_utilities_count = 0;
 	int _methods_count = 0;
 	int _lambdas_count = 0;
+	int _inline_caches_count = 0;
 
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
@@ -438,6 +482,7 @@ private:
 		SafeNumeric<uint64_t> frame_call_count;
 		SafeNumeric<uint64_t> frame_self_time;
 		SafeNumeric<uint64_t> frame_total_time;
+		SafeNumeric<uint64_t> dispatch_count;
 		uint64_t last_frame_call_count = 0;
 		uint64_t last_frame_self_time = 0;
 		uint64_t last_frame_total_time = 0;
@@ -494,6 +539,8 @@ public:
 #ifdef DEBUG_ENABLED
 	void _profile_native_call(uint64_t p_t_taken, const String &p_function_name, const String &p_instance_class_name = String());
 	void disassemble(const Vector<String> &p_code_lines) const;
+	// Number of opcodes dispatched while profiling, used to measure the VM.
+	uint64_t get_profile_dispatch_count() const { return profile.dispatch_count.get(); }
 #endif
 
 	GDScriptFunction();
@@ -408,6 +408,11 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY, \
 		&&OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY, \
 		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY, \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF, \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, \
+		&&OPCODE_GET_MEMBER_OPERATOR_VALIDATED_SET_MEMBER, \
+		&&OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN_ASSIGN, \
+		&&OPCODE_ITERATE_ARRAY_ASSIGN_TYPED_BUILTIN, \
 		&&OPCODE_ASSERT, \
 		&&OPCODE_BREAKPOINT, \
 		&&OPCODE_LINE, \
@@ -427,6 +432,9 @@ void (*type_init_function_table[])(Variant *) = {
 #ifdef DEBUG_ENABLED
 #define DISPATCH_OPCODE \
 	last_opcode = _code_ptr[ip]; \
+	if (unlikely(count_dispatches)) { \
+		dispatch_count++; \
+	} \
 	goto *switch_table_ops[last_opcode]
 #else // !DEBUG_ENABLED
 #define DISPATCH_OPCODE goto *switch_table_ops[_code_ptr[ip]]
@@ -733,6 +741,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #ifdef DEBUG_ENABLED
 	uint64_t function_start_time = 0;
 	uint64_t function_call_time = 0;
+	// Dispatches are only counted while profiling, so they don't slow down every other debug run.
+	const bool count_dispatches = GDScriptLanguage::get_singleton()->profiling;
+	uint64_t dispatch_count = 0;
 
 	if (GDScriptLanguage::get_singleton()->profiling) {
 		function_start_time = OS::get_singleton()->get_ticks_usec();
@@ -750,6 +761,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
+		if (unlikely(count_dispatches)) {
+			dispatch_count++;
+		}
 #else
 	OPCODE_WHILE(true) {
 #endif
@@ -1259,7 +1273,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1269,22 +1283,39 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
+				int cache_index = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_caches_count);
+
+				Object *src_obj = nullptr;
+				MethodBind *getter = nullptr;
+				if (src->get_type() == Variant::OBJECT) {
+					src_obj = src->get_validated_object();
+					if (src_obj && !src_obj->get_script_instance()) {
+						getter = inline_caches[cache_index].get_method(src_obj, *index, true);
+					}
+				}
+
+				if (getter) {
+					Callable::CallError err;
+					*dst = getter->call(src_obj, nullptr, 0, err);
+				} else {
+					bool valid;
 #ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+					//allow better error message in cases where src and dst are the same stack position
+					Variant ret = src->get_named(*index, valid);
 
 #else
-				*dst = src->get_named(*index, valid);
+					*dst = src->get_named(*index, valid);
 #endif
 #ifdef DEBUG_ENABLED
-				if (!valid) {
-					err_text = "Invalid access to property or key '" + index->string() + "' on a base object of type '" + _get_var_type(src) + "'.";
-					OPCODE_BREAK;
-				}
-				*dst = ret;
+					if (!valid) {
+						err_text = "Invalid access to property or key '" + index->string() + "' on a base object of type '" + _get_var_type(src) + "'.";
+						OPCODE_BREAK;
+					}
+					*dst = ret;
 #endif
-				ip += 4;
+				}
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1907,7 +1938,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1918,6 +1949,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_index = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_caches_count);
+
 				GodotProfileZoneScriptSystemCall(methodname, source, name, *methodname, line);
 
 				GET_INSTRUCTION_ARG(base, argc);
@@ -1933,11 +1967,26 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Object *base_obj = nullptr;
 #endif
 
+				// Native methods are called directly once resolved for the receiver's class.
+				Object *cached_obj = nullptr;
+				MethodBind *cached_method = nullptr;
+				if (base->get_type() == Variant::OBJECT) {
+					cached_obj = base->get_validated_object();
+					if (cached_obj && !cached_obj->get_script_instance()) {
+						cached_method = inline_caches[cache_index].get_method(cached_obj, *methodname, false);
+					}
+				}
+
 				Variant temp_ret;
 				Callable::CallError err;
+				if (cached_method) {
+					temp_ret = cached_obj->callp_method_bind(cached_method, (const Variant **)argptrs, argc, err);
+				} else {
+					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+				}
+
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1971,8 +2020,6 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						}
 					}
 #endif
-				} else {
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
 #ifdef DEBUG_ENABLED
 
@@ -2028,7 +2075,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2278,7 +2325,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN_ASSIGN)
 			OPCODE(OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN) {
+				const bool assign_return = _code_ptr[ip] == OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN_ASSIGN;
+
 				LOAD_INSTRUCTION_ARGS
 				CHECK_SPACE(3 + instr_arg_count);
 
@@ -2329,6 +2379,17 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
 				ip += 3;
+
+				if (assign_return) {
+					// Fused with the following OPCODE_ASSIGN.
+					CHECK_SPACE(3);
+					GET_VARIANT_PTR(dst, 0);
+					GET_VARIANT_PTR(src, 1);
+
+					*dst = *src;
+
+					ip += 3;
+				}
 			}
 			DISPATCH_OPCODE;
 
@@ -3879,6 +3940,139 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE_TYPE_ADJUST(PACKED_COLOR_ARRAY, PackedColorArray);
 			OPCODE_TYPE_ADJUST(PACKED_VECTOR4_ARRAY, PackedVector4Array);
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF)
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				// OPCODE_OPERATOR_VALIDATED followed by a conditional jump.
+				CHECK_SPACE(8);
+
+				const bool jump_if = _code_ptr[ip] == OPCODE_OPERATOR_VALIDATED_JUMP_IF;
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				ip += 5;
+
+				GET_VARIANT_PTR(test, 0);
+
+				if (test->booleanize() == jump_if) {
+					int to = _code_ptr[ip + 2];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 3;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_GET_MEMBER_OPERATOR_VALIDATED_SET_MEMBER) {
+				// OPCODE_GET_MEMBER, OPCODE_OPERATOR_VALIDATED and OPCODE_SET_MEMBER, as in `position += offset`.
+				CHECK_SPACE(11);
+
+				GET_VARIANT_PTR(member, 0);
+				int get_indexname = _code_ptr[ip + 2];
+				GD_ERR_BREAK(get_indexname < 0 || get_indexname >= _global_names_count);
+				const StringName *get_index = &_global_names_ptr[get_indexname];
+#ifndef DEBUG_ENABLED
+				ClassDB::get_property(p_instance->owner, *get_index, *member);
+#else
+				bool get_ok = ClassDB::get_property(p_instance->owner, *get_index, *member);
+				if (!get_ok) {
+					err_text = "Internal error getting property: " + String(*get_index);
+					OPCODE_BREAK;
+				}
+#endif
+				ip += 3;
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				ip += 5;
+
+				GET_VARIANT_PTR(src, 0);
+				int set_indexname = _code_ptr[ip + 2];
+				GD_ERR_BREAK(set_indexname < 0 || set_indexname >= _global_names_count);
+				const StringName *set_index = &_global_names_ptr[set_indexname];
+
+				bool valid;
+#ifndef DEBUG_ENABLED
+				ClassDB::set_property(p_instance->owner, *set_index, *src, &valid);
+#else
+				bool set_ok = ClassDB::set_property(p_instance->owner, *set_index, *src, &valid);
+				if (!set_ok) {
+					err_text = "Internal error setting property: " + String(*set_index);
+					OPCODE_BREAK;
+				} else if (!valid) {
+					err_text = "Error setting property '" + String(*set_index) + "' with value of type " + Variant::get_type_name(src->get_type()) + ".";
+					OPCODE_BREAK;
+				}
+#endif
+				ip += 3;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_ITERATE_ARRAY_ASSIGN_TYPED_BUILTIN) {
+				// OPCODE_ITERATE_ARRAY followed by the conversion to the typed loop variable.
+				CHECK_SPACE(9);
+
+				GET_VARIANT_PTR(counter, 0);
+				GET_VARIANT_PTR(container, 1);
+
+				const Array *array = VariantInternal::get_array((const Variant *)container);
+				int64_t *idx = VariantInternal::get_int(counter);
+				(*idx)++;
+
+				if (*idx >= array->size()) {
+					int jumpto = _code_ptr[ip + 4];
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					ip = jumpto;
+				} else {
+					GET_VARIANT_PTR(iterator, 2);
+					*iterator = array->get(*idx);
+
+					ip += 5;
+
+					GET_VARIANT_PTR(dst, 0);
+					GET_VARIANT_PTR(src, 1);
+
+					Variant::Type var_type = (Variant::Type)_code_ptr[ip + 3];
+					GD_ERR_BREAK(var_type < 0 || var_type >= Variant::VARIANT_MAX);
+
+					if (src->get_type() != var_type) {
+#ifdef DEBUG_ENABLED
+						if (Variant::can_convert_strict(src->get_type(), var_type)) {
+#endif // DEBUG_ENABLED
+							Callable::CallError ce;
+							Variant::construct(var_type, *dst, const_cast<const Variant **>(&src), 1, ce);
+						} else {
+#ifdef DEBUG_ENABLED
+							err_text = "Trying to assign value of type '" + Variant::get_type_name(src->get_type()) +
+									"' to a variable of type '" + Variant::get_type_name(var_type) + "'.";
+							OPCODE_BREAK;
+						}
+					} else {
+#endif // DEBUG_ENABLED
+						*dst = *src;
+					}
+
+					ip += 4; // Loop again.
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_ASSERT) {
 				CHECK_SPACE(3);
 
@@ -4003,6 +4197,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		profile.self_time.add(time_taken - function_call_time);
 		profile.frame_total_time.add(time_taken);
 		profile.frame_self_time.add(time_taken - function_call_time);
+		profile.dispatch_count.add(dispatch_count);
 		if (Thread::get_caller_id() == Thread::get_main_id()) {
 			GDScriptLanguage::get_singleton()->script_frame_time += time_taken - function_call_time;
 		}
@@ -0,0 +1,44 @@
+extends Node
+
+# Sequences that the bytecode generator fuses into superinstructions.
+
+func test():
+	# Validated operator followed by a conditional jump.
+	var a := 3
+	var b := 5
+	if a < b:
+		print("less")
+	if a > b:
+		print("greater")
+	else:
+		print("not greater")
+	if a > b or a == 3:
+		print("short-circuit")
+
+	var i := 0
+	var total := 0
+	while i < 4:
+		total += i
+		i += 1
+	print(total)
+
+	# Compound assignment to a native property.
+	process_priority = 10
+	var change := 20
+	process_priority += change
+	print(process_priority)
+
+	# Validated native call followed by an assignment.
+	var child := Node.new()
+	add_child(child)
+	var count: int = get_child_count()
+	print(count)
+	remove_child(child)
+	child.free()
+
+	# Conversion to a typed loop variable over an untyped array.
+	var values := [1, 2, 3]
+	var sum := 0.0
+	for value: float in values:
+		sum += value
+	print(sum)
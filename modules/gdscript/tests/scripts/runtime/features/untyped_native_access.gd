@@ -0,0 +1,43 @@
+extends Node
+
+# Untyped calls and property accesses on native objects are cached per receiver class.
+
+class Scripted extends Node:
+	var label := "scripted"
+
+	func describe() -> String:
+		return "%s %s" % [label, name]
+
+
+func get_info(object) -> String:
+	return "%s %s" % [object.get_class(), object.name]
+
+
+func test():
+	# More receiver classes than a single call site caches.
+	var objects: Array = [Node.new(), Node2D.new(), Node3D.new(), Control.new(), Timer.new(), Scripted.new()]
+	for i in objects.size():
+		objects[i].name = "Object%d" % i
+	for _i in 2:
+		for object in objects:
+			print(get_info(object))
+	print(objects[5].describe())
+
+	# Built-in members and dictionary keys share the same instruction.
+	var values: Array = [Vector2(1, 2), { "x": 3 }, Vector3(4, 5, 6)]
+	for value in values:
+		print(value.x)
+
+	# Scripts and native classes handle their own calls.
+	var script_class = Scripted
+	var made = script_class.new()
+	made.name = "Made"
+	print(made.describe())
+	var native_class = Timer
+	var timer = native_class.new()
+	print(timer.get_class())
+
+	for object in objects:
+		object.free()
+	made.free()
+	timer.free()
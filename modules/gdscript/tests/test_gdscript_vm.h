@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*  test_gdscript_vm.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+
+#include "core/object/class_db.h"
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace TestGDScriptVM {
+
+struct BenchmarkResult {
+	double nsec_per_op = 0.0;
+	double dispatches_per_op = 0.0;
+};
+
+// Runs `bench(p_iterations)` from the given source on an instance of `p_base_class`, and reports the cost per loop iteration.
+static BenchmarkResult run_benchmark(const String &p_source, int p_iterations, const StringName &p_base_class = SNAME("RefCounted")) {
+	BenchmarkResult result;
+
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(p_source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The benchmark script should parse successfully.");
+
+	Object *instance = ClassDB::instantiate(p_base_class);
+	REQUIRE(instance);
+	// Keeps reference counted instances alive until the end of the benchmark.
+	Variant instance_holder = instance;
+	instance->set_script(gdscript);
+
+	// Warm up once so that lazily resolved state is excluded from the measurement.
+	instance->call("bench", 1);
+
+#ifdef DEBUG_ENABLED
+	GDScriptLanguage::get_singleton()->profiling_start();
+#endif
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	instance->call("bench", p_iterations);
+	const uint64_t end = OS::get_singleton()->get_ticks_usec();
+#ifdef DEBUG_ENABLED
+	GDScriptLanguage::get_singleton()->profiling_stop();
+	GDScriptFunction *const *function = gdscript->get_member_functions().getptr("bench");
+	if (function) {
+		result.dispatches_per_op = double((*function)->get_profile_dispatch_count()) / p_iterations;
+	}
+#endif
+	result.nsec_per_op = double(end - begin) * 1000.0 / p_iterations;
+
+	instance->set_script(Variant());
+	if (!Object::cast_to<RefCounted>(instance)) {
+		memdelete(instance);
+	}
+	return result;
+}
+
+static void report(const String &p_name, const BenchmarkResult &p_result) {
+	MESSAGE(vformat("%s: %.2f ns/op, %.2f dispatches/op", p_name, p_result.nsec_per_op, p_result.dispatches_per_op).utf8().get_data());
+}
+
+TEST_CASE_PENDING("[Modules][GDScript][Benchmark] Bytecode dispatch") {
+	const int iterations = 1000000;
+
+	SUBCASE("Typed comparison loop") {
+		const String source = R"(
+extends RefCounted
+
+func bench(n: int) -> int:
+	var i := 0
+	var total := 0
+	while i < n:
+		if i < 100:
+			total += 1
+		i += 1
+	return total
+)";
+		report("Typed comparison loop", run_benchmark(source, iterations));
+	}
+
+	SUBCASE("Member compound assignment") {
+		const String source = R"(
+extends RefCounted
+
+var counter := 0
+
+func bench(n: int) -> void:
+	for i in n:
+		counter += i
+)";
+		report("Member compound assignment", run_benchmark(source, iterations));
+	}
+
+	SUBCASE("Native property compound assignment") {
+		// Native properties go through GET_MEMBER and SET_MEMBER, which get fused with the operator in between.
+		const String source = R"(
+extends Node
+
+func bench(n: int) -> void:
+	var step := 1
+	for i in n:
+		process_priority += step
+)";
+		report("Native property compound assignment", run_benchmark(source, iterations, SNAME("Node")));
+	}
+
+	SUBCASE("Validated native call") {
+		const String source = R"(
+extends RefCounted
+
+func bench(n: int) -> int:
+	var total := 0
+	for i in n:
+		var count: int = get_reference_count()
+		total += count
+	return total
+)";
+		report("Validated native call", run_benchmark(source, iterations));
+	}
+
+	SUBCASE("Typed loop over untyped array") {
+		const String source = R"(
+extends RefCounted
+
+func bench(n: int) -> float:
+	var values := []
+	values.resize(n)
+	values.fill(1)
+	var sum := 0.0
+	for value: float in values:
+		sum += value
+	return sum
+)";
+		report("Typed loop over untyped array", run_benchmark(source, iterations));
+	}
+
+	SUBCASE("Untyped native call") {
+		const String source = R"(
+extends RefCounted
+
+func bench(n: int) -> int:
+	var object = RefCounted.new()
+	var total := 0
+	for i in n:
+		total += object.get_reference_count()
+	return total
+)";
+		report("Untyped native call", run_benchmark(source, iterations));
+	}
+
+	SUBCASE("Untyped native property") {
+		const String source = R"(
+extends RefCounted
+
+func bench(n: int) -> int:
+	var resource = Resource.new()
+	resource.resource_name = "resource"
+	var total := 0
+	for i in n:
+		total += resource.resource_name.length()
+	return total
+)";
+		report("Untyped native property", run_benchmark(source, iterations));
+	}
+}
+
+} // namespace TestGDScriptVM
@@ -286,6 +286,11 @@ void GodotBody2D::set_mode(PS2DE::BodyMode p_mode) {
 			set_active(true);
 		}
 	}
+
+	if (prev != mode && get_space()) {
+		// Only rigid bodies are part of islands, and static bodies split them, so this can merge or split several islands.
+		get_space()->invalidate_islands();
+	}
 }
 
 PS2DE::BodyMode GodotBody2D::get_mode() const {
@@ -606,12 +611,20 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector2();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		_update_shape_aabbs_with_motion(motion);
+		broadphase_update_pending = true;
 	}
 
 	contact_count = 0;
 }
 
+void GodotBody2D::finish_integrate_forces() {
+	if (broadphase_update_pending) {
+		_update_shapes_broadphase();
+		broadphase_update_pending = false;
+	}
+}
+
 void GodotBody2D::integrate_velocities(real_t p_step) {
 	if (mode == PS2DE::BODY_MODE_STATIC) {
 		return;
@@ -619,16 +632,9 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 
 	ERR_FAIL_NULL(get_space());
 
-	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
-
 	if (mode == PS2DE::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
-		if (contacts.is_empty() && linear_velocity == Vector2() && angular_velocity == 0) {
-			set_active(false); //stopped moving, deactivate
-		}
 		return;
 	}
 
@@ -644,16 +650,57 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 		pos += center_of_mass - center_of_mass.rotated(angle_delta);
 	}
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PS2DE::CCD_MODE_DISABLED);
+	_set_transform(Transform2D(angle, pos), false);
 	_set_inv_transform(get_transform().inverse());
 
-	if (continuous_cd_mode != PS2DE::CCD_MODE_DISABLED) {
+	if (continuous_cd_mode == PS2DE::CCD_MODE_DISABLED) {
+		_update_shape_aabbs();
+		broadphase_update_pending = true;
+	} else {
 		new_transform = get_transform();
 	}
 
 	_update_transform_dependent();
 }
 
+void GodotBody2D::finish_integrate_velocities() {
+	if (mode == PS2DE::BODY_MODE_STATIC) {
+		return;
+	}
+
+	ERR_FAIL_NULL(get_space());
+
+	if (fi_callback_data || body_state_callback.is_valid()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (mode == PS2DE::BODY_MODE_KINEMATIC) {
+		if (contacts.is_empty() && linear_velocity == Vector2() && angular_velocity == 0) {
+			set_active(false); //stopped moving, deactivate
+		}
+		return;
+	}
+
+	if (broadphase_update_pending) {
+		_update_shapes_broadphase();
+		broadphase_update_pending = false;
+	}
+}
+
+void GodotBody2D::add_constraint(GodotConstraint2D *p_constraint, int p_pos) {
+	constraint_list.push_back({ p_constraint, p_pos });
+	if (get_space()) {
+		get_space()->invalidate_body_island(this);
+	}
+}
+
+void GodotBody2D::remove_constraint(GodotConstraint2D *p_constraint, int p_pos) {
+	constraint_list.erase({ p_constraint, p_pos });
+	if (get_space()) {
+		get_space()->invalidate_body_island(this);
+	}
+}
+
 void GodotBody2D::wakeup_neighbours() {
 	for (const Pair<GodotConstraint2D *, int> &E : constraint_list) {
 		const GodotConstraint2D *c = E.first;
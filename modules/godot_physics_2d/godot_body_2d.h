@@ -100,6 +100,7 @@ class GodotBody2D : public GodotCollisionObject2D {
 	VSet<RID> exceptions;
 	PS2DE::CCDMode continuous_cd_mode = PS2DE::CCD_MODE_DISABLED;
 	bool omit_force_integration = false;
+	bool broadphase_update_pending = false; // Shape AABBs changed during integration.
 	bool active = true;
 	bool can_sleep = true;
 	bool first_time_kinematic = false;
@@ -152,6 +153,7 @@ class GodotBody2D : public GodotCollisionObject2D {
 	GodotPhysicsDirectBodyState2D *direct_state = nullptr;
 
 	uint64_t island_step = 0;
+	uint32_t island_index = UINT32_MAX; // Slot in the space's island cache.
 
 	void _update_transform_dependent();
 
@@ -204,8 +206,11 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
-	_FORCE_INLINE_ void add_constraint(GodotConstraint2D *p_constraint, int p_pos) { constraint_list.push_back({ p_constraint, p_pos }); }
-	_FORCE_INLINE_ void remove_constraint(GodotConstraint2D *p_constraint, int p_pos) { constraint_list.erase({ p_constraint, p_pos }); }
+	_FORCE_INLINE_ uint32_t get_island_index() const { return island_index; }
+	_FORCE_INLINE_ void set_island_index(uint32_t p_index) { island_index = p_index; }
+
+	void add_constraint(GodotConstraint2D *p_constraint, int p_pos);
+	void remove_constraint(GodotConstraint2D *p_constraint, int p_pos);
 	const List<Pair<GodotConstraint2D *, int>> &get_constraint_list() const { return constraint_list; }
 	_FORCE_INLINE_ void clear_constraint_list() { constraint_list.clear(); }
 
@@ -317,8 +322,13 @@ public:
 	_FORCE_INLINE_ real_t get_friction() const { return friction; }
 	_FORCE_INLINE_ real_t get_bounce() const { return bounce; }
 
+	// The integration steps only touch this body, so they can run in parallel for different bodies.
+	// Whatever involves the space (broadphase, active and query lists) is left to the matching
+	// finish call, which must run afterwards on the stepping thread.
 	void integrate_forces(real_t p_step);
+	void finish_integrate_forces();
 	void integrate_velocities(real_t p_step);
+	void finish_integrate_velocities();
 
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * (rel_pos.y - center_of_mass.y), angular_velocity * (rel_pos.x - center_of_mass.x));
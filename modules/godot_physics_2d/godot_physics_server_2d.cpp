@@ -1296,11 +1296,17 @@ void GodotPhysicsServer2D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
+		elapsed_time[i] = 0;
+	}
 	for (GodotSpace2D *E : active_spaces) {
 		stepper->step(E, p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		for (int i = 0; i < GodotSpace2D::ELAPSED_TIME_MAX; i++) {
+			elapsed_time[i] += E->get_elapsed_time(GodotSpace2D::ElapsedTime(i));
+		}
 	}
 }
 
@@ -1327,6 +1333,7 @@ void GodotPhysicsServer2D::flush_queries() {
 		uint64_t total_time[GodotSpace2D::ELAPSED_TIME_MAX];
 		static const char *time_name[GodotSpace2D::ELAPSED_TIME_MAX] = {
 			"integrate_forces",
+			"broadphase",
 			"generate_islands",
 			"setup_constraints",
 			"solve_constraints",
@@ -1383,6 +1390,24 @@ int GodotPhysicsServer2D::get_process_info(PS2DE::ProcessInfo p_info) {
 		case PS2DE::INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case PS2DE::INFO_INTEGRATE_FORCES_TIME: {
+			return MIN(elapsed_time[GodotSpace2D::ELAPSED_TIME_INTEGRATE_FORCES], (uint64_t)INT32_MAX);
+		} break;
+		case PS2DE::INFO_BROADPHASE_TIME: {
+			return MIN(elapsed_time[GodotSpace2D::ELAPSED_TIME_BROADPHASE], (uint64_t)INT32_MAX);
+		} break;
+		case PS2DE::INFO_GENERATE_ISLANDS_TIME: {
+			return MIN(elapsed_time[GodotSpace2D::ELAPSED_TIME_GENERATE_ISLANDS], (uint64_t)INT32_MAX);
+		} break;
+		case PS2DE::INFO_SETUP_CONSTRAINTS_TIME: {
+			return MIN(elapsed_time[GodotSpace2D::ELAPSED_TIME_SETUP_CONSTRAINTS], (uint64_t)INT32_MAX);
+		} break;
+		case PS2DE::INFO_SOLVE_CONSTRAINTS_TIME: {
+			return MIN(elapsed_time[GodotSpace2D::ELAPSED_TIME_SOLVE_CONSTRAINTS], (uint64_t)INT32_MAX);
+		} break;
+		case PS2DE::INFO_INTEGRATE_VELOCITIES_TIME: {
+			return MIN(elapsed_time[GodotSpace2D::ELAPSED_TIME_INTEGRATE_VELOCITIES], (uint64_t)INT32_MAX);
+		} break;
 	}
 
 	return 0;
@@ -49,6 +49,7 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	uint64_t elapsed_time[GodotSpace2D::ELAPSED_TIME_MAX] = {}; // Summed over all active spaces, in usec.
 
 	bool using_threads = false;
 
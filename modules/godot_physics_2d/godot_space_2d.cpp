@@ -1057,10 +1057,16 @@ const SelfList<GodotBody2D>::List &GodotSpace2D::get_active_body_list() const {
 
 void GodotSpace2D::body_add_to_active_list(SelfList<GodotBody2D> *p_body) {
 	active_list.add(p_body);
+	invalidate_body_island(p_body->self());
 }
 
 void GodotSpace2D::body_remove_from_active_list(SelfList<GodotBody2D> *p_body) {
 	active_list.remove(p_body);
+	invalidate_body_island(p_body->self());
+}
+
+const SelfList<GodotBody2D>::List &GodotSpace2D::get_mass_properties_update_list() const {
+	return mass_properties_update_list;
 }
 
 void GodotSpace2D::body_add_to_mass_properties_update_list(SelfList<GodotBody2D> *p_body) {
@@ -1078,11 +1084,21 @@ GodotBroadPhase2D *GodotSpace2D::get_broadphase() {
 void GodotSpace2D::add_object(GodotCollisionObject2D *p_object) {
 	ERR_FAIL_COND(objects.has(p_object));
 	objects.insert(p_object);
+	if (p_object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+		GodotBody2D *body = static_cast<GodotBody2D *>(p_object);
+		body->set_island_index(UINT32_MAX);
+		invalidate_body_island(body);
+	}
 }
 
 void GodotSpace2D::remove_object(GodotCollisionObject2D *p_object) {
 	ERR_FAIL_COND(!objects.has(p_object));
 	objects.erase(p_object);
+	if (p_object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+		GodotBody2D *body = static_cast<GodotBody2D *>(p_object);
+		invalidate_body_island(body);
+		body->set_island_index(UINT32_MAX);
+	}
 }
 
 const HashSet<GodotCollisionObject2D *> &GodotSpace2D::get_objects() const {
@@ -1117,6 +1133,16 @@ const SelfList<GodotArea2D>::List &GodotSpace2D::get_moved_area_list() const {
 	return area_moved_list;
 }
 
+void GodotSpace2D::invalidate_body_island(GodotBody2D *p_body) {
+	// Only the island the body was in needs to be regenerated, along with any island
+	// the active bodies without one end up in.
+	uint32_t index = p_body->get_island_index();
+	if (index < island_cache.islands.size()) {
+		island_cache.islands[index].dirty = true;
+	}
+	island_cache.dirty = true;
+}
+
 void GodotSpace2D::call_queries() {
 	while (state_query_list.first()) {
 		GodotBody2D *b = state_query_list.first()->self();
@@ -1134,10 +1160,8 @@ void GodotSpace2D::call_queries() {
 void GodotSpace2D::setup() {
 	contact_debug_count = 0;
 
-	while (mass_properties_update_list.first()) {
-		mass_properties_update_list.first()->self()->update_mass_properties();
-		mass_properties_update_list.remove(mass_properties_update_list.first());
-	}
+	// The step has already updated the mass properties of these bodies.
+	mass_properties_update_list.clear();
 }
 
 void GodotSpace2D::update() {
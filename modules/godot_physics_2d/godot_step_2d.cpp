@@ -35,14 +35,14 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
-#define BODY_ISLAND_COUNT_RESERVE 128
 #define BODY_ISLAND_SIZE_RESERVE 512
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
-void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
+void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island, uint32_t p_island_index) {
 	p_body->set_island_step(_step);
+	p_body->set_island_index(p_island_index);
 
 	if (p_body->get_mode() > PS2DE::BODY_MODE_KINEMATIC) {
 		// Only rigid bodies are tested for activation.
@@ -56,7 +56,6 @@ void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D
 		}
 		constraint->set_island_step(_step);
 		p_constraint_island.push_back(constraint);
-		all_constraints.push_back(constraint);
 
 		for (int i = 0; i < constraint->get_body_count(); i++) {
 			if (i == E.second) {
@@ -69,11 +68,75 @@ void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D
 			if (other_body->get_mode() == PS2DE::BODY_MODE_STATIC) {
 				continue; // Static bodies don't connect islands.
 			}
-			_populate_island(other_body, p_body_island, p_constraint_island);
+			_populate_island(other_body, p_body_island, p_constraint_island, p_island_index);
 		}
 	}
 }
 
+uint32_t GodotStep2D::_alloc_island(GodotSpace2D::IslandCache &r_island_cache) {
+	uint32_t index;
+	if (!r_island_cache.free_islands.is_empty()) {
+		index = r_island_cache.free_islands[r_island_cache.free_islands.size() - 1];
+		r_island_cache.free_islands.resize(r_island_cache.free_islands.size() - 1);
+	} else {
+		index = r_island_cache.islands.size();
+		r_island_cache.islands.resize(index + 1);
+		r_island_cache.islands[index].bodies.reserve(BODY_ISLAND_SIZE_RESERVE);
+		r_island_cache.islands[index].constraints.reserve(ISLAND_SIZE_RESERVE);
+	}
+	r_island_cache.islands[index].used = true;
+	r_island_cache.generated_island_count++;
+	return index;
+}
+
+void GodotStep2D::_free_island(GodotSpace2D::IslandCache &r_island_cache, uint32_t p_index) {
+	GodotSpace2D::Island &island = r_island_cache.islands[p_index];
+	island.bodies.clear();
+	island.constraints.clear();
+	island.used = false;
+	r_island_cache.free_islands.push_back(p_index);
+}
+
+void GodotStep2D::_generate_islands(const SelfList<GodotBody2D>::List &p_body_list, GodotSpace2D::IslandCache &r_island_cache, bool p_regenerate_all) {
+	LocalVector<GodotSpace2D::Island> &islands = r_island_cache.islands;
+
+	for (uint32_t island_index = 0; island_index < islands.size(); ++island_index) {
+		GodotSpace2D::Island &island = islands[island_index];
+		if (island.used && (island.dirty || p_regenerate_all)) {
+			_free_island(r_island_cache, island_index);
+		}
+		island.dirty = false;
+	}
+
+	// Islands are only regenerated from the active bodies that lost theirs, so the other islands stay untouched.
+	// Those are gathered first, because the islands they reference may be reused while regenerating.
+	island_seeds.clear();
+	for (const SelfList<GodotBody2D> *b = p_body_list.first(); b; b = b->next()) {
+		GodotBody2D *body = b->self();
+		uint32_t index = body->get_island_index();
+		if (index >= islands.size() || !islands[index].used) {
+			island_seeds.push_back(body);
+		}
+	}
+
+	for (GodotBody2D *body : island_seeds) {
+		if (body->get_island_step() != _step) {
+			uint32_t island_index = _alloc_island(r_island_cache);
+			GodotSpace2D::Island &island = islands[island_index];
+
+			_populate_island(body, island.bodies, island.constraints, island_index);
+
+			if (island.bodies.is_empty() && island.constraints.is_empty()) {
+				_free_island(r_island_cache, island_index);
+			}
+		}
+	}
+}
+
+void GodotStep2D::_update_mass_properties(uint32_t p_body_index, void *p_userdata) {
+	mass_properties_bodies[p_body_index]->update_mass_properties();
+}
+
 void GodotStep2D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint2D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -103,34 +166,69 @@ void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const
 	}
 }
 
-void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) const {
+void GodotStep2D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep2D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep2D::_sleep_test_island(uint32_t p_island_index, const GodotSpace2D::IslandCache *p_island_cache) {
+	const LocalVector<GodotBody2D *> &body_island = p_island_cache->islands[p_island_index].bodies;
+
 	bool can_sleep = true;
 
-	uint32_t body_count = p_body_island.size();
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody2D *body = p_body_island[body_index];
+		GodotBody2D *body = body_island[body_index];
 
 		if (!body->sleep_test(delta)) {
 			can_sleep = false;
 		}
 	}
 
+	body_island_can_sleep[p_island_index] = can_sleep;
+}
+
+void GodotStep2D::_check_suspend(const LocalVector<GodotBody2D *> &p_body_island, bool p_can_sleep) const {
 	// Put all to sleep or wake up everyone.
+	uint32_t body_count = p_body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
 		GodotBody2D *body = p_body_island[body_index];
 
 		bool active = body->is_active();
 
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
+		if (active == p_can_sleep) {
+			body->set_active(!p_can_sleep);
 		}
 	}
 }
 
+void GodotStep2D::_gather_active_bodies(const SelfList<GodotBody2D>::List &p_body_list) {
+	active_bodies.clear();
+	for (const SelfList<GodotBody2D> *b = p_body_list.first(); b; b = b->next()) {
+		active_bodies.push_back(b->self());
+	}
+}
+
 void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
-	p_space->setup(); //update inertias, etc
+	WorkerThreadPool *pool = thread_pool ? thread_pool : WorkerThreadPool::get_singleton();
+
+	/* UPDATE MASS PROPERTIES */
+
+	// Each body only reads its own shapes, so this can run on threads.
+	mass_properties_bodies.clear();
+	for (const SelfList<GodotBody2D> *b = p_space->get_mass_properties_update_list().first(); b; b = b->next()) {
+		mass_properties_bodies.push_back(b->self());
+	}
+
+	WorkerThreadPool::GroupID group_task = pool->add_template_group_task(this, &GodotStep2D::_update_mass_properties, nullptr, mass_properties_bodies.size(), -1, true, SNAME("Physics2DUpdateMassProperties"));
+	pool->wait_for_group_task_completion(group_task);
+
+	p_space->setup(); // Clears the mass properties update list.
 
 	p_space->set_last_step(p_delta);
 
@@ -144,30 +242,77 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_gather_active_bodies(*body_list);
+	int active_count = active_bodies.size();
 
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	group_task = pool->add_template_group_task(this, &GodotStep2D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics2DIntegrateForces"));
+	pool->wait_for_group_task_completion(group_task);
+
+	// Moving shapes in the broadphase isn't thread-safe.
+	for (GodotBody2D *body : active_bodies) {
+		body->finish_integrate_forces();
 	}
 
 	p_space->set_active_objects(active_count);
 
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
 	// Update the broadphase to register collision pairs.
+	// WARNING: This doesn't run on threads, because the pair callbacks create and destroy constraints.
 	p_space->update();
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_BROADPHASE, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
+	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
+
+	// WARNING: Generating islands doesn't run on threads, because the flood fill marks shared bodies and constraints.
+	// Islands only change when constraints are added or removed, or when the set of active bodies changes,
+	// so they are kept in the space between steps and only the ones affected by those changes are regenerated.
+	// Body mode changes, which can merge or split any number of islands, regenerate all of them.
+	GodotSpace2D::IslandCache &island_cache = p_space->get_island_cache();
+	island_cache.generated_island_count = 0;
+	bool regenerate_all = island_cache.version != p_space->get_island_version();
+	if (regenerate_all || island_cache.dirty) {
+		_generate_islands(*body_list, island_cache, regenerate_all);
+		island_cache.version = p_space->get_island_version();
+		island_cache.dirty = false;
+	}
 
+	// Constraint islands are modified while solving, so work on a copy.
 	uint32_t island_count = 0;
 
+	for (const GodotSpace2D::Island &cached_island : island_cache.islands) {
+		if (cached_island.constraints.is_empty()) {
+			continue;
+		}
+
+		++island_count;
+		if (constraint_islands.size() < island_count) {
+			constraint_islands.resize(island_count);
+		}
+		LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
+		constraint_island.clear();
+
+		for (GodotConstraint2D *constraint : cached_island.constraints) {
+			constraint->set_island_step(_step);
+			constraint_island.push_back(constraint);
+			all_constraints.push_back(constraint);
+		}
+	}
+
+	// Unused islands have no bodies, so testing them is a no-op.
+	uint32_t body_island_count = island_cache.islands.size();
+
+	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
+
 	const SelfList<GodotArea2D>::List &aml = p_space->get_moved_area_list();
 
 	while (aml.first()) {
@@ -192,45 +337,6 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		p_space->area_remove_from_moved_list((SelfList<GodotArea2D> *)aml.first()); //faster to remove here
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
-
-	b = body_list->first();
-
-	uint32_t body_island_count = 0;
-
-	while (b) {
-		GodotBody2D *body = b->self();
-
-		if (body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody2D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
-
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island(body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
-
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
-		}
-		b = b->next();
-	}
-
 	p_space->set_island_count((int)island_count);
 
 	{ //profile
@@ -242,8 +348,8 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	group_task = pool->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
+	pool->wait_for_group_task_completion(group_task);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -262,8 +368,8 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	group_task = pool->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
+	pool->wait_for_group_task_completion(group_task);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -273,17 +379,25 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	// Solving may have woken up more bodies.
+	_gather_active_bodies(*body_list);
+
+	group_task = pool->add_template_group_task(this, &GodotStep2D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics2DIntegrateVelocities"));
+	pool->wait_for_group_task_completion(group_task);
+
+	// This can deactivate bodies and touches the broadphase, so it's not thread-safe.
+	for (GodotBody2D *body : active_bodies) {
+		body->finish_integrate_velocities();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
 
+	body_island_can_sleep.resize(body_island_count);
+	group_task = pool->add_template_group_task(this, &GodotStep2D::_sleep_test_island, (const GodotSpace2D::IslandCache *)&island_cache, body_island_count, -1, true, SNAME("Physics2DSleepTestIslands"));
+	pool->wait_for_group_task_completion(group_task);
+
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		_check_suspend(island_cache.islands[island_index].bodies, body_island_can_sleep[island_index]);
 	}
 
 	{ //profile
@@ -298,8 +412,8 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	_step++;
 }
 
-GodotStep2D::GodotStep2D() {
-	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
+GodotStep2D::GodotStep2D(WorkerThreadPool *p_thread_pool) {
+	thread_pool = p_thread_pool;
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
 }
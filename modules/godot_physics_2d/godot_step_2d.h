@@ -34,24 +34,39 @@
 
 #include "core/templates/local_vector.h"
 
+class WorkerThreadPool;
+
 class GodotStep2D {
 	uint64_t _step = 1;
 
+	WorkerThreadPool *thread_pool = nullptr; // The global pool is used when null.
+
 	int iterations = 0;
 	real_t delta = 0.0;
 
-	LocalVector<LocalVector<GodotBody2D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
+	LocalVector<GodotBody2D *> active_bodies;
+	LocalVector<GodotBody2D *> mass_properties_bodies;
+	LocalVector<GodotBody2D *> island_seeds;
+	LocalVector<bool> body_island_can_sleep;
 
-	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
+	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island, uint32_t p_island_index);
+	uint32_t _alloc_island(GodotSpace2D::IslandCache &r_island_cache);
+	void _free_island(GodotSpace2D::IslandCache &r_island_cache, uint32_t p_index);
+	void _generate_islands(const SelfList<GodotBody2D>::List &p_body_list, GodotSpace2D::IslandCache &r_island_cache, bool p_regenerate_all);
+	void _update_mass_properties(uint32_t p_body_index, void *p_userdata = nullptr);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr) const;
-	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island) const;
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _sleep_test_island(uint32_t p_island_index, const GodotSpace2D::IslandCache *p_island_cache);
+	void _check_suspend(const LocalVector<GodotBody2D *> &p_body_island, bool p_can_sleep) const;
+	void _gather_active_bodies(const SelfList<GodotBody2D>::List &p_body_list);
 
 public:
 	void step(GodotSpace2D *p_space, real_t p_delta);
-	GodotStep2D();
+	GodotStep2D(WorkerThreadPool *p_thread_pool = nullptr);
 	~GodotStep2D();
 };
@@ -337,6 +337,11 @@ void GodotBody3D::set_mode(PS3DE::BodyMode p_mode) {
 			set_active(true);
 		}
 	}
+
+	if (prev != mode && get_space()) {
+		// Only rigid bodies are part of islands, and static bodies split them, so this can merge or split several islands.
+		get_space()->invalidate_islands();
+	}
 }
 
 PS3DE::BodyMode GodotBody3D::get_mode() const {
@@ -665,12 +670,20 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector3();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		_update_shape_aabbs_with_motion(motion);
+		broadphase_update_pending = true;
 	}
 
 	contact_count = 0;
 }
 
+void GodotBody3D::finish_integrate_forces() {
+	if (broadphase_update_pending) {
+		_update_shapes_broadphase();
+		broadphase_update_pending = false;
+	}
+}
+
 void GodotBody3D::integrate_velocities(real_t p_step) {
 	if (mode == PS3DE::BODY_MODE_STATIC) {
 		return;
@@ -678,10 +691,6 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	ERR_FAIL_NULL(get_space());
 
-	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
-
 	//apply axis lock linear
 	for (int i = 0; i < 3; i++) {
 		if (is_axis_locked((PS3DE::BodyAxis)(1 << i))) {
@@ -701,10 +710,6 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	if (mode == PS3DE::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
-		if (contacts.is_empty() && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
-		}
-
 		return;
 	}
 
@@ -731,12 +736,52 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	_set_transform(transform_new, false);
 	_set_inv_transform(get_transform().inverse());
+	_update_shape_aabbs();
+	broadphase_update_pending = true;
 
 	_update_transform_dependent();
 }
 
+void GodotBody3D::finish_integrate_velocities() {
+	if (mode == PS3DE::BODY_MODE_STATIC) {
+		return;
+	}
+
+	ERR_FAIL_NULL(get_space());
+
+	if (fi_callback_data || body_state_callback.is_valid()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (mode == PS3DE::BODY_MODE_KINEMATIC) {
+		if (contacts.is_empty() && linear_velocity == Vector3() && angular_velocity == Vector3()) {
+			set_active(false); //stopped moving, deactivate
+		}
+		return;
+	}
+
+	if (broadphase_update_pending) {
+		_update_shapes_broadphase();
+		broadphase_update_pending = false;
+	}
+}
+
+void GodotBody3D::add_constraint(GodotConstraint3D *p_constraint, int p_pos) {
+	constraint_map[p_constraint] = p_pos;
+	if (get_space()) {
+		get_space()->invalidate_body_island(this);
+	}
+}
+
+void GodotBody3D::remove_constraint(GodotConstraint3D *p_constraint) {
+	constraint_map.erase(p_constraint);
+	if (get_space()) {
+		get_space()->invalidate_body_island(this);
+	}
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
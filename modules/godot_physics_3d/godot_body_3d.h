@@ -102,6 +102,7 @@ class GodotBody3D : public GodotCollisionObject3D {
 
 	VSet<RID> exceptions;
 	bool omit_force_integration = false;
+	bool broadphase_update_pending = false; // Shape AABBs changed during integration.
 	bool active = true;
 
 	bool continuous_cd = false;
@@ -145,6 +146,7 @@ class GodotBody3D : public GodotCollisionObject3D {
 	GodotPhysicsDirectBodyState3D *direct_state = nullptr;
 
 	uint64_t island_step = 0;
+	uint32_t island_index = UINT32_MAX; // Slot in the space's island cache.
 
 	void _update_transform_dependent();
 
@@ -196,8 +198,11 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
-	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
-	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraint_map.erase(p_constraint); }
+	_FORCE_INLINE_ uint32_t get_island_index() const { return island_index; }
+	_FORCE_INLINE_ void set_island_index(uint32_t p_index) { island_index = p_index; }
+
+	void add_constraint(GodotConstraint3D *p_constraint, int p_pos);
+	void remove_constraint(GodotConstraint3D *p_constraint);
 	const HashMap<GodotConstraint3D *, int> &get_constraint_map() const { return constraint_map; }
 	_FORCE_INLINE_ void clear_constraint_map() { constraint_map.clear(); }
 
@@ -317,8 +322,13 @@ public:
 	void set_axis_lock(PS3DE::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PS3DE::BodyAxis p_axis) const;
 
+	// The integration steps only touch this body, so they can run in parallel for different bodies.
+	// Whatever involves the space (broadphase, active and query lists) is left to the matching
+	// finish call, which must run afterwards on the stepping thread.
 	void integrate_forces(real_t p_step);
+	void finish_integrate_forces();
 	void integrate_velocities(real_t p_step);
+	void finish_integrate_velocities();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -81,6 +81,12 @@ private:
 
 protected:
 	void _update_shapes_with_motion(const Vector3 &p_motion);
+
+	// The AABB updates only touch this object, so they can run in parallel for different objects.
+	// Moving the shapes to their new AABBs in the broadphase can't, so it's done separately.
+	void _update_shape_aabbs();
+	void _update_shape_aabbs_with_motion(const Vector3 &p_motion);
+	void _update_shapes_broadphase();
 	void _unregister_shapes();
 
 	_FORCE_INLINE_ void _set_transform(const Transform3D &p_transform, bool p_update_shapes = true) {
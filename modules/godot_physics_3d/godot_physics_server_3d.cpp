@@ -1700,11 +1700,17 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
+		elapsed_time[i] = 0;
+	}
 	for (GodotSpace3D *E : active_spaces) {
 		stepper->step(E, p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
+			elapsed_time[i] += E->get_elapsed_time(GodotSpace3D::ElapsedTime(i));
+		}
 	}
 }
 
@@ -1732,6 +1738,7 @@ void GodotPhysicsServer3D::flush_queries() {
 		uint64_t total_time[GodotSpace3D::ELAPSED_TIME_MAX];
 		static const char *time_name[GodotSpace3D::ELAPSED_TIME_MAX] = {
 			"integrate_forces",
+			"broadphase",
 			"generate_islands",
 			"setup_constraints",
 			"solve_constraints",
@@ -1781,6 +1788,24 @@ int GodotPhysicsServer3D::get_process_info(PS3DE::ProcessInfo p_info) {
 		case PS3DE::INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case PS3DE::INFO_INTEGRATE_FORCES_TIME: {
+			return MIN(elapsed_time[GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES], (uint64_t)INT32_MAX);
+		} break;
+		case PS3DE::INFO_BROADPHASE_TIME: {
+			return MIN(elapsed_time[GodotSpace3D::ELAPSED_TIME_BROADPHASE], (uint64_t)INT32_MAX);
+		} break;
+		case PS3DE::INFO_GENERATE_ISLANDS_TIME: {
+			return MIN(elapsed_time[GodotSpace3D::ELAPSED_TIME_GENERATE_ISLANDS], (uint64_t)INT32_MAX);
+		} break;
+		case PS3DE::INFO_SETUP_CONSTRAINTS_TIME: {
+			return MIN(elapsed_time[GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS], (uint64_t)INT32_MAX);
+		} break;
+		case PS3DE::INFO_SOLVE_CONSTRAINTS_TIME: {
+			return MIN(elapsed_time[GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS], (uint64_t)INT32_MAX);
+		} break;
+		case PS3DE::INFO_INTEGRATE_VELOCITIES_TIME: {
+			return MIN(elapsed_time[GodotSpace3D::ELAPSED_TIME_INTEGRATE_VELOCITIES], (uint64_t)INT32_MAX);
+		} break;
 	}
 
 	return 0;
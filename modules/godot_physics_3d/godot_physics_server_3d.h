@@ -47,6 +47,7 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	uint64_t elapsed_time[GodotSpace3D::ELAPSED_TIME_MAX] = {}; // Summed over all active spaces, in usec.
 
 	bool using_threads = false;
 	bool doing_sync = false;
@@ -63,6 +63,20 @@ GodotSoftBody3D::GodotSoftBody3D() :
 void GodotSoftBody3D::_shapes_changed() {
 }
 
+void GodotSoftBody3D::add_constraint(GodotConstraint3D *p_constraint) {
+	constraints.insert(p_constraint);
+	if (get_space()) {
+		get_space()->invalidate_islands();
+	}
+}
+
+void GodotSoftBody3D::remove_constraint(GodotConstraint3D *p_constraint) {
+	constraints.erase(p_constraint);
+	if (get_space()) {
+		get_space()->invalidate_islands();
+	}
+}
+
 void GodotSoftBody3D::set_state(PS3DE::BodyState p_state, const Variant &p_variant) {
 	switch (p_state) {
 		case PS3DE::BODY_STATE_TRANSFORM: {
@@ -122,8 +122,8 @@ public:
 	void set_state(PS3DE::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PS3DE::BodyState p_state) const;
 
-	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint) { constraints.insert(p_constraint); }
-	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraints.erase(p_constraint); }
+	void add_constraint(GodotConstraint3D *p_constraint);
+	void remove_constraint(GodotConstraint3D *p_constraint);
 	_FORCE_INLINE_ const HashSet<GodotConstraint3D *> &get_constraints() const { return constraints; }
 	_FORCE_INLINE_ void clear_constraints() { constraints.clear(); }
 
@@ -1091,10 +1091,16 @@ const SelfList<GodotBody3D>::List &GodotSpace3D::get_active_body_list() const {
 
 void GodotSpace3D::body_add_to_active_list(SelfList<GodotBody3D> *p_body) {
 	active_list.add(p_body);
+	invalidate_body_island(p_body->self());
 }
 
 void GodotSpace3D::body_remove_from_active_list(SelfList<GodotBody3D> *p_body) {
 	active_list.remove(p_body);
+	invalidate_body_island(p_body->self());
+}
+
+const SelfList<GodotBody3D>::List &GodotSpace3D::get_mass_properties_update_list() const {
+	return mass_properties_update_list;
 }
 
 void GodotSpace3D::body_add_to_mass_properties_update_list(SelfList<GodotBody3D> *p_body) {
@@ -1112,11 +1118,25 @@ GodotBroadPhase3D *GodotSpace3D::get_broadphase() {
 void GodotSpace3D::add_object(GodotCollisionObject3D *p_object) {
 	ERR_FAIL_COND(objects.has(p_object));
 	objects.insert(p_object);
+	if (p_object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+		GodotBody3D *body = static_cast<GodotBody3D *>(p_object);
+		body->set_island_index(UINT32_MAX);
+		invalidate_body_island(body);
+	} else if (p_object->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
+		invalidate_islands();
+	}
 }
 
 void GodotSpace3D::remove_object(GodotCollisionObject3D *p_object) {
 	ERR_FAIL_COND(!objects.has(p_object));
 	objects.erase(p_object);
+	if (p_object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+		GodotBody3D *body = static_cast<GodotBody3D *>(p_object);
+		invalidate_body_island(body);
+		body->set_island_index(UINT32_MAX);
+	} else if (p_object->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
+		invalidate_islands();
+	}
 }
 
 const HashSet<GodotCollisionObject3D *> &GodotSpace3D::get_objects() const {
@@ -1157,10 +1177,22 @@ const SelfList<GodotSoftBody3D>::List &GodotSpace3D::get_active_soft_body_list()
 
 void GodotSpace3D::soft_body_add_to_active_list(SelfList<GodotSoftBody3D> *p_soft_body) {
 	active_soft_body_list.add(p_soft_body);
+	invalidate_islands();
 }
 
 void GodotSpace3D::soft_body_remove_from_active_list(SelfList<GodotSoftBody3D> *p_soft_body) {
 	active_soft_body_list.remove(p_soft_body);
+	invalidate_islands();
+}
+
+void GodotSpace3D::invalidate_body_island(GodotBody3D *p_body) {
+	// Only the island the body was in needs to be regenerated, along with any island
+	// the active bodies without one end up in.
+	uint32_t index = p_body->get_island_index();
+	if (index < island_cache.islands.size()) {
+		island_cache.islands[index].dirty = true;
+	}
+	island_cache.dirty = true;
 }
 
 void GodotSpace3D::call_queries() {
@@ -1179,10 +1211,9 @@ void GodotSpace3D::call_queries() {
 
 void GodotSpace3D::setup() {
 	contact_debug_count = 0;
-	while (mass_properties_update_list.first()) {
-		mass_properties_update_list.first()->self()->update_mass_properties();
-		mass_properties_update_list.remove(mass_properties_update_list.first());
-	}
+
+	// The step has already updated the mass properties of these bodies.
+	mass_properties_update_list.clear();
 }
 
 void GodotSpace3D::update() {
@@ -36,6 +36,7 @@
 #include "godot_collision_object_3d.h"
 #include "godot_soft_body_3d.h"
 
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 #include "servers/physics_3d/direct_states/physics_direct_space_state_3d.h"
 
@@ -60,6 +61,7 @@ class GodotSpace3D {
 public:
 	enum ElapsedTime {
 		ELAPSED_TIME_INTEGRATE_FORCES,
+		ELAPSED_TIME_BROADPHASE,
 		ELAPSED_TIME_GENERATE_ISLANDS,
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
@@ -68,6 +70,23 @@ public:
 
 	};
 
+	// Islands built for the active bodies, kept between steps. Changes to the constraints
+	// of a body, or to whether it's active, only mark its own island for regeneration.
+	struct Island {
+		LocalVector<GodotBody3D *> bodies; // Only rigid bodies, which are tested for sleeping.
+		LocalVector<GodotConstraint3D *> constraints;
+		bool used = false;
+		bool dirty = false; // Regenerated on the next step.
+	};
+
+	struct IslandCache {
+		uint64_t version = 0; // Everything is regenerated when this doesn't match the space.
+		bool dirty = false; // Some islands are dirty, or some active bodies aren't in an island yet.
+		LocalVector<Island> islands;
+		LocalVector<uint32_t> free_islands;
+		uint32_t generated_island_count = 0; // During the last step.
+	};
+
 private:
 	uint64_t elapsed_time[ELAPSED_TIME_MAX] = {};
 
@@ -112,6 +131,9 @@ private:
 	real_t last_step = 0.001;
 
 	int island_count = 0;
+	uint64_t island_version = 1;
+	IslandCache island_cache;
+
 	int active_objects = 0;
 	int collision_pairs = 0;
 
@@ -134,6 +156,7 @@ public:
 	const SelfList<GodotBody3D>::List &get_active_body_list() const;
 	void body_add_to_active_list(SelfList<GodotBody3D> *p_body);
 	void body_remove_from_active_list(SelfList<GodotBody3D> *p_body);
+	const SelfList<GodotBody3D>::List &get_mass_properties_update_list() const;
 	void body_add_to_mass_properties_update_list(SelfList<GodotBody3D> *p_body);
 	void body_remove_from_mass_properties_update_list(SelfList<GodotBody3D> *p_body);
 
@@ -182,6 +205,11 @@ public:
 	void set_island_count(int p_island_count) { island_count = p_island_count; }
 	int get_island_count() const { return island_count; }
 
+	_FORCE_INLINE_ void invalidate_islands() { island_version++; }
+	void invalidate_body_island(GodotBody3D *p_body);
+	_FORCE_INLINE_ uint64_t get_island_version() const { return island_version; }
+	_FORCE_INLINE_ IslandCache &get_island_cache() { return island_cache; }
+
 	void set_active_objects(int p_active_objects) { active_objects = p_active_objects; }
 	int get_active_objects() const { return active_objects; }
 
@@ -35,14 +35,14 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
-#define BODY_ISLAND_COUNT_RESERVE 128
 #define BODY_ISLAND_SIZE_RESERVE 512
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
-void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
+void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island, uint32_t p_island_index) {
 	p_body->set_island_step(_step);
+	p_body->set_island_index(p_island_index);
 
 	if (p_body->get_mode() > PS3DE::BODY_MODE_KINEMATIC) {
 		// Only rigid bodies are tested for activation.
@@ -57,8 +57,6 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 		constraint->set_island_step(_step);
 		p_constraint_island.push_back(constraint);
 
-		all_constraints.push_back(constraint);
-
 		// Find connected rigid bodies.
 		for (int i = 0; i < constraint->get_body_count(); i++) {
 			if (i == E.value) {
@@ -71,7 +69,7 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 			if (other_body->get_mode() == PS3DE::BODY_MODE_STATIC) {
 				continue; // Static bodies don't connect islands.
 			}
-			_populate_island(other_body, p_body_island, p_constraint_island);
+			_populate_island(other_body, p_body_island, p_constraint_island, p_island_index);
 		}
 
 		// Find connected soft bodies.
@@ -80,12 +78,12 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 			if (soft_body->get_island_step() == _step) {
 				continue; // Already processed.
 			}
-			_populate_island_soft_body(soft_body, p_body_island, p_constraint_island);
+			_populate_island_soft_body(soft_body, p_body_island, p_constraint_island, p_island_index);
 		}
 	}
 }
 
-void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
+void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island, uint32_t p_island_index) {
 	p_soft_body->set_island_step(_step);
 
 	for (GodotConstraint3D *E : p_soft_body->get_constraints()) {
@@ -96,8 +94,6 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 		constraint->set_island_step(_step);
 		p_constraint_island.push_back(constraint);
 
-		all_constraints.push_back(constraint);
-
 		// Find connected rigid bodies.
 		for (int i = 0; i < constraint->get_body_count(); i++) {
 			GodotBody3D *body = constraint->get_body_ptr()[i];
@@ -107,11 +103,96 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 			if (body->get_mode() == PS3DE::BODY_MODE_STATIC) {
 				continue; // Static bodies don't connect islands.
 			}
-			_populate_island(body, p_body_island, p_constraint_island);
+			_populate_island(body, p_body_island, p_constraint_island, p_island_index);
+		}
+	}
+}
+
+uint32_t GodotStep3D::_alloc_island(GodotSpace3D::IslandCache &r_island_cache) {
+	uint32_t index;
+	if (!r_island_cache.free_islands.is_empty()) {
+		index = r_island_cache.free_islands[r_island_cache.free_islands.size() - 1];
+		r_island_cache.free_islands.resize(r_island_cache.free_islands.size() - 1);
+	} else {
+		index = r_island_cache.islands.size();
+		r_island_cache.islands.resize(index + 1);
+		r_island_cache.islands[index].bodies.reserve(BODY_ISLAND_SIZE_RESERVE);
+		r_island_cache.islands[index].constraints.reserve(ISLAND_SIZE_RESERVE);
+	}
+	r_island_cache.islands[index].used = true;
+	r_island_cache.generated_island_count++;
+	return index;
+}
+
+void GodotStep3D::_free_island(GodotSpace3D::IslandCache &r_island_cache, uint32_t p_index) {
+	GodotSpace3D::Island &island = r_island_cache.islands[p_index];
+	island.bodies.clear();
+	island.constraints.clear();
+	island.used = false;
+	r_island_cache.free_islands.push_back(p_index);
+}
+
+void GodotStep3D::_generate_islands(const SelfList<GodotBody3D>::List &p_body_list, const SelfList<GodotSoftBody3D>::List &p_soft_body_list, GodotSpace3D::IslandCache &r_island_cache, bool p_regenerate_all) {
+	LocalVector<GodotSpace3D::Island> &islands = r_island_cache.islands;
+
+	for (uint32_t island_index = 0; island_index < islands.size(); ++island_index) {
+		GodotSpace3D::Island &island = islands[island_index];
+		if (island.used && (island.dirty || p_regenerate_all)) {
+			_free_island(r_island_cache, island_index);
+		}
+		island.dirty = false;
+	}
+
+	/* RIGID BODIES */
+
+	// Islands are only regenerated from the active bodies that lost theirs, so the other islands stay untouched.
+	// Those are gathered first, because the islands they reference may be reused while regenerating.
+	island_seeds.clear();
+	for (const SelfList<GodotBody3D> *b = p_body_list.first(); b; b = b->next()) {
+		GodotBody3D *body = b->self();
+		uint32_t index = body->get_island_index();
+		if (index >= islands.size() || !islands[index].used) {
+			island_seeds.push_back(body);
+		}
+	}
+
+	for (GodotBody3D *body : island_seeds) {
+		if (body->get_island_step() != _step) {
+			uint32_t island_index = _alloc_island(r_island_cache);
+			GodotSpace3D::Island &island = islands[island_index];
+
+			_populate_island(body, island.bodies, island.constraints, island_index);
+
+			if (island.bodies.is_empty() && island.constraints.is_empty()) {
+				_free_island(r_island_cache, island_index);
+			}
+		}
+	}
+
+	/* SOFT BODIES */
+
+	// Soft bodies don't remember their island, so they're only used when regenerating everything.
+	if (p_regenerate_all) {
+		for (const SelfList<GodotSoftBody3D> *sb = p_soft_body_list.first(); sb; sb = sb->next()) {
+			GodotSoftBody3D *soft_body = sb->self();
+			if (soft_body->get_island_step() != _step) {
+				uint32_t island_index = _alloc_island(r_island_cache);
+				GodotSpace3D::Island &island = islands[island_index];
+
+				_populate_island_soft_body(soft_body, island.bodies, island.constraints, island_index);
+
+				if (island.bodies.is_empty() && island.constraints.is_empty()) {
+					_free_island(r_island_cache, island_index);
+				}
+			}
 		}
 	}
 }
 
+void GodotStep3D::_update_mass_properties(uint32_t p_body_index, void *p_userdata) {
+	mass_properties_bodies[p_body_index]->update_mass_properties();
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -158,34 +239,69 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
-void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep3D::_sleep_test_island(uint32_t p_island_index, const GodotSpace3D::IslandCache *p_island_cache) {
+	const LocalVector<GodotBody3D *> &body_island = p_island_cache->islands[p_island_index].bodies;
+
 	bool can_sleep = true;
 
-	uint32_t body_count = p_body_island.size();
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody3D *body = p_body_island[body_index];
+		GodotBody3D *body = body_island[body_index];
 
 		if (!body->sleep_test(delta)) {
 			can_sleep = false;
 		}
 	}
 
+	body_island_can_sleep[p_island_index] = can_sleep;
+}
+
+void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island, bool p_can_sleep) const {
 	// Put all to sleep or wake up everyone.
+	uint32_t body_count = p_body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
 		GodotBody3D *body = p_body_island[body_index];
 
 		bool active = body->is_active();
 
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
+		if (active == p_can_sleep) {
+			body->set_active(!p_can_sleep);
 		}
 	}
 }
 
+void GodotStep3D::_gather_active_bodies(const SelfList<GodotBody3D>::List &p_body_list) {
+	active_bodies.clear();
+	for (const SelfList<GodotBody3D> *b = p_body_list.first(); b; b = b->next()) {
+		active_bodies.push_back(b->self());
+	}
+}
+
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
-	p_space->setup(); //update inertias, etc
+	WorkerThreadPool *pool = thread_pool ? thread_pool : WorkerThreadPool::get_singleton();
+
+	/* UPDATE MASS PROPERTIES */
+
+	// Each body only reads its own shapes, so this can run on threads.
+	mass_properties_bodies.clear();
+	for (const SelfList<GodotBody3D> *b = p_space->get_mass_properties_update_list().first(); b; b = b->next()) {
+		mass_properties_bodies.push_back(b->self());
+	}
+
+	WorkerThreadPool::GroupID group_task = pool->add_template_group_task(this, &GodotStep3D::_update_mass_properties, nullptr, mass_properties_bodies.size(), -1, true, SNAME("Physics3DUpdateMassProperties"));
+	pool->wait_for_group_task_completion(group_task);
+
+	p_space->setup(); // Clears the mass properties update list.
 
 	p_space->set_last_step(p_delta);
 
@@ -201,17 +317,20 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_gather_active_bodies(*body_list);
+	int active_count = active_bodies.size();
 
-	const SelfList<GodotBody3D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	group_task = pool->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateForces"));
+	pool->wait_for_group_task_completion(group_task);
+
+	// Moving shapes in the broadphase isn't thread-safe.
+	for (GodotBody3D *body : active_bodies) {
+		body->finish_integrate_forces();
 	}
 
 	/* UPDATE SOFT BODY MOTION */
 
+	// WARNING: This doesn't run on threads, because it updates the broadphase directly.
 	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
 	while (sb) {
 		sb->self()->predict_motion(p_delta);
@@ -221,19 +340,64 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	p_space->set_active_objects(active_count);
 
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
 	// Update the broadphase to register collision pairs.
+	// WARNING: This doesn't run on threads, because the pair callbacks create and destroy constraints.
 	p_space->update();
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_BROADPHASE, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
+	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID AND SOFT BODIES */
+
+	// WARNING: Generating islands doesn't run on threads, because the flood fill marks shared bodies and constraints.
+	// Islands only change when constraints are added or removed, or when the set of active bodies changes,
+	// so they are kept in the space between steps and only the ones affected by those changes are regenerated.
+	// Soft bodies, and body mode changes, which can merge or split any number of islands, regenerate all of them.
+	GodotSpace3D::IslandCache &island_cache = p_space->get_island_cache();
+	island_cache.generated_island_count = 0;
+	bool regenerate_all = island_cache.version != p_space->get_island_version() || (island_cache.dirty && soft_body_list->first());
+	if (regenerate_all || island_cache.dirty) {
+		_generate_islands(*body_list, *soft_body_list, island_cache, regenerate_all);
+		island_cache.version = p_space->get_island_version();
+		island_cache.dirty = false;
+	}
 
+	// Constraint islands are modified while solving, so work on a copy.
 	uint32_t island_count = 0;
 
+	for (const GodotSpace3D::Island &cached_island : island_cache.islands) {
+		if (cached_island.constraints.is_empty()) {
+			continue;
+		}
+
+		++island_count;
+		if (constraint_islands.size() < island_count) {
+			constraint_islands.resize(island_count);
+		}
+		LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
+		constraint_island.clear();
+
+		for (GodotConstraint3D *constraint : cached_island.constraints) {
+			constraint->set_island_step(_step);
+			constraint_island.push_back(constraint);
+			all_constraints.push_back(constraint);
+		}
+	}
+
+	// Unused islands have no bodies, so testing them is a no-op.
+	uint32_t body_island_count = island_cache.islands.size();
+
+	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
+
 	const SelfList<GodotArea3D>::List &aml = p_space->get_moved_area_list();
 
 	while (aml.first()) {
@@ -258,81 +422,6 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
-
-	b = body_list->first();
-
-	uint32_t body_island_count = 0;
-
-	while (b) {
-		GodotBody3D *body = b->self();
-
-		if (body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
-
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island(body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
-
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
-		}
-		b = b->next();
-	}
-
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
-
-	sb = soft_body_list->first();
-	while (sb) {
-		GodotSoftBody3D *soft_body = sb->self();
-
-		if (soft_body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
-
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island_soft_body(soft_body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
-
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
-		}
-		sb = sb->next();
-	}
-
 	p_space->set_island_count((int)island_count);
 
 	{ //profile
@@ -344,8 +433,8 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	group_task = pool->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	pool->wait_for_group_task_completion(group_task);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -364,8 +453,8 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	group_task = pool->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+	pool->wait_for_group_task_completion(group_task);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -375,17 +464,25 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	// Solving may have woken up more bodies.
+	_gather_active_bodies(*body_list);
+
+	group_task = pool->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateVelocities"));
+	pool->wait_for_group_task_completion(group_task);
+
+	// This can deactivate bodies and touches the broadphase, so it's not thread-safe.
+	for (GodotBody3D *body : active_bodies) {
+		body->finish_integrate_velocities();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
 
+	body_island_can_sleep.resize(body_island_count);
+	group_task = pool->add_template_group_task(this, &GodotStep3D::_sleep_test_island, (const GodotSpace3D::IslandCache *)&island_cache, body_island_count, -1, true, SNAME("Physics3DSleepTestIslands"));
+	pool->wait_for_group_task_completion(group_task);
+
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		_check_suspend(island_cache.islands[island_index].bodies, body_island_can_sleep[island_index]);
 	}
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
@@ -408,8 +505,8 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	_step++;
 }
 
-GodotStep3D::GodotStep3D() {
-	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
+GodotStep3D::GodotStep3D(WorkerThreadPool *p_thread_pool) {
+	thread_pool = p_thread_pool;
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
 }
@@ -0,0 +1,203 @@
+/**************************************************************************/
+/*  test_godot_step_3d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_3d.h"
+#include "../godot_step_3d.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "tests/test_macros.h"
+
+namespace TestGodotStep3D {
+
+struct TestScene {
+	RID space;
+	RID floor_shape;
+	RID box_shape;
+	RID floor;
+	LocalVector<RID> boxes;
+};
+
+static GodotSpace3D *get_space(RID p_space) {
+	GodotPhysicsDirectSpaceState3D *direct_state = Object::cast_to<GodotPhysicsDirectSpaceState3D>(PhysicsServer3D::get_singleton()->space_get_direct_state(p_space));
+	return direct_state ? direct_state->space : nullptr;
+}
+
+// Stacks of boxes dropped on a shared floor, so there are both several islands and several constraints per island.
+static void create_scene(TestScene &r_scene, int p_stacks, int p_stack_height) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+	r_scene.space = ps->space_create();
+	ps->area_set_param(r_scene.space, PS3DE::AREA_PARAM_GRAVITY, 9.8);
+	ps->area_set_param(r_scene.space, PS3DE::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+
+	r_scene.floor_shape = ps->box_shape_create();
+	ps->shape_set_data(r_scene.floor_shape, Vector3(100, 1, 100));
+	r_scene.floor = ps->body_create();
+	ps->body_set_mode(r_scene.floor, PS3DE::BODY_MODE_STATIC);
+	ps->body_add_shape(r_scene.floor, r_scene.floor_shape);
+	ps->body_set_space(r_scene.floor, r_scene.space);
+
+	r_scene.box_shape = ps->box_shape_create();
+	ps->shape_set_data(r_scene.box_shape, Vector3(0.5, 0.5, 0.5));
+	for (int i = 0; i < p_stacks; i++) {
+		for (int j = 0; j < p_stack_height; j++) {
+			RID box = ps->body_create();
+			ps->body_add_shape(box, r_scene.box_shape);
+			ps->body_set_state(box, PS3DE::BODY_STATE_TRANSFORM, Transform3D(Basis::from_euler(Vector3(0.1 * j, 0.2 * i, 0)), Vector3(i * 4.0 - 40.0, 2.0 + j * 1.1, 0)));
+			ps->body_set_space(box, r_scene.space);
+			r_scene.boxes.push_back(box);
+		}
+	}
+}
+
+static void free_scene(TestScene &p_scene) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	for (const RID &box : p_scene.boxes) {
+		ps->free_rid(box);
+	}
+	ps->free_rid(p_scene.floor);
+	ps->free_rid(p_scene.box_shape);
+	ps->free_rid(p_scene.floor_shape);
+	ps->free_rid(p_scene.space);
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D] Stepping on threads gives the same result as stepping serially") {
+	if (!Object::cast_to<GodotPhysicsServer3D>(PhysicsServer3D::get_singleton())) {
+		return;
+	}
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+	// With a single thread, the pool runs the elements of every group task one after the other.
+	WorkerThreadPool *serial_pool = memnew(WorkerThreadPool(false));
+	serial_pool->init(1);
+	GodotStep3D serial_step(serial_pool);
+	GodotStep3D threaded_step;
+
+	TestScene serial_scene;
+	TestScene threaded_scene;
+	create_scene(serial_scene, 16, 3);
+	create_scene(threaded_scene, 16, 3);
+
+	GodotSpace3D *serial_space = get_space(serial_scene.space);
+	GodotSpace3D *threaded_space = get_space(threaded_scene.space);
+	REQUIRE(serial_space);
+	REQUIRE(threaded_space);
+
+	bool all_equal = true;
+	for (int frame = 0; frame < 120; frame++) {
+		serial_step.step(serial_space, 1.0 / 60.0);
+		threaded_step.step(threaded_space, 1.0 / 60.0);
+
+		for (uint32_t i = 0; i < serial_scene.boxes.size(); i++) {
+			Transform3D serial_transform = ps->body_get_state(serial_scene.boxes[i], PS3DE::BODY_STATE_TRANSFORM);
+			Transform3D threaded_transform = ps->body_get_state(threaded_scene.boxes[i], PS3DE::BODY_STATE_TRANSFORM);
+			Vector3 serial_velocity = ps->body_get_state(serial_scene.boxes[i], PS3DE::BODY_STATE_LINEAR_VELOCITY);
+			Vector3 threaded_velocity = ps->body_get_state(threaded_scene.boxes[i], PS3DE::BODY_STATE_LINEAR_VELOCITY);
+			if (serial_transform != threaded_transform || serial_velocity != threaded_velocity) {
+				all_equal = false;
+			}
+		}
+	}
+	CHECK(all_equal);
+	CHECK(serial_space->get_island_count() == threaded_space->get_island_count());
+
+	// The boxes should have landed, so the scene wasn't trivially at rest.
+	Transform3D landed = ps->body_get_state(threaded_scene.boxes[0], PS3DE::BODY_STATE_TRANSFORM);
+	CHECK(landed.origin.y < 2.0);
+
+	free_scene(serial_scene);
+	free_scene(threaded_scene);
+	serial_pool->finish();
+	memdelete(serial_pool);
+}
+
+TEST_CASE("[SceneTree][GodotPhysics3D] Islands are only regenerated for changed bodies") {
+	if (!Object::cast_to<GodotPhysicsServer3D>(PhysicsServer3D::get_singleton())) {
+		return;
+	}
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+	GodotStep3D step;
+	TestScene scene;
+	create_scene(scene, 4, 3);
+	for (const RID &box : scene.boxes) {
+		// Keep the bodies active, so the islands are still needed after the stacks settle.
+		ps->body_set_state(box, PS3DE::BODY_STATE_CAN_SLEEP, false);
+	}
+
+	GodotSpace3D *space = get_space(scene.space);
+	REQUIRE(space);
+	const GodotSpace3D::IslandCache &island_cache = space->get_island_cache();
+
+	for (int frame = 0; frame < 120; frame++) {
+		step.step(space, 1.0 / 60.0);
+	}
+	int island_count = space->get_island_count();
+	CHECK(island_count == 4);
+
+	SUBCASE("A static scene reuses all of its islands") {
+		bool reused = true;
+		for (int frame = 0; frame < 30; frame++) {
+			step.step(space, 1.0 / 60.0);
+			if (island_cache.generated_island_count != 0) {
+				reused = false;
+			}
+		}
+		CHECK(reused);
+		CHECK(space->get_island_count() == island_count);
+	}
+
+	SUBCASE("Dropping a box on a stack only regenerates the islands it touches") {
+		RID box = ps->body_create();
+		ps->body_add_shape(box, scene.box_shape);
+		ps->body_set_state(box, PS3DE::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(-40.0, 6.0, 0)));
+		ps->body_set_state(box, PS3DE::BODY_STATE_CAN_SLEEP, false);
+		ps->body_set_space(box, scene.space);
+		scene.boxes.push_back(box);
+
+		step.step(space, 1.0 / 60.0);
+		CHECK(island_cache.generated_island_count == 1);
+
+		uint32_t max_generated_island_count = 0;
+		for (int frame = 0; frame < 120; frame++) {
+			step.step(space, 1.0 / 60.0);
+			max_generated_island_count = MAX(max_generated_island_count, island_cache.generated_island_count);
+		}
+		CHECK(max_generated_island_count == 1);
+		// The box landed on the first stack and merged with its island.
+		CHECK(space->get_island_count() == island_count);
+	}
+
+	free_scene(scene);
+}
+
+} // namespace TestGodotStep3D
@@ -54,8 +54,11 @@ void EditorNetworkProfiler::_notification(int p_what) {
 			down_label->set_text(TTR("Down", "Network"));
 			// TRANSLATORS: This is the label for the network profiler's outgoing bandwidth.
 			up_label->set_text(TTR("Up", "Network"));
+			// TRANSLATORS: This is the label for the average replication data sent to each peer on each network tick.
+			peer_replication_label->set_text(TTR("Sync per Peer", "Network"));
 
 			set_bandwidth(incoming_bandwidth, outgoing_bandwidth);
+			peer_replication_text->set_text(vformat(TTR("%s/tick"), String::humanize_size(peer_replication_size)));
 
 			if (is_ready()) {
 				refresh_rpc_data();
@@ -239,6 +242,7 @@ void EditorNetworkProfiler::_clear_pressed() {
 	node_data.clear();
 	missing_node_data.clear();
 	set_bandwidth(0, 0);
+	set_peer_replication_data(Vector<PeerReplicationInfo>());
 	refresh_rpc_data();
 	refresh_replication_data();
 	clear_button->set_disabled(true);
@@ -314,6 +318,17 @@ void EditorNetworkProfiler::set_bandwidth(int p_incoming, int p_outgoing) {
 			theme_cache.outgoing_bandwidth_color * Color(1, 1, 1, p_outgoing > 0 ? 1 : 0.5));
 }
 
+void EditorNetworkProfiler::set_peer_replication_data(const Vector<PeerReplicationInfo> &p_infos) {
+	int64_t size = 0;
+	int64_t ticks = 0;
+	for (const PeerReplicationInfo &info : p_infos) {
+		size += info.outgoing_size;
+		ticks += info.ticks;
+	}
+	peer_replication_size = ticks ? int(size / ticks) : 0;
+	peer_replication_text->set_text(vformat(TTR("%s/tick"), String::humanize_size(peer_replication_size)));
+}
+
 bool EditorNetworkProfiler::is_profiling() {
 	return activate->is_pressed();
 }
@@ -379,6 +394,23 @@ EditorNetworkProfiler::EditorNetworkProfiler() {
 	outgoing_bandwidth_text->set_accessibility_name(TTRC("Outgoing Bandwidth"));
 	hb->add_child(outgoing_bandwidth_text);
 
+	Control *up_peer_spacer = memnew(Control);
+	up_peer_spacer->set_custom_minimum_size(Size2(30, 0) * EDSCALE);
+	hb->add_child(up_peer_spacer);
+
+	peer_replication_label = memnew(Label);
+	peer_replication_label->set_focus_mode(FOCUS_ACCESSIBILITY);
+	peer_replication_label->set_auto_translate_mode(AUTO_TRANSLATE_MODE_DISABLED);
+	hb->add_child(peer_replication_label);
+
+	peer_replication_text = memnew(LineEdit);
+	peer_replication_text->set_editable(false);
+	peer_replication_text->set_custom_minimum_size(Size2(120, 0) * EDSCALE);
+	peer_replication_text->set_horizontal_alignment(HORIZONTAL_ALIGNMENT_RIGHT);
+	peer_replication_text->set_tooltip_text(TTRC("Average replication data sent to each peer on each network tick."));
+	peer_replication_text->set_accessibility_name(TTRC("Sync per Peer"));
+	hb->add_child(peer_replication_text);
+
 	HSplitContainer *sc = memnew(HSplitContainer);
 	add_child(sc);
 	sc->set_v_size_flags(SIZE_EXPAND_FILL);
@@ -59,6 +59,7 @@ public:
 private:
 	using RPCNodeInfo = MultiplayerDebugger::RPCNodeInfo;
 	using SyncInfo = MultiplayerDebugger::SyncInfo;
+	using PeerReplicationInfo = MultiplayerDebugger::PeerReplicationInfo;
 
 	bool dirty = false;
 	Timer *refresh_timer = nullptr;
@@ -67,13 +68,16 @@ private:
 	Tree *counters_display = nullptr;
 	LineEdit *incoming_bandwidth_text = nullptr;
 	LineEdit *outgoing_bandwidth_text = nullptr;
+	LineEdit *peer_replication_text = nullptr;
 	Tree *replication_display = nullptr;
 
 	Label *up_label = nullptr;
 	Label *down_label = nullptr;
+	Label *peer_replication_label = nullptr;
 
 	int incoming_bandwidth = 0;
 	int outgoing_bandwidth = 0;
+	int peer_replication_size = 0;
 
 	HashMap<ObjectID, RPCNodeInfo> rpc_data;
 	HashMap<ObjectID, SyncInfo> sync_data;
@@ -118,6 +122,7 @@ public:
 	void add_rpc_frame_data(const RPCNodeInfo &p_frame);
 	void add_sync_frame_data(const SyncInfo &p_frame);
 	void set_bandwidth(int p_incoming, int p_outgoing);
+	void set_peer_replication_data(const Vector<PeerReplicationInfo> &p_infos);
 	bool is_profiling();
 
 	void set_profiling(bool p_pressed);
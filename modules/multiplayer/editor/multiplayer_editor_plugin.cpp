@@ -74,6 +74,11 @@ bool MultiplayerEditorDebugger::capture(const String &p_message, const Array &p_
 			get_session(p_session)->send_message("multiplayer:cache", missing);
 		}
 		return true;
+	} else if (p_message == "multiplayer:sync_peers") {
+		MultiplayerDebugger::PeerReplicationFrame frame;
+		frame.deserialize(p_data);
+		profiler->set_peer_replication_data(frame.infos);
+		return true;
 	} else if (p_message == "multiplayer:cache") {
 		ERR_FAIL_COND_V(p_data.size() % 3, false);
 		for (int i = 0; i < p_data.size(); i += 3) {
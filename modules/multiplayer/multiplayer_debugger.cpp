@@ -292,13 +292,48 @@ bool MultiplayerDebugger::ReplicationFrame::deserialize(const Array &p_arr) {
 	return true;
 }
 
+Array MultiplayerDebugger::PeerReplicationFrame::serialize() {
+	Array arr = { infos.size() * 3 };
+	for (int i = 0; i < infos.size(); ++i) {
+		arr.push_back(infos[i].peer);
+		arr.push_back(infos[i].ticks);
+		arr.push_back(infos[i].outgoing_size);
+	}
+	return arr;
+}
+
+bool MultiplayerDebugger::PeerReplicationFrame::deserialize(const Array &p_arr) {
+	ERR_FAIL_COND_V(p_arr.is_empty(), false);
+	uint32_t size = p_arr[0];
+	ERR_FAIL_COND_V(size % 3, false);
+	ERR_FAIL_COND_V((uint32_t)p_arr.size() != size + 1, false);
+	infos.resize(size / 3);
+	int idx = 1;
+	for (uint32_t i = 0; i < size / 3; i++) {
+		infos.write[i].peer = p_arr[idx];
+		infos.write[i].ticks = p_arr[idx + 1];
+		infos.write[i].outgoing_size = p_arr[idx + 2];
+		idx += 3;
+	}
+	return true;
+}
+
 void MultiplayerDebugger::ReplicationProfiler::toggle(bool p_enable, const Array &p_opts) {
 	sync_data.clear();
+	peer_data.clear();
 }
 
 void MultiplayerDebugger::ReplicationProfiler::add(const Array &p_data) {
 	ERR_FAIL_COND(p_data.size() != 3);
 	const String what = p_data[0];
+	if (what == "peer_out") {
+		const int peer = p_data[1];
+		PeerReplicationInfo &info = peer_data[peer];
+		info.peer = peer;
+		info.ticks++;
+		info.outgoing_size += int(p_data[2]);
+		return;
+	}
 	const ObjectID id = p_data[1];
 	const uint64_t size = p_data[2];
 	MultiplayerSynchronizer *sync = ObjectDB::get_instance<MultiplayerSynchronizer>(id);
@@ -326,5 +361,14 @@ void MultiplayerDebugger::ReplicationProfiler::tick(double p_frame_time, double
 		}
 		sync_data.clear();
 		EngineDebugger::get_singleton()->send_message("multiplayer:syncs", frame.serialize());
+
+		if (!peer_data.is_empty()) {
+			PeerReplicationFrame peer_frame;
+			for (const KeyValue<int, PeerReplicationInfo> &E : peer_data) {
+				peer_frame.infos.push_back(E.value);
+			}
+			peer_data.clear();
+			EngineDebugger::get_singleton()->send_message("multiplayer:sync_peers", peer_frame.serialize());
+		}
 	}
 }
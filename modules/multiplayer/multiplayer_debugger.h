@@ -75,6 +75,20 @@ public:
 		bool deserialize(const Array &p_arr);
 	};
 
+	// Replication data sent to a peer during the ticks of a frame.
+	struct PeerReplicationInfo {
+		int peer = 0;
+		int ticks = 0;
+		int outgoing_size = 0;
+	};
+
+	struct PeerReplicationFrame {
+		Vector<PeerReplicationInfo> infos;
+
+		Array serialize();
+		bool deserialize(const Array &p_arr);
+	};
+
 private:
 	class BandwidthProfiler : public EngineProfiler {
 		GDSOFTCLASS(BandwidthProfiler, EngineProfiler);
@@ -119,6 +133,7 @@ private:
 
 	private:
 		HashMap<ObjectID, SyncInfo> sync_data;
+		HashMap<int, PeerReplicationInfo> peer_data;
 		uint64_t last_profile_time = 0;
 
 	public:
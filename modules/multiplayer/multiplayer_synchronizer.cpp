@@ -32,8 +32,13 @@
 
 #include "core/config/engine.h"
 #include "core/object/class_db.h"
+#include "scene/2d/node_2d.h"
 #include "scene/main/multiplayer_api.h"
 
+#ifndef _3D_DISABLED
+#include "scene/3d/node_3d.h"
+#endif // _3D_DISABLED
+
 Object *MultiplayerSynchronizer::_get_prop_target(Object *p_obj, const NodePath &p_path) {
 	if (p_path.get_name_count() == 0) {
 		return p_obj;
@@ -268,12 +273,16 @@ void MultiplayerSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_visibility_for", "peer", "visible"), &MultiplayerSynchronizer::set_visibility_for);
 	ClassDB::bind_method(D_METHOD("get_visibility_for", "peer"), &MultiplayerSynchronizer::get_visibility_for);
 
+	ClassDB::bind_method(D_METHOD("set_spatial_interest_enabled", "enabled"), &MultiplayerSynchronizer::set_spatial_interest_enabled);
+	ClassDB::bind_method(D_METHOD("is_spatial_interest_enabled"), &MultiplayerSynchronizer::is_spatial_interest_enabled);
+
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_path"), "set_root_path", "get_root_path");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "replication_interval", PROPERTY_HINT_RANGE, "0,5,0.001,suffix:s"), "set_replication_interval", "get_replication_interval");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "delta_interval", PROPERTY_HINT_RANGE, "0,5,0.001,suffix:s"), "set_delta_interval", "get_delta_interval");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "replication_config", PROPERTY_HINT_RESOURCE_TYPE, SceneReplicationConfig::get_class_static(), PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_EDITOR_INSTANTIATE_OBJECT), "set_replication_config", "get_replication_config");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "visibility_update_mode", PROPERTY_HINT_ENUM, "Idle,Physics,None"), "set_visibility_update_mode", "get_visibility_update_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "public_visibility"), "set_visibility_public", "is_visibility_public");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "spatial_interest"), "set_spatial_interest_enabled", "is_spatial_interest_enabled");
 
 	BIND_ENUM_CONSTANT(VISIBILITY_PROCESS_IDLE);
 	BIND_ENUM_CONSTANT(VISIBILITY_PROCESS_PHYSICS);
@@ -404,6 +413,33 @@ Error MultiplayerSynchronizer::_watch_changes(uint64_t p_usec) {
 	return OK;
 }
 
+void MultiplayerSynchronizer::set_spatial_interest_enabled(bool p_enabled) {
+	spatial_interest = p_enabled;
+}
+
+bool MultiplayerSynchronizer::is_spatial_interest_enabled() const {
+	return spatial_interest;
+}
+
+bool MultiplayerSynchronizer::get_interest_position(Vector3 &r_position) {
+	Node *node = get_root_node();
+	if (!node) {
+		return false;
+	}
+#ifndef _3D_DISABLED
+	if (const Node3D *node_3d = Object::cast_to<Node3D>(node)) {
+		r_position = node_3d->get_global_position();
+		return true;
+	}
+#endif // _3D_DISABLED
+	if (const Node2D *node_2d = Object::cast_to<Node2D>(node)) {
+		const Vector2 position = node_2d->get_global_position();
+		r_position = Vector3(position.x, position.y, 0);
+		return true;
+	}
+	return false;
+}
+
 List<Variant> MultiplayerSynchronizer::get_delta_state(uint64_t p_cur_usec, uint64_t p_last_usec, uint64_t &r_indexes) {
 	r_indexes = 0;
 	List<Variant> out;
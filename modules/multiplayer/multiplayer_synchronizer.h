@@ -56,6 +56,7 @@ private:
 	uint64_t sync_interval_usec = 0;
 	uint64_t delta_interval_usec = 0;
 	VisibilityUpdateMode visibility_update_mode = VISIBILITY_PROCESS_IDLE;
+	bool spatial_interest = false;
 	HashSet<Callable> visibility_filters;
 	HashSet<int> peer_visibility;
 	Vector<Watcher> watchers;
@@ -116,6 +117,11 @@ public:
 	void remove_visibility_filter(Callable p_callback);
 	VisibilityUpdateMode get_visibility_update_mode() const;
 
+	void set_spatial_interest_enabled(bool p_enabled);
+	bool is_spatial_interest_enabled() const;
+	// Position of the root node used for spatial interest, false if it has none.
+	bool get_interest_position(Vector3 &r_position);
+
 	List<Variant> get_delta_state(uint64_t p_cur_usec, uint64_t p_last_usec, uint64_t &r_indexes);
 	List<NodePath> get_delta_properties(uint64_t p_indexes);
 	SceneReplicationConfig *get_replication_config_ptr() const;
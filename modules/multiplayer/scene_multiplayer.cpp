@@ -635,6 +635,30 @@ int SceneMultiplayer::get_max_delta_packet_size() const {
 	return replicator->get_max_delta_packet_size();
 }
 
+Error SceneMultiplayer::set_peer_interest(int p_peer, const Vector3 &p_position, real_t p_radius) {
+	return replicator->set_peer_interest(p_peer, p_position, p_radius);
+}
+
+void SceneMultiplayer::clear_peer_interest(int p_peer) {
+	replicator->clear_peer_interest(p_peer);
+}
+
+void SceneMultiplayer::set_interest_cell_size(real_t p_size) {
+	replicator->set_interest_cell_size(p_size);
+}
+
+real_t SceneMultiplayer::get_interest_cell_size() const {
+	return replicator->get_interest_cell_size();
+}
+
+void SceneMultiplayer::set_interest_max_tick_interval(int p_interval) {
+	replicator->set_interest_max_tick_interval(p_interval);
+}
+
+int SceneMultiplayer::get_interest_max_tick_interval() const {
+	return replicator->get_interest_max_tick_interval();
+}
+
 void SceneMultiplayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_root_path", "path"), &SceneMultiplayer::set_root_path);
 	ClassDB::bind_method(D_METHOD("get_root_path"), &SceneMultiplayer::get_root_path);
@@ -664,6 +688,13 @@ void SceneMultiplayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_max_delta_packet_size"), &SceneMultiplayer::get_max_delta_packet_size);
 	ClassDB::bind_method(D_METHOD("set_max_delta_packet_size", "size"), &SceneMultiplayer::set_max_delta_packet_size);
 
+	ClassDB::bind_method(D_METHOD("set_peer_interest", "peer", "position", "radius"), &SceneMultiplayer::set_peer_interest);
+	ClassDB::bind_method(D_METHOD("clear_peer_interest", "peer"), &SceneMultiplayer::clear_peer_interest);
+	ClassDB::bind_method(D_METHOD("get_interest_cell_size"), &SceneMultiplayer::get_interest_cell_size);
+	ClassDB::bind_method(D_METHOD("set_interest_cell_size", "size"), &SceneMultiplayer::set_interest_cell_size);
+	ClassDB::bind_method(D_METHOD("get_interest_max_tick_interval"), &SceneMultiplayer::get_interest_max_tick_interval);
+	ClassDB::bind_method(D_METHOD("set_interest_max_tick_interval", "interval"), &SceneMultiplayer::set_interest_max_tick_interval);
+
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_path"), "set_root_path", "get_root_path");
 	ADD_PROPERTY(PropertyInfo(Variant::CALLABLE, "auth_callback"), "set_auth_callback", "get_auth_callback");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "auth_timeout", PROPERTY_HINT_RANGE, "0,30,0.1,or_greater,suffix:s"), "set_auth_timeout", "get_auth_timeout");
@@ -672,6 +703,8 @@ void SceneMultiplayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_sync_packet_size"), "set_max_sync_packet_size", "get_max_sync_packet_size");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_delta_packet_size"), "set_max_delta_packet_size", "get_max_delta_packet_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "interest_cell_size", PROPERTY_HINT_RANGE, "0.01,1024,0.01,or_greater"), "set_interest_cell_size", "get_interest_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "interest_max_tick_interval", PROPERTY_HINT_RANGE, "1,60,1,or_greater"), "set_interest_max_tick_interval", "get_interest_max_tick_interval");
 
 	ADD_PROPERTY_DEFAULT("refuse_new_connections", false);
 
@@ -200,6 +200,15 @@ public:
 	void set_max_delta_packet_size(int p_size);
 	int get_max_delta_packet_size() const;
 
+	Error set_peer_interest(int p_peer, const Vector3 &p_position, real_t p_radius);
+	void clear_peer_interest(int p_peer);
+
+	void set_interest_cell_size(real_t p_size);
+	real_t get_interest_cell_size() const;
+
+	void set_interest_max_tick_interval(int p_interval);
+	int get_interest_max_tick_interval() const;
+
 	SceneMultiplayer();
 	~SceneMultiplayer();
 };
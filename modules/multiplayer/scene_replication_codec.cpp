@@ -0,0 +1,382 @@
+/**************************************************************************/
+/*  scene_replication_codec.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "scene_replication_codec.h"
+
+#include "scene/main/multiplayer_api.h"
+
+namespace {
+
+// Quantized values are clamped so that the differences between them fit in 64 bits.
+constexpr int64_t QUANTIZED_LIMIT = int64_t(1) << 52;
+
+struct BitWriter {
+	LocalVector<uint8_t> &buffer;
+	uint32_t bit_count = 0;
+
+	void write(uint64_t p_value, uint32_t p_bits) {
+		while (p_bits > 0) {
+			const uint32_t offset = bit_count & 7;
+			if (offset == 0) {
+				buffer.push_back(0);
+			}
+			const uint32_t count = MIN(8 - offset, p_bits);
+			buffer[buffer.size() - 1] |= uint8_t((p_value & ((1u << count) - 1)) << offset);
+			p_value >>= count;
+			p_bits -= count;
+			bit_count += count;
+		}
+	}
+
+	// Exponential-Golomb code, small values use few bits.
+	void write_unsigned(uint64_t p_value) {
+		const uint64_t value = p_value + 1;
+		uint32_t bits = 64;
+		while (!(value & (uint64_t(1) << (bits - 1)))) {
+			bits--;
+		}
+		write(0, bits - 1);
+		write(1, 1);
+		write(value, bits - 1);
+	}
+
+	void write_signed(int64_t p_value) {
+		write_unsigned((uint64_t(p_value) << 1) ^ uint64_t(p_value >> 63));
+	}
+
+	explicit BitWriter(LocalVector<uint8_t> &r_buffer) :
+			buffer(r_buffer) {}
+};
+
+struct BitReader {
+	const uint8_t *buffer = nullptr;
+	uint32_t bit_length = 0;
+	uint32_t bit_count = 0;
+	bool error = false;
+
+	uint64_t read(uint32_t p_bits) {
+		if (p_bits > bit_length - bit_count) {
+			error = true;
+			bit_count = bit_length;
+			return 0;
+		}
+		uint64_t value = 0;
+		uint32_t shift = 0;
+		while (p_bits > 0) {
+			const uint32_t offset = bit_count & 7;
+			const uint32_t count = MIN(8 - offset, p_bits);
+			value |= uint64_t((buffer[bit_count >> 3] >> offset) & ((1u << count) - 1)) << shift;
+			shift += count;
+			p_bits -= count;
+			bit_count += count;
+		}
+		return value;
+	}
+
+	uint64_t read_unsigned() {
+		uint32_t zeros = 0;
+		while (!error && read(1) == 0) {
+			zeros++;
+			if (zeros > 63) {
+				error = true;
+			}
+		}
+		if (error) {
+			return 0;
+		}
+		return ((uint64_t(1) << zeros) | read(zeros)) - 1;
+	}
+
+	int64_t read_signed() {
+		const uint64_t value = read_unsigned();
+		return int64_t(value >> 1) ^ -int64_t(value & 1);
+	}
+
+	BitReader(const uint8_t *p_buffer, int p_len) {
+		buffer = p_buffer;
+		bit_length = uint32_t(p_len) * 8;
+	}
+};
+
+int64_t quantize(double p_value, double p_step) {
+	const double value = Math::round(p_value / p_step);
+	if (!(value > -QUANTIZED_LIMIT)) {
+		// Also handles NaN.
+		return value < 0.0 ? -QUANTIZED_LIMIT : 0;
+	}
+	return value < QUANTIZED_LIMIT ? int64_t(value) : QUANTIZED_LIMIT;
+}
+
+} // namespace
+
+SceneReplicationCodec::QuantizedType SceneReplicationCodec::get_quantized_type(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::FLOAT:
+			return QUANTIZED_FLOAT;
+		case Variant::VECTOR2:
+			return QUANTIZED_VECTOR2;
+		case Variant::VECTOR3:
+			return QUANTIZED_VECTOR3;
+		case Variant::VECTOR4:
+			return QUANTIZED_VECTOR4;
+		case Variant::QUATERNION:
+			return QUANTIZED_QUATERNION;
+		case Variant::COLOR:
+			return QUANTIZED_COLOR;
+		default:
+			return QUANTIZED_NONE;
+	}
+}
+
+uint32_t SceneReplicationCodec::get_component_count(QuantizedType p_type) {
+	switch (p_type) {
+		case QUANTIZED_FLOAT:
+			return 1;
+		case QUANTIZED_VECTOR2:
+			return 2;
+		case QUANTIZED_VECTOR3:
+			return 3;
+		case QUANTIZED_VECTOR4:
+		case QUANTIZED_QUATERNION:
+		case QUANTIZED_COLOR:
+			return 4;
+		default:
+			return 0;
+	}
+}
+
+void SceneReplicationCodec::make_snapshot(const Vector<Variant> &p_values, const LocalVector<float> &p_quantization, Snapshot &r_snapshot) {
+	const uint32_t count = p_values.size();
+	r_snapshot.types.resize(count);
+	r_snapshot.components.resize(count * MAX_COMPONENTS);
+	r_snapshot.values.resize(count);
+	memset(r_snapshot.components.ptr(), 0, r_snapshot.components.size() * sizeof(int64_t));
+
+	for (uint32_t i = 0; i < count; i++) {
+		const Variant &value = p_values[i];
+		const QuantizedType type = i < p_quantization.size() && p_quantization[i] > 0.0f ? get_quantized_type(value.get_type()) : QUANTIZED_NONE;
+		r_snapshot.types[i] = type;
+		if (type == QUANTIZED_NONE) {
+			r_snapshot.values.write[i] = value;
+			continue;
+		}
+		r_snapshot.values.write[i] = Variant();
+
+		double components[MAX_COMPONENTS] = {};
+		switch (type) {
+			case QUANTIZED_FLOAT: {
+				components[0] = value.operator double();
+			} break;
+			case QUANTIZED_VECTOR2: {
+				const Vector2 v = value;
+				components[0] = v.x;
+				components[1] = v.y;
+			} break;
+			case QUANTIZED_VECTOR3: {
+				const Vector3 v = value;
+				components[0] = v.x;
+				components[1] = v.y;
+				components[2] = v.z;
+			} break;
+			case QUANTIZED_VECTOR4: {
+				const Vector4 v = value;
+				components[0] = v.x;
+				components[1] = v.y;
+				components[2] = v.z;
+				components[3] = v.w;
+			} break;
+			case QUANTIZED_QUATERNION: {
+				const Quaternion q = value;
+				components[0] = q.x;
+				components[1] = q.y;
+				components[2] = q.z;
+				components[3] = q.w;
+			} break;
+			case QUANTIZED_COLOR: {
+				const Color c = value;
+				components[0] = c.r;
+				components[1] = c.g;
+				components[2] = c.b;
+				components[3] = c.a;
+			} break;
+			default:
+				break;
+		}
+		for (uint32_t j = 0; j < MAX_COMPONENTS; j++) {
+			r_snapshot.components[i * MAX_COMPONENTS + j] = quantize(components[j], p_quantization[i]);
+		}
+	}
+}
+
+void SceneReplicationCodec::get_values(const Snapshot &p_snapshot, const LocalVector<float> &p_quantization, Vector<Variant> &r_values) {
+	const uint32_t count = p_snapshot.types.size();
+	r_values.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		const QuantizedType type = QuantizedType(p_snapshot.types[i]);
+		if (type == QUANTIZED_NONE) {
+			r_values.write[i] = p_snapshot.values[i];
+			continue;
+		}
+
+		const double step = i < p_quantization.size() ? p_quantization[i] : 0.0;
+		const int64_t *quantized = &p_snapshot.components[i * MAX_COMPONENTS];
+		double c[MAX_COMPONENTS];
+		for (uint32_t j = 0; j < MAX_COMPONENTS; j++) {
+			c[j] = quantized[j] * step;
+		}
+		switch (type) {
+			case QUANTIZED_FLOAT: {
+				r_values.write[i] = c[0];
+			} break;
+			case QUANTIZED_VECTOR2: {
+				r_values.write[i] = Vector2(c[0], c[1]);
+			} break;
+			case QUANTIZED_VECTOR3: {
+				r_values.write[i] = Vector3(c[0], c[1], c[2]);
+			} break;
+			case QUANTIZED_VECTOR4: {
+				r_values.write[i] = Vector4(c[0], c[1], c[2], c[3]);
+			} break;
+			case QUANTIZED_QUATERNION: {
+				r_values.write[i] = Quaternion(c[0], c[1], c[2], c[3]);
+			} break;
+			case QUANTIZED_COLOR: {
+				r_values.write[i] = Color(c[0], c[1], c[2], c[3]);
+			} break;
+			default:
+				break;
+		}
+	}
+}
+
+Error SceneReplicationCodec::encode(const Snapshot &p_snapshot, const Snapshot *p_baseline, LocalVector<uint8_t> &r_buffer, bool p_allow_object_decoding) {
+	const uint32_t count = p_snapshot.types.size();
+	ERR_FAIL_COND_V(p_baseline && p_baseline->types.size() != count, ERR_INVALID_PARAMETER);
+
+	r_buffer.clear();
+	BitWriter writer(r_buffer);
+	LocalVector<uint32_t> changed_values;
+	for (uint32_t i = 0; i < count; i++) {
+		const uint8_t type = p_snapshot.types[i];
+		const int64_t *quantized = &p_snapshot.components[i * MAX_COMPONENTS];
+		const int64_t *base = nullptr;
+		if (p_baseline && p_baseline->types[i] == type) {
+			base = &p_baseline->components[i * MAX_COMPONENTS];
+		}
+
+		if (p_baseline) {
+			bool changed = true;
+			if (base && type != QUANTIZED_NONE) {
+				changed = memcmp(quantized, base, MAX_COMPONENTS * sizeof(int64_t)) != 0;
+			} else if (base) {
+				changed = p_snapshot.values[i] != p_baseline->values[i];
+			}
+			writer.write(changed ? 1 : 0, 1);
+			if (!changed) {
+				continue;
+			}
+		}
+
+		writer.write(type, 3);
+		if (type == QUANTIZED_NONE) {
+			changed_values.push_back(i);
+			continue;
+		}
+		const uint32_t component_count = get_component_count(QuantizedType(type));
+		for (uint32_t j = 0; j < component_count; j++) {
+			// Wrap around instead of overflowing, decoding wraps back the same way.
+			writer.write_signed(int64_t(uint64_t(quantized[j]) - uint64_t(base ? base[j] : 0)));
+		}
+	}
+
+	// The other values follow the bits, byte aligned.
+	for (uint32_t i : changed_values) {
+		int size = 0;
+		Error err = MultiplayerAPI::encode_and_compress_variant(p_snapshot.values[i], nullptr, size, p_allow_object_decoding);
+		ERR_FAIL_COND_V(err != OK, err);
+		const uint32_t offset = r_buffer.size();
+		r_buffer.resize(offset + size);
+		err = MultiplayerAPI::encode_and_compress_variant(p_snapshot.values[i], r_buffer.ptr() + offset, size, p_allow_object_decoding);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+	return OK;
+}
+
+Error SceneReplicationCodec::decode(const uint8_t *p_buffer, int p_len, const Snapshot *p_baseline, uint32_t p_property_count, Snapshot &r_snapshot, bool p_allow_object_decoding) {
+	ERR_FAIL_COND_V(p_baseline && p_baseline->types.size() != p_property_count, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_len < 0, ERR_INVALID_DATA);
+
+	r_snapshot.types.resize(p_property_count);
+	r_snapshot.components.resize(p_property_count * MAX_COMPONENTS);
+	r_snapshot.values.resize(p_property_count);
+
+	BitReader reader(p_buffer, p_len);
+	LocalVector<uint32_t> changed_values;
+	for (uint32_t i = 0; i < p_property_count; i++) {
+		int64_t *quantized = &r_snapshot.components[i * MAX_COMPONENTS];
+		if (p_baseline && reader.read(1) == 0) {
+			r_snapshot.types[i] = p_baseline->types[i];
+			memcpy(quantized, &p_baseline->components[i * MAX_COMPONENTS], MAX_COMPONENTS * sizeof(int64_t));
+			r_snapshot.values.write[i] = p_baseline->values[i];
+			continue;
+		}
+
+		const uint8_t type = reader.read(3);
+		ERR_FAIL_COND_V(reader.error || type > QUANTIZED_COLOR, ERR_INVALID_DATA);
+		r_snapshot.types[i] = type;
+		r_snapshot.values.write[i] = Variant();
+		memset(quantized, 0, MAX_COMPONENTS * sizeof(int64_t));
+		if (type == QUANTIZED_NONE) {
+			changed_values.push_back(i);
+			continue;
+		}
+		const int64_t *base = nullptr;
+		if (p_baseline && p_baseline->types[i] == type) {
+			base = &p_baseline->components[i * MAX_COMPONENTS];
+		}
+		const uint32_t component_count = get_component_count(QuantizedType(type));
+		for (uint32_t j = 0; j < component_count; j++) {
+			// Untrusted deltas may overflow, wrap around like the encoder does.
+			quantized[j] = int64_t(uint64_t(reader.read_signed()) + uint64_t(base ? base[j] : 0));
+		}
+	}
+	ERR_FAIL_COND_V(reader.error, ERR_INVALID_DATA);
+
+	int offset = (reader.bit_count + 7) / 8;
+	for (uint32_t i : changed_values) {
+		ERR_FAIL_COND_V(offset >= p_len, ERR_INVALID_DATA);
+		int size = 0;
+		Error err = MultiplayerAPI::decode_and_decompress_variant(r_snapshot.values.write[i], p_buffer + offset, p_len - offset, &size, p_allow_object_decoding);
+		ERR_FAIL_COND_V(err != OK, err);
+		offset += size;
+	}
+	ERR_FAIL_COND_V(offset != p_len, ERR_INVALID_DATA);
+	return OK;
+}
@@ -0,0 +1,76 @@
+/**************************************************************************/
+/*  scene_replication_codec.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+// Compact encoding of the state of a MultiplayerSynchronizer.
+//
+// Properties with a quantization step are stored as integer multiples of that
+// step, other properties are stored as Variants. A state can be encoded against
+// a baseline state that the receiver already has, in which case only the
+// properties that changed are written, and the quantized components are written
+// as bit-packed differences to the baseline.
+class SceneReplicationCodec {
+public:
+	enum QuantizedType : uint8_t {
+		QUANTIZED_NONE,
+		QUANTIZED_FLOAT,
+		QUANTIZED_VECTOR2,
+		QUANTIZED_VECTOR3,
+		QUANTIZED_VECTOR4,
+		QUANTIZED_QUATERNION,
+		QUANTIZED_COLOR,
+	};
+
+	static constexpr uint32_t MAX_COMPONENTS = 4;
+
+	struct Snapshot {
+		// Type of each property, QUANTIZED_NONE for the properties stored in `values`.
+		LocalVector<uint8_t> types;
+		// MAX_COMPONENTS quantized components for each property.
+		LocalVector<int64_t> components;
+		// Value of each property, nil for quantized properties.
+		Vector<Variant> values;
+	};
+
+	static QuantizedType get_quantized_type(Variant::Type p_type);
+	static uint32_t get_component_count(QuantizedType p_type);
+
+	static void make_snapshot(const Vector<Variant> &p_values, const LocalVector<float> &p_quantization, Snapshot &r_snapshot);
+	static void get_values(const Snapshot &p_snapshot, const LocalVector<float> &p_quantization, Vector<Variant> &r_values);
+
+	// Encodes `p_snapshot` into `r_buffer`. `p_baseline` can be null, otherwise it must have the same properties.
+	static Error encode(const Snapshot &p_snapshot, const Snapshot *p_baseline, LocalVector<uint8_t> &r_buffer, bool p_allow_object_decoding = false);
+	// Decodes a snapshot of `p_property_count` properties encoded against the same `p_baseline`.
+	static Error decode(const uint8_t *p_buffer, int p_len, const Snapshot *p_baseline, uint32_t p_property_count, Snapshot &r_snapshot, bool p_allow_object_decoding = false);
+};
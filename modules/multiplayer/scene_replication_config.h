@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/io/resource.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/typed_array.h"
 
 class SceneReplicationConfig : public Resource {
@@ -50,6 +51,7 @@ private:
 		NodePath name;
 		bool spawn = true;
 		ReplicationMode mode = REPLICATION_MODE_ALWAYS;
+		float quantization = 0.0f;
 
 		bool operator==(const ReplicationProperty &p_to) {
 			return name == p_to.name;
@@ -66,6 +68,9 @@ private:
 	List<NodePath> spawn_props;
 	List<NodePath> sync_props;
 	List<NodePath> watch_props;
+	LocalVector<float> sync_quantization;
+	LocalVector<float> watch_quantization;
+	bool quantized = false;
 	bool dirty = false;
 
 	void _update();
@@ -99,10 +104,19 @@ public:
 	ReplicationMode property_get_replication_mode(const NodePath &p_path);
 	void property_set_replication_mode(const NodePath &p_path, ReplicationMode p_mode);
 
+	float property_get_quantization(const NodePath &p_path);
+	void property_set_quantization(const NodePath &p_path, float p_step);
+
 	const List<NodePath> &get_spawn_properties();
 	const List<NodePath> &get_sync_properties();
 	const List<NodePath> &get_watch_properties();
 
+	// Quantization steps of the sync and watch properties, in the same order.
+	const LocalVector<float> &get_sync_quantization();
+	const LocalVector<float> &get_watch_quantization();
+	// Whether any property is quantized, the state is then sent with SceneReplicationCodec.
+	bool has_quantized_properties();
+
 	SceneReplicationConfig() {}
 };
 
@@ -49,8 +49,58 @@ _FORCE_INLINE_ void SceneReplicationInterface::_profile_node_data(const String &
 		EngineDebugger::profiler_add_frame_data("multiplayer:replication", values);
 	}
 }
+
+_FORCE_INLINE_ void SceneReplicationInterface::_profile_peer_data(const String &p_what, int p_peer, int p_size) {
+	if (EngineDebugger::is_profiling("multiplayer:replication")) {
+		Array values = { p_what, p_peer, p_size };
+		EngineDebugger::profiler_add_frame_data("multiplayer:replication", values);
+	}
+}
 #endif
 
+// Sizes in compact sync packets use 7 bits per byte, the high bit marks that more bytes follow.
+static int _encode_size(uint32_t p_size, uint8_t *p_buffer) {
+	int len = 0;
+	do {
+		uint8_t byte = p_size & 0x7F;
+		p_size >>= 7;
+		if (p_size) {
+			byte |= 0x80;
+		}
+		if (p_buffer) {
+			p_buffer[len] = byte;
+		}
+		len++;
+	} while (p_size);
+	return len;
+}
+
+static int _decode_size(const uint8_t *p_buffer, int p_len, uint32_t &r_size) {
+	r_size = 0;
+	for (int i = 0; i < MIN(p_len, 5); i++) {
+		r_size |= uint32_t(p_buffer[i] & 0x7F) << (7 * i);
+		if (!(p_buffer[i] & 0x80)) {
+			return i + 1;
+		}
+	}
+	return -1;
+}
+
+const SceneReplicationCodec::Snapshot *SceneReplicationInterface::SnapshotHistory::get(uint16_t p_time, uint16_t p_now) const {
+	const uint16_t slot = p_time % SIZE;
+	if (!used[slot] || times[slot] != p_time || uint16_t(p_now - p_time) >= SIZE) {
+		return nullptr;
+	}
+	return &snapshots[slot];
+}
+
+SceneReplicationCodec::Snapshot &SceneReplicationInterface::SnapshotHistory::insert(uint16_t p_time) {
+	const uint16_t slot = p_time % SIZE;
+	used[slot] = true;
+	times[slot] = p_time;
+	return snapshots[slot];
+}
+
 SceneReplicationInterface::TrackedNode &SceneReplicationInterface::_track(const ObjectID &p_id) {
 	if (!tracked_nodes.has(p_id)) {
 		tracked_nodes[p_id] = TrackedNode(p_id);
@@ -142,14 +192,129 @@ void SceneReplicationInterface::on_network_process() {
 
 	// Process syncs.
 	uint64_t usec = OS::get_singleton()->get_ticks_usec();
+	bool interest_dirty = true;
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
-		const HashSet<ObjectID> to_sync(E.value.sync_nodes);
-		if (to_sync.is_empty()) {
+		if (!E.value.pending_acks.is_empty()) {
+			_send_sync_acks(E.key, E.value);
+		}
+		if (E.value.sync_nodes.is_empty()) {
 			continue; // Nothing to sync
 		}
 		uint16_t sync_net_time = ++E.value.last_sent_sync;
-		_send_sync(E.key, to_sync, sync_net_time, usec);
-		_send_delta(E.key, to_sync, usec, E.value.last_watch_usecs);
+		HashSet<ObjectID> to_sync;
+		if (E.value.has_interest) {
+			if (interest_dirty) {
+				_update_interest_grid();
+				interest_dirty = false;
+			}
+			_get_interest_syncs(E.value, sync_net_time, to_sync);
+			if (to_sync.is_empty()) {
+				continue;
+			}
+		} else {
+			to_sync = E.value.sync_nodes;
+		}
+		int size = _send_sync(E.key, to_sync, sync_net_time, usec);
+		size += _send_delta(E.key, to_sync, usec, E.value.last_watch_usecs);
+#ifdef DEBUG_ENABLED
+		_profile_peer_data("peer_out", E.key, size);
+#endif
+	}
+}
+
+Vector3i SceneReplicationInterface::_get_interest_cell(const Vector3 &p_position) const {
+	// Far positions share the border cells rather than overflowing.
+	const Vector3 cell = (p_position / interest_cell_size).floor();
+	Vector3i result;
+	for (int i = 0; i < 3; i++) {
+		// Also catches NaN.
+		result[i] = cell[i] >= -INTEREST_CELL_LIMIT ? int(MIN(cell[i], real_t(INTEREST_CELL_LIMIT))) : -INTEREST_CELL_LIMIT;
+	}
+	return result;
+}
+
+void SceneReplicationInterface::_update_interest_grid() {
+	interest_grid.clear();
+	interest_global.clear();
+	interest_grid_min = Vector3i();
+	interest_grid_max = Vector3i();
+	bool first = true;
+	for (const ObjectID &oid : sync_nodes) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
+		if (!sync) {
+			continue;
+		}
+		Vector3 position;
+		if (!sync->is_spatial_interest_enabled() || !sync->get_interest_position(position)) {
+			interest_global.push_back(oid);
+			continue;
+		}
+		const Vector3i cell = _get_interest_cell(position);
+		if (first) {
+			interest_grid_min = cell;
+			interest_grid_max = cell;
+			first = false;
+		} else {
+			interest_grid_min = interest_grid_min.min(cell);
+			interest_grid_max = interest_grid_max.max(cell);
+		}
+		interest_grid[cell].push_back({ oid, position });
+	}
+}
+
+void SceneReplicationInterface::_get_interest_syncs(const PeerInfo &p_info, uint16_t p_sync_net_time, HashSet<ObjectID> &r_syncs) const {
+	for (const ObjectID &oid : interest_global) {
+		if (p_info.sync_nodes.has(oid)) {
+			r_syncs.insert(oid);
+		}
+	}
+	if (interest_grid.is_empty()) {
+		return;
+	}
+	const real_t radius = p_info.interest_radius;
+	const real_t radius_squared = radius * radius;
+	// Far objects are synchronized less often. The interval counts from the last state sent to this peer, since
+	// synchronizers with a replication interval skip the frames on which it did not elapse.
+	auto add_entry = [&](const InterestEntry &p_entry) {
+		const real_t distance_squared = p_entry.position.distance_squared_to(p_info.interest_position);
+		if (distance_squared > radius_squared || !p_info.sync_nodes.has(p_entry.oid)) {
+			return;
+		}
+		const int interval = CLAMP(1 + int(Math::sqrt(distance_squared) / radius * interest_max_tick_interval), 1, interest_max_tick_interval);
+		const uint16_t *last_sync_time = p_info.interest_sync_times.getptr(p_entry.oid);
+		if (interval == 1 || !last_sync_time || uint16_t(p_sync_net_time - *last_sync_time) >= interval) {
+			r_syncs.insert(p_entry.oid);
+		}
+	};
+	const Vector3i from = _get_interest_cell(p_info.interest_position - Vector3(radius, radius, radius));
+	const Vector3i to = _get_interest_cell(p_info.interest_position + Vector3(radius, radius, radius));
+	const Vector3i query_min = from.max(interest_grid_min);
+	const Vector3i query_max = to.min(interest_grid_max);
+	if (query_min.x > query_max.x || query_min.y > query_max.y || query_min.z > query_max.z) {
+		return;
+	}
+	const Vector3i query_size = query_max - query_min + Vector3i(1, 1, 1);
+	if (int64_t(query_size.x) * query_size.y * query_size.z > int64_t(interest_grid.size())) {
+		// Visiting the cells would take longer than visiting the occupied ones.
+		for (const KeyValue<Vector3i, LocalVector<InterestEntry>> &E : interest_grid) {
+			for (const InterestEntry &entry : E.value) {
+				add_entry(entry);
+			}
+		}
+		return;
+	}
+	for (int x = query_min.x; x <= query_max.x; x++) {
+		for (int y = query_min.y; y <= query_max.y; y++) {
+			for (int z = query_min.z; z <= query_max.z; z++) {
+				const LocalVector<InterestEntry> *entries = interest_grid.getptr(Vector3i(x, y, z));
+				if (!entries) {
+					continue;
+				}
+				for (const InterestEntry &entry : *entries) {
+					add_entry(entry);
+				}
+			}
+		}
 	}
 }
 
@@ -282,8 +447,11 @@ Error SceneReplicationInterface::on_replication_stop(Object *p_obj, Variant p_co
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
 		E.value.sync_nodes.erase(sid);
 		E.value.last_watch_usecs.erase(sid);
+		E.value.interest_sync_times.erase(sid);
+		E.value.sent_snapshots.erase(sync->get_net_id());
 		if (sync->get_net_id() && uint32_t(E.key) == tobj.remote_peer) {
 			E.value.recv_sync_ids.erase(sync->get_net_id());
+			E.value.recv_snapshots.erase(sync->get_net_id());
 		}
 	}
 	return OK;
@@ -360,6 +528,8 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 			} else {
 				E.value.sync_nodes.erase(sid);
 				E.value.last_watch_usecs.erase(sid);
+				E.value.interest_sync_times.erase(sid);
+				E.value.sent_snapshots.erase(p_sync->get_net_id());
 			}
 		}
 		return OK;
@@ -373,6 +543,8 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 		} else {
 			peers_info[p_peer].sync_nodes.erase(sid);
 			peers_info[p_peer].last_watch_usecs.erase(sid);
+			peers_info[p_peer].interest_sync_times.erase(sid);
+			peers_info[p_peer].sent_snapshots.erase(p_sync->get_net_id());
 		}
 		return OK;
 	}
@@ -707,11 +879,12 @@ MultiplayerSynchronizer *SceneReplicationInterface::_find_synchronizer(int p_pee
 	return sync;
 }
 
-void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs) {
+int SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs) {
 	MAKE_ROOM(/* header */ 1 + /* element */ 4 + 8 + 4 + delta_mtu);
 	uint8_t *ptr = packet_cache.ptrw();
 	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT);
 	int ofs = 1;
+	int sent = 0;
 	for (const ObjectID &oid : p_synchronizers) {
 		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
 		ERR_CONTINUE(!sync || !sync->get_replication_config_ptr() || !_has_authority(sync));
@@ -736,21 +909,47 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 			i++;
 		}
 		int size;
-		Error err = MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), nullptr, size);
-		ERR_CONTINUE_MSG(err != OK, "Unable to encode delta state.");
+		SceneReplicationConfig *config = sync->get_replication_config_ptr();
+		if (config->has_quantized_properties()) {
+			// Quantize the changed properties, the reliable channel needs no baseline.
+			const LocalVector<float> &watch_quantization = config->get_watch_quantization();
+			LocalVector<float> quantization;
+			Vector<Variant> values;
+			for (uint32_t j = 0; j < watch_quantization.size(); j++) {
+				if (indexes & (1ULL << j)) {
+					quantization.push_back(watch_quantization[j]);
+				}
+			}
+			for (const Variant &v : delta) {
+				values.push_back(v);
+			}
+			SceneReplicationCodec::Snapshot snapshot;
+			SceneReplicationCodec::make_snapshot(values, quantization, snapshot);
+			Error err = SceneReplicationCodec::encode(snapshot, nullptr, state_cache);
+			ERR_CONTINUE_MSG(err != OK, "Unable to encode delta state.");
+			size = state_cache.size();
+		} else {
+			Error err = MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), nullptr, size);
+			ERR_CONTINUE_MSG(err != OK, "Unable to encode delta state.");
+		}
 
 		ERR_CONTINUE_MSG(size > delta_mtu, vformat("Synchronizer delta bigger than MTU will not be sent (%d > %d): %s", size, delta_mtu, sync->get_path()));
 
 		if (ofs + 4 + 8 + 4 + size > delta_mtu) {
 			// Send what we got, and reset write.
 			_send_raw(packet_cache.ptr(), ofs, p_peer, true);
+			sent += ofs;
 			ofs = 1;
 		}
 		if (size) {
 			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
 			ofs += encode_uint64(indexes, &ptr[ofs]);
 			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), &ptr[ofs], size);
+			if (config->has_quantized_properties()) {
+				memcpy(&ptr[ofs], state_cache.ptr(), size);
+			} else {
+				MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), &ptr[ofs], size);
+			}
 			ofs += size;
 		}
 #ifdef DEBUG_ENABLED
@@ -761,7 +960,9 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 	if (ofs > 1) {
 		// Got some left over to send.
 		_send_raw(packet_cache.ptr(), ofs, p_peer, true);
+		sent += ofs;
 	}
+	return sent;
 }
 
 Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
@@ -783,12 +984,27 @@ Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_b
 		List<NodePath> props = sync->get_delta_properties(indexes);
 		ERR_FAIL_COND_V(props.is_empty(), ERR_INVALID_DATA);
 		Vector<Variant> vars;
-		vars.resize(props.size());
-		int consumed = 0;
-		Error err = MultiplayerAPI::decode_and_decompress_variants(vars, p_buffer + ofs, size, consumed);
-		ERR_FAIL_COND_V(err != OK, err);
-		ERR_FAIL_COND_V(uint32_t(consumed) != size, ERR_INVALID_DATA);
-		err = MultiplayerSynchronizer::set_state(props, node, vars);
+		SceneReplicationConfig *config = sync->get_replication_config_ptr();
+		if (config->has_quantized_properties()) {
+			const LocalVector<float> &watch_quantization = config->get_watch_quantization();
+			LocalVector<float> quantization;
+			for (uint32_t j = 0; j < watch_quantization.size(); j++) {
+				if (indexes & (1ULL << j)) {
+					quantization.push_back(watch_quantization[j]);
+				}
+			}
+			SceneReplicationCodec::Snapshot snapshot;
+			Error err = SceneReplicationCodec::decode(p_buffer + ofs, size, nullptr, props.size(), snapshot);
+			ERR_FAIL_COND_V(err != OK, err);
+			SceneReplicationCodec::get_values(snapshot, quantization, vars);
+		} else {
+			vars.resize(props.size());
+			int consumed = 0;
+			Error err = MultiplayerAPI::decode_and_decompress_variants(vars, p_buffer + ofs, size, consumed);
+			ERR_FAIL_COND_V(err != OK, err);
+			ERR_FAIL_COND_V(uint32_t(consumed) != size, ERR_INVALID_DATA);
+		}
+		Error err = MultiplayerSynchronizer::set_state(props, node, vars);
 		ERR_FAIL_COND_V(err != OK, err);
 		ofs += size;
 		sync->emit_signal(SNAME("delta_synchronized"));
@@ -799,12 +1015,46 @@ Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_b
 	return OK;
 }
 
-void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec) {
+Error SceneReplicationInterface::_encode_compact_sync(PeerInfo &p_info, uint32_t p_net_id, uint16_t p_sync_net_time, const Vector<Variant> &p_state, const LocalVector<float> &p_quantization) {
+	SnapshotHistory &history = p_info.sent_snapshots[p_net_id];
+	// Encode against the last state the peer acknowledged, if it is recent enough.
+	const SceneReplicationCodec::Snapshot *baseline = history.acked ? history.get(history.acked_time, p_sync_net_time) : nullptr;
+	if (baseline && baseline->types.size() != uint32_t(p_state.size())) {
+		baseline = nullptr; // The configuration changed.
+	}
+	SceneReplicationCodec::Snapshot snapshot;
+	SceneReplicationCodec::make_snapshot(p_state, p_quantization, snapshot);
+	Error err = SceneReplicationCodec::encode(snapshot, baseline, state_cache);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	// Prepend the baseline information.
+	const uint32_t header_size = baseline ? 3 : 1;
+	const uint32_t state_size = state_cache.size();
+	state_cache.resize(header_size + state_size);
+	memmove(state_cache.ptr() + header_size, state_cache.ptr(), state_size);
+	state_cache[0] = baseline ? 1 : 0;
+	if (baseline) {
+		encode_uint16(history.acked_time, &state_cache[1]);
+	}
+	history.insert(p_sync_net_time) = snapshot;
+	return OK;
+}
+
+int SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec) {
 	MAKE_ROOM(/* header */ 3 + /* element */ 4 + 4 + sync_mtu);
 	uint8_t *ptr = packet_cache.ptrw();
 	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC;
 	int ofs = 1;
 	ofs += encode_uint16(p_sync_net_time, &ptr[1]);
+	// States with quantized properties are sent in their own packets.
+	if (compact_packet_cache.size() < 3 + 4 + 5 + sync_mtu) {
+		compact_packet_cache.resize(3 + 4 + 5 + sync_mtu);
+	}
+	uint8_t *compact_ptr = compact_packet_cache.ptrw();
+	compact_ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT);
+	int compact_ofs = 1;
+	compact_ofs += encode_uint16(p_sync_net_time, &compact_ptr[1]);
+	int sent = 0;
 	// Can only send updates for already notified nodes.
 	// This is a lazy implementation, we could optimize much more here with by grouping by replication config.
 	for (const ObjectID &oid : p_synchronizers) {
@@ -821,12 +1071,40 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 			// The path based sync is not yet confirmed, skipping.
 			continue;
 		}
+		PeerInfo &peer_info = peers_info[p_peer];
+		if (peer_info.has_interest && sync->is_spatial_interest_enabled()) {
+			peer_info.interest_sync_times[oid] = p_sync_net_time;
+		}
 		int size;
 		Vector<Variant> vars;
 		Vector<const Variant *> varp;
-		const List<NodePath> props(sync->get_replication_config_ptr()->get_sync_properties());
+		SceneReplicationConfig *config = sync->get_replication_config_ptr();
+		const List<NodePath> props(config->get_sync_properties());
 		Error err = MultiplayerSynchronizer::get_state(props, node, vars, varp);
 		ERR_CONTINUE_MSG(err != OK, "Unable to retrieve sync state.");
+
+		if (config->has_quantized_properties()) {
+			err = _encode_compact_sync(peer_info, sync->get_net_id(), p_sync_net_time, vars, config->get_sync_quantization());
+			ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
+			size = state_cache.size();
+			ERR_CONTINUE_MSG(size > sync_mtu, vformat("Node states bigger than MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
+			const int element_size = 4 + _encode_size(size, nullptr) + size;
+			if (compact_ofs > 3 && compact_ofs + element_size > sync_mtu) {
+				// Send what we got, and reset write.
+				_send_raw(compact_packet_cache.ptr(), compact_ofs, p_peer, false);
+				sent += compact_ofs;
+				compact_ofs = 3;
+			}
+			compact_ofs += encode_uint32(sync->get_net_id(), &compact_ptr[compact_ofs]);
+			compact_ofs += _encode_size(size, &compact_ptr[compact_ofs]);
+			memcpy(&compact_ptr[compact_ofs], state_cache.ptr(), size);
+			compact_ofs += size;
+#ifdef DEBUG_ENABLED
+			_profile_node_data("sync_out", oid, size);
+#endif
+			continue;
+		}
+
 		err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
 		ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
 		// TODO Handle single state above MTU.
@@ -834,6 +1112,7 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 		if (ofs + 4 + 4 + size > sync_mtu) {
 			// Send what we got, and reset write.
 			_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+			sent += ofs;
 			ofs = 3;
 		}
 		if (size) {
@@ -849,10 +1128,23 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 	if (ofs > 3) {
 		// Got some left over to send.
 		_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+		sent += ofs;
+	}
+	if (compact_ofs > 3) {
+		_send_raw(compact_packet_cache.ptr(), compact_ofs, p_peer, false);
+		sent += compact_ofs;
 	}
+	return sent;
 }
 
 Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 1, ERR_INVALID_DATA, "Invalid sync packet received");
+	if (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_2_SHIFT)) {
+		return on_sync_ack_receive(p_from, p_buffer, p_buffer_len);
+	}
+	if (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT)) {
+		return on_compact_sync_receive(p_from, p_buffer, p_buffer_len);
+	}
 	ERR_FAIL_COND_V_MSG(p_buffer_len < 11, ERR_INVALID_DATA, "Invalid sync packet received");
 	bool is_delta = (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT)) != 0;
 	if (is_delta) {
@@ -900,6 +1192,109 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 	return OK;
 }
 
+Error SceneReplicationInterface::on_compact_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 3, ERR_INVALID_DATA, "Invalid sync packet received");
+	ERR_FAIL_COND_V(!peers_info.has(p_from), ERR_INVALID_DATA);
+	PeerInfo &info = peers_info[p_from];
+	uint16_t time = decode_uint16(&p_buffer[1]);
+	int ofs = 3;
+	while (ofs + 4 < p_buffer_len) {
+		uint32_t net_id = decode_uint32(&p_buffer[ofs]);
+		ofs += 4;
+		uint32_t size = 0;
+		const int size_len = _decode_size(&p_buffer[ofs], p_buffer_len - ofs, size);
+		ERR_FAIL_COND_V(size_len < 0, ERR_INVALID_DATA);
+		ofs += size_len;
+		ERR_FAIL_COND_V(size < 1 || size > uint32_t(p_buffer_len - ofs), ERR_INVALID_DATA);
+		const uint8_t *state = &p_buffer[ofs];
+		ofs += size;
+
+		MultiplayerSynchronizer *sync = _find_synchronizer(p_from, net_id);
+		if (!sync) {
+			// Not received yet.
+			continue;
+		}
+		Node *node = sync->get_root_node();
+		SceneReplicationConfig *config = sync->get_replication_config_ptr();
+		if (sync->get_multiplayer_authority() != p_from || !node || !config) {
+			// Not valid for me.
+			ERR_CONTINUE_MSG(true, "Ignoring sync data from non-authority or for missing node.");
+		}
+		ERR_CONTINUE_MSG(!config->has_quantized_properties(), "Ignoring quantized sync data for a configuration without quantized properties.");
+
+		const List<NodePath> props(config->get_sync_properties());
+		SnapshotHistory &history = info.recv_snapshots[net_id];
+		const SceneReplicationCodec::Snapshot *baseline = nullptr;
+		uint32_t header_size = 1;
+		if (state[0] & 1) {
+			ERR_FAIL_COND_V(size < 3, ERR_INVALID_DATA);
+			header_size = 3;
+			baseline = history.get(decode_uint16(&state[1]), time);
+			if (!baseline) {
+				// The baseline is gone, wait for a state we can decode.
+				continue;
+			}
+		}
+		if (!sync->update_inbound_sync_time(time)) {
+			// State is too old.
+			continue;
+		}
+		SceneReplicationCodec::Snapshot snapshot;
+		Error err = SceneReplicationCodec::decode(state + header_size, size - header_size, baseline, props.size(), snapshot);
+		ERR_FAIL_COND_V(err, err);
+		Vector<Variant> vars;
+		SceneReplicationCodec::get_values(snapshot, config->get_sync_quantization(), vars);
+		err = MultiplayerSynchronizer::set_state(props, node, vars);
+		ERR_FAIL_COND_V(err, err);
+		history.insert(time) = snapshot;
+		info.pending_acks[net_id] = time;
+		sync->emit_signal(SNAME("synchronized"));
+#ifdef DEBUG_ENABLED
+		_profile_node_data("sync_in", sync->get_instance_id(), size);
+#endif
+	}
+	return OK;
+}
+
+void SceneReplicationInterface::_send_sync_acks(int p_peer, PeerInfo &p_info) {
+	MAKE_ROOM(/* header */ 1 + /* element */ 4 + 2 + sync_mtu);
+	uint8_t *ptr = packet_cache.ptrw();
+	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_2_SHIFT);
+	int ofs = 1;
+	for (const KeyValue<uint32_t, uint16_t> &E : p_info.pending_acks) {
+		if (ofs + 4 + 2 > sync_mtu) {
+			_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+			ofs = 1;
+		}
+		ofs += encode_uint32(E.key, &ptr[ofs]);
+		ofs += encode_uint16(E.value, &ptr[ofs]);
+	}
+	_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+	p_info.pending_acks.clear();
+}
+
+Error SceneReplicationInterface::on_sync_ack_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
+	ERR_FAIL_COND_V(!peers_info.has(p_from), ERR_INVALID_DATA);
+	PeerInfo &info = peers_info[p_from];
+	int ofs = 1;
+	while (ofs + 4 + 2 <= p_buffer_len) {
+		uint32_t net_id = decode_uint32(&p_buffer[ofs]);
+		ofs += 4;
+		uint16_t time = decode_uint16(&p_buffer[ofs]);
+		ofs += 2;
+		SnapshotHistory *history = info.sent_snapshots.getptr(net_id);
+		if (!history) {
+			continue;
+		}
+		// Acknowledgments can arrive out of order, keep the newest.
+		if (!history->acked || uint16_t(time - history->acked_time - 1) < 32767) {
+			history->acked = true;
+			history->acked_time = time;
+		}
+	}
+	return OK;
+}
+
 void SceneReplicationInterface::set_max_sync_packet_size(int p_size) {
 	ERR_FAIL_COND_MSG(p_size < 128, "Sync maximum packet size must be at least 128 bytes.");
 	sync_mtu = p_size;
@@ -909,6 +1304,41 @@ int SceneReplicationInterface::get_max_sync_packet_size() const {
 	return sync_mtu;
 }
 
+Error SceneReplicationInterface::set_peer_interest(int p_peer, const Vector3 &p_position, real_t p_radius) {
+	ERR_FAIL_COND_V_MSG(p_radius <= 0, ERR_INVALID_PARAMETER, "Interest radius must be greater than 0.");
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_NULL_V_MSG(info, ERR_INVALID_PARAMETER, vformat("Unknown peer: %d.", p_peer));
+	info->has_interest = true;
+	info->interest_position = p_position;
+	info->interest_radius = p_radius;
+	return OK;
+}
+
+void SceneReplicationInterface::clear_peer_interest(int p_peer) {
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_NULL_MSG(info, vformat("Unknown peer: %d.", p_peer));
+	info->has_interest = false;
+	info->interest_sync_times.clear();
+}
+
+void SceneReplicationInterface::set_interest_cell_size(real_t p_size) {
+	ERR_FAIL_COND_MSG(p_size <= 0, "Interest cell size must be greater than 0.");
+	interest_cell_size = p_size;
+}
+
+real_t SceneReplicationInterface::get_interest_cell_size() const {
+	return interest_cell_size;
+}
+
+void SceneReplicationInterface::set_interest_max_tick_interval(int p_interval) {
+	ERR_FAIL_COND_MSG(p_interval < 1, "Interest maximum tick interval must be at least 1.");
+	interest_max_tick_interval = p_interval;
+}
+
+int SceneReplicationInterface::get_interest_max_tick_interval() const {
+	return interest_max_tick_interval;
+}
+
 void SceneReplicationInterface::set_max_delta_packet_size(int p_size) {
 	ERR_FAIL_COND_MSG(p_size < 128, "Sync maximum packet size must be at least 128 bytes.");
 	delta_mtu = p_size;
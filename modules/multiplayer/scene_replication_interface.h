@@ -32,6 +32,7 @@
 
 #include "multiplayer_spawner.h"
 #include "multiplayer_synchronizer.h"
+#include "scene_replication_codec.h"
 
 #include "core/object/ref_counted.h"
 #include "core/templates/rb_set.h"
@@ -60,6 +61,21 @@ private:
 		}
 	};
 
+	// Recent quantized states of a synchronizer, indexed by sync time.
+	struct SnapshotHistory {
+		static constexpr uint16_t SIZE = 32;
+
+		SceneReplicationCodec::Snapshot snapshots[SIZE];
+		uint16_t times[SIZE] = {};
+		bool used[SIZE] = {};
+		// Last state acknowledged by the receiver.
+		bool acked = false;
+		uint16_t acked_time = 0;
+
+		const SceneReplicationCodec::Snapshot *get(uint16_t p_time, uint16_t p_now) const;
+		SceneReplicationCodec::Snapshot &insert(uint16_t p_time);
+	};
+
 	struct PeerInfo {
 		HashSet<ObjectID> sync_nodes;
 		HashSet<ObjectID> spawn_nodes;
@@ -67,6 +83,22 @@ private:
 		HashMap<uint32_t, ObjectID> recv_sync_ids;
 		HashMap<uint32_t, ObjectID> recv_nodes;
 		uint16_t last_sent_sync = 0;
+		// Quantized states sent to and received from this peer, by synchronizer net ID.
+		HashMap<uint32_t, SnapshotHistory> sent_snapshots;
+		HashMap<uint32_t, SnapshotHistory> recv_snapshots;
+		// Latest received quantized state of each synchronizer, to acknowledge.
+		HashMap<uint32_t, uint16_t> pending_acks;
+		// Spatial interest of this peer, see SceneMultiplayer::set_peer_interest().
+		bool has_interest = false;
+		Vector3 interest_position;
+		real_t interest_radius = 0;
+		// Sync time of the last state of each synchronizer with spatial interest sent to this peer.
+		HashMap<ObjectID, uint16_t> interest_sync_times;
+	};
+
+	struct InterestEntry {
+		ObjectID oid;
+		Vector3 position;
 	};
 
 	// Replication state.
@@ -90,9 +122,23 @@ private:
 	SceneMultiplayer *multiplayer = nullptr;
 	SceneCacheInterface *multiplayer_cache = nullptr;
 	PackedByteArray packet_cache;
+	PackedByteArray compact_packet_cache;
+	LocalVector<uint8_t> state_cache;
 	int sync_mtu = 1350; // Highly dependent on underlying protocol.
 	int delta_mtu = 65535;
 
+	// Spatial interest.
+	// Limit of the interest grid coordinates, so the cell count of a query fits in 64 bits.
+	static constexpr int INTEREST_CELL_LIMIT = 1 << 19;
+	real_t interest_cell_size = 32;
+	int interest_max_tick_interval = 4;
+	// Synchronizers with spatial interest, bucketed by grid cell. Rebuilt once per network tick.
+	HashMap<Vector3i, LocalVector<InterestEntry>> interest_grid;
+	Vector3i interest_grid_min;
+	Vector3i interest_grid_max;
+	// Synchronizers that are always relevant.
+	LocalVector<ObjectID> interest_global;
+
 	TrackedNode &_track(const ObjectID &p_id);
 	void _untrack(const ObjectID &p_id);
 	void _node_ready(const ObjectID &p_oid);
@@ -101,8 +147,10 @@ private:
 	bool _verify_synchronizer(int p_peer, MultiplayerSynchronizer *p_sync, uint32_t &r_net_id);
 	MultiplayerSynchronizer *_find_synchronizer(int p_peer, uint32_t p_net_ida);
 
-	void _send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec);
-	void _send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs);
+	int _send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec);
+	int _send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs);
+	Error _encode_compact_sync(PeerInfo &p_info, uint32_t p_net_id, uint16_t p_sync_net_time, const Vector<Variant> &p_state, const LocalVector<float> &p_quantization);
+	void _send_sync_acks(int p_peer, PeerInfo &p_info);
 	Error _make_spawn_packet(Node *p_node, MultiplayerSpawner *p_spawner, int &r_len);
 	Error _make_despawn_packet(Node *p_node, int &r_len);
 	Error _send_raw(const uint8_t *p_buffer, int p_size, int p_peer, bool p_reliable);
@@ -112,6 +160,10 @@ private:
 	Error _update_spawn_visibility(int p_peer, const ObjectID &p_oid);
 	void _free_remotes(const PeerInfo &p_info);
 
+	Vector3i _get_interest_cell(const Vector3 &p_position) const;
+	void _update_interest_grid();
+	void _get_interest_syncs(const PeerInfo &p_info, uint16_t p_sync_net_time, HashSet<ObjectID> &r_syncs) const;
+
 	template <typename T>
 	static T *get_id_as(const ObjectID &p_id) {
 		return p_id.is_valid() ? ObjectDB::get_instance<T>(p_id) : nullptr;
@@ -119,6 +171,7 @@ private:
 
 #ifdef DEBUG_ENABLED
 	_FORCE_INLINE_ void _profile_node_data(const String &p_what, ObjectID p_id, int p_size);
+	_FORCE_INLINE_ void _profile_peer_data(const String &p_what, int p_peer, int p_size);
 #endif
 
 public:
@@ -137,6 +190,8 @@ public:
 	Error on_despawn_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 	Error on_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 	Error on_delta_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
+	Error on_compact_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
+	Error on_sync_ack_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 
 	bool is_rpc_visible(const ObjectID &p_oid, int p_peer) const;
 
@@ -146,6 +201,15 @@ public:
 	void set_max_delta_packet_size(int p_size);
 	int get_max_delta_packet_size() const;
 
+	Error set_peer_interest(int p_peer, const Vector3 &p_position, real_t p_radius);
+	void clear_peer_interest(int p_peer);
+
+	void set_interest_cell_size(real_t p_size);
+	real_t get_interest_cell_size() const;
+
+	void set_interest_max_tick_interval(int p_interval);
+	int get_interest_max_tick_interval() const;
+
 	SceneReplicationInterface(SceneMultiplayer *p_multiplayer, SceneCacheInterface *p_cache) {
 		multiplayer = p_multiplayer;
 		multiplayer_cache = p_cache;
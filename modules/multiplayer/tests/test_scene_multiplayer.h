@@ -30,12 +30,15 @@
 
 #pragma once
 
+#include "../multiplayer_synchronizer.h"
 #include "../scene_multiplayer.h"
 
+#include "core/io/marshalls.h"
 #include "core/object/callable_mp.h"
 #include "core/os/os.h"
 #include "scene/2d/node_2d.h"
 #include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
 #include "tests/signal_watcher.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
@@ -59,9 +62,300 @@ TEST_CASE("[Multiplayer][SceneMultiplayer] Defaults") {
 	CHECK(scene_multiplayer->is_server_relay_enabled());
 	CHECK_EQ(scene_multiplayer->get_max_sync_packet_size(), 1350);
 	CHECK_EQ(scene_multiplayer->get_max_delta_packet_size(), 65535);
+	CHECK_EQ(scene_multiplayer->get_interest_cell_size(), 32.0);
+	CHECK_EQ(scene_multiplayer->get_interest_max_tick_interval(), 4);
 	CHECK(scene_multiplayer->is_server());
 }
 
+TEST_CASE("[Multiplayer][SceneMultiplayer] Peer interest") {
+	Ref<SceneMultiplayer> scene_multiplayer;
+	scene_multiplayer.instantiate();
+
+	SUBCASE("Fails when the peer is not connected") {
+		ERR_PRINT_OFF;
+		CHECK_EQ(scene_multiplayer->set_peer_interest(42, Vector3(), 10.0), Error::ERR_INVALID_PARAMETER);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Fails when the radius is not positive") {
+		ERR_PRINT_OFF;
+		CHECK_EQ(scene_multiplayer->set_peer_interest(42, Vector3(), 0.0), Error::ERR_INVALID_PARAMETER);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Ignores invalid settings") {
+		ERR_PRINT_OFF;
+		scene_multiplayer->set_interest_cell_size(0.0);
+		scene_multiplayer->set_interest_max_tick_interval(0);
+		ERR_PRINT_ON;
+		CHECK_EQ(scene_multiplayer->get_interest_cell_size(), 32.0);
+		CHECK_EQ(scene_multiplayer->get_interest_max_tick_interval(), 4);
+	}
+}
+
+// Confirms the node paths it receives like a remote peer would, and counts the synchronizer states sent to each peer.
+class ReplicationTestPeer : public MultiplayerPeer {
+	GDCLASS(ReplicationTestPeer, MultiplayerPeer);
+
+	struct Packet {
+		int peer = 0;
+		Vector<uint8_t> data;
+	};
+
+	List<Packet> incoming;
+	Packet current;
+	int target_peer = 0;
+	HashMap<int, HashMap<uint32_t, int>> sync_counts;
+
+public:
+	int get_sync_count(int p_peer, uint32_t p_net_id) const {
+		const HashMap<uint32_t, int> *counts = sync_counts.getptr(p_peer);
+		const int *count = counts ? counts->getptr(p_net_id) : nullptr;
+		return count ? *count : 0;
+	}
+	void clear_sync_counts() { sync_counts.clear(); }
+
+	virtual int get_available_packet_count() const override { return incoming.size(); }
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override {
+		ERR_FAIL_COND_V(incoming.is_empty(), ERR_UNAVAILABLE);
+		current = incoming.front()->get();
+		incoming.pop_front();
+		*r_buffer = current.data.ptr();
+		r_buffer_size = current.data.size();
+		return OK;
+	}
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override {
+		if (p_buffer[0] == SceneMultiplayer::NETWORK_COMMAND_SIMPLIFY_PATH) {
+			// The cache ID follows the RPC checksum string.
+			int ofs = 1;
+			while (ofs < p_buffer_size && p_buffer[ofs] != 0) {
+				ofs++;
+			}
+			ERR_FAIL_COND_V(ofs + 5 > p_buffer_size, ERR_INVALID_DATA);
+			Packet confirm;
+			confirm.peer = target_peer;
+			confirm.data.resize(6);
+			confirm.data.write[0] = SceneMultiplayer::NETWORK_COMMAND_CONFIRM_PATH;
+			confirm.data.write[1] = 1; // Valid RPC checksum.
+			memcpy(&confirm.data.write[2], &p_buffer[ofs + 1], 4);
+			incoming.push_back(confirm);
+		} else if (p_buffer[0] == SceneMultiplayer::NETWORK_COMMAND_SYNC) {
+			// Full states, a header with the sync time followed by the net ID, size and state of each synchronizer.
+			int ofs = 3;
+			while (ofs + 8 <= p_buffer_size) {
+				sync_counts[target_peer][decode_uint32(&p_buffer[ofs])]++;
+				ofs += 8 + decode_uint32(&p_buffer[ofs + 4]);
+			}
+		}
+		return OK;
+	}
+	virtual int get_max_packet_size() const override { return 1 << 24; }
+
+	virtual void set_target_peer(int p_peer_id) override { target_peer = p_peer_id; }
+	virtual int get_packet_peer() const override { return incoming.is_empty() ? 0 : incoming.front()->get().peer; }
+	virtual TransferMode get_packet_mode() const override { return TRANSFER_MODE_RELIABLE; }
+	virtual int get_packet_channel() const override { return 0; }
+	virtual void disconnect_peer(int p_peer, bool p_force = false) override {}
+	virtual bool is_server() const override { return true; }
+	virtual void poll() override {}
+	virtual void close() override {}
+	virtual int get_unique_id() const override { return TARGET_PEER_SERVER; }
+	virtual ConnectionStatus get_connection_status() const override { return CONNECTION_CONNECTED; }
+};
+
+TEST_CASE("[Multiplayer][SceneMultiplayer][SceneTree] Peer interest limits synchronization") {
+	Ref<SceneMultiplayer> scene_multiplayer;
+	scene_multiplayer.instantiate();
+	Ref<ReplicationTestPeer> multiplayer_peer;
+	multiplayer_peer.instantiate();
+	scene_multiplayer->set_multiplayer_peer(multiplayer_peer);
+	SceneTree::get_singleton()->set_multiplayer(scene_multiplayer);
+
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(":position"));
+
+	// Synchronizers close to the interest position, within the radius but far, and outside the radius.
+	// The last one does not use spatial interest, and is synchronized even though it is outside the radius.
+	const real_t distances[4] = { 1.0, 80.0, 200.0, 200.0 };
+	Node2D *nodes[4];
+	MultiplayerSynchronizer *synchronizers[4];
+	for (int i = 0; i < 4; i++) {
+		nodes[i] = memnew(Node2D);
+		nodes[i]->set_position(Vector2(distances[i], 0));
+		synchronizers[i] = memnew(MultiplayerSynchronizer);
+		synchronizers[i]->set_replication_config(config);
+		synchronizers[i]->set_spatial_interest_enabled(i < 3);
+		nodes[i]->add_child(synchronizers[i]);
+		SceneTree::get_singleton()->get_root()->add_child(nodes[i]);
+	}
+
+	// One peer with an area of interest, and one without.
+	const int interest_peer_id = 42;
+	const int peer_id = 84;
+	multiplayer_peer->emit_signal(SNAME("peer_connected"), interest_peer_id);
+	multiplayer_peer->emit_signal(SNAME("peer_connected"), peer_id);
+	CHECK_EQ(scene_multiplayer->set_peer_interest(interest_peer_id, Vector3(), 100.0), Error::OK);
+
+	// Let the peers confirm the synchronizer paths, every relevant synchronizer is sent within the maximum interval.
+	for (int i = 0; i < 2 * scene_multiplayer->get_interest_max_tick_interval(); i++) {
+		CHECK_EQ(scene_multiplayer->poll(), Error::OK);
+	}
+	multiplayer_peer->clear_sync_counts();
+
+	const int frame_count = 40;
+	for (int i = 0; i < frame_count; i++) {
+		CHECK_EQ(scene_multiplayer->poll(), Error::OK);
+	}
+
+	SUBCASE("Peers without interest get every synchronizer on every frame") {
+		for (int i = 0; i < 4; i++) {
+			CHECK_EQ(multiplayer_peer->get_sync_count(peer_id, synchronizers[i]->get_net_id()), frame_count);
+		}
+	}
+
+	SUBCASE("Close synchronizers are sent on every frame") {
+		CHECK_EQ(multiplayer_peer->get_sync_count(interest_peer_id, synchronizers[0]->get_net_id()), frame_count);
+	}
+
+	SUBCASE("Far synchronizers are sent less often") {
+		// 80% of the radius away, so once every 4 frames.
+		CHECK_EQ(multiplayer_peer->get_sync_count(interest_peer_id, synchronizers[1]->get_net_id()), frame_count / 4);
+	}
+
+	SUBCASE("Synchronizers outside the radius are skipped") {
+		CHECK_EQ(multiplayer_peer->get_sync_count(interest_peer_id, synchronizers[2]->get_net_id()), 0);
+	}
+
+	SUBCASE("Synchronizers without spatial interest are sent on every frame") {
+		CHECK_EQ(multiplayer_peer->get_sync_count(interest_peer_id, synchronizers[3]->get_net_id()), frame_count);
+	}
+
+	SUBCASE("Clearing the interest sends every synchronizer again") {
+		scene_multiplayer->clear_peer_interest(interest_peer_id);
+		multiplayer_peer->clear_sync_counts();
+		// The path of the synchronizer outside the radius still has to be confirmed.
+		CHECK_EQ(scene_multiplayer->poll(), Error::OK);
+		for (int i = 0; i < frame_count; i++) {
+			CHECK_EQ(scene_multiplayer->poll(), Error::OK);
+		}
+		for (int i = 0; i < 4; i++) {
+			CHECK_GE(multiplayer_peer->get_sync_count(interest_peer_id, synchronizers[i]->get_net_id()), frame_count);
+		}
+	}
+
+	for (int i = 0; i < 4; i++) {
+		memdelete(nodes[i]);
+	}
+	SceneTree::get_singleton()->set_multiplayer(MultiplayerAPI::create_default_interface());
+}
+
+TEST_CASE("[Multiplayer][SceneMultiplayer][SceneTree] Peer interest with a replication interval") {
+	Ref<SceneMultiplayer> scene_multiplayer;
+	scene_multiplayer.instantiate();
+	Ref<ReplicationTestPeer> multiplayer_peer;
+	multiplayer_peer.instantiate();
+	scene_multiplayer->set_multiplayer_peer(multiplayer_peer);
+	SceneTree::get_singleton()->set_multiplayer(scene_multiplayer);
+
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(":position"));
+
+	// A synchronizer sent at most once every 50 ms, 80% of the interest radius away, so once every 4 frames at most.
+	Node2D *node = memnew(Node2D);
+	node->set_position(Vector2(80.0, 0));
+	MultiplayerSynchronizer *synchronizer = memnew(MultiplayerSynchronizer);
+	synchronizer->set_replication_config(config);
+	synchronizer->set_replication_interval(0.05);
+	synchronizer->set_spatial_interest_enabled(true);
+	node->add_child(synchronizer);
+	SceneTree::get_singleton()->get_root()->add_child(node);
+
+	// The peer without interest makes the synchronizer send its state as soon as its interval elapses.
+	const int interest_peer_id = 42;
+	const int peer_id = 84;
+	multiplayer_peer->emit_signal(SNAME("peer_connected"), interest_peer_id);
+	multiplayer_peer->emit_signal(SNAME("peer_connected"), peer_id);
+	CHECK_EQ(scene_multiplayer->set_peer_interest(interest_peer_id, Vector3(), 100.0), Error::OK);
+
+	// The interval elapses once every 6 frames, which is not a multiple of the interest interval.
+	auto poll_frames = [&](int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			OS::get_singleton()->delay_usec(60000);
+			for (int j = 0; j < 6; j++) {
+				CHECK_EQ(scene_multiplayer->poll(), Error::OK);
+			}
+		}
+	};
+
+	// Let the peers confirm the synchronizer path.
+	poll_frames(2);
+	multiplayer_peer->clear_sync_counts();
+
+	const int interval_count = 6;
+	poll_frames(interval_count);
+	CHECK_EQ(multiplayer_peer->get_sync_count(peer_id, synchronizer->get_net_id()), interval_count);
+	CHECK_MESSAGE(multiplayer_peer->get_sync_count(interest_peer_id, synchronizer->get_net_id()) == interval_count,
+			"Far synchronizers should be sent whenever their replication interval elapsed, if the interest interval did too.");
+
+	memdelete(node);
+	SceneTree::get_singleton()->set_multiplayer(MultiplayerAPI::create_default_interface());
+}
+
+TEST_CASE("[Multiplayer][SceneMultiplayer][SceneTree] Peer interest with huge positions and radii") {
+	Ref<SceneMultiplayer> scene_multiplayer;
+	scene_multiplayer.instantiate();
+	Ref<ReplicationTestPeer> multiplayer_peer;
+	multiplayer_peer.instantiate();
+	scene_multiplayer->set_multiplayer_peer(multiplayer_peer);
+	SceneTree::get_singleton()->set_multiplayer(scene_multiplayer);
+
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(":position"));
+
+	// Positions past the range of the grid coordinates.
+	const real_t positions[2] = { -1e30, 1e30 };
+	Node2D *nodes[2];
+	MultiplayerSynchronizer *synchronizers[2];
+	for (int i = 0; i < 2; i++) {
+		nodes[i] = memnew(Node2D);
+		nodes[i]->set_position(Vector2(positions[i], 0));
+		synchronizers[i] = memnew(MultiplayerSynchronizer);
+		synchronizers[i]->set_replication_config(config);
+		synchronizers[i]->set_spatial_interest_enabled(true);
+		nodes[i]->add_child(synchronizers[i]);
+		SceneTree::get_singleton()->get_root()->add_child(nodes[i]);
+	}
+
+	const int peer_id = 42;
+	multiplayer_peer->emit_signal(SNAME("peer_connected"), peer_id);
+
+	SUBCASE("Synchronizers within a huge radius are sent") {
+		CHECK_EQ(scene_multiplayer->set_peer_interest(peer_id, Vector3(1e30, 0, 0), 1e31), Error::OK);
+		for (int i = 0; i < 2 * scene_multiplayer->get_interest_max_tick_interval(); i++) {
+			CHECK_EQ(scene_multiplayer->poll(), Error::OK);
+		}
+		CHECK_GT(multiplayer_peer->get_sync_count(peer_id, synchronizers[0]->get_net_id()), 0);
+		CHECK_GT(multiplayer_peer->get_sync_count(peer_id, synchronizers[1]->get_net_id()), 0);
+	}
+
+	SUBCASE("Synchronizers sharing a border cell are only sent within the radius") {
+		CHECK_EQ(scene_multiplayer->set_peer_interest(peer_id, Vector3(1e30, 0, 0), 10.0), Error::OK);
+		for (int i = 0; i < 2 * scene_multiplayer->get_interest_max_tick_interval(); i++) {
+			CHECK_EQ(scene_multiplayer->poll(), Error::OK);
+		}
+		CHECK_EQ(multiplayer_peer->get_sync_count(peer_id, synchronizers[0]->get_net_id()), 0);
+		CHECK_GT(multiplayer_peer->get_sync_count(peer_id, synchronizers[1]->get_net_id()), 0);
+	}
+
+	for (int i = 0; i < 2; i++) {
+		memdelete(nodes[i]);
+	}
+	SceneTree::get_singleton()->set_multiplayer(MultiplayerAPI::create_default_interface());
+}
+
 TEST_CASE("[Multiplayer][SceneMultiplayer][SceneTree] SceneTree has a OfflineMultiplayerPeer by default") {
 	Ref<SceneMultiplayer> scene_multiplayer = SceneTree::get_singleton()->get_multiplayer();
 	REQUIRE(scene_multiplayer->has_multiplayer_peer());
@@ -0,0 +1,187 @@
+/**************************************************************************/
+/*  test_scene_replication_codec.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../scene_replication_codec.h"
+#include "../scene_replication_config.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneReplicationCodec {
+
+static Vector<Variant> decode_values(const LocalVector<uint8_t> &p_buffer, const SceneReplicationCodec::Snapshot *p_baseline, uint32_t p_count, const LocalVector<float> &p_quantization, SceneReplicationCodec::Snapshot &r_snapshot) {
+	Vector<Variant> values;
+	Error err = SceneReplicationCodec::decode(p_buffer.ptr(), p_buffer.size(), p_baseline, p_count, r_snapshot);
+	CHECK_EQ(err, OK);
+	SceneReplicationCodec::get_values(r_snapshot, p_quantization, values);
+	return values;
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationCodec] Quantized values round trip within half a step") {
+	Vector<Variant> state = { 1.2345, Vector2(-3.217, 100.004), Vector3(0.5, -0.25, 1234.5678), Quaternion(0.1, 0.2, 0.3, 0.927), Color(0.1, 0.5, 0.9, 1.0), String("Not quantized") };
+	LocalVector<float> quantization = { 0.01f, 0.01f, 0.001f, 0.001f, 1.0f / 255.0f, 0.01f };
+
+	SceneReplicationCodec::Snapshot snapshot;
+	SceneReplicationCodec::make_snapshot(state, quantization, snapshot);
+	CHECK_EQ(snapshot.types[5], SceneReplicationCodec::QUANTIZED_NONE);
+
+	LocalVector<uint8_t> buffer;
+	CHECK_EQ(SceneReplicationCodec::encode(snapshot, nullptr, buffer), OK);
+	SceneReplicationCodec::Snapshot decoded;
+	Vector<Variant> values = decode_values(buffer, nullptr, state.size(), quantization, decoded);
+	REQUIRE_EQ(values.size(), state.size());
+
+	CHECK(Math::abs(double(values[0]) - 1.2345) <= 0.005 + CMP_EPSILON);
+	CHECK(Vector2(values[1]).distance_to(state[1]) <= 0.01);
+	CHECK(Vector3(values[2]).distance_to(state[2]) <= 0.001);
+	CHECK(Quaternion(values[3]).is_equal_approx(Quaternion(0.1, 0.2, 0.3, 0.927)));
+	CHECK(Math::abs(Color(values[4]).g - 0.5f) <= 0.5f / 255.0f + CMP_EPSILON);
+	CHECK_EQ(values[5], state[5]);
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationCodec] Delta encoding against a baseline") {
+	LocalVector<float> quantization = { 0.01f, 0.01f, 0.0f };
+	Vector<Variant> state = { Vector3(10.0, 2.0, -30.0), 0.5, 42 };
+
+	SceneReplicationCodec::Snapshot baseline;
+	SceneReplicationCodec::make_snapshot(state, quantization, baseline);
+	LocalVector<uint8_t> full;
+	CHECK_EQ(SceneReplicationCodec::encode(baseline, nullptr, full), OK);
+
+	SUBCASE("Unchanged state only takes one bit per property") {
+		LocalVector<uint8_t> buffer;
+		CHECK_EQ(SceneReplicationCodec::encode(baseline, &baseline, buffer), OK);
+		CHECK_EQ(buffer.size(), 1);
+
+		SceneReplicationCodec::Snapshot decoded;
+		Vector<Variant> values = decode_values(buffer, &baseline, state.size(), quantization, decoded);
+		CHECK(Vector3(values[0]).is_equal_approx(Vector3(10.0, 2.0, -30.0)));
+		CHECK(Math::is_equal_approx(double(values[1]), 0.5));
+		CHECK_EQ(int(values[2]), 42);
+	}
+
+	SUBCASE("Small changes are smaller than the full state") {
+		state.write[0] = Vector3(10.05, 2.0, -29.98);
+		state.write[2] = 43;
+		SceneReplicationCodec::Snapshot snapshot;
+		SceneReplicationCodec::make_snapshot(state, quantization, snapshot);
+		LocalVector<uint8_t> buffer;
+		CHECK_EQ(SceneReplicationCodec::encode(snapshot, &baseline, buffer), OK);
+		CHECK(buffer.size() < full.size());
+
+		SceneReplicationCodec::Snapshot decoded;
+		Vector<Variant> values = decode_values(buffer, &baseline, state.size(), quantization, decoded);
+		CHECK(Vector3(values[0]).is_equal_approx(Vector3(10.05, 2.0, -29.98)));
+		CHECK(Math::is_equal_approx(double(values[1]), 0.5));
+		CHECK_EQ(int(values[2]), 43);
+		CHECK(memcmp(decoded.components.ptr(), snapshot.components.ptr(), snapshot.components.size() * sizeof(int64_t)) == 0);
+	}
+
+	SUBCASE("Type changes are encoded without the baseline") {
+		state.write[1] = Vector2(1.0, 2.0);
+		SceneReplicationCodec::Snapshot snapshot;
+		SceneReplicationCodec::make_snapshot(state, quantization, snapshot);
+		LocalVector<uint8_t> buffer;
+		CHECK_EQ(SceneReplicationCodec::encode(snapshot, &baseline, buffer), OK);
+
+		SceneReplicationCodec::Snapshot decoded;
+		Vector<Variant> values = decode_values(buffer, &baseline, state.size(), quantization, decoded);
+		CHECK(Vector2(values[1]).is_equal_approx(Vector2(1.0, 2.0)));
+	}
+
+	SUBCASE("Deltas out of the integer range wrap around") {
+		// Received deltas can be anything, decoding must not overflow.
+		SceneReplicationCodec::Snapshot snapshot;
+		SceneReplicationCodec::make_snapshot(state, quantization, snapshot);
+		SceneReplicationCodec::Snapshot extreme_baseline = baseline;
+		extreme_baseline.components[0] = INT64_MAX;
+		snapshot.components[0] = INT64_MIN;
+		LocalVector<uint8_t> buffer;
+		CHECK_EQ(SceneReplicationCodec::encode(snapshot, &extreme_baseline, buffer), OK);
+
+		SceneReplicationCodec::Snapshot decoded;
+		CHECK_EQ(SceneReplicationCodec::decode(buffer.ptr(), buffer.size(), &extreme_baseline, state.size(), decoded), OK);
+		CHECK_EQ(decoded.components[0], INT64_MIN);
+	}
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationCodec] Invalid data") {
+	LocalVector<float> quantization = { 0.01f, 0.0f };
+	Vector<Variant> state = { Vector3(1.0, 2.0, 3.0), String("Text") };
+	SceneReplicationCodec::Snapshot snapshot;
+	SceneReplicationCodec::make_snapshot(state, quantization, snapshot);
+	LocalVector<uint8_t> buffer;
+	CHECK_EQ(SceneReplicationCodec::encode(snapshot, nullptr, buffer), OK);
+
+	SceneReplicationCodec::Snapshot decoded;
+	ERR_PRINT_OFF;
+	CHECK_NE(SceneReplicationCodec::decode(buffer.ptr(), buffer.size() - 1, nullptr, state.size(), decoded), OK);
+	CHECK_NE(SceneReplicationCodec::decode(buffer.ptr(), buffer.size(), nullptr, state.size() + 1, decoded), OK);
+	CHECK_NE(SceneReplicationCodec::decode(buffer.ptr(), buffer.size(), &snapshot, state.size() + 1, decoded), OK);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationConfig] Quantization") {
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(".:position"));
+	config->add_property(NodePath(".:rotation"));
+	config->add_property(NodePath(".:name"));
+	config->property_set_replication_mode(NodePath(".:rotation"), SceneReplicationConfig::REPLICATION_MODE_ON_CHANGE);
+	CHECK_FALSE(config->has_quantized_properties());
+
+	config->property_set_quantization(NodePath(".:position"), 0.01);
+	config->property_set_quantization(NodePath(".:rotation"), 0.001);
+	CHECK(config->has_quantized_properties());
+	CHECK(Math::is_equal_approx(config->property_get_quantization(NodePath(".:position")), 0.01f));
+	CHECK_EQ(config->property_get_quantization(NodePath(".:name")), 0.0f);
+
+	const LocalVector<float> &sync_quantization = config->get_sync_quantization();
+	REQUIRE_EQ(sync_quantization.size(), 2);
+	CHECK(Math::is_equal_approx(sync_quantization[0], 0.01f));
+	CHECK_EQ(sync_quantization[1], 0.0f);
+	const LocalVector<float> &watch_quantization = config->get_watch_quantization();
+	REQUIRE_EQ(watch_quantization.size(), 1);
+	CHECK(Math::is_equal_approx(watch_quantization[0], 0.001f));
+
+	ERR_PRINT_OFF;
+	config->property_set_quantization(NodePath(".:position"), -1.0);
+	ERR_PRINT_ON;
+	CHECK(Math::is_equal_approx(config->property_get_quantization(NodePath(".:position")), 0.01f));
+
+	// Stored with the other property settings.
+	CHECK(Math::is_equal_approx(float(config->get("properties/0/quantization")), 0.01f));
+	config->set("properties/1/quantization", 0.0);
+	config->set("properties/0/quantization", 0.0);
+	CHECK_FALSE(config->has_quantized_properties());
+}
+
+} // namespace TestSceneReplicationCodec
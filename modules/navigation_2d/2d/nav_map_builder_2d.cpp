@@ -69,6 +69,8 @@ void NavMapBuilder2D::build_navmap_iteration(NavMapIterationBuild2D &r_build) {
 
 	_build_step_navlink_connections(r_build);
 
+	_build_step_region_bvh(r_build);
+
 	_build_update_map_iteration(r_build);
 }
 
@@ -391,6 +393,28 @@ void NavMapBuilder2D::_build_step_navlink_connections(NavMapIterationBuild2D &r_
 	r_build.polygon_count = polygon_count;
 }
 
+void NavMapBuilder2D::_build_step_region_bvh(NavMapIterationBuild2D &r_build) {
+	NavMapIteration2D *map_iteration = r_build.map_iteration;
+	const LocalVector<Ref<NavRegionIteration2D>> &regions = map_iteration->region_iterations;
+
+	LocalVector<NavBVH2D::Item> items;
+	items.reserve(regions.size());
+
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		const NavBVH2D &polygon_bvh = regions[i]->get_polygon_bvh();
+		if (polygon_bvh.is_empty()) {
+			continue;
+		}
+
+		NavBVH2D::Item item;
+		item.bounds = polygon_bvh.get_bounds();
+		item.id = i;
+		items.push_back(item);
+	}
+
+	map_iteration->region_bvh.build(items);
+}
+
 void NavMapBuilder2D::_build_update_map_iteration(NavMapIterationBuild2D &r_build) {
 	NavMapIteration2D *map_iteration = r_build.map_iteration;
 
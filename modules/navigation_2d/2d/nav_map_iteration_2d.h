@@ -31,6 +31,7 @@
 #pragma once
 
 #include "../nav_utils_2d.h"
+#include "nav_bvh_2d.h"
 #include "nav_mesh_queries_2d.h"
 
 #include "core/math/math_defs.h"
@@ -77,6 +78,9 @@ struct NavMapIteration2D {
 	LocalVector<Ref<NavRegionIteration2D>> region_iterations;
 	LocalVector<Ref<NavLinkIteration2D>> link_iterations;
 
+	// Bounds of the region iterations, indexed like `region_iterations`.
+	NavBVH2D region_bvh;
+
 	int navmesh_polygon_count = 0;
 
 	// The edge connections that the map builds on top with the edge connection margin.
@@ -96,6 +100,7 @@ struct NavMapIteration2D {
 
 		region_iterations.clear();
 		link_iterations.clear();
+		region_bvh.clear();
 		external_region_connections.clear();
 		navbases_polygons_external_connections.clear();
 		navlink_polygons.clear();
@@ -236,44 +236,53 @@ void NavMeshQueries2D::map_query_path(NavMap2D *p_map, const Ref<NavigationPathQ
 }
 
 void NavMeshQueries2D::_query_task_find_start_end_positions(NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration) {
-	real_t begin_d = FLT_MAX;
-	real_t end_d = FLT_MAX;
-
 	const LocalVector<Ref<NavRegionIteration2D>> &regions = p_map_iteration.region_iterations;
 
-	for (const Ref<NavRegionIteration2D> &region : regions) {
-		if (!_query_task_is_connection_owner_usable(p_query_task, region.ptr())) {
-			continue;
-		}
-
-		// Find the initial poly and the end poly on this map.
-		for (const Polygon &p : region->get_navmesh_polygons()) {
-			// Only consider the polygon if it in a region with compatible layers.
-			if ((p_query_task.navigation_layers & p.owner->get_navigation_layers()) == 0) {
-				continue;
-			}
+	// Find the initial poly and the end poly on this map.
+	for (int i = 0; i < 2; i++) {
+		const bool is_begin = i == 0;
+		const Vector2 &position = is_begin ? p_query_task.start_position : p_query_task.target_position;
+		real_t closest_distance_squared = FLT_MAX;
 
-			// For each triangle check the distance between the origin/destination.
-			for (uint32_t point_id = 2; point_id < p.vertices.size(); point_id++) {
-				const Triangle2 triangle(p.vertices[0], p.vertices[point_id - 1], p.vertices[point_id]);
+		const auto node_distance = [&position](const Rect2 &p_bounds) {
+			return NavBVH2D::get_distance_squared_to_point(p_bounds, position);
+		};
 
-				Vector2 point = triangle.get_closest_point_to(p_query_task.start_position);
-				real_t distance_to_point = point.distance_to(p_query_task.start_position);
-				if (distance_to_point < begin_d) {
-					begin_d = distance_to_point;
-					p_query_task.begin_polygon = &p;
-					p_query_task.begin_position = point;
-				}
+		p_map_iteration.region_bvh.query_nearest(node_distance, [&](uint32_t p_region_index) {
+			const NavRegionIteration2D *region = regions[p_region_index].ptr();
+			if (!_query_task_is_connection_owner_usable(p_query_task, region)) {
+				return;
+			}
+			// Only consider the polygons if they are in a region with compatible layers.
+			if ((p_query_task.navigation_layers & region->get_navigation_layers()) == 0) {
+				return;
+			}
 
-				point = triangle.get_closest_point_to(p_query_task.target_position);
-				distance_to_point = point.distance_to(p_query_task.target_position);
-				if (distance_to_point < end_d) {
-					end_d = distance_to_point;
-					p_query_task.end_polygon = &p;
-					p_query_task.end_position = point;
+			const LocalVector<Polygon> &polygons = region->get_navmesh_polygons();
+			region->get_polygon_bvh().query_nearest(node_distance, [&](uint32_t p_polygon_index) {
+				const Polygon &p = polygons[p_polygon_index];
+
+				// For each triangle check the distance to the origin/destination.
+				for (uint32_t point_id = 2; point_id < p.vertices.size(); point_id++) {
+					const Triangle2 triangle(p.vertices[0], p.vertices[point_id - 1], p.vertices[point_id]);
+
+					const Vector2 point = triangle.get_closest_point_to(position);
+					const real_t distance_squared = point.distance_squared_to(position);
+					if (distance_squared < closest_distance_squared) {
+						closest_distance_squared = distance_squared;
+						if (is_begin) {
+							p_query_task.begin_polygon = &p;
+							p_query_task.begin_position = point;
+						} else {
+							p_query_task.end_polygon = &p;
+							p_query_task.end_position = point;
+						}
+					}
 				}
-			}
-		}
+			},
+					closest_distance_squared);
+		},
+				closest_distance_squared);
 	}
 }
 
@@ -892,11 +901,16 @@ ClosestPointQueryResult NavMeshQueries2D::map_iteration_get_closest_point_info(c
 	ClosestPointQueryResult result;
 	real_t closest_point_distance_squared = FLT_MAX;
 
-	// TODO: Check for further 2D improvements.
-
 	const LocalVector<Ref<NavRegionIteration2D>> &regions = p_map_iteration.region_iterations;
-	for (const Ref<NavRegionIteration2D> &region : regions) {
-		for (const Polygon &polygon : region->get_navmesh_polygons()) {
+
+	const auto node_distance = [&p_point](const Rect2 &p_bounds) {
+		return NavBVH2D::get_distance_squared_to_point(p_bounds, p_point);
+	};
+
+	p_map_iteration.region_bvh.query_nearest(node_distance, [&](uint32_t p_region_index) {
+		const LocalVector<Polygon> &polygons = regions[p_region_index]->get_navmesh_polygons();
+		regions[p_region_index]->get_polygon_bvh().query_nearest(node_distance, [&](uint32_t p_polygon_index) {
+			const Polygon &polygon = polygons[p_polygon_index];
 			real_t cross = -(polygon.vertices[1] - polygon.vertices[0]).cross(polygon.vertices[2] - polygon.vertices[0]);
 			Vector2 closest_on_polygon;
 			real_t closest = FLT_MAX;
@@ -939,8 +953,6 @@ ClosestPointQueryResult NavMeshQueries2D::map_iteration_get_closest_point_info(c
 				closest_point_distance_squared = 0.0;
 				result.point = p_point;
 				result.owner = polygon.owner->get_self();
-
-				break;
 			} else {
 				real_t distance = closest_on_polygon.distance_squared_to(p_point);
 				if (distance < closest_point_distance_squared) {
@@ -949,8 +961,10 @@ ClosestPointQueryResult NavMeshQueries2D::map_iteration_get_closest_point_info(c
 					result.owner = polygon.owner->get_self();
 				}
 			}
-		}
-	}
+		},
+				closest_point_distance_squared);
+	},
+			closest_point_distance_squared);
 
 	return result;
 }
@@ -52,6 +52,8 @@ void NavRegionBuilder2D::build_iteration(NavRegionIterationBuild2D &r_build) {
 
 	_build_step_merge_edge_connection_pairs(r_build);
 
+	_build_step_polygon_bvh(r_build);
+
 	_build_update_iteration(r_build);
 }
 
@@ -255,6 +257,32 @@ void NavRegionBuilder2D::_build_step_merge_edge_connection_pairs(NavRegionIterat
 	}
 }
 
+void NavRegionBuilder2D::_build_step_polygon_bvh(NavRegionIterationBuild2D &r_build) {
+	Ref<NavRegionIteration2D> region_iteration = r_build.region_iteration;
+	const LocalVector<Nav2D::Polygon> &navmesh_polygons = region_iteration->navmesh_polygons;
+
+	LocalVector<NavBVH2D::Item> items;
+	items.reserve(navmesh_polygons.size());
+
+	for (const Polygon &polygon : navmesh_polygons) {
+		if (polygon.vertices.size() < 3) {
+			continue;
+		}
+
+		NavBVH2D::Item item;
+		item.id = polygon.id;
+		item.bounds.position = polygon.vertices[0];
+		for (uint32_t i = 1; i < polygon.vertices.size(); i++) {
+			item.bounds.expand_to(polygon.vertices[i]);
+		}
+		item.bounds.grow_by(CMP_EPSILON);
+
+		items.push_back(item);
+	}
+
+	region_iteration->polygon_bvh.build(items);
+}
+
 void NavRegionBuilder2D::_build_update_iteration(NavRegionIterationBuild2D &r_build) {
 	ERR_FAIL_NULL(r_build.region);
 	// Stub. End of the build.
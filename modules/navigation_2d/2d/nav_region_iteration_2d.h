@@ -32,6 +32,7 @@
 
 #include "../nav_utils_2d.h"
 #include "nav_base_iteration_2d.h"
+#include "nav_bvh_2d.h"
 
 #include "core/math/rect2.h"
 
@@ -77,14 +78,17 @@ public:
 	real_t surface_area = 0.0;
 	Rect2 bounds;
 	LocalVector<Nav2D::ConnectableEdge> external_edges;
+	NavBVH2D polygon_bvh;
 
 	const Transform2D &get_transform() const { return transform; }
 	real_t get_surface_area() const { return surface_area; }
 	Rect2 get_bounds() const { return bounds; }
 	const LocalVector<Nav2D::ConnectableEdge> &get_external_edges() const { return external_edges; }
+	const NavBVH2D &get_polygon_bvh() const { return polygon_bvh; }
 
 	virtual ~NavRegionIteration2D() override {
 		external_edges.clear();
+		polygon_bvh.clear();
 		navmesh_polygons.clear();
 		internal_connections.clear();
 	}
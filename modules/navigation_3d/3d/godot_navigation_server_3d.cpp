@@ -1232,6 +1232,9 @@ COMMAND_1(free_rid, RID, p_object) {
 	if (map_owner.owns(p_object)) {
 		NavMap3D *map = map_owner.get_or_null(p_object);
 
+		// Path query batches still read from the map iterations.
+		_finish_path_query_batches(map);
+
 		// Removes any assigned region
 		for (NavRegion3D *region : map->get_regions()) {
 			map->remove_region(region);
@@ -1370,6 +1373,8 @@ void GodotNavigationServer3D::sync() {
 	if (navmesh_generator_3d) {
 		navmesh_generator_3d->sync();
 	}
+
+	_sync_path_query_batches();
 }
 
 void GodotNavigationServer3D::process(double p_delta_time) {
@@ -1441,6 +1446,7 @@ void GodotNavigationServer3D::init() {
 
 void GodotNavigationServer3D::finish() {
 	flush_queries();
+	_finish_path_query_batches();
 	if (navmesh_generator_3d) {
 		navmesh_generator_3d->finish();
 		memdelete(navmesh_generator_3d);
@@ -1458,6 +1464,107 @@ void GodotNavigationServer3D::query_path(const Ref<NavigationPathQueryParameters
 	NavMeshQueries3D::map_query_path(map, p_query_parameters, p_query_result, p_callback);
 }
 
+int64_t GodotNavigationServer3D::query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_V(p_query_parameters.is_empty(), -1);
+	ERR_FAIL_COND_V_MSG(p_query_parameters.size() != p_query_results.size(), -1, "The number of path query parameters and results must match.");
+
+	NavMeshQueries3D::PathQueryBatch3D *batch = memnew(NavMeshQueries3D::PathQueryBatch3D);
+	batch->query_parameters.resize(p_query_parameters.size());
+	batch->query_results.resize(p_query_results.size());
+	batch->callback = p_callback;
+
+	RID map_rid;
+	for (uint32_t i = 0; i < batch->query_parameters.size(); i++) {
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		const Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		if (query_parameters.is_null() || query_result.is_null() || (i > 0 && query_parameters->get_map() != map_rid)) {
+			memdelete(batch);
+			ERR_FAIL_V_MSG(-1, "All path queries of a batch need valid parameters and results that use the same navigation map.");
+		}
+		map_rid = query_parameters->get_map();
+		batch->query_parameters[i] = query_parameters;
+		batch->query_results[i] = query_result;
+	}
+
+	batch->map = map_owner.get_or_null(map_rid);
+	if (batch->map == nullptr) {
+		memdelete(batch);
+		ERR_FAIL_V_MSG(-1, "Path query batch navigation map not found.");
+	}
+
+	// All queries of the batch see the same map state, even if the map syncs in the meantime.
+	batch->map_iteration = batch->map->acquire_iteration();
+
+	MutexLock lock(path_query_batch_mutex);
+	batch->group_task_id = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshQueries3D::map_query_path_batch_thread, batch, batch->query_parameters.size(), -1, false, SNAME("NavPathQueryBatch3D"));
+	path_query_batches.insert(batch->group_task_id, batch);
+	return batch->group_task_id;
+}
+
+bool GodotNavigationServer3D::is_path_query_batch_completed(int64_t p_batch_id) const {
+	MutexLock lock(path_query_batch_mutex);
+	if (!path_query_batches.has(p_batch_id)) {
+		// Already finished and released by the server.
+		return true;
+	}
+	return WorkerThreadPool::get_singleton()->is_group_task_completed(p_batch_id);
+}
+
+void GodotNavigationServer3D::_sync_path_query_batches() {
+	LocalVector<NavMeshQueries3D::PathQueryBatch3D *> finished_batches;
+	{
+		MutexLock lock(path_query_batch_mutex);
+		if (path_query_batches.is_empty()) {
+			return;
+		}
+
+		for (const KeyValue<WorkerThreadPool::GroupID, NavMeshQueries3D::PathQueryBatch3D *> &E : path_query_batches) {
+			if (WorkerThreadPool::get_singleton()->is_group_task_completed(E.key)) {
+				finished_batches.push_back(E.value);
+			}
+		}
+		for (NavMeshQueries3D::PathQueryBatch3D *batch : finished_batches) {
+			path_query_batches.erase(batch->group_task_id);
+		}
+	}
+
+	// Callbacks run outside of the lock so that they can submit new batches.
+	for (NavMeshQueries3D::PathQueryBatch3D *batch : finished_batches) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->group_task_id);
+		if (batch->map_iteration) {
+			batch->map->release_iteration(batch->map_iteration);
+		}
+		if (batch->callback.is_valid()) {
+			NavMeshQueries3D::emit_callback(batch->callback);
+		}
+		memdelete(batch);
+	}
+}
+
+void GodotNavigationServer3D::_finish_path_query_batches(const NavMap3D *p_map) {
+	LocalVector<NavMeshQueries3D::PathQueryBatch3D *> finished_batches;
+	{
+		MutexLock lock(path_query_batch_mutex);
+		for (const KeyValue<WorkerThreadPool::GroupID, NavMeshQueries3D::PathQueryBatch3D *> &E : path_query_batches) {
+			if (p_map == nullptr || E.value->map == p_map) {
+				finished_batches.push_back(E.value);
+			}
+		}
+		for (NavMeshQueries3D::PathQueryBatch3D *batch : finished_batches) {
+			path_query_batches.erase(batch->group_task_id);
+		}
+	}
+
+	// The map is about to go away, wait for its queries but do not call back into scripts.
+	for (NavMeshQueries3D::PathQueryBatch3D *batch : finished_batches) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->group_task_id);
+		if (batch->map_iteration) {
+			batch->map->release_iteration(batch->map_iteration);
+		}
+		memdelete(batch);
+	}
+}
+
 RID GodotNavigationServer3D::source_geometry_parser_create() {
 	RWLockWrite write_lock(geometry_parser_rwlock);
 
@@ -36,6 +36,7 @@
 #include "../nav_obstacle_3d.h"
 #include "../nav_region_3d.h"
 
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
@@ -82,6 +83,9 @@ class GodotNavigationServer3D : public NavigationServer3D {
 
 	NavMeshGenerator3D *navmesh_generator_3d = nullptr;
 
+	mutable Mutex path_query_batch_mutex;
+	HashMap<WorkerThreadPool::GroupID, NavMeshQueries3D::PathQueryBatch3D *> path_query_batches;
+
 	// Performance Monitor
 	int pm_region_count = 0;
 	int pm_agent_count = 0;
@@ -293,12 +297,17 @@ public:
 	virtual void finish() override;
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback = Callable()) override;
+	virtual int64_t query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable()) override;
+	virtual bool is_path_query_batch_completed(int64_t p_batch_id) const override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+
+	void _sync_path_query_batches();
+	void _finish_path_query_batches(const NavMap3D *p_map = nullptr);
 };
 
 #undef COMMAND_1
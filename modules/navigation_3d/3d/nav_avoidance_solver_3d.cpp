@@ -0,0 +1,520 @@
+/**************************************************************************/
+/*  nav_avoidance_solver_3d.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_avoidance_solver_3d.h"
+
+#include "../nav_agent_3d.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/sort_array.h"
+
+#include <Agent2d.h>
+#include <KdTree2d.h>
+#include <RVOSimulator2d.h>
+
+#include <cfloat> // FLT_MAX
+
+static _FORCE_INLINE_ uint32_t _get_cell_coordinate(float p_value, float p_min, float p_inv_cell_size, uint32_t p_size) {
+	const float coordinate = (p_value - p_min) * p_inv_cell_size;
+	// Also catches NaN.
+	if (!(coordinate >= 0.0f)) {
+		return 0;
+	}
+	if (coordinate >= float(p_size)) {
+		return p_size - 1;
+	}
+	return MIN(uint32_t(coordinate), p_size - 1);
+}
+
+void NavAvoidanceSolver3D::Agents::resize(uint32_t p_size) {
+	position_x.resize(p_size);
+	position_y.resize(p_size);
+	velocity_x.resize(p_size);
+	velocity_y.resize(p_size);
+	radius.resize(p_size);
+	elevation.resize(p_size);
+	height.resize(p_size);
+	avoidance_priority.resize(p_size);
+	avoidance_layers.resize(p_size);
+}
+
+void NavAvoidanceSolver3D::_gather_task(uint32_t p_task_index, void *p_userdata) {
+	const uint32_t begin = p_task_index * AGENTS_PER_TASK;
+	const uint32_t end = MIN(begin + AGENTS_PER_TASK, agent_count);
+
+	for (uint32_t i = begin; i < end; i++) {
+		const RVO2D::Agent2D *rvo_agent = agents[i]->get_rvo_agent_2d();
+		unsorted.position_x[i] = rvo_agent->position_.x();
+		unsorted.position_y[i] = rvo_agent->position_.y();
+		unsorted.velocity_x[i] = rvo_agent->velocity_.x();
+		unsorted.velocity_y[i] = rvo_agent->velocity_.y();
+		unsorted.radius[i] = rvo_agent->radius_;
+		unsorted.elevation[i] = rvo_agent->elevation_;
+		unsorted.height[i] = rvo_agent->height_;
+		unsorted.avoidance_priority[i] = rvo_agent->avoidance_priority_;
+		unsorted.avoidance_layers[i] = rvo_agent->avoidance_layers_;
+		neighbor_distance[i] = rvo_agent->maxNeighbors_ > 0 ? rvo_agent->neighborDist_ : 0.0f;
+	}
+
+	Bounds &bounds = task_bounds[p_task_index];
+	bounds.min_x = FLT_MAX;
+	bounds.min_y = FLT_MAX;
+	bounds.max_x = -FLT_MAX;
+	bounds.max_y = -FLT_MAX;
+	for (uint32_t i = begin; i < end; i++) {
+		bounds.min_x = MIN(bounds.min_x, unsorted.position_x[i]);
+		bounds.min_y = MIN(bounds.min_y, unsorted.position_y[i]);
+		bounds.max_x = MAX(bounds.max_x, unsorted.position_x[i]);
+		bounds.max_y = MAX(bounds.max_y, unsorted.position_y[i]);
+	}
+}
+
+void NavAvoidanceSolver3D::_build_grid(bool p_use_threads) {
+	float min_x = FLT_MAX;
+	float min_y = FLT_MAX;
+	float max_x = -FLT_MAX;
+	float max_y = -FLT_MAX;
+	for (const Bounds &bounds : task_bounds) {
+		min_x = MIN(min_x, bounds.min_x);
+		min_y = MIN(min_y, bounds.min_y);
+		max_x = MAX(max_x, bounds.max_x);
+		max_y = MAX(max_y, bounds.max_y);
+	}
+
+	// Size the cells for a few agents per cell on average, the neighbor searches
+	// visit the cells nearest first and stop once the remaining cells are out of range.
+	grid_min_x = min_x;
+	grid_min_y = min_y;
+	const double extent_x = MAX(double(max_x - min_x), 0.01);
+	const double extent_y = MAX(double(max_y - min_y), 0.01);
+	grid_cell_size = float(Math::sqrt(extent_x * extent_y * AGENTS_PER_CELL / agent_count));
+
+	const double max_cells = double(agent_count) * MAX_CELLS_PER_AGENT;
+	double width = Math::floor(extent_x / grid_cell_size) + 1.0;
+	double height = Math::floor(extent_y / grid_cell_size) + 1.0;
+	if (width * height > max_cells) {
+		// The agents are all on a line.
+		grid_cell_size *= float(Math::sqrt(width * height / max_cells));
+		width = Math::floor(extent_x / grid_cell_size) + 1.0;
+		height = Math::floor(extent_y / grid_cell_size) + 1.0;
+	}
+	if (!(width * height <= max_cells * 2.0)) {
+		// Positions that are not finite.
+		width = 1.0;
+		height = 1.0;
+	}
+	grid_width = uint32_t(width);
+	grid_height = uint32_t(height);
+
+	// Counting sort of the agents by cell. Each task counts its agents in runs of the same cell, the runs are then
+	// placed in task order so every cell lists its agents by agent index, which keeps the steps deterministic.
+	const uint32_t cell_count = grid_width * grid_height;
+	cell_start.resize(cell_count + 1);
+	cell_cursor.resize(cell_count);
+	memset(cell_start.ptr(), 0, cell_start.size() * sizeof(uint32_t));
+
+	_run_tasks(&NavAvoidanceSolver3D::_count_task, p_use_threads, SNAME("NavAvoidanceCount3D"));
+
+	// Single passes over the runs and the cells, which are cheap next to finding the cells and placing the agents.
+	for (uint32_t task = 0; task < task_run_count.size(); task++) {
+		const CellRun *runs = cell_runs.ptr() + task * AGENTS_PER_TASK;
+		for (uint32_t run = 0; run < task_run_count[task]; run++) {
+			cell_start[runs[run].cell] += runs[run].count;
+		}
+	}
+	uint32_t sum = 0;
+	for (uint32_t cell = 0; cell < cell_count; cell++) {
+		const uint32_t count = cell_start[cell];
+		cell_start[cell] = sum;
+		cell_cursor[cell] = sum;
+		sum += count;
+	}
+	cell_start[cell_count] = sum;
+	for (uint32_t task = 0; task < task_run_count.size(); task++) {
+		CellRun *runs = cell_runs.ptr() + task * AGENTS_PER_TASK;
+		for (uint32_t run = 0; run < task_run_count[task]; run++) {
+			runs[run].start = cell_cursor[runs[run].cell];
+			cell_cursor[runs[run].cell] += runs[run].count;
+		}
+	}
+
+	_run_tasks(&NavAvoidanceSolver3D::_scatter_task, p_use_threads, SNAME("NavAvoidanceScatter3D"));
+}
+
+void NavAvoidanceSolver3D::_count_task(uint32_t p_task_index, void *p_userdata) {
+	const uint32_t begin = p_task_index * AGENTS_PER_TASK;
+	const uint32_t end = MIN(begin + AGENTS_PER_TASK, agent_count);
+
+	const float inv_cell_size = 1.0f / grid_cell_size;
+	for (uint32_t i = begin; i < end; i++) {
+		const uint32_t cell_x = _get_cell_coordinate(unsorted.position_x[i], grid_min_x, inv_cell_size, grid_width);
+		const uint32_t cell_y = _get_cell_coordinate(unsorted.position_y[i], grid_min_y, inv_cell_size, grid_height);
+		const uint32_t cell = cell_y * grid_width + cell_x;
+		agent_cell_keys[i] = (uint64_t(cell) << 32) | i;
+	}
+
+	SortArray<uint64_t> sorter;
+	sorter.sort(agent_cell_keys.ptr() + begin, end - begin);
+
+	CellRun *runs = cell_runs.ptr() + begin;
+	uint32_t run_count = 0;
+	for (uint32_t i = begin; i < end; i++) {
+		const uint32_t cell = uint32_t(agent_cell_keys[i] >> 32);
+		if (run_count == 0 || runs[run_count - 1].cell != cell) {
+			runs[run_count].cell = cell;
+			runs[run_count].count = 0;
+			run_count++;
+		}
+		runs[run_count - 1].count++;
+	}
+	task_run_count[p_task_index] = run_count;
+}
+
+void NavAvoidanceSolver3D::_scatter_task(uint32_t p_task_index, void *p_userdata) {
+	const uint32_t begin = p_task_index * AGENTS_PER_TASK;
+
+	const CellRun *runs = cell_runs.ptr() + begin;
+	const uint64_t *keys = agent_cell_keys.ptr() + begin;
+	for (uint32_t run = 0; run < task_run_count[p_task_index]; run++) {
+		for (uint32_t i = 0; i < runs[run].count; i++) {
+			sorted_agent_index[runs[run].start + i] = uint32_t(*keys++);
+		}
+	}
+}
+
+void NavAvoidanceSolver3D::_sort_task(uint32_t p_task_index, void *p_userdata) {
+	const uint32_t begin = p_task_index * AGENTS_PER_TASK;
+	const uint32_t end = MIN(begin + AGENTS_PER_TASK, agent_count);
+
+	for (uint32_t sorted_index = begin; sorted_index < end; sorted_index++) {
+		const uint32_t i = sorted_agent_index[sorted_index];
+		sorted.position_x[sorted_index] = unsorted.position_x[i];
+		sorted.position_y[sorted_index] = unsorted.position_y[i];
+		sorted.velocity_x[sorted_index] = unsorted.velocity_x[i];
+		sorted.velocity_y[sorted_index] = unsorted.velocity_y[i];
+		sorted.radius[sorted_index] = unsorted.radius[i];
+		sorted.elevation[sorted_index] = unsorted.elevation[i];
+		sorted.height[sorted_index] = unsorted.height[i];
+		sorted.avoidance_priority[sorted_index] = unsorted.avoidance_priority[i];
+		sorted.avoidance_layers[sorted_index] = unsorted.avoidance_layers[i];
+	}
+}
+
+void NavAvoidanceSolver3D::_find_agent_neighbors(uint32_t p_sorted_index, const RVO2D::Agent2D *p_rvo_agent, NeighborScratch &r_scratch) const {
+	LocalVector<uint32_t> &neighbors = r_scratch.neighbors;
+	LocalVector<float> &neighbors_distance_squared = r_scratch.neighbors_distance_squared;
+	neighbors.clear();
+	neighbors_distance_squared.clear();
+
+	const float range = neighbor_distance[sorted_agent_index[p_sorted_index]];
+	if (range <= 0.0f) {
+		return;
+	}
+
+	const uint32_t max_neighbors = p_rvo_agent->maxNeighbors_;
+	const uint32_t avoidance_mask = p_rvo_agent->avoidance_mask_;
+	const float position_x = sorted.position_x[p_sorted_index];
+	const float position_y = sorted.position_y[p_sorted_index];
+	const float elevation = sorted.elevation[p_sorted_index];
+	const float height = sorted.height[p_sorted_index];
+	const float avoidance_priority = sorted.avoidance_priority[p_sorted_index];
+
+	float range_squared = range * range;
+
+	// Scans the agents of a range of sorted indices.
+	auto scan = [&](uint32_t p_begin, uint32_t p_end) {
+		const uint32_t count = p_end - p_begin;
+		if (count == 0) {
+			return;
+		}
+
+		if (r_scratch.distance_squared.size() < count) {
+			r_scratch.distance_squared.resize(count);
+		}
+		float *distance_squared = r_scratch.distance_squared.ptr();
+		const float *other_position_x = sorted.position_x.ptr() + p_begin;
+		const float *other_position_y = sorted.position_y.ptr() + p_begin;
+		for (uint32_t j = 0; j < count; j++) {
+			const float delta_x = position_x - other_position_x[j];
+			const float delta_y = position_y - other_position_y[j];
+			distance_squared[j] = delta_x * delta_x + delta_y * delta_y;
+		}
+
+		for (uint32_t j = 0; j < count; j++) {
+			const float distance = distance_squared[j];
+			if (distance >= range_squared) {
+				continue;
+			}
+
+			const uint32_t other = p_begin + j;
+			if (other == p_sorted_index) {
+				continue;
+			}
+			// Ignore the other agent if layers/mask bitmasks have no matching bit.
+			if ((avoidance_mask & sorted.avoidance_layers[other]) == 0) {
+				continue;
+			}
+			// Ignore the other agent if this agent is below or above.
+			if ((elevation > sorted.elevation[other] + sorted.height[other]) || (elevation + height < sorted.elevation[other])) {
+				continue;
+			}
+			if (avoidance_priority > sorted.avoidance_priority[other]) {
+				continue;
+			}
+
+			// Keep the nearest neighbors sorted by distance, like the RVO2 agent does.
+			if (neighbors.size() < max_neighbors) {
+				neighbors.push_back(other);
+				neighbors_distance_squared.push_back(distance);
+			}
+
+			uint32_t insert_index = neighbors.size() - 1;
+			while (insert_index != 0 && distance < neighbors_distance_squared[insert_index - 1]) {
+				neighbors[insert_index] = neighbors[insert_index - 1];
+				neighbors_distance_squared[insert_index] = neighbors_distance_squared[insert_index - 1];
+				insert_index--;
+			}
+			neighbors[insert_index] = other;
+			neighbors_distance_squared[insert_index] = distance;
+
+			if (neighbors.size() == max_neighbors) {
+				range_squared = neighbors_distance_squared[neighbors.size() - 1];
+			}
+		}
+	};
+
+	const float inv_cell_size = 1.0f / grid_cell_size;
+	const int64_t cell_x = _get_cell_coordinate(position_x, grid_min_x, inv_cell_size, grid_width);
+	const int64_t cell_y = _get_cell_coordinate(position_y, grid_min_y, inv_cell_size, grid_height);
+	const int64_t width = grid_width;
+	const int64_t height_in_cells = grid_height;
+	const int64_t max_ring = MAX(MAX(cell_x, width - 1 - cell_x), MAX(cell_y, height_in_cells - 1 - cell_y));
+
+	// Distance from the agent to the nearest edge of its cell.
+	const float cell_min_x = grid_min_x + cell_x * grid_cell_size;
+	const float cell_min_y = grid_min_y + cell_y * grid_cell_size;
+	const float edge_distance = MAX(0.0f, MIN(MIN(position_x - cell_min_x, cell_min_x + grid_cell_size - position_x), MIN(position_y - cell_min_y, cell_min_y + grid_cell_size - position_y)));
+
+	// Visit the rings of cells around the cell of the agent, nearest first, so the range
+	// shrinks early once the maximum number of neighbors is found.
+	for (int64_t ring = 0; ring <= max_ring; ring++) {
+		if (ring > 0) {
+			const float ring_distance = edge_distance + (ring - 1) * grid_cell_size;
+			if (ring_distance * ring_distance >= range_squared) {
+				break;
+			}
+		}
+
+		const int64_t min_x = MAX(cell_x - ring, int64_t(0));
+		const int64_t max_x = MIN(cell_x + ring, width - 1);
+		for (int64_t y = MAX(cell_y - ring, int64_t(0)); y <= MIN(cell_y + ring, height_in_cells - 1); y++) {
+			const int64_t row = y * width;
+			if (y == cell_y - ring || y == cell_y + ring) {
+				// The cells of a row are next to each other in the sorted arrays.
+				scan(cell_start[row + min_x], cell_start[row + max_x + 1]);
+			} else {
+				if (cell_x - ring >= 0) {
+					scan(cell_start[row + cell_x - ring], cell_start[row + cell_x - ring + 1]);
+				}
+				if (cell_x + ring < width) {
+					scan(cell_start[row + cell_x + ring], cell_start[row + cell_x + ring + 1]);
+				}
+			}
+		}
+	}
+}
+
+void NavAvoidanceSolver3D::_add_agent_lines(uint32_t p_sorted_index, RVO2D::Agent2D *p_rvo_agent, NeighborScratch &r_scratch) const {
+	const LocalVector<uint32_t> &neighbors = r_scratch.neighbors;
+	const uint32_t count = neighbors.size();
+	if (count == 0) {
+		return;
+	}
+
+	const float velocity_x = sorted.velocity_x[p_sorted_index];
+	const float velocity_y = sorted.velocity_y[p_sorted_index];
+	const float position_x = sorted.position_x[p_sorted_index];
+	const float position_y = sorted.position_y[p_sorted_index];
+	const float radius = sorted.radius[p_sorted_index];
+	const float inv_time_horizon = 1.0f / p_rvo_agent->timeHorizon_;
+	const float inv_time_step = 1.0f / simulation->getTimeStep();
+
+	r_scratch.line_data.resize(count * 9);
+	float *relative_position_x = r_scratch.line_data.ptr();
+	float *relative_position_y = relative_position_x + count;
+	float *relative_velocity_x = relative_position_y + count;
+	float *relative_velocity_y = relative_velocity_x + count;
+	float *combined_radius = relative_velocity_y + count;
+	float *direction_x = combined_radius + count;
+	float *direction_y = direction_x + count;
+	float *point_x = direction_y + count;
+	float *point_y = point_x + count;
+
+	for (uint32_t j = 0; j < count; j++) {
+		const uint32_t other = neighbors[j];
+		relative_position_x[j] = sorted.position_x[other] - position_x;
+		relative_position_y[j] = sorted.position_y[other] - position_y;
+		relative_velocity_x[j] = velocity_x - sorted.velocity_x[other];
+		relative_velocity_y[j] = velocity_y - sorted.velocity_y[other];
+		combined_radius[j] = radius + sorted.radius[other];
+	}
+
+	// Same as the agent ORCA lines of RVO2D::Agent2D::computeNewVelocity(), but every case
+	// is computed and the result is selected afterwards so that the loop has no branches.
+	for (uint32_t j = 0; j < count; j++) {
+		const float rp_x = relative_position_x[j];
+		const float rp_y = relative_position_y[j];
+		const float rv_x = relative_velocity_x[j];
+		const float rv_y = relative_velocity_y[j];
+		const float combined = combined_radius[j];
+		const float distance_squared = rp_x * rp_x + rp_y * rp_y;
+		const float combined_squared = combined * combined;
+
+		// No collision, vector from the cutoff center to the relative velocity.
+		const float w_x = rv_x - inv_time_horizon * rp_x;
+		const float w_y = rv_y - inv_time_horizon * rp_y;
+		const float w_length_squared = w_x * w_x + w_y * w_y;
+		const float dot_product = w_x * rp_x + w_y * rp_y;
+		const bool project_on_cutoff = dot_product < 0.0f && dot_product * dot_product > combined_squared * w_length_squared;
+
+		// Project on the cut-off circle.
+		const float w_length = Math::sqrt(w_length_squared);
+		const float inv_w_length = 1.0f / w_length;
+		const float unit_w_x = w_x * inv_w_length;
+		const float unit_w_y = w_y * inv_w_length;
+		const float cutoff_u_scale = combined * inv_time_horizon - w_length;
+
+		// Project on the left or right leg.
+		const float leg = Math::sqrt(MAX(distance_squared - combined_squared, 0.0f));
+		const float inv_distance_squared = 1.0f / distance_squared;
+		const bool left_leg = rp_x * w_y - rp_y * w_x > 0.0f;
+		const float leg_direction_x = left_leg ? (rp_x * leg - rp_y * combined) * inv_distance_squared : -((rp_x * leg + rp_y * combined) * inv_distance_squared);
+		const float leg_direction_y = left_leg ? (rp_x * combined + rp_y * leg) * inv_distance_squared : -((-rp_x * combined + rp_y * leg) * inv_distance_squared);
+		const float leg_dot_product = rv_x * leg_direction_x + rv_y * leg_direction_y;
+
+		// Collision, project on the cut-off circle of the time step.
+		const float collision_w_x = rv_x - inv_time_step * rp_x;
+		const float collision_w_y = rv_y - inv_time_step * rp_y;
+		const float collision_w_length = Math::sqrt(collision_w_x * collision_w_x + collision_w_y * collision_w_y);
+		const float inv_collision_w_length = 1.0f / collision_w_length;
+		const float collision_unit_w_x = collision_w_x * inv_collision_w_length;
+		const float collision_unit_w_y = collision_w_y * inv_collision_w_length;
+		const float collision_u_scale = combined * inv_time_step - collision_w_length;
+
+		const bool collision = !(distance_squared > combined_squared);
+		const bool use_circle = collision || project_on_cutoff;
+		const float circle_unit_w_x = collision ? collision_unit_w_x : unit_w_x;
+		const float circle_unit_w_y = collision ? collision_unit_w_y : unit_w_y;
+		const float circle_u_scale = collision ? collision_u_scale : cutoff_u_scale;
+
+		const float u_x = use_circle ? circle_u_scale * circle_unit_w_x : leg_dot_product * leg_direction_x - rv_x;
+		const float u_y = use_circle ? circle_u_scale * circle_unit_w_y : leg_dot_product * leg_direction_y - rv_y;
+
+		direction_x[j] = use_circle ? circle_unit_w_y : leg_direction_x;
+		direction_y[j] = use_circle ? -circle_unit_w_x : leg_direction_y;
+		point_x[j] = velocity_x + 0.5f * u_x;
+		point_y[j] = velocity_y + 0.5f * u_y;
+	}
+
+	std::vector<RVO2D::Line> &orca_lines = p_rvo_agent->orcaLines_;
+	for (uint32_t j = 0; j < count; j++) {
+		RVO2D::Line line;
+		line.direction = RVO2D::Vector2(direction_x[j], direction_y[j]);
+		line.point = RVO2D::Vector2(point_x[j], point_y[j]);
+		orca_lines.push_back(line);
+	}
+}
+
+void NavAvoidanceSolver3D::_solve_task(uint32_t p_task_index, void *p_userdata) {
+	const uint32_t begin = p_task_index * AGENTS_PER_TASK;
+	const uint32_t end = MIN(begin + AGENTS_PER_TASK, agent_count);
+
+	NeighborScratch scratch;
+
+	// Agents are processed in grid order, so that neighboring agents share the cells they read.
+	for (uint32_t sorted_index = begin; sorted_index < end; sorted_index++) {
+		NavAgent3D *agent = agents[sorted_agent_index[sorted_index]];
+		RVO2D::Agent2D *rvo_agent = agent->get_rvo_agent_2d();
+
+		rvo_agent->obstacleNeighbors_.clear();
+		simulation->kdTree_->computeObstacleNeighbors(rvo_agent, RVO2D::sqr(rvo_agent->timeHorizonObst_ * rvo_agent->maxSpeed_ + rvo_agent->radius_));
+
+		rvo_agent->orcaLines_.clear();
+		rvo_agent->computeObstacleOrcaLines();
+		const size_t obstacle_line_count = rvo_agent->orcaLines_.size();
+
+		_find_agent_neighbors(sorted_index, rvo_agent, scratch);
+		_add_agent_lines(sorted_index, rvo_agent, scratch);
+
+		const size_t line_fail = RVO2D::linearProgram2(rvo_agent->orcaLines_, rvo_agent->maxSpeed_, rvo_agent->prefVelocity_, false, rvo_agent->newVelocity_);
+		if (line_fail < rvo_agent->orcaLines_.size()) {
+			RVO2D::linearProgram3(rvo_agent->orcaLines_, obstacle_line_count, line_fail, rvo_agent->maxSpeed_, rvo_agent->newVelocity_);
+		}
+
+		rvo_agent->update(simulation);
+		agent->update();
+	}
+}
+
+void NavAvoidanceSolver3D::_run_tasks(void (NavAvoidanceSolver3D::*p_task)(uint32_t, void *), bool p_use_threads, const StringName &p_description) {
+	const uint32_t task_count = task_bounds.size();
+	if (p_use_threads && task_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_task, (void *)nullptr, task_count, -1, true, p_description);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < task_count; i++) {
+			(this->*p_task)(i, nullptr);
+		}
+	}
+}
+
+void NavAvoidanceSolver3D::step(LocalVector<NavAgent3D *> &p_agents, RVO2D::RVOSimulator2D *p_simulation, bool p_use_threads) {
+	agents = p_agents.ptr();
+	agent_count = p_agents.size();
+	simulation = p_simulation;
+
+	if (agent_count == 0) {
+		return;
+	}
+
+	unsorted.resize(agent_count);
+	sorted.resize(agent_count);
+	sorted_agent_index.resize(agent_count);
+	agent_cell_keys.resize(agent_count);
+	cell_runs.resize(agent_count);
+	neighbor_distance.resize(agent_count);
+	task_bounds.resize((agent_count + AGENTS_PER_TASK - 1) / AGENTS_PER_TASK);
+	task_run_count.resize(task_bounds.size());
+
+	_run_tasks(&NavAvoidanceSolver3D::_gather_task, p_use_threads, SNAME("NavAvoidanceGather3D"));
+	_build_grid(p_use_threads);
+	_run_tasks(&NavAvoidanceSolver3D::_sort_task, p_use_threads, SNAME("NavAvoidanceSort3D"));
+	_run_tasks(&NavAvoidanceSolver3D::_solve_task, p_use_threads, SNAME("NavAvoidanceSolve3D"));
+}
@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  nav_avoidance_solver_3d.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+
+namespace RVO2D {
+class Agent2D;
+class RVOSimulator2D;
+} //namespace RVO2D
+
+class NavAgent3D;
+
+// Avoidance step for the agents that avoid each other on the XZ plane.
+//
+// Instead of having every RVO2 agent query the agent KD-tree on its own, the
+// agent state is copied once per step into flat arrays sorted by the cell of a
+// uniform grid. Agent neighbors are then searched ring by ring around the cell
+// of each agent, on contiguous rows of cells, and the ORCA lines of all
+// neighbors of an agent are built in one branchless loop. Obstacle neighbors,
+// obstacle ORCA lines and the linear programs still use the RVO2 code.
+//
+// All agents read the state they had at the start of the step, so the results do
+// not depend on the order in which the agents are processed.
+class NavAvoidanceSolver3D {
+	static constexpr uint32_t AGENTS_PER_TASK = 64;
+	// Average number of agents in a grid cell.
+	static constexpr double AGENTS_PER_CELL = 4.0;
+	// Limits the grid size when the agents are spread far apart.
+	static constexpr uint32_t MAX_CELLS_PER_AGENT = 4;
+
+	struct Agents {
+		LocalVector<float> position_x;
+		LocalVector<float> position_y;
+		LocalVector<float> velocity_x;
+		LocalVector<float> velocity_y;
+		LocalVector<float> radius;
+		LocalVector<float> elevation;
+		LocalVector<float> height;
+		LocalVector<float> avoidance_priority;
+		LocalVector<uint32_t> avoidance_layers;
+
+		void resize(uint32_t p_size);
+	};
+
+	struct Bounds {
+		float min_x = 0.0f;
+		float min_y = 0.0f;
+		float max_x = 0.0f;
+		float max_y = 0.0f;
+	};
+
+	NavAgent3D **agents = nullptr;
+	uint32_t agent_count = 0;
+	RVO2D::RVOSimulator2D *simulation = nullptr;
+
+	// Agent state in the order of `agents`.
+	Agents unsorted;
+	// Agent state sorted by grid cell.
+	Agents sorted;
+	// Agent index of each sorted entry.
+	LocalVector<uint32_t> sorted_agent_index;
+	// Cell of each agent in the high bits and agent index in the low bits, sorted within the agents of each task.
+	LocalVector<uint64_t> agent_cell_keys;
+	// Zero for agents that do not avoid other agents.
+	LocalVector<float> neighbor_distance;
+	// Position bounds of the agents of each task.
+	LocalVector<Bounds> task_bounds;
+
+	float grid_min_x = 0.0f;
+	float grid_min_y = 0.0f;
+	float grid_cell_size = 1.0f;
+	uint32_t grid_width = 1;
+	uint32_t grid_height = 1;
+	// First sorted index of each cell, with one more entry for the end of the last cell.
+	LocalVector<uint32_t> cell_start;
+	// Next sorted index of each cell while the runs are placed in the cells.
+	LocalVector<uint32_t> cell_cursor;
+
+	// Agents of a task that are in the same cell.
+	struct CellRun {
+		uint32_t cell = 0;
+		uint32_t count = 0;
+		// Sorted index of the first agent of the run.
+		uint32_t start = 0;
+	};
+	// Runs of each task, starting at the index of the first agent of the task.
+	LocalVector<CellRun> cell_runs;
+	LocalVector<uint32_t> task_run_count;
+
+	struct NeighborScratch {
+		LocalVector<float> distance_squared;
+		LocalVector<uint32_t> neighbors;
+		LocalVector<float> neighbors_distance_squared;
+		LocalVector<float> line_data;
+	};
+
+	void _gather_task(uint32_t p_task_index, void *p_userdata = nullptr);
+	void _build_grid(bool p_use_threads);
+	void _count_task(uint32_t p_task_index, void *p_userdata = nullptr);
+	void _scatter_task(uint32_t p_task_index, void *p_userdata = nullptr);
+	void _sort_task(uint32_t p_task_index, void *p_userdata = nullptr);
+	void _find_agent_neighbors(uint32_t p_sorted_index, const RVO2D::Agent2D *p_rvo_agent, NeighborScratch &r_scratch) const;
+	void _add_agent_lines(uint32_t p_sorted_index, RVO2D::Agent2D *p_rvo_agent, NeighborScratch &r_scratch) const;
+	void _solve_task(uint32_t p_task_index, void *p_userdata = nullptr);
+	void _run_tasks(void (NavAvoidanceSolver3D::*p_task)(uint32_t, void *), bool p_use_threads, const StringName &p_description);
+
+public:
+	// Computes the new velocities of `p_agents`, moves their RVO2 agents and updates the agents.
+	void step(LocalVector<NavAgent3D *> &p_agents, RVO2D::RVOSimulator2D *p_simulation, bool p_use_threads);
+};
@@ -0,0 +1,150 @@
+/**************************************************************************/
+/*  nav_bvh_3d.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_bvh_3d.h"
+
+#include "core/templates/sort_array.h"
+
+struct NavBVH3DItemCenterComparator {
+	int axis = 0;
+
+	_FORCE_INLINE_ bool operator()(const NavBVH3D::Item &p_a, const NavBVH3D::Item &p_b) const {
+		return (p_a.bounds.position[axis] * 2.0 + p_a.bounds.size[axis]) < (p_b.bounds.position[axis] * 2.0 + p_b.bounds.size[axis]);
+	}
+};
+
+void NavBVH3D::_build_node(uint32_t p_node, Item *p_items, uint32_t p_first, uint32_t p_count, uint32_t p_depth) {
+	AABB bounds = p_items[p_first].bounds;
+	AABB center_bounds(bounds.get_center(), Vector3());
+	for (uint32_t i = p_first + 1; i < p_first + p_count; i++) {
+		bounds.merge_with(p_items[i].bounds);
+		center_bounds.expand_to(p_items[i].bounds.get_center());
+	}
+	nodes[p_node].bounds = bounds;
+
+	if (p_count <= MAX_LEAF_ITEMS || p_depth >= MAX_DEPTH) {
+		nodes[p_node].first = p_first;
+		nodes[p_node].count = p_count;
+		return;
+	}
+
+	// Split at the median along the axis where the item centers are spread the most.
+	SortArray<Item, NavBVH3DItemCenterComparator> sorter;
+	sorter.compare.axis = center_bounds.get_longest_axis_index();
+	const uint32_t half = p_count / 2;
+	sorter.nth_element(p_first, p_first + p_count, p_first + half, p_items);
+
+	const uint32_t children = nodes.size();
+	nodes.resize(children + 2);
+	nodes[p_node].first = children;
+	nodes[p_node].count = 0;
+
+	_build_node(children, p_items, p_first, half, p_depth + 1);
+	_build_node(children + 1, p_items, p_first + half, p_count - half, p_depth + 1);
+}
+
+void NavBVH3D::build(LocalVector<Item> &p_items) {
+	clear();
+	if (p_items.is_empty()) {
+		return;
+	}
+
+	nodes.reserve(p_items.size() / MAX_LEAF_ITEMS * 2 + 1);
+	nodes.resize(1);
+	_build_node(0, p_items.ptr(), 0, p_items.size(), 0);
+
+	item_ids.resize(p_items.size());
+	for (uint32_t i = 0; i < p_items.size(); i++) {
+		item_ids[i] = p_items[i].id;
+	}
+}
+
+void NavBVH3D::clear() {
+	nodes.clear();
+	item_ids.clear();
+}
+
+real_t NavBVH3D::get_distance_squared_to_point(const AABB &p_bounds, const Vector3 &p_point) {
+	const Vector3 end = p_bounds.get_end();
+	real_t distance_squared = 0.0;
+	for (int i = 0; i < 3; i++) {
+		real_t d = 0.0;
+		if (p_point[i] < p_bounds.position[i]) {
+			d = p_bounds.position[i] - p_point[i];
+		} else if (p_point[i] > end[i]) {
+			d = p_point[i] - end[i];
+		}
+		distance_squared += d * d;
+	}
+	return distance_squared;
+}
+
+real_t NavBVH3D::get_distance_squared_to_bounds(const AABB &p_bounds, const AABB &p_other) {
+	const Vector3 end = p_bounds.get_end();
+	const Vector3 other_end = p_other.get_end();
+	real_t distance_squared = 0.0;
+	for (int i = 0; i < 3; i++) {
+		real_t d = 0.0;
+		if (other_end[i] < p_bounds.position[i]) {
+			d = p_bounds.position[i] - other_end[i];
+		} else if (p_other.position[i] > end[i]) {
+			d = p_other.position[i] - end[i];
+		}
+		distance_squared += d * d;
+	}
+	return distance_squared;
+}
+
+bool NavBVH3D::intersects_segment(const AABB &p_bounds, const Vector3 &p_from, const Vector3 &p_to) {
+	// Slab test that, unlike `AABB::intersects_segment()`, accepts flat bounds and axis aligned segments.
+	const Vector3 end = p_bounds.get_end();
+	real_t min = 0.0;
+	real_t max = 1.0;
+	for (int i = 0; i < 3; i++) {
+		const real_t length = p_to[i] - p_from[i];
+		if (Math::is_zero_approx(length)) {
+			if (p_from[i] < p_bounds.position[i] || p_from[i] > end[i]) {
+				return false;
+			}
+			continue;
+		}
+		real_t t0 = (p_bounds.position[i] - p_from[i]) / length;
+		real_t t1 = (end[i] - p_from[i]) / length;
+		if (t0 > t1) {
+			SWAP(t0, t1);
+		}
+		min = MAX(min, t0);
+		max = MIN(max, t1);
+		if (min > max) {
+			return false;
+		}
+	}
+	return true;
+}
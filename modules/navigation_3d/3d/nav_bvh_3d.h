@@ -0,0 +1,126 @@
+/**************************************************************************/
+/*  nav_bvh_3d.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/aabb.h"
+#include "core/templates/local_vector.h"
+
+#include <cfloat> // FLT_MAX
+
+// Static bounding volume hierarchy, built once per iteration so that closest
+// point and segment queries do not have to test every polygon or region.
+class NavBVH3D {
+public:
+	struct Item {
+		AABB bounds;
+		uint32_t id = 0;
+	};
+
+private:
+	struct Node {
+		AABB bounds;
+		// Leaves use `count` items from `first` in `item_ids`, other nodes have their children at `first` and `first + 1`.
+		uint32_t first = 0;
+		uint32_t count = 0;
+	};
+
+	static constexpr uint32_t MAX_LEAF_ITEMS = 4;
+	static constexpr uint32_t MAX_DEPTH = 48;
+
+	LocalVector<Node> nodes;
+	LocalVector<uint32_t> item_ids;
+
+	void _build_node(uint32_t p_node, Item *p_items, uint32_t p_first, uint32_t p_count, uint32_t p_depth);
+
+public:
+	// Reorders `p_items`.
+	void build(LocalVector<Item> &p_items);
+	void clear();
+
+	_FORCE_INLINE_ bool is_empty() const { return nodes.is_empty(); }
+	_FORCE_INLINE_ AABB get_bounds() const { return nodes.is_empty() ? AABB() : nodes[0].bounds; }
+
+	static real_t get_distance_squared_to_point(const AABB &p_bounds, const Vector3 &p_point);
+	static real_t get_distance_squared_to_bounds(const AABB &p_bounds, const AABB &p_other);
+	static bool intersects_segment(const AABB &p_bounds, const Vector3 &p_from, const Vector3 &p_to);
+
+	// Visits item ids nearest first. `p_node_distance` returns a lower bound of
+	// the distance to anything inside the given bounds, nodes that are not
+	// closer than `p_best_distance` are skipped. `p_visit` is expected to lower
+	// `p_best_distance` when it finds a closer result.
+	template <typename NodeDistance, typename Visit>
+	void query_nearest(NodeDistance p_node_distance, Visit p_visit, const real_t &p_best_distance) const {
+		if (nodes.is_empty()) {
+			return;
+		}
+
+		struct Entry {
+			uint32_t node;
+			real_t distance;
+		};
+		Entry stack[MAX_DEPTH + 2];
+		uint32_t stack_size = 0;
+
+		const real_t root_distance = p_node_distance(nodes[0].bounds);
+		if (root_distance >= p_best_distance) {
+			return;
+		}
+		stack[stack_size++] = { 0, root_distance };
+
+		while (stack_size > 0) {
+			const Entry entry = stack[--stack_size];
+			if (entry.distance >= p_best_distance) {
+				continue;
+			}
+
+			const Node &node = nodes[entry.node];
+			if (node.count > 0) {
+				for (uint32_t i = node.first; i < node.first + node.count; i++) {
+					p_visit(item_ids[i]);
+				}
+				continue;
+			}
+
+			Entry near = { node.first, p_node_distance(nodes[node.first].bounds) };
+			Entry far = { node.first + 1, p_node_distance(nodes[node.first + 1].bounds) };
+			if (far.distance < near.distance) {
+				SWAP(near, far);
+			}
+			// Push the farthest child first so the nearest one is visited first.
+			if (far.distance < p_best_distance) {
+				stack[stack_size++] = far;
+			}
+			if (near.distance < p_best_distance) {
+				stack[stack_size++] = near;
+			}
+		}
+	}
+};
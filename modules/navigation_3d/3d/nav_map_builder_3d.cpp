@@ -35,6 +35,7 @@
 #include "nav_region_iteration_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/templates/hash_set.h"
 
 using namespace Nav3D;
 
@@ -62,14 +63,22 @@ void NavMapBuilder3D::build_navmap_iteration(NavMapIterationBuild3D &r_build) {
 
 	_build_step_gather_region_polygons(r_build);
 
+	_build_step_region_bvh(r_build);
+
+	_build_step_find_changed_regions(r_build);
+
 	_build_step_find_edge_connection_pairs(r_build);
 
 	_build_step_merge_edge_connection_pairs(r_build);
 
 	_build_step_edge_connection_margin_connections(r_build);
 
+	_build_step_copy_region_connections(r_build);
+
 	_build_step_navlink_connections(r_build);
 
+	_build_step_path_clusters(r_build);
+
 	_build_update_map_iteration(r_build);
 }
 
@@ -78,31 +87,129 @@ void NavMapBuilder3D::_build_step_gather_region_polygons(NavMapIterationBuild3D
 	NavMapIteration3D *map_iteration = r_build.map_iteration;
 
 	const LocalVector<Ref<NavRegionIteration3D>> &regions = map_iteration->region_iterations;
-	HashMap<const NavBaseIteration3D *, LocalVector<Connection>> &region_external_connections = map_iteration->external_region_connections;
-
-	map_iteration->navbases_polygons_external_connections.clear();
 
 	// Remove regions connections.
-	region_external_connections.clear();
+	map_iteration->navbases_polygons_external_connections.clear();
+	map_iteration->external_region_connections.clear();
 
-	// Copy all region polygons in the map.
 	int polygon_count = 0;
 	for (const Ref<NavRegionIteration3D> &region : regions) {
-		const uint32_t polygons_size = region->navmesh_polygons.size();
-		polygon_count += polygons_size;
-
-		region_external_connections[region.ptr()] = LocalVector<Connection>();
-		map_iteration->navbases_polygons_external_connections[region.ptr()] = LocalVector<LocalVector<Connection>>();
-		map_iteration->navbases_polygons_external_connections[region.ptr()].resize(polygons_size);
+		polygon_count += region->navmesh_polygons.size();
 	}
 
 	performance_data.pm_polygon_count = polygon_count;
 	r_build.polygon_count = polygon_count;
 }
 
+void NavMapBuilder3D::_build_step_find_changed_regions(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+	const LocalVector<Ref<NavRegionIteration3D>> &regions = map_iteration->region_iterations;
+
+	HashMap<const NavBaseIteration3D *, NavMapIterationBuild3D::RegionConnections> &region_connections_cache = r_build.region_connections_cache;
+	LocalVector<NavRegionIteration3D *> &edge_regions = r_build.iter_edge_regions;
+	LocalVector<AABB> &dirty_bounds = r_build.iter_dirty_bounds;
+
+	edge_regions.clear();
+	dirty_bounds.clear();
+
+	// All connections depend on the map settings.
+	if (r_build.cache_merge_rasterizer_cell_size != r_build.merge_rasterizer_cell_size ||
+			r_build.cache_use_edge_connections != r_build.use_edge_connections ||
+			r_build.cache_edge_connection_margin != r_build.edge_connection_margin ||
+			r_build.cache_link_connection_radius != r_build.link_connection_radius) {
+		r_build.clear_cache();
+		r_build.cache_merge_rasterizer_cell_size = r_build.merge_rasterizer_cell_size;
+		r_build.cache_use_edge_connections = r_build.use_edge_connections;
+		r_build.cache_edge_connection_margin = r_build.edge_connection_margin;
+		r_build.cache_link_connection_radius = r_build.link_connection_radius;
+	}
+
+	// A changed region has a new iteration, so the old iteration is removed and the new one added.
+	HashSet<const NavBaseIteration3D *> region_set;
+	region_set.reserve(regions.size());
+	for (const Ref<NavRegionIteration3D> &region : regions) {
+		region_set.insert(region.ptr());
+	}
+
+	LocalVector<const NavBaseIteration3D *> removed_regions;
+	for (KeyValue<const NavBaseIteration3D *, NavMapIterationBuild3D::RegionConnections> &E : region_connections_cache) {
+		E.value.rebuild = false;
+		if (!region_set.has(E.key)) {
+			removed_regions.push_back(E.key);
+			dirty_bounds.push_back(E.value.region_iteration->get_bounds());
+		}
+	}
+	for (const NavBaseIteration3D *removed_region : removed_regions) {
+		region_connections_cache.erase(removed_region);
+	}
+
+	LocalVector<uint32_t> rebuild_region_indices;
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		if (!region_connections_cache.has(regions[i].ptr())) {
+			NavMapIterationBuild3D::RegionConnections &region_connections = region_connections_cache[regions[i].ptr()];
+			region_connections.region_iteration = regions[i];
+			region_connections.rebuild = true;
+			rebuild_region_indices.push_back(i);
+			dirty_bounds.push_back(regions[i]->get_bounds());
+		}
+	}
+
+	if (dirty_bounds.is_empty()) {
+		return;
+	}
+
+	// Connections between two regions depend on edges that are at most the edge connection margin apart,
+	// and on the edges that share merge rasterizer cells with those. Regions within that range of a
+	// changed region get new connections, and regions within that range of those provide the edges.
+	const real_t connection_range = r_build.edge_connection_margin + 2.0 * r_build.merge_rasterizer_cell_size.length();
+	const real_t connection_range_squared = connection_range * connection_range;
+	const NavBVH3D &region_bvh = map_iteration->region_bvh;
+
+	for (const AABB &bounds : dirty_bounds) {
+		region_bvh.query_nearest(
+				[&](const AABB &p_node_bounds) { return NavBVH3D::get_distance_squared_to_bounds(p_node_bounds, bounds); },
+				[&](uint32_t p_region_index) {
+					NavMapIterationBuild3D::RegionConnections &region_connections = region_connections_cache[regions[p_region_index].ptr()];
+					if (!region_connections.rebuild) {
+						region_connections.rebuild = true;
+						rebuild_region_indices.push_back(p_region_index);
+					}
+				},
+				connection_range_squared);
+	}
+
+	LocalVector<bool> use_region_edges;
+	use_region_edges.resize(regions.size());
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		NavMapIterationBuild3D::RegionConnections &region_connections = region_connections_cache[regions[i].ptr()];
+		use_region_edges[i] = region_connections.rebuild;
+
+		if (region_connections.rebuild) {
+			region_connections.polygons_connections.clear();
+			region_connections.polygons_connections.resize(regions[i]->navmesh_polygons.size());
+			region_connections.margin_connections.clear();
+			region_connections.edge_connection_count = 0;
+			region_connections.edge_free_count = 0;
+		}
+	}
+
+	for (uint32_t rebuild_region_index : rebuild_region_indices) {
+		const AABB bounds = regions[rebuild_region_index]->get_bounds();
+		region_bvh.query_nearest(
+				[&](const AABB &p_node_bounds) { return NavBVH3D::get_distance_squared_to_bounds(p_node_bounds, bounds); },
+				[&](uint32_t p_region_index) { use_region_edges[p_region_index] = true; },
+				connection_range_squared);
+	}
+
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		if (use_region_edges[i]) {
+			edge_regions.push_back(regions[i].ptr());
+		}
+	}
+}
+
 void NavMapBuilder3D::_build_step_find_edge_connection_pairs(NavMapIterationBuild3D &r_build) {
 	PerformanceData &performance_data = r_build.performance_data;
-	NavMapIteration3D *map_iteration = r_build.map_iteration;
 	int polygon_count = r_build.polygon_count;
 
 	HashMap<EdgeKey, EdgeConnectionPair, EdgeKey> &connection_pairs_map = r_build.iter_connection_pairs_map;
@@ -113,7 +220,7 @@ void NavMapBuilder3D::_build_step_find_edge_connection_pairs(NavMapIterationBuil
 	int free_edges_count = 0; // How many ConnectionPairs have only one Connection.
 	int edge_merge_error_count = 0;
 
-	for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
+	for (NavRegionIteration3D *region : r_build.iter_edge_regions) {
 		for (const ConnectableEdge &connectable_edge : region->get_external_edges()) {
 			const EdgeKey &ek = connectable_edge.ek;
 
@@ -153,8 +260,6 @@ void NavMapBuilder3D::_build_step_find_edge_connection_pairs(NavMapIterationBuil
 }
 
 void NavMapBuilder3D::_build_step_merge_edge_connection_pairs(NavMapIterationBuild3D &r_build) {
-	PerformanceData &performance_data = r_build.performance_data;
-
 	HashMap<EdgeKey, EdgeConnectionPair, EdgeKey> &connection_pairs_map = r_build.iter_connection_pairs_map;
 	LocalVector<Connection> &free_edges = r_build.iter_free_edges;
 	int free_edges_count = r_build.free_edge_count;
@@ -163,9 +268,7 @@ void NavMapBuilder3D::_build_step_merge_edge_connection_pairs(NavMapIterationBui
 	free_edges.clear();
 	free_edges.reserve(free_edges_count);
 
-	NavMapIteration3D *map_iteration = r_build.map_iteration;
-
-	HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Nav3D::Connection>>> &navbases_polygons_external_connections = map_iteration->navbases_polygons_external_connections;
+	HashMap<const NavBaseIteration3D *, NavMapIterationBuild3D::RegionConnections> &region_connections_cache = r_build.region_connections_cache;
 
 	for (const KeyValue<EdgeKey, EdgeConnectionPair> &pair_it : connection_pairs_map) {
 		const EdgeConnectionPair &pair = pair_it.value;
@@ -174,9 +277,21 @@ void NavMapBuilder3D::_build_step_merge_edge_connection_pairs(NavMapIterationBui
 			const Connection &c1 = pair.connections[0];
 			const Connection &c2 = pair.connections[1];
 
-			navbases_polygons_external_connections[c1.polygon->owner][c1.polygon->id].push_back(c2);
-			navbases_polygons_external_connections[c2.polygon->owner][c2.polygon->id].push_back(c1);
-			performance_data.pm_edge_connection_count += 1;
+			// Only regions that are rebuilt take new connections, the others keep theirs. Each pair is counted once.
+			NavMapIterationBuild3D::RegionConnections &c1_region_connections = region_connections_cache[c1.polygon->owner];
+			if (c1_region_connections.rebuild) {
+				c1_region_connections.polygons_connections[c1.polygon->id].push_back(c2);
+				if (c1.polygon->owner <= c2.polygon->owner) {
+					c1_region_connections.edge_connection_count += 1;
+				}
+			}
+			NavMapIterationBuild3D::RegionConnections &c2_region_connections = region_connections_cache[c2.polygon->owner];
+			if (c2_region_connections.rebuild) {
+				c2_region_connections.polygons_connections[c2.polygon->id].push_back(c1);
+				if (c2.polygon->owner < c1.polygon->owner) {
+					c2_region_connections.edge_connection_count += 1;
+				}
+			}
 
 		} else {
 			CRASH_COND_MSG(pair.size != 1, vformat("Number of connection != 1. Found: %d", pair.size));
@@ -188,15 +303,10 @@ void NavMapBuilder3D::_build_step_merge_edge_connection_pairs(NavMapIterationBui
 }
 
 void NavMapBuilder3D::_build_step_edge_connection_margin_connections(NavMapIterationBuild3D &r_build) {
-	PerformanceData &performance_data = r_build.performance_data;
-	NavMapIteration3D *map_iteration = r_build.map_iteration;
-
 	real_t edge_connection_margin = r_build.edge_connection_margin;
 
 	LocalVector<Connection> &free_edges = r_build.iter_free_edges;
-	HashMap<const NavBaseIteration3D *, LocalVector<Connection>> &region_external_connections = map_iteration->external_region_connections;
-
-	HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Nav3D::Connection>>> &navbases_polygons_external_connections = map_iteration->navbases_polygons_external_connections;
+	HashMap<const NavBaseIteration3D *, NavMapIterationBuild3D::RegionConnections> &region_connections_cache = r_build.region_connections_cache;
 
 	// Find the compatible near edges.
 	//
@@ -205,12 +315,16 @@ void NavMapBuilder3D::_build_step_edge_connection_margin_connections(NavMapItera
 	// to be connected, create new polygons to remove that small gap is
 	// not really useful and would result in wasteful computation during
 	// connection, integration and path finding.
-	performance_data.pm_edge_free_count = free_edges.size();
-
 	const real_t edge_connection_margin_squared = edge_connection_margin * edge_connection_margin;
 
 	for (uint32_t i = 0; i < free_edges.size(); i++) {
 		const Connection &free_edge = free_edges[i];
+		NavMapIterationBuild3D::RegionConnections &region_connections = region_connections_cache[free_edge.polygon->owner];
+		if (!region_connections.rebuild) {
+			continue;
+		}
+		region_connections.edge_free_count += 1;
+
 		const Vector3 &edge_p1 = free_edge.pathway_start;
 		const Vector3 &edge_p2 = free_edge.pathway_end;
 
@@ -261,13 +375,32 @@ void NavMapBuilder3D::_build_step_edge_connection_margin_connections(NavMapItera
 			//free_edge.polygon->connections.push_back(new_connection);
 
 			// Add the connection to the region_connection map.
-			region_external_connections[free_edge.polygon->owner].push_back(new_connection);
-			navbases_polygons_external_connections[free_edge.polygon->owner][free_edge.polygon->id].push_back(new_connection);
-			performance_data.pm_edge_connection_count += 1;
+			region_connections.margin_connections.push_back(new_connection);
+			region_connections.polygons_connections[free_edge.polygon->id].push_back(new_connection);
+			region_connections.edge_connection_count += 1;
 		}
 	}
 }
 
+void NavMapBuilder3D::_build_step_copy_region_connections(NavMapIterationBuild3D &r_build) {
+	PerformanceData &performance_data = r_build.performance_data;
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+
+	HashMap<const NavBaseIteration3D *, LocalVector<Connection>> &region_external_connections = map_iteration->external_region_connections;
+	HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Nav3D::Connection>>> &navbases_polygons_external_connections = map_iteration->navbases_polygons_external_connections;
+
+	for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
+		NavMapIterationBuild3D::RegionConnections &region_connections = r_build.region_connections_cache[region.ptr()];
+		region_connections.rebuild = false;
+
+		region_external_connections[region.ptr()] = region_connections.margin_connections;
+		navbases_polygons_external_connections[region.ptr()] = region_connections.polygons_connections;
+
+		performance_data.pm_edge_connection_count += region_connections.edge_connection_count;
+		performance_data.pm_edge_free_count += region_connections.edge_free_count;
+	}
+}
+
 void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_build) {
 	NavMapIteration3D *map_iteration = r_build.map_iteration;
 
@@ -277,14 +410,31 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 
 	int polygon_count = r_build.polygon_count;
 
-	real_t link_connection_radius_sqr = link_connection_radius * link_connection_radius;
-
 	HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Nav3D::Connection>>> &navbases_polygons_external_connections = map_iteration->navbases_polygons_external_connections;
 	LocalVector<Nav3D::Polygon> &navlink_polygons = map_iteration->navlink_polygons;
 	navlink_polygons.clear();
 	navlink_polygons.resize(links.size());
 	uint32_t navlink_index = 0;
 
+	HashMap<const NavBaseIteration3D *, NavMapIterationBuild3D::LinkConnections> &link_connections_cache = r_build.link_connections_cache;
+	const LocalVector<AABB> &dirty_bounds = r_build.iter_dirty_bounds;
+
+	// Forget the links that were removed or changed.
+	HashSet<const NavBaseIteration3D *> link_set;
+	link_set.reserve(links.size());
+	for (const Ref<NavLinkIteration3D> &link : links) {
+		link_set.insert(link.ptr());
+	}
+	LocalVector<const NavBaseIteration3D *> removed_links;
+	for (const KeyValue<const NavBaseIteration3D *, NavMapIterationBuild3D::LinkConnections> &E : link_connections_cache) {
+		if (!link_set.has(E.key)) {
+			removed_links.push_back(E.key);
+		}
+	}
+	for (const NavBaseIteration3D *removed_link : removed_links) {
+		link_connections_cache.erase(removed_link);
+	}
+
 	// Search for polygons within range of a nav link.
 	for (const Ref<NavLinkIteration3D> &link : links) {
 		polygon_count++;
@@ -296,50 +446,27 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 		const Vector3 link_start_pos = link->get_start_position();
 		const Vector3 link_end_pos = link->get_end_position();
 
-		Polygon *closest_start_polygon = nullptr;
-		real_t closest_start_sqr_dist = link_connection_radius_sqr;
-		Vector3 closest_start_point;
-
-		Polygon *closest_end_polygon = nullptr;
-		real_t closest_end_sqr_dist = link_connection_radius_sqr;
-		Vector3 closest_end_point;
-
-		for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
-			AABB region_bounds = region->get_bounds().grow(link_connection_radius);
-			if (!region_bounds.has_point(link_start_pos) && !region_bounds.has_point(link_end_pos)) {
-				continue;
-			}
-
-			for (Polygon &polyon : region->navmesh_polygons) {
-				for (uint32_t point_id = 2; point_id < polyon.vertices.size(); point_id += 1) {
-					const Face3 face(polyon.vertices[0], polyon.vertices[point_id - 1], polyon.vertices[point_id]);
-
-					{
-						const Vector3 start_point = face.get_closest_point_to(link_start_pos);
-						const real_t sqr_dist = start_point.distance_squared_to(link_start_pos);
-
-						// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-						if (sqr_dist < closest_start_sqr_dist) {
-							closest_start_sqr_dist = sqr_dist;
-							closest_start_point = start_point;
-							closest_start_polygon = &polyon;
-						}
-					}
-
-					{
-						const Vector3 end_point = face.get_closest_point_to(link_end_pos);
-						const real_t sqr_dist = end_point.distance_squared_to(link_end_pos);
-
-						// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-						if (sqr_dist < closest_end_sqr_dist) {
-							closest_end_sqr_dist = sqr_dist;
-							closest_end_point = end_point;
-							closest_end_polygon = &polyon;
-						}
-					}
+		// The closest polygons of an unchanged link only change when regions within its connection radius changed.
+		NavMapIterationBuild3D::LinkConnections *link_connections = link_connections_cache.getptr(link.ptr());
+		if (link_connections) {
+			for (const AABB &bounds : dirty_bounds) {
+				const AABB link_bounds = bounds.grow(link_connection_radius);
+				if (link_bounds.has_point(link_start_pos) || link_bounds.has_point(link_end_pos)) {
+					link_connections = nullptr;
+					break;
 				}
 			}
 		}
+		if (!link_connections) {
+			link_connections = &link_connections_cache[link.ptr()];
+			link_connections->link_iteration = link;
+			_build_find_link_polygons(r_build, link_start_pos, link_end_pos, link_connections->start_polygon, link_connections->start_point, link_connections->end_polygon, link_connections->end_point);
+		}
+
+		Polygon *closest_start_polygon = link_connections->start_polygon;
+		const Vector3 closest_start_point = link_connections->start_point;
+		Polygon *closest_end_polygon = link_connections->end_polygon;
+		const Vector3 closest_end_point = link_connections->end_point;
 
 		// If we have both a start and end point, then create a synthetic polygon to route through.
 		if (closest_start_polygon && closest_end_polygon) {
@@ -392,6 +519,263 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 	r_build.polygon_count = polygon_count;
 }
 
+void NavMapBuilder3D::_build_find_link_polygons(NavMapIterationBuild3D &r_build, const Vector3 &p_link_start_pos, const Vector3 &p_link_end_pos, Polygon *&r_closest_start_polygon, Vector3 &r_closest_start_point, Polygon *&r_closest_end_polygon, Vector3 &r_closest_end_point) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+
+	real_t link_connection_radius = r_build.link_connection_radius;
+	real_t link_connection_radius_sqr = link_connection_radius * link_connection_radius;
+
+	const Vector3 &link_start_pos = p_link_start_pos;
+	const Vector3 &link_end_pos = p_link_end_pos;
+
+	Polygon *closest_start_polygon = nullptr;
+	real_t closest_start_sqr_dist = link_connection_radius_sqr;
+	Vector3 closest_start_point;
+
+	Polygon *closest_end_polygon = nullptr;
+	real_t closest_end_sqr_dist = link_connection_radius_sqr;
+	Vector3 closest_end_point;
+
+	for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
+		AABB region_bounds = region->get_bounds().grow(link_connection_radius);
+		if (!region_bounds.has_point(link_start_pos) && !region_bounds.has_point(link_end_pos)) {
+			continue;
+		}
+
+		for (Polygon &polyon : region->navmesh_polygons) {
+			for (uint32_t point_id = 2; point_id < polyon.vertices.size(); point_id += 1) {
+				const Face3 face(polyon.vertices[0], polyon.vertices[point_id - 1], polyon.vertices[point_id]);
+
+				{
+					const Vector3 start_point = face.get_closest_point_to(link_start_pos);
+					const real_t sqr_dist = start_point.distance_squared_to(link_start_pos);
+
+					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+					if (sqr_dist < closest_start_sqr_dist) {
+						closest_start_sqr_dist = sqr_dist;
+						closest_start_point = start_point;
+						closest_start_polygon = &polyon;
+					}
+				}
+
+				{
+					const Vector3 end_point = face.get_closest_point_to(link_end_pos);
+					const real_t sqr_dist = end_point.distance_squared_to(link_end_pos);
+
+					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+					if (sqr_dist < closest_end_sqr_dist) {
+						closest_end_sqr_dist = sqr_dist;
+						closest_end_point = end_point;
+						closest_end_polygon = &polyon;
+					}
+				}
+			}
+		}
+	}
+
+	r_closest_start_polygon = closest_start_polygon;
+	r_closest_start_point = closest_start_point;
+	r_closest_end_polygon = closest_end_polygon;
+	r_closest_end_point = closest_end_point;
+}
+
+void NavMapBuilder3D::_build_step_region_bvh(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+	const LocalVector<Ref<NavRegionIteration3D>> &regions = map_iteration->region_iterations;
+
+	LocalVector<NavBVH3D::Item> items;
+	items.reserve(regions.size());
+
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		const NavBVH3D &polygon_bvh = regions[i]->get_polygon_bvh();
+		if (polygon_bvh.is_empty()) {
+			continue;
+		}
+
+		NavBVH3D::Item item;
+		item.bounds = polygon_bvh.get_bounds();
+		item.id = i;
+		items.push_back(item);
+	}
+
+	map_iteration->region_bvh.build(items);
+}
+
+void NavMapBuilder3D::_build_step_path_clusters(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+	const LocalVector<Ref<NavRegionIteration3D>> &regions = map_iteration->region_iterations;
+	const LocalVector<Polygon> &navlink_polygons = map_iteration->navlink_polygons;
+
+	LocalVector<PathCluster> &path_clusters = map_iteration->path_clusters;
+	LocalVector<PathClusterConnection> &path_cluster_connections = map_iteration->path_cluster_connections;
+	LocalVector<uint32_t> &polygon_path_clusters = map_iteration->polygon_path_clusters;
+
+	path_clusters.clear();
+	path_cluster_connections.clear();
+	polygon_path_clusters.clear();
+
+	if (r_build.path_cluster_size == 0) {
+		return;
+	}
+
+	// Polygons are numbered like in the path query slots, region polygons first and link polygons after.
+	HashMap<const NavBaseIteration3D *, uint32_t> navbase_polygon_offsets;
+	uint32_t polygon_count = 0;
+	for (const Ref<NavRegionIteration3D> &region : regions) {
+		navbase_polygon_offsets[region.ptr()] = polygon_count;
+		polygon_count += region->navmesh_polygons.size();
+	}
+	for (const Polygon &polygon : navlink_polygons) {
+		navbase_polygon_offsets[polygon.owner] = polygon_count;
+		polygon_count += 1;
+	}
+
+	polygon_path_clusters.resize(polygon_count);
+	for (uint32_t &polygon_path_cluster : polygon_path_clusters) {
+		polygon_path_cluster = UINT32_MAX;
+	}
+
+	// Clusters are the connected parts of the region polygons that share a cell of a coarse grid.
+	// The cell size aims for `path_cluster_size` polygons per cell so that clusters stay compact.
+	LocalVector<Vector3> polygon_centers;
+	LocalVector<uint64_t> polygon_cell_keys;
+	LocalVector<uint32_t> cluster_polygon_ids;
+	for (const Ref<NavRegionIteration3D> &region : regions) {
+		const uint32_t polygon_offset = navbase_polygon_offsets[region.ptr()];
+		const LocalVector<Polygon> &polygons = region->navmesh_polygons;
+		const LocalVector<LocalVector<Connection>> &internal_connections = region->internal_connections;
+		if (polygons.is_empty()) {
+			continue;
+		}
+
+		real_t cluster_cell_size = Math::sqrt(region->get_surface_area() * r_build.path_cluster_size / polygons.size());
+		if (cluster_cell_size < CMP_EPSILON) {
+			cluster_cell_size = 1.0;
+		}
+		const Vector3 cluster_cell = Vector3(cluster_cell_size, cluster_cell_size, cluster_cell_size);
+
+		polygon_centers.resize(polygons.size());
+		polygon_cell_keys.resize(polygons.size());
+		for (uint32_t polygon_id = 0; polygon_id < polygons.size(); polygon_id++) {
+			const Polygon &polygon = polygons[polygon_id];
+			Vector3 polygon_center;
+			for (const Vector3 &vertex : polygon.vertices) {
+				polygon_center += vertex;
+			}
+			if (!polygon.vertices.is_empty()) {
+				polygon_center /= polygon.vertices.size();
+			}
+			polygon_centers[polygon_id] = polygon_center;
+			polygon_cell_keys[polygon_id] = get_point_key(polygon_center, cluster_cell).key;
+		}
+
+		for (uint32_t seed_id = 0; seed_id < polygons.size(); seed_id++) {
+			if (polygon_path_clusters[polygon_offset + seed_id] != UINT32_MAX) {
+				continue;
+			}
+
+			const uint32_t cluster_id = path_clusters.size();
+			polygon_path_clusters[polygon_offset + seed_id] = cluster_id;
+			cluster_polygon_ids.clear();
+			cluster_polygon_ids.push_back(seed_id);
+
+			Vector3 center;
+			for (uint32_t i = 0; i < cluster_polygon_ids.size(); i++) {
+				const uint32_t polygon_id = cluster_polygon_ids[i];
+				center += polygon_centers[polygon_id];
+
+				for (const Connection &connection : internal_connections[polygon_id]) {
+					const uint32_t connection_polygon_id = connection.polygon->id;
+					uint32_t &polygon_path_cluster = polygon_path_clusters[polygon_offset + connection_polygon_id];
+					if (polygon_path_cluster == UINT32_MAX && polygon_cell_keys[connection_polygon_id] == polygon_cell_keys[seed_id]) {
+						polygon_path_cluster = cluster_id;
+						cluster_polygon_ids.push_back(connection_polygon_id);
+					}
+				}
+			}
+
+			PathCluster path_cluster;
+			path_cluster.owner = region.ptr();
+			path_cluster.center = center / cluster_polygon_ids.size();
+			path_clusters.push_back(path_cluster);
+		}
+	}
+
+	// Every link is a cluster of its own.
+	for (const Polygon &polygon : navlink_polygons) {
+		polygon_path_clusters[navbase_polygon_offsets[polygon.owner]] = path_clusters.size();
+
+		PathCluster path_cluster;
+		path_cluster.owner = polygon.owner;
+		if (!polygon.vertices.is_empty()) {
+			path_cluster.center = (polygon.vertices[0] + polygon.vertices[polygon.vertices.size() - 1]) * 0.5;
+		}
+		path_clusters.push_back(path_cluster);
+	}
+
+	// Gather the polygon connections that cross cluster borders, merged per pair of clusters.
+	struct PathClusterPortal {
+		Vector3 position_sum;
+		uint32_t count = 0;
+	};
+	HashMap<uint64_t, PathClusterPortal> path_cluster_portals;
+
+	const auto add_portals = [&](uint32_t p_from_cluster, const LocalVector<Connection> &p_connections) {
+		for (const Connection &connection : p_connections) {
+			const uint32_t to_cluster = polygon_path_clusters[navbase_polygon_offsets[connection.polygon->owner] + connection.polygon->id];
+			if (to_cluster == p_from_cluster) {
+				continue;
+			}
+			PathClusterPortal &portal = path_cluster_portals[((uint64_t)p_from_cluster << 32) | to_cluster];
+			portal.position_sum += (connection.pathway_start + connection.pathway_end) * 0.5;
+			portal.count += 1;
+		}
+	};
+
+	for (const KeyValue<const NavBaseIteration3D *, uint32_t> &E : navbase_polygon_offsets) {
+		const NavBaseIteration3D *navbase = E.key;
+		const LocalVector<LocalVector<Connection>> &internal_connections = navbase->get_internal_connections();
+		const LocalVector<LocalVector<Connection>> *external_connections = map_iteration->navbases_polygons_external_connections.getptr(navbase);
+		const uint32_t navbase_polygon_count = navbase->get_type() == NavigationEnums3D::PathSegmentType::PATH_SEGMENT_TYPE_LINK ? 1 : navbase->get_navmesh_polygons().size();
+
+		for (uint32_t polygon_id = 0; polygon_id < navbase_polygon_count; polygon_id++) {
+			const uint32_t from_cluster = polygon_path_clusters[E.value + polygon_id];
+			if (polygon_id < internal_connections.size()) {
+				add_portals(from_cluster, internal_connections[polygon_id]);
+			}
+			if (external_connections && polygon_id < external_connections->size()) {
+				add_portals(from_cluster, (*external_connections)[polygon_id]);
+			}
+		}
+	}
+
+	// Store the connections sorted by source cluster.
+	for (const KeyValue<uint64_t, PathClusterPortal> &E : path_cluster_portals) {
+		path_clusters[E.key >> 32].connections_end += 1;
+	}
+	uint32_t connection_count = 0;
+	for (PathCluster &path_cluster : path_clusters) {
+		path_cluster.connections_begin = connection_count;
+		connection_count += path_cluster.connections_end;
+		path_cluster.connections_end = path_cluster.connections_begin;
+	}
+	path_cluster_connections.resize(connection_count);
+
+	for (const KeyValue<uint64_t, PathClusterPortal> &E : path_cluster_portals) {
+		PathCluster &from_cluster = path_clusters[E.key >> 32];
+		const uint32_t to_cluster_id = E.key & UINT32_MAX;
+		const PathCluster &to_cluster = path_clusters[to_cluster_id];
+		const Vector3 portal_position = E.value.position_sum / E.value.count;
+
+		PathClusterConnection &connection = path_cluster_connections[from_cluster.connections_end++];
+		connection.cluster = to_cluster_id;
+		connection.cost = from_cluster.center.distance_to(portal_position) * from_cluster.owner->get_travel_cost() + portal_position.distance_to(to_cluster.center) * to_cluster.owner->get_travel_cost();
+		if (from_cluster.owner != to_cluster.owner) {
+			connection.cost += to_cluster.owner->get_enter_cost();
+		}
+	}
+}
+
 void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_build) {
 	NavMapIteration3D *map_iteration = r_build.map_iteration;
 
@@ -425,6 +809,12 @@ void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_buil
 		}
 
 		DEV_ASSERT(p_path_query_slot.path_corridor.size() == p_path_query_slot.poly_to_id.size());
+
+		p_path_query_slot.traversable_path_clusters.clear();
+		p_path_query_slot.path_cluster_nodes.resize(map_iteration->path_clusters.size());
+		for (uint32_t i = 0; i < p_path_query_slot.path_cluster_nodes.size(); i++) {
+			p_path_query_slot.path_cluster_nodes[i].id = i;
+		}
 	}
 
 	map_iteration->path_query_slots_mutex.unlock();
@@ -36,12 +36,18 @@ struct NavMapIterationBuild3D;
 
 class NavMapBuilder3D {
 	static void _build_step_gather_region_polygons(NavMapIterationBuild3D &r_build);
+	static void _build_step_region_bvh(NavMapIterationBuild3D &r_build);
+	static void _build_step_find_changed_regions(NavMapIterationBuild3D &r_build);
 	static void _build_step_find_edge_connection_pairs(NavMapIterationBuild3D &r_build);
 	static void _build_step_merge_edge_connection_pairs(NavMapIterationBuild3D &r_build);
 	static void _build_step_edge_connection_margin_connections(NavMapIterationBuild3D &r_build);
+	static void _build_step_copy_region_connections(NavMapIterationBuild3D &r_build);
 	static void _build_step_navlink_connections(NavMapIterationBuild3D &r_build);
+	static void _build_step_path_clusters(NavMapIterationBuild3D &r_build);
 	static void _build_update_map_iteration(NavMapIterationBuild3D &r_build);
 
+	static void _build_find_link_polygons(NavMapIterationBuild3D &r_build, const Vector3 &p_link_start_pos, const Vector3 &p_link_end_pos, Nav3D::Polygon *&r_closest_start_polygon, Vector3 &r_closest_start_point, Nav3D::Polygon *&r_closest_end_polygon, Vector3 &r_closest_end_point);
+
 public:
 	static Nav3D::PointKey get_point_key(const Vector3 &p_pos, const Vector3 &p_cell_size);
 
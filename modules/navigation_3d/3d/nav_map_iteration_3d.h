@@ -31,6 +31,7 @@
 #pragma once
 
 #include "../nav_utils_3d.h"
+#include "nav_bvh_3d.h"
 #include "nav_mesh_queries_3d.h"
 
 #include "core/math/math_defs.h"
@@ -47,6 +48,7 @@ struct NavMapIterationBuild3D {
 	bool use_edge_connections = true;
 	real_t edge_connection_margin;
 	real_t link_connection_radius;
+	uint32_t path_cluster_size = 0;
 	Nav3D::PerformanceData performance_data;
 	int polygon_count = 0;
 	int free_edge_count = 0;
@@ -54,6 +56,40 @@ struct NavMapIterationBuild3D {
 	HashMap<Nav3D::EdgeKey, Nav3D::EdgeConnectionPair, Nav3D::EdgeKey> iter_connection_pairs_map;
 	LocalVector<Nav3D::Connection> iter_free_edges;
 
+	// Regions whose external edges take part in the edge connection steps of this build.
+	LocalVector<NavRegionIteration3D *> iter_edge_regions;
+	// Bounds of the region iterations that were added or removed since the previous build.
+	LocalVector<AABB> iter_dirty_bounds;
+
+	// The connections of the previous builds are kept so that only regions and links near changes need new connections.
+	struct RegionConnections {
+		Ref<NavRegionIteration3D> region_iteration;
+		// Edge connections of each polygon to other regions, the link connections are not included.
+		LocalVector<LocalVector<Nav3D::Connection>> polygons_connections;
+		// Connections that were made with the edge connection margin.
+		LocalVector<Nav3D::Connection> margin_connections;
+		int edge_connection_count = 0;
+		int edge_free_count = 0;
+		bool rebuild = false;
+	};
+
+	struct LinkConnections {
+		Ref<NavLinkIteration3D> link_iteration;
+		Nav3D::Polygon *start_polygon = nullptr;
+		Nav3D::Polygon *end_polygon = nullptr;
+		Vector3 start_point;
+		Vector3 end_point;
+	};
+
+	HashMap<const NavBaseIteration3D *, RegionConnections> region_connections_cache;
+	HashMap<const NavBaseIteration3D *, LinkConnections> link_connections_cache;
+
+	// The settings the cached connections were made with.
+	Vector3 cache_merge_rasterizer_cell_size;
+	bool cache_use_edge_connections = true;
+	real_t cache_edge_connection_margin = 0.0;
+	real_t cache_link_connection_radius = 0.0;
+
 	NavMapIteration3D *map_iteration = nullptr;
 
 	int navmesh_polygon_count = 0;
@@ -63,11 +99,18 @@ struct NavMapIterationBuild3D {
 
 		iter_connection_pairs_map.clear();
 		iter_free_edges.clear();
+		iter_edge_regions.clear();
+		iter_dirty_bounds.clear();
 		polygon_count = 0;
 		free_edge_count = 0;
 
 		navmesh_polygon_count = 0;
 	}
+
+	void clear_cache() {
+		region_connections_cache.clear();
+		link_connections_cache.clear();
+	}
 };
 
 struct NavMapIteration3D {
@@ -79,6 +122,9 @@ struct NavMapIteration3D {
 	LocalVector<Ref<NavRegionIteration3D>> region_iterations;
 	LocalVector<Ref<NavLinkIteration3D>> link_iterations;
 
+	// Bounds of the region iterations, indexed like `region_iterations`.
+	NavBVH3D region_bvh;
+
 	int navmesh_polygon_count = 0;
 
 	// The edge connections that the map builds on top with the edge connection margin.
@@ -87,6 +133,11 @@ struct NavMapIteration3D {
 
 	LocalVector<Nav3D::Polygon> navlink_polygons;
 
+	// Coarse graph for long path searches, polygons are indexed like in the path query slots.
+	LocalVector<Nav3D::PathCluster> path_clusters;
+	LocalVector<Nav3D::PathClusterConnection> path_cluster_connections;
+	LocalVector<uint32_t> polygon_path_clusters;
+
 	HashMap<NavRegion3D *, Ref<NavRegionIteration3D>> region_ptr_to_region_iteration;
 
 	LocalVector<NavMeshQueries3D::PathQuerySlot> path_query_slots;
@@ -99,9 +150,13 @@ struct NavMapIteration3D {
 
 		region_iterations.clear();
 		link_iterations.clear();
+		region_bvh.clear();
 		external_region_connections.clear();
 		navbases_polygons_external_connections.clear();
 		navlink_polygons.clear();
+		path_clusters.clear();
+		path_cluster_connections.clear();
+		polygon_path_clusters.clear();
 		region_ptr_to_region_iteration.clear();
 	}
 };
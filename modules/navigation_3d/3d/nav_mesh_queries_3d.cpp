@@ -150,129 +150,160 @@ void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQue
 	ERR_FAIL_COND(p_query_parameters.is_null());
 	ERR_FAIL_COND(p_query_result.is_null());
 
-	using namespace NavigationDefaults3D;
-
 	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
-	query_task.start_position = p_query_parameters->get_start_position();
-	query_task.target_position = p_query_parameters->get_target_position();
-	query_task.navigation_layers = p_query_parameters->get_navigation_layers();
+	query_task_set_parameters(query_task, p_query_parameters);
 	query_task.callback = p_callback;
 
+	map->query_path(query_task);
+
+	query_task_get_result(query_task, p_query_result);
+
+	if (query_task.callback.is_valid()) {
+		if (emit_callback(query_task.callback)) {
+			query_task.status = NavMeshPathQueryTask3D::TaskStatus::CALLBACK_DISPATCHED;
+		} else {
+			query_task.status = NavMeshPathQueryTask3D::TaskStatus::CALLBACK_FAILED;
+		}
+	}
+}
+
+void NavMeshQueries3D::map_query_path_batch_thread(void *p_arg, uint32_t p_index) {
+	PathQueryBatch3D *batch = static_cast<PathQueryBatch3D *>(p_arg);
+
+	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
+	query_task_set_parameters(query_task, batch->query_parameters[p_index]);
+
+	// Maps without an iteration yet return empty results, same as `map_query_path()`.
+	if (batch->map_iteration != nullptr) {
+		batch->map->query_path(query_task, *batch->map_iteration);
+	}
+
+	query_task_get_result(query_task, batch->query_results[p_index]);
+}
+
+void NavMeshQueries3D::query_task_set_parameters(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters) {
+	using namespace NavigationDefaults3D;
+
+	r_query_task.start_position = p_query_parameters->get_start_position();
+	r_query_task.target_position = p_query_parameters->get_target_position();
+	r_query_task.navigation_layers = p_query_parameters->get_navigation_layers();
+
 	const TypedArray<RID> &_excluded_regions = p_query_parameters->get_excluded_regions();
 	const TypedArray<RID> &_included_regions = p_query_parameters->get_included_regions();
 
 	uint32_t _excluded_region_count = _excluded_regions.size();
 	uint32_t _included_region_count = _included_regions.size();
 
-	query_task.exclude_regions = _excluded_region_count > 0;
-	query_task.include_regions = _included_region_count > 0;
+	r_query_task.exclude_regions = _excluded_region_count > 0;
+	r_query_task.include_regions = _included_region_count > 0;
 
-	if (query_task.exclude_regions) {
-		query_task.excluded_regions.resize(_excluded_region_count);
+	if (r_query_task.exclude_regions) {
+		r_query_task.excluded_regions.resize(_excluded_region_count);
 		for (uint32_t i = 0; i < _excluded_region_count; i++) {
-			query_task.excluded_regions[i] = _excluded_regions[i];
+			r_query_task.excluded_regions[i] = _excluded_regions[i];
 		}
 	}
 
-	if (query_task.include_regions) {
-		query_task.included_regions.resize(_included_region_count);
+	if (r_query_task.include_regions) {
+		r_query_task.included_regions.resize(_included_region_count);
 		for (uint32_t i = 0; i < _included_region_count; i++) {
-			query_task.included_regions[i] = _included_regions[i];
+			r_query_task.included_regions[i] = _included_regions[i];
 		}
 	}
 
 	switch (p_query_parameters->get_pathfinding_algorithm()) {
 		case NavigationPathQueryParameters3D::PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR: {
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathfindingAlgorithm - fallback to default");
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 	}
 
 	switch (p_query_parameters->get_path_postprocessing()) {
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_NONE: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathPostProcessing - fallback to default");
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 	}
 
-	query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
-	query_task.simplify_path = p_query_parameters->get_simplify_path();
-	query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
-	query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
-	query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
-	query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
-	query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
-	query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
-
-	map->query_path(query_task);
+	r_query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
+	r_query_task.simplify_path = p_query_parameters->get_simplify_path();
+	r_query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
+	r_query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
+	r_query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
+	r_query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
+	r_query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
+	r_query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+}
 
+void NavMeshQueries3D::query_task_get_result(const NavMeshPathQueryTask3D &p_query_task, Ref<NavigationPathQueryResult3D> p_query_result) {
 	p_query_result->set_data(
-			query_task.path_points,
-			query_task.path_meta_point_types,
-			query_task.path_meta_point_rids,
-			query_task.path_meta_point_owners);
-	p_query_result->set_path_length(query_task.path_length);
-
-	if (query_task.callback.is_valid()) {
-		if (emit_callback(query_task.callback)) {
-			query_task.status = NavMeshPathQueryTask3D::TaskStatus::CALLBACK_DISPATCHED;
-		} else {
-			query_task.status = NavMeshPathQueryTask3D::TaskStatus::CALLBACK_FAILED;
-		}
-	}
+			p_query_task.path_points,
+			p_query_task.path_meta_point_types,
+			p_query_task.path_meta_point_rids,
+			p_query_task.path_meta_point_owners);
+	p_query_result->set_path_length(p_query_task.path_length);
 }
 
 void NavMeshQueries3D::_query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
-	real_t begin_d = FLT_MAX;
-	real_t end_d = FLT_MAX;
-
 	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
 
-	for (const Ref<NavRegionIteration3D> &region : regions) {
-		if (!_query_task_is_connection_owner_usable(p_query_task, region.ptr())) {
-			continue;
-		}
-
-		// Find the initial poly and the end poly on this map.
-		for (const Polygon &p : region->get_navmesh_polygons()) {
-			// Only consider the polygon if it in a region with compatible layers.
-			if ((p_query_task.navigation_layers & p.owner->get_navigation_layers()) == 0) {
-				continue;
-			}
+	// Find the initial poly and the end poly on this map.
+	for (int i = 0; i < 2; i++) {
+		const bool is_begin = i == 0;
+		const Vector3 &position = is_begin ? p_query_task.start_position : p_query_task.target_position;
+		real_t closest_distance_squared = FLT_MAX;
 
-			// For each face check the distance between the origin/destination.
-			for (uint32_t point_id = 2; point_id < p.vertices.size(); point_id++) {
-				const Face3 face(p.vertices[0], p.vertices[point_id - 1], p.vertices[point_id]);
+		const auto node_distance = [&position](const AABB &p_bounds) {
+			return NavBVH3D::get_distance_squared_to_point(p_bounds, position);
+		};
 
-				Vector3 point = face.get_closest_point_to(p_query_task.start_position);
-				real_t distance_to_point = point.distance_to(p_query_task.start_position);
-				if (distance_to_point < begin_d) {
-					begin_d = distance_to_point;
-					p_query_task.begin_polygon = &p;
-					p_query_task.begin_position = point;
-				}
+		p_map_iteration.region_bvh.query_nearest(node_distance, [&](uint32_t p_region_index) {
+			const NavRegionIteration3D *region = regions[p_region_index].ptr();
+			if (!_query_task_is_connection_owner_usable(p_query_task, region)) {
+				return;
+			}
+			// Only consider the polygons if they are in a region with compatible layers.
+			if ((p_query_task.navigation_layers & region->get_navigation_layers()) == 0) {
+				return;
+			}
 
-				point = face.get_closest_point_to(p_query_task.target_position);
-				distance_to_point = point.distance_to(p_query_task.target_position);
-				if (distance_to_point < end_d) {
-					end_d = distance_to_point;
-					p_query_task.end_polygon = &p;
-					p_query_task.end_position = point;
+			const LocalVector<Polygon> &polygons = region->get_navmesh_polygons();
+			region->get_polygon_bvh().query_nearest(node_distance, [&](uint32_t p_polygon_index) {
+				const Polygon &p = polygons[p_polygon_index];
+
+				// For each face check the distance to the origin/destination.
+				for (uint32_t point_id = 2; point_id < p.vertices.size(); point_id++) {
+					const Face3 face(p.vertices[0], p.vertices[point_id - 1], p.vertices[point_id]);
+
+					const Vector3 point = face.get_closest_point_to(position);
+					const real_t distance_squared = point.distance_squared_to(position);
+					if (distance_squared < closest_distance_squared) {
+						closest_distance_squared = distance_squared;
+						if (is_begin) {
+							p_query_task.begin_polygon = &p;
+							p_query_task.begin_position = point;
+						} else {
+							p_query_task.end_polygon = &p;
+							p_query_task.end_position = point;
+						}
+					}
 				}
-			}
-		}
+			},
+					closest_distance_squared);
+		},
+				closest_distance_squared);
 	}
 }
 
@@ -293,8 +324,14 @@ void NavMeshQueries3D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 	Vector3 new_entry = Geometry3D::get_closest_point_to_segment(p_least_cost_poly.entry, p_connection.pathway_start, p_connection.pathway_end);
 	real_t new_traveled_distance = p_least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost + p_poly_enter_cost + p_least_cost_poly.traveled_distance;
 
+	const uint32_t neighbor_poly_id = p_query_task.path_query_slot->poly_to_id[p_connection.polygon];
+	if (p_query_task.polygon_path_clusters && !p_query_task.path_query_slot->path_cluster_nodes[(*p_query_task.polygon_path_clusters)[neighbor_poly_id]].in_corridor) {
+		p_query_task.path_query_slot->path_corridor_border_ids.push_back(p_least_cost_id);
+		return;
+	}
+
 	// Check if the neighbor polygon has already been processed.
-	NavigationPoly &neighbor_poly = navigation_polys[p_query_task.path_query_slot->poly_to_id[p_connection.polygon]];
+	NavigationPoly &neighbor_poly = navigation_polys[neighbor_poly_id];
 	if (new_traveled_distance < neighbor_poly.traveled_distance) {
 		// Add the polygon to the heap of polygons to traverse next.
 		neighbor_poly.back_navigation_poly_id = p_least_cost_id;
@@ -317,6 +354,95 @@ void NavMeshQueries3D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 }
 
 void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
+	// Long paths search the coarse cluster graph first and refine through the polygons of the found clusters only.
+	if (_query_task_search_path_clusters(p_query_task, p_map_iteration)) {
+		p_query_task.polygon_path_clusters = &p_map_iteration.polygon_path_clusters;
+	}
+
+	_query_task_search_path_corridor(p_query_task, p_map_iteration);
+	p_query_task.polygon_path_clusters = nullptr;
+}
+
+bool NavMeshQueries3D::_query_task_search_path_clusters(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
+	const LocalVector<PathCluster> &path_clusters = p_map_iteration.path_clusters;
+	if (path_clusters.is_empty()) {
+		return false;
+	}
+
+	PathQuerySlot *path_query_slot = p_query_task.path_query_slot;
+	const uint32_t begin_cluster_id = p_map_iteration.polygon_path_clusters[path_query_slot->poly_to_id[p_query_task.begin_polygon]];
+	const uint32_t end_cluster_id = p_map_iteration.polygon_path_clusters[path_query_slot->poly_to_id[p_query_task.end_polygon]];
+	if (begin_cluster_id == end_cluster_id) {
+		return false;
+	}
+
+	LocalVector<PathClusterNode> &path_cluster_nodes = path_query_slot->path_cluster_nodes;
+	Heap<PathClusterNode *, PathClusterTravelCostGreaterThan, PathClusterHeapIndexer> &traversable_path_clusters = path_query_slot->traversable_path_clusters;
+	traversable_path_clusters.clear();
+	for (PathClusterNode &path_cluster_node : path_cluster_nodes) {
+		path_cluster_node.reset();
+	}
+
+	const Vector3 &end_point = p_query_task.end_position;
+
+	const PathCluster &begin_cluster = path_clusters[begin_cluster_id];
+	path_cluster_nodes[begin_cluster_id].traveled_cost = 0.0;
+	path_cluster_nodes[begin_cluster_id].distance_to_destination = begin_cluster.center.distance_to(end_point) * begin_cluster.owner->get_travel_cost();
+	traversable_path_clusters.push(&path_cluster_nodes[begin_cluster_id]);
+
+	// This is an implementation of the A* algorithm on the cluster graph.
+	bool found_route = false;
+	while (!traversable_path_clusters.is_empty()) {
+		const PathClusterNode *least_cost_node = traversable_path_clusters.pop();
+		if (least_cost_node->id == end_cluster_id) {
+			found_route = true;
+			break;
+		}
+
+		const PathCluster &least_cost_cluster = path_clusters[least_cost_node->id];
+		for (uint32_t i = least_cost_cluster.connections_begin; i < least_cost_cluster.connections_end; i++) {
+			const PathClusterConnection &connection = p_map_iteration.path_cluster_connections[i];
+			const PathCluster &neighbor_cluster = path_clusters[connection.cluster];
+			if (!_query_task_is_connection_owner_usable(p_query_task, neighbor_cluster.owner)) {
+				continue;
+			}
+
+			const real_t new_traveled_cost = least_cost_node->traveled_cost + connection.cost;
+			PathClusterNode &neighbor_node = path_cluster_nodes[connection.cluster];
+			if (new_traveled_cost < neighbor_node.traveled_cost) {
+				neighbor_node.back_cluster_id = least_cost_node->id;
+				neighbor_node.traveled_cost = new_traveled_cost;
+				neighbor_node.distance_to_destination = neighbor_cluster.center.distance_to(end_point) * neighbor_cluster.owner->get_travel_cost();
+
+				if (neighbor_node.traversable_cluster_index != traversable_path_clusters.INVALID_INDEX) {
+					traversable_path_clusters.shift(neighbor_node.traversable_cluster_index);
+				} else {
+					traversable_path_clusters.push(&neighbor_node);
+				}
+			}
+		}
+	}
+	traversable_path_clusters.clear();
+
+	if (!found_route) {
+		// Let the polygon search find the closest reachable point.
+		return false;
+	}
+
+	// The route and its neighbors are always part of the corridor.
+	for (uint32_t cluster_id = end_cluster_id; cluster_id != UINT32_MAX; cluster_id = path_cluster_nodes[cluster_id].back_cluster_id) {
+		path_cluster_nodes[cluster_id].in_corridor = true;
+
+		const PathCluster &path_cluster = path_clusters[cluster_id];
+		for (uint32_t i = path_cluster.connections_begin; i < path_cluster.connections_end; i++) {
+			path_cluster_nodes[p_map_iteration.path_cluster_connections[i].cluster].in_corridor = true;
+		}
+	}
+
+	return true;
+}
+
+void NavMeshQueries3D::_query_task_search_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	const Vector3 p_target_position = p_query_task.target_position;
 	const Polygon *begin_poly = p_query_task.begin_polygon;
 	const Polygon *end_poly = p_query_task.end_polygon;
@@ -332,6 +458,8 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 	for (NavigationPoly &polygon : navigation_polys) {
 		polygon.reset();
 	}
+	LocalVector<uint32_t> &path_corridor_border_ids = p_query_task.path_query_slot->path_corridor_border_ids;
+	path_corridor_border_ids.clear();
 
 	// Initialize the matching navigation polygon.
 	NavigationPoly &begin_navigation_poly = navigation_polys[p_query_task.path_query_slot->poly_to_id[begin_poly]];
@@ -397,6 +525,20 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 		}
 
 		poly_enter_cost = 0;
+
+		if (traversable_polys.is_empty() && p_query_task.polygon_path_clusters && !path_search_max_reached) {
+			// The corridor can miss routes, e.g. through clusters that are split by obstacles. Instead of searching
+			// again from the start, leave the corridor and continue from the polygons that stopped at its border.
+			p_query_task.polygon_path_clusters = nullptr;
+			for (uint32_t border_id : path_corridor_border_ids) {
+				NavigationPoly &border_poly = navigation_polys[border_id];
+				if (border_poly.traversable_poly_index == traversable_polys.INVALID_INDEX) {
+					traversable_polys.push(&border_poly);
+				}
+			}
+			path_corridor_border_ids.clear();
+		}
+
 		// When the heap of traversable polygons is empty at this point it means the end polygon is
 		// unreachable.
 		if (traversable_polys.is_empty()) {
@@ -878,67 +1020,97 @@ void NavMeshQueries3D::_query_task_post_process_nopostprocessing(NavMeshPathQuer
 }
 
 Vector3 NavMeshQueries3D::map_iteration_get_closest_point_to_segment(const NavMapIteration3D &p_map_iteration, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) {
-	bool use_collision = p_use_collision;
+	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
+
+	// An intersection with the segment always wins, look for the one closest to `p_from` first.
 	Vector3 closest_point;
-	real_t closest_point_distance = FLT_MAX;
+	real_t closest_point_distance_squared = FLT_MAX;
 
-	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
-	for (const Ref<NavRegionIteration3D> &region : regions) {
-		for (const Polygon &polygon : region->get_navmesh_polygons()) {
-			// For each face check the distance to the segment.
+	const auto intersection_distance = [&p_from, &p_to](const AABB &p_bounds) {
+		if (!NavBVH3D::intersects_segment(p_bounds, p_from, p_to)) {
+			return real_t(FLT_MAX);
+		}
+		return NavBVH3D::get_distance_squared_to_point(p_bounds, p_from);
+	};
+
+	p_map_iteration.region_bvh.query_nearest(intersection_distance, [&](uint32_t p_region_index) {
+		const LocalVector<Polygon> &polygons = regions[p_region_index]->get_navmesh_polygons();
+		regions[p_region_index]->get_polygon_bvh().query_nearest(intersection_distance, [&](uint32_t p_polygon_index) {
+			const Polygon &polygon = polygons[p_polygon_index];
 			for (uint32_t point_id = 2; point_id < polygon.vertices.size(); point_id += 1) {
 				const Face3 face(polygon.vertices[0], polygon.vertices[point_id - 1], polygon.vertices[point_id]);
 				Vector3 intersection_point;
 				if (face.intersects_segment(p_from, p_to, &intersection_point)) {
-					const real_t d = p_from.distance_to(intersection_point);
-					if (!use_collision) {
+					const real_t d = p_from.distance_squared_to(intersection_point);
+					if (d < closest_point_distance_squared) {
 						closest_point = intersection_point;
-						use_collision = true;
-						closest_point_distance = d;
-					} else if (closest_point_distance > d) {
-						closest_point = intersection_point;
-						closest_point_distance = d;
+						closest_point_distance_squared = d;
 					}
 				}
-				// If segment does not itersect face, check the distance from segment's endpoints.
-				else if (!use_collision) {
-					const Vector3 p_from_closest = face.get_closest_point_to(p_from);
-					const real_t d_p_from = p_from.distance_to(p_from_closest);
-					if (closest_point_distance > d_p_from) {
-						closest_point = p_from_closest;
-						closest_point_distance = d_p_from;
-					}
+			}
+		},
+				closest_point_distance_squared);
+	},
+			closest_point_distance_squared);
 
-					const Vector3 p_to_closest = face.get_closest_point_to(p_to);
-					const real_t d_p_to = p_to.distance_to(p_to_closest);
-					if (closest_point_distance > d_p_to) {
-						closest_point = p_to_closest;
-						closest_point_distance = d_p_to;
-					}
+	if (p_use_collision || closest_point_distance_squared < FLT_MAX) {
+		return closest_point;
+	}
+
+	// The segment does not intersect any face, find the closest point from the segment instead.
+	AABB segment_bounds(p_from, Vector3());
+	segment_bounds.expand_to(p_to);
+
+	const auto segment_distance = [&segment_bounds](const AABB &p_bounds) {
+		return NavBVH3D::get_distance_squared_to_bounds(p_bounds, segment_bounds);
+	};
+
+	p_map_iteration.region_bvh.query_nearest(segment_distance, [&](uint32_t p_region_index) {
+		const LocalVector<Polygon> &polygons = regions[p_region_index]->get_navmesh_polygons();
+		regions[p_region_index]->get_polygon_bvh().query_nearest(segment_distance, [&](uint32_t p_polygon_index) {
+			const Polygon &polygon = polygons[p_polygon_index];
+
+			// For each face check the distance from the segment's endpoints.
+			for (uint32_t point_id = 2; point_id < polygon.vertices.size(); point_id += 1) {
+				const Face3 face(polygon.vertices[0], polygon.vertices[point_id - 1], polygon.vertices[point_id]);
+
+				const Vector3 p_from_closest = face.get_closest_point_to(p_from);
+				const real_t d_p_from = p_from.distance_squared_to(p_from_closest);
+				if (closest_point_distance_squared > d_p_from) {
+					closest_point = p_from_closest;
+					closest_point_distance_squared = d_p_from;
+				}
+
+				const Vector3 p_to_closest = face.get_closest_point_to(p_to);
+				const real_t d_p_to = p_to.distance_squared_to(p_to_closest);
+				if (closest_point_distance_squared > d_p_to) {
+					closest_point = p_to_closest;
+					closest_point_distance_squared = d_p_to;
 				}
 			}
+
 			// Finally, check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
-			if (!use_collision) {
-				for (uint32_t point_id = 0; point_id < polygon.vertices.size(); point_id += 1) {
-					Vector3 a, b;
-
-					Geometry3D::get_closest_points_between_segments(
-							p_from,
-							p_to,
-							polygon.vertices[point_id],
-							polygon.vertices[(point_id + 1) % polygon.vertices.size()],
-							a,
-							b);
-
-					const real_t d = a.distance_to(b);
-					if (d < closest_point_distance) {
-						closest_point_distance = d;
-						closest_point = b;
-					}
+			for (uint32_t point_id = 0; point_id < polygon.vertices.size(); point_id += 1) {
+				Vector3 a, b;
+
+				Geometry3D::get_closest_points_between_segments(
+						p_from,
+						p_to,
+						polygon.vertices[point_id],
+						polygon.vertices[(point_id + 1) % polygon.vertices.size()],
+						a,
+						b);
+
+				const real_t d = a.distance_squared_to(b);
+				if (d < closest_point_distance_squared) {
+					closest_point_distance_squared = d;
+					closest_point = b;
 				}
 			}
-		}
-	}
+		},
+				closest_point_distance_squared);
+	},
+			closest_point_distance_squared);
 
 	return closest_point;
 }
@@ -963,8 +1135,15 @@ ClosestPointQueryResult NavMeshQueries3D::map_iteration_get_closest_point_info(c
 	real_t closest_point_distance_squared = FLT_MAX;
 
 	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
-	for (const Ref<NavRegionIteration3D> &region : regions) {
-		for (const Polygon &polygon : region->get_navmesh_polygons()) {
+
+	const auto node_distance = [&p_point](const AABB &p_bounds) {
+		return NavBVH3D::get_distance_squared_to_point(p_bounds, p_point);
+	};
+
+	p_map_iteration.region_bvh.query_nearest(node_distance, [&](uint32_t p_region_index) {
+		const LocalVector<Polygon> &polygons = regions[p_region_index]->get_navmesh_polygons();
+		regions[p_region_index]->get_polygon_bvh().query_nearest(node_distance, [&](uint32_t p_polygon_index) {
+			const Polygon &polygon = polygons[p_polygon_index];
 			Vector3 plane_normal = (polygon.vertices[1] - polygon.vertices[0]).cross(polygon.vertices[2] - polygon.vertices[0]);
 			Vector3 closest_on_polygon;
 			real_t closest = FLT_MAX;
@@ -1012,10 +1191,6 @@ ClosestPointQueryResult NavMeshQueries3D::map_iteration_get_closest_point_info(c
 					result.point = p_point - plane_normalized * distance;
 					result.normal = plane_normalized;
 					result.owner = polygon.owner->get_self();
-
-					if (Math::is_zero_approx(distance)) {
-						break;
-					}
 				}
 			} else {
 				real_t distance = closest_on_polygon.distance_squared_to(p_point);
@@ -1026,8 +1201,10 @@ ClosestPointQueryResult NavMeshQueries3D::map_iteration_get_closest_point_info(c
 					result.owner = polygon.owner->get_self();
 				}
 			}
-		}
-	}
+		},
+				closest_point_distance_squared);
+	},
+			closest_point_distance_squared);
 
 	return result;
 }
@@ -32,6 +32,7 @@
 
 #include "../nav_utils_3d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/a_hash_map.h"
 #include "servers/nav_heap.h"
 #include "servers/navigation_3d/navigation_constants_3d.h"
@@ -52,6 +53,10 @@ public:
 		bool in_use = false;
 		uint32_t slot_index = 0;
 		AHashMap<const Nav3D::Polygon *, uint32_t> poly_to_id;
+		LocalVector<Nav3D::PathClusterNode> path_cluster_nodes;
+		Heap<Nav3D::PathClusterNode *, Nav3D::PathClusterTravelCostGreaterThan, Nav3D::PathClusterHeapIndexer> traversable_path_clusters;
+		// Polygons that had neighbors outside the cluster corridor, where the search continues if the corridor misses the route.
+		LocalVector<uint32_t> path_corridor_border_ids;
 	};
 
 	struct NavMeshPathQueryTask3D {
@@ -89,6 +94,8 @@ public:
 		const Nav3D::Polygon *begin_polygon = nullptr;
 		const Nav3D::Polygon *end_polygon = nullptr;
 		uint32_t least_cost_id = 0;
+		// Set while the polygon search is limited to the cluster corridor of the coarse search.
+		const LocalVector<uint32_t> *polygon_path_clusters = nullptr;
 
 		// Map.
 		Vector3 map_up;
@@ -122,6 +129,16 @@ public:
 		}
 	};
 
+	// Path queries submitted together, all run against the same pinned map iteration.
+	struct PathQueryBatch3D {
+		NavMap3D *map = nullptr;
+		NavMapIteration3D *map_iteration = nullptr;
+		LocalVector<Ref<NavigationPathQueryParameters3D>> query_parameters;
+		LocalVector<Ref<NavigationPathQueryResult3D>> query_results;
+		Callable callback;
+		WorkerThreadPool::GroupID group_task_id = -1;
+	};
+
 	static bool emit_callback(const Callable &p_callback);
 
 	static Vector3 polygons_get_random_point(const LocalVector<Nav3D::Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly);
@@ -140,11 +157,17 @@ public:
 	static Vector3 map_iteration_get_random_point(const NavMapIteration3D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly);
 
 	static void map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback);
+	static void map_query_path_batch_thread(void *p_arg, uint32_t p_index);
+
+	static void query_task_set_parameters(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters);
+	static void query_task_get_result(const NavMeshPathQueryTask3D &p_query_task, Ref<NavigationPathQueryResult3D> p_query_result);
 
 	static void query_task_map_iteration_get_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_push_back_point_with_metadata(NavMeshPathQueryTask3D &p_query_task, const Vector3 &p_point, const Nav3D::Polygon *p_point_polygon);
 	static void _query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static void _query_task_search_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static bool _query_task_search_path_clusters(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_post_process_corridorfunnel(NavMeshPathQueryTask3D &p_query_task);
 	static void _query_task_post_process_edgecentered(NavMeshPathQueryTask3D &p_query_task);
 	static void _query_task_post_process_nopostprocessing(NavMeshPathQueryTask3D &p_query_task);
@@ -51,6 +51,8 @@ void NavRegionBuilder3D::build_iteration(NavRegionIterationBuild3D &r_build) {
 
 	_build_step_merge_edge_connection_pairs(r_build);
 
+	_build_step_polygon_bvh(r_build);
+
 	_build_update_iteration(r_build);
 }
 
@@ -256,6 +258,41 @@ void NavRegionBuilder3D::_build_step_merge_edge_connection_pairs(NavRegionIterat
 	}
 }
 
+void NavRegionBuilder3D::_build_step_polygon_bvh(NavRegionIterationBuild3D &r_build) {
+	Ref<NavRegionIteration3D> region_iteration = r_build.region_iteration;
+	const LocalVector<Nav3D::Polygon> &navmesh_polygons = region_iteration->navmesh_polygons;
+
+	LocalVector<NavBVH3D::Item> items;
+	items.reserve(navmesh_polygons.size());
+
+	for (const Polygon &polygon : navmesh_polygons) {
+		if (polygon.vertices.size() < 3) {
+			continue;
+		}
+
+		NavBVH3D::Item item;
+		item.id = polygon.id;
+		item.bounds.position = polygon.vertices[0];
+		for (uint32_t i = 1; i < polygon.vertices.size(); i++) {
+			item.bounds.expand_to(polygon.vertices[i]);
+		}
+
+		// Closest point queries project on the plane of the first three vertices.
+		// Grow the bounds by how far the polygon is from being flat, so that they
+		// still contain that projection for non-planar polygons.
+		const Vector3 plane_normal = (polygon.vertices[1] - polygon.vertices[0]).cross(polygon.vertices[2] - polygon.vertices[0]).normalized();
+		real_t plane_margin = 0.0;
+		for (uint32_t i = 3; i < polygon.vertices.size(); i++) {
+			plane_margin = MAX(plane_margin, Math::abs(plane_normal.dot(polygon.vertices[i] - polygon.vertices[0])));
+		}
+		item.bounds.grow_by(plane_margin + CMP_EPSILON);
+
+		items.push_back(item);
+	}
+
+	region_iteration->polygon_bvh.build(items);
+}
+
 void NavRegionBuilder3D::_build_update_iteration(NavRegionIterationBuild3D &r_build) {
 	ERR_FAIL_NULL(r_build.region);
 	// Stub. End of the build.
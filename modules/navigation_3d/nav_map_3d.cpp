@@ -151,34 +151,55 @@ void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task
 
 	GET_MAP_ITERATION();
 
-	map_iteration.path_query_slots_semaphore.wait();
+	query_path(p_query_task, map_iteration);
+}
+
+void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task, NavMapIteration3D &p_map_iteration) {
+	p_map_iteration.path_query_slots_semaphore.wait();
 
-	map_iteration.path_query_slots_mutex.lock();
-	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : map_iteration.path_query_slots) {
+	p_map_iteration.path_query_slots_mutex.lock();
+	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : p_map_iteration.path_query_slots) {
 		if (!p_path_query_slot.in_use) {
 			p_path_query_slot.in_use = true;
 			p_query_task.path_query_slot = &p_path_query_slot;
 			break;
 		}
 	}
-	map_iteration.path_query_slots_mutex.unlock();
+	p_map_iteration.path_query_slots_mutex.unlock();
 
 	if (p_query_task.path_query_slot == nullptr) {
-		map_iteration.path_query_slots_semaphore.post();
+		p_map_iteration.path_query_slots_semaphore.post();
 		ERR_FAIL_NULL_MSG(p_query_task.path_query_slot, "No unused NavMap3D path query slot found! This should never happen :(.");
 	}
 
-	p_query_task.map_up = map_iteration.map_up;
+	p_query_task.map_up = p_map_iteration.map_up;
 
-	NavMeshQueries3D::query_task_map_iteration_get_path(p_query_task, map_iteration);
+	NavMeshQueries3D::query_task_map_iteration_get_path(p_query_task, p_map_iteration);
 
-	map_iteration.path_query_slots_mutex.lock();
+	p_map_iteration.path_query_slots_mutex.lock();
 	uint32_t used_slot_index = p_query_task.path_query_slot->slot_index;
-	map_iteration.path_query_slots[used_slot_index].in_use = false;
+	p_map_iteration.path_query_slots[used_slot_index].in_use = false;
 	p_query_task.path_query_slot = nullptr;
-	map_iteration.path_query_slots_mutex.unlock();
+	p_map_iteration.path_query_slots_mutex.unlock();
 
-	map_iteration.path_query_slots_semaphore.post();
+	p_map_iteration.path_query_slots_semaphore.post();
+}
+
+NavMapIteration3D *NavMap3D::acquire_iteration() {
+	if (iteration_id == 0) {
+		return nullptr;
+	}
+
+	// The builder only reuses an iteration slot once it has no users left.
+	RWLockRead read_lock(iteration_slot_rwlock);
+	NavMapIteration3D &map_iteration = iteration_slots[iteration_slot_index];
+	map_iteration.users.increment();
+	return &map_iteration;
+}
+
+void NavMap3D::release_iteration(NavMapIteration3D *p_map_iteration) {
+	ERR_FAIL_NULL(p_map_iteration);
+	p_map_iteration->users.decrement();
 }
 
 Vector3 NavMap3D::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -369,6 +390,7 @@ void NavMap3D::_build_iteration() {
 	iteration_build.use_edge_connections = get_use_edge_connections();
 	iteration_build.edge_connection_margin = get_edge_connection_margin();
 	iteration_build.link_connection_radius = get_link_connection_radius();
+	iteration_build.path_cluster_size = path_cluster_size;
 
 	next_map_iteration.clear();
 
@@ -588,7 +610,9 @@ void NavMap3D::_update_rvo_simulation() {
 		_update_rvo_obstacles_tree_2d();
 	}
 	if (agents_dirty) {
-		_update_rvo_agents_tree_2d();
+		if (!avoidance_use_batched_solver) {
+			_update_rvo_agents_tree_2d();
+		}
 		_update_rvo_agents_tree_3d();
 	}
 }
@@ -612,7 +636,9 @@ void NavMap3D::step(double p_delta_time) {
 	rvo_simulation_3d.setTimeStep(float(p_delta_time));
 
 	if (active_2d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
+		if (avoidance_use_batched_solver) {
+			avoidance_solver_2d.step(active_2d_avoidance_agents, &rvo_simulation_2d, use_threads && avoidance_use_multiple_threads);
+		} else if (use_threads && avoidance_use_multiple_threads) {
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
@@ -856,8 +882,10 @@ bool NavMap3D::get_use_async_iterations() const {
 NavMap3D::NavMap3D() {
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+	avoidance_use_batched_solver = GLOBAL_GET("navigation/avoidance/use_batched_solver");
 
 	path_query_slots_max = GLOBAL_GET("navigation/pathfinding/max_threads");
+	path_cluster_size = MAX(0, (int)GLOBAL_GET("navigation/pathfinding/path_cluster_size"));
 
 	int processor_count = OS::get_singleton()->get_processor_count();
 	if (path_query_slots_max < 0) {
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "3d/nav_avoidance_solver_3d.h"
 #include "3d/nav_map_iteration_3d.h"
 #include "3d/nav_mesh_queries_3d.h"
 #include "nav_rid_3d.h"
@@ -107,6 +108,10 @@ class NavMap3D : public NavRid3D {
 	bool avoidance_use_multiple_threads = true;
 	bool avoidance_use_high_priority_threads = true;
 
+	/// Solves the 2D avoidance agents with the batched solver instead of the RVO2 agents one by one.
+	bool avoidance_use_batched_solver = false;
+	NavAvoidanceSolver3D avoidance_solver_2d;
+
 	// Performance Monitor
 	Nav3D::PerformanceData performance_data;
 
@@ -137,6 +142,7 @@ class NavMap3D : public NavRid3D {
 	} async_dirty_requests;
 
 	int path_query_slots_max = 4;
+	uint32_t path_cluster_size = 0;
 
 	bool use_async_iterations = true;
 
@@ -198,6 +204,11 @@ public:
 	const Vector3 &get_merge_rasterizer_cell_size() const;
 
 	void query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task);
+	void query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task, NavMapIteration3D &p_map_iteration);
+
+	// Keeps the current iteration alive and unchanged until released, e.g. for path query batches.
+	NavMapIteration3D *acquire_iteration();
+	void release_iteration(NavMapIteration3D *p_map_iteration);
 
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
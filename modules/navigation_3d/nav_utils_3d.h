@@ -171,6 +171,54 @@ struct NavPolyHeapIndexer {
 	}
 };
 
+/// Polygons of one region or link that are connected and close to each other.
+/// Clusters are the nodes of the coarse graph that long path searches use first.
+struct PathCluster {
+	const NavBaseIteration3D *owner = nullptr;
+	Vector3 center;
+	/// Range of the outgoing connections in the map iteration `path_cluster_connections`.
+	uint32_t connections_begin = 0;
+	uint32_t connections_end = 0;
+};
+
+struct PathClusterConnection {
+	/// Cluster that this connection leads to.
+	uint32_t cluster = 0;
+	/// Travel cost from the source cluster center through the shared edges to the center of `cluster`.
+	real_t cost = 0.0;
+};
+
+struct PathClusterNode {
+	uint32_t id = 0;
+	/// Index in the heap of traversable clusters.
+	uint32_t traversable_cluster_index = UINT32_MAX;
+	uint32_t back_cluster_id = UINT32_MAX;
+	real_t traveled_cost = FLT_MAX;
+	real_t distance_to_destination = 0.0;
+	/// Polygons of this cluster may be used by the refining polygon search.
+	bool in_corridor = false;
+
+	void reset() {
+		traversable_cluster_index = UINT32_MAX;
+		back_cluster_id = UINT32_MAX;
+		traveled_cost = FLT_MAX;
+		distance_to_destination = 0.0;
+		in_corridor = false;
+	}
+};
+
+struct PathClusterTravelCostGreaterThan {
+	bool operator()(const PathClusterNode *p_cluster_a, const PathClusterNode *p_cluster_b) const {
+		return p_cluster_a->traveled_cost + p_cluster_a->distance_to_destination > p_cluster_b->traveled_cost + p_cluster_b->distance_to_destination;
+	}
+};
+
+struct PathClusterHeapIndexer {
+	void operator()(PathClusterNode *p_cluster, uint32_t p_heap_index) const {
+		p_cluster->traversable_cluster_index = p_heap_index;
+	}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
@@ -596,6 +596,7 @@ void AnimationMixer::_clear_caches(bool p_clear_track_cache) {
 	}
 	track_cache.clear();
 	animation_track_num_to_track_cache.clear();
+	animation_instance_key_cursors.clear();
 	cache_valid = false;
 	emit_signal(SNAME("caches_cleared"));
 }
@@ -1236,7 +1237,11 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 #ifdef TOOLS_ENABLED
 	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
 #endif // TOOLS_ENABLED
-	for (const AnimationInstance &ai : animation_instances) {
+	if (animation_instance_key_cursors.size() < animation_instances.size()) {
+		animation_instance_key_cursors.resize(animation_instances.size());
+	}
+	for (uint32_t instance_idx = 0; instance_idx < animation_instances.size(); instance_idx++) {
+		const AnimationInstance &ai = animation_instances[instance_idx];
 		const Ref<Animation> &a = ai.animation;
 		double time = ai.playback_info.time;
 		double delta = ai.playback_info.delta;
@@ -1259,6 +1264,11 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 		Animation::Track *const *tracks_ptr = tracks.ptr();
 		double a_length = a->get_length();
 		int count = tracks.size();
+		// The cursors are only hints for the key lookups, so they stay valid if another animation ends up in this instance.
+		LocalVector<int32_t> &key_cursors = animation_instance_key_cursors[instance_idx];
+		if (key_cursors.size() != (uint32_t)count) {
+			key_cursors.resize_initialized(count);
+		}
 		for (int i = 0; i < count; i++) {
 			const Animation::Track *animation_track = tracks_ptr[i];
 			if (!animation_track->enabled) {
@@ -1423,7 +1433,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 loc;
-						Error err = a->try_position_track_interpolate(i, time, &loc);
+						Error err = a->try_position_track_interpolate(i, time, &loc, false, &key_cursors[i]);
 						if (err != OK) {
 							continue;
 						}
@@ -1511,7 +1521,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Quaternion rot;
-						Error err = a->try_rotation_track_interpolate(i, time, &rot);
+						Error err = a->try_rotation_track_interpolate(i, time, &rot, false, &key_cursors[i]);
 						if (err != OK) {
 							continue;
 						}
@@ -1599,7 +1609,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 scale;
-						Error err = a->try_scale_track_interpolate(i, time, &scale);
+						Error err = a->try_scale_track_interpolate(i, time, &scale, false, &key_cursors[i]);
 						if (err != OK) {
 							continue;
 						}
@@ -1615,7 +1625,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
 					float value;
-					Error err = a->try_blend_shape_track_interpolate(i, time, &value);
+					Error err = a->try_blend_shape_track_interpolate(i, time, &value, false, &key_cursors[i]);
 					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 					if (err != OK) {
 						continue;
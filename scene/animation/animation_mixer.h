@@ -322,6 +322,7 @@ protected:
 
 	/* ---- Blending processor ---- */
 	LocalVector<AnimationInstance> animation_instances;
+	LocalVector<LocalVector<int32_t>> animation_instance_key_cursors; // Key cursors of the tracks, by index in animation_instances.
 	uint64_t animation_instance_weight_pass_counter = 0;
 	AHashMap<NodePath, int> track_map;
 	uint64_t track_map_version = 1;
@@ -1180,7 +1180,7 @@ Error Animation::position_track_get_key(int p_track, int p_key, Vector3 *r_posit
 	return OK;
 }
 
-Error Animation::try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward) const {
+Error Animation::try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward, int32_t *r_cursor) const {
 	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_POSITION_3D, ERR_INVALID_PARAMETER);
@@ -1197,7 +1197,7 @@ Error Animation::try_position_track_interpolate(int p_track, double p_time, Vect
 
 	bool ok = false;
 
-	Vector3 tk = _interpolate(tt->positions, p_time, tt->interpolation, tt->loop_wrap, &ok, p_backward);
+	Vector3 tk = _interpolate(tt->positions, p_time, tt->interpolation, tt->loop_wrap, &ok, p_backward, r_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1260,7 +1260,7 @@ Error Animation::rotation_track_get_key(int p_track, int p_key, Quaternion *r_ro
 	return OK;
 }
 
-Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward) const {
+Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward, int32_t *r_cursor) const {
 	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_ROTATION_3D, ERR_INVALID_PARAMETER);
@@ -1277,7 +1277,7 @@ Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quat
 
 	bool ok = false;
 
-	Quaternion tk = _interpolate(rt->rotations, p_time, rt->interpolation, rt->loop_wrap, &ok, p_backward);
+	Quaternion tk = _interpolate(rt->rotations, p_time, rt->interpolation, rt->loop_wrap, &ok, p_backward, r_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1340,7 +1340,7 @@ Error Animation::scale_track_get_key(int p_track, int p_key, Vector3 *r_scale) c
 	return OK;
 }
 
-Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward) const {
+Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward, int32_t *r_cursor) const {
 	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_SCALE_3D, ERR_INVALID_PARAMETER);
@@ -1357,7 +1357,7 @@ Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3
 
 	bool ok = false;
 
-	Vector3 tk = _interpolate(st->scales, p_time, st->interpolation, st->loop_wrap, &ok, p_backward);
+	Vector3 tk = _interpolate(st->scales, p_time, st->interpolation, st->loop_wrap, &ok, p_backward, r_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1420,7 +1420,7 @@ Error Animation::blend_shape_track_get_key(int p_track, int p_key, float *r_blen
 	return OK;
 }
 
-Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, float *r_interpolation, bool p_backward) const {
+Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, float *r_interpolation, bool p_backward, int32_t *r_cursor) const {
 	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_BLEND_SHAPE, ERR_INVALID_PARAMETER);
@@ -1437,7 +1437,7 @@ Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, f
 
 	bool ok = false;
 
-	float tk = _interpolate(bst->blend_shapes, p_time, bst->interpolation, bst->loop_wrap, &ok, p_backward);
+	float tk = _interpolate(bst->blend_shapes, p_time, bst->interpolation, bst->loop_wrap, &ok, p_backward, r_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -2447,6 +2447,68 @@ int Animation::_find(const LocalVector<K> &p_keys, double p_time, bool p_backwar
 	return middle;
 }
 
+template <typename K>
+int Animation::_find_from_cursor(const LocalVector<K> &p_keys, double p_time, bool p_backward, int32_t &r_cursor) const {
+	const int len = p_keys.size();
+	if (len == 0 || Math::is_nan(p_time)) {
+		return _find(p_keys, p_time, p_backward);
+	}
+
+	const K *keys = p_keys.ptr();
+
+	// The cursor is the index of the first key after `p_time`. When playing, it is usually still right or one key behind.
+	int upper = CLAMP(r_cursor, 0, len);
+	if (upper < len && keys[upper].time <= p_time) {
+		upper++;
+		if (upper < len && keys[upper].time <= p_time) {
+			int low = upper + 1;
+			int high = len;
+			while (low < high) {
+				const int middle = (low + high) / 2;
+				if (keys[middle].time <= p_time) {
+					low = middle + 1;
+				} else {
+					high = middle;
+				}
+			}
+			upper = low;
+		}
+	} else if (upper > 0 && keys[upper - 1].time > p_time) {
+		upper--;
+		if (upper > 0 && keys[upper - 1].time > p_time) {
+			int low = 0;
+			int high = upper - 1;
+			while (low < high) {
+				const int middle = (low + high) / 2;
+				if (keys[middle].time <= p_time) {
+					low = middle + 1;
+				} else {
+					high = middle;
+				}
+			}
+			upper = low;
+		}
+	}
+	r_cursor = upper;
+
+	// `_find()` returns a key approximately at `p_time` when there is one, and it always checks the keys around
+	// `upper` for it. When several keys are that close, which one it returns depends on the search, so let it decide.
+	int match = -1;
+	for (int i = MAX(upper - 2, 0); i < MIN(upper + 2, len); i++) {
+		if (Math::is_equal_approx(p_time, (double)keys[i].time)) {
+			if (match != -1 || (i != upper - 1 && i != upper)) {
+				return _find(p_keys, p_time, p_backward);
+			}
+			match = i;
+		}
+	}
+	if (match != -1) {
+		return match;
+	}
+
+	return p_backward ? upper : upper - 1;
+}
+
 // Linear interpolation for anytype.
 
 Vector3 Animation::_interpolate(const Vector3 &p_a, const Vector3 &p_b, real_t p_c) const {
@@ -2516,8 +2578,12 @@ Variant Animation::_cubic_interpolate_angle_in_time(const Variant &p_pre_a, cons
 }
 
 template <typename T>
-T Animation::_interpolate(const LocalVector<TKey<T>> &p_keys, double p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, bool p_backward) const {
-	int len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+T Animation::_interpolate(const LocalVector<TKey<T>> &p_keys, double p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, bool p_backward, int32_t *r_cursor) const {
+	int len = p_keys.size();
+	// Usually the last key is in the animation, then the search for it can be skipped.
+	if (len == 0 || !(p_keys[len - 1].time <= length || Math::is_equal_approx(length, (double)p_keys[len - 1].time)) || (len > 1 && Math::is_equal_approx(length, (double)p_keys[len - 2].time))) {
+		len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+	}
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
@@ -2534,7 +2600,7 @@ T Animation::_interpolate(const LocalVector<TKey<T>> &p_keys, double p_time, Int
 		return p_keys[0].value;
 	}
 
-	int idx = _find(p_keys, p_time, p_backward);
+	int idx = r_cursor ? _find_from_cursor(p_keys, p_time, p_backward, *r_cursor) : _find(p_keys, p_time, p_backward);
 
 	ERR_FAIL_COND_V(idx == -2, T());
 	int maxi = len - 1;
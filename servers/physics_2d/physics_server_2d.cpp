@@ -323,6 +323,12 @@ void PhysicsServer2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(PS2DE::INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(PS2DE::INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PS2DE::INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(PS2DE::INFO_INTEGRATE_FORCES_TIME);
+	BIND_ENUM_CONSTANT(PS2DE::INFO_BROADPHASE_TIME);
+	BIND_ENUM_CONSTANT(PS2DE::INFO_GENERATE_ISLANDS_TIME);
+	BIND_ENUM_CONSTANT(PS2DE::INFO_SETUP_CONSTRAINTS_TIME);
+	BIND_ENUM_CONSTANT(PS2DE::INFO_SOLVE_CONSTRAINTS_TIME);
+	BIND_ENUM_CONSTANT(PS2DE::INFO_INTEGRATE_VELOCITIES_TIME);
 }
 
 PhysicsServer2D::PhysicsServer2D() {
@@ -169,7 +169,13 @@ enum AreaBodyStatus {
 enum ProcessInfo {
 	INFO_ACTIVE_OBJECTS,
 	INFO_COLLISION_PAIRS,
-	INFO_ISLAND_COUNT
+	INFO_ISLAND_COUNT,
+	INFO_INTEGRATE_FORCES_TIME,
+	INFO_BROADPHASE_TIME,
+	INFO_GENERATE_ISLANDS_TIME,
+	INFO_SETUP_CONSTRAINTS_TIME,
+	INFO_SOLVE_CONSTRAINTS_TIME,
+	INFO_INTEGRATE_VELOCITIES_TIME
 };
 
 #ifndef DISABLE_DEPRECATED
@@ -506,6 +506,12 @@ void PhysicsServer3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(PS3DE::INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(PS3DE::INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PS3DE::INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(PS3DE::INFO_INTEGRATE_FORCES_TIME);
+	BIND_ENUM_CONSTANT(PS3DE::INFO_BROADPHASE_TIME);
+	BIND_ENUM_CONSTANT(PS3DE::INFO_GENERATE_ISLANDS_TIME);
+	BIND_ENUM_CONSTANT(PS3DE::INFO_SETUP_CONSTRAINTS_TIME);
+	BIND_ENUM_CONSTANT(PS3DE::INFO_SOLVE_CONSTRAINTS_TIME);
+	BIND_ENUM_CONSTANT(PS3DE::INFO_INTEGRATE_VELOCITIES_TIME);
 
 	BIND_ENUM_CONSTANT(PS3DE::SPACE_PARAM_CONTACT_RECYCLE_RADIUS);
 	BIND_ENUM_CONSTANT(PS3DE::SPACE_PARAM_CONTACT_MAX_SEPARATION);
@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*  instance_bounds_array.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "instance_bounds_array.h"
+
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__AVX__)
+#include <immintrin.h>
+#define INSTANCE_BOUNDS_AVX
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define INSTANCE_BOUNDS_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define INSTANCE_BOUNDS_NEON
+#endif
+#endif // REAL_T_IS_DOUBLE
+
+#ifdef INSTANCE_BOUNDS_NEON
+static _FORCE_INLINE_ uint32_t _neon_movemask(uint32x4_t p_mask) {
+	static const uint32_t lane_bits[4] = { 1, 2, 4, 8 };
+	const uint32x4_t bits = vandq_u32(p_mask, vld1q_u32(lane_bits));
+	const uint32x2_t sum = vadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+	return vget_lane_u32(vpadd_u32(sum, sum), 0);
+}
+#endif
+
+void InstanceBoundsArray::_resize_arrays(uint32_t p_size) {
+	const uint32_t padded_size = (p_size + 7) & ~7u;
+	if (padded_size == min_x.size()) {
+		return;
+	}
+	// Padding is zeroed so vectors never load uninitialized values.
+	min_x.resize_initialized(padded_size);
+	min_y.resize_initialized(padded_size);
+	min_z.resize_initialized(padded_size);
+	max_x.resize_initialized(padded_size);
+	max_y.resize_initialized(padded_size);
+	max_z.resize_initialized(padded_size);
+}
+
+void InstanceBoundsArray::push_back(const AABB &p_aabb) {
+	_resize_arrays(count + 1);
+	count++;
+	set(count - 1, p_aabb);
+}
+
+void InstanceBoundsArray::set(uint32_t p_index, const AABB &p_aabb) {
+	DEV_ASSERT(p_index < count);
+	min_x[p_index] = p_aabb.position.x;
+	min_y[p_index] = p_aabb.position.y;
+	min_z[p_index] = p_aabb.position.z;
+	max_x[p_index] = p_aabb.position.x + p_aabb.size.x;
+	max_y[p_index] = p_aabb.position.y + p_aabb.size.y;
+	max_z[p_index] = p_aabb.position.z + p_aabb.size.z;
+}
+
+void InstanceBoundsArray::remove_at_unordered(uint32_t p_index) {
+	ERR_FAIL_UNSIGNED_INDEX(p_index, count);
+	const uint32_t last = count - 1;
+	min_x[p_index] = min_x[last];
+	min_y[p_index] = min_y[last];
+	min_z[p_index] = min_z[last];
+	max_x[p_index] = max_x[last];
+	max_y[p_index] = max_y[last];
+	max_z[p_index] = max_z[last];
+	min_x[last] = 0;
+	min_y[last] = 0;
+	min_z[last] = 0;
+	max_x[last] = 0;
+	max_y[last] = 0;
+	max_z[last] = 0;
+	count--;
+	_resize_arrays(count);
+}
+
+void InstanceBoundsArray::clear() {
+	count = 0;
+	_resize_arrays(0);
+}
+
+uint64_t InstanceBoundsArray::cull_planes(uint32_t p_from, const Plane *p_planes, uint32_t p_plane_count, bool p_cull_touching) const {
+	DEV_ASSERT(p_from % 8 == 0);
+	if (p_from >= count) {
+		return 0;
+	}
+
+	const uint32_t block_count = MIN(BLOCK_SIZE, count - p_from);
+	uint64_t inside = block_count == BLOCK_SIZE ? UINT64_MAX : (uint64_t(1) << block_count) - 1;
+
+	for (uint32_t i = 0; i < p_plane_count && inside != 0; i++) {
+		const Plane &plane = p_planes[i];
+		// The corner of the box that is the farthest behind the plane.
+		const real_t *x = (plane.normal.x > 0 ? min_x.ptr() : max_x.ptr()) + p_from;
+		const real_t *y = (plane.normal.y > 0 ? min_y.ptr() : max_y.ptr()) + p_from;
+		const real_t *z = (plane.normal.z > 0 ? min_z.ptr() : max_z.ptr()) + p_from;
+		uint64_t culled = 0;
+
+#if defined(INSTANCE_BOUNDS_AVX)
+		const __m256 normal_x = _mm256_set1_ps(plane.normal.x);
+		const __m256 normal_y = _mm256_set1_ps(plane.normal.y);
+		const __m256 normal_z = _mm256_set1_ps(plane.normal.z);
+		const __m256 d = _mm256_set1_ps(plane.d);
+		const __m256 zero = _mm256_setzero_ps();
+		for (uint32_t j = 0; j < block_count; j += 8) {
+			const __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(normal_x, _mm256_loadu_ps(x + j)), _mm256_mul_ps(normal_y, _mm256_loadu_ps(y + j))), _mm256_mul_ps(normal_z, _mm256_loadu_ps(z + j)));
+			const __m256 distance = _mm256_sub_ps(dot, d);
+			const __m256 in_front = p_cull_touching ? _mm256_cmp_ps(distance, zero, _CMP_GE_OQ) : _mm256_cmp_ps(distance, zero, _CMP_GT_OQ);
+			culled |= uint64_t(_mm256_movemask_ps(in_front)) << j;
+		}
+#elif defined(INSTANCE_BOUNDS_SSE2)
+		const __m128 normal_x = _mm_set1_ps(plane.normal.x);
+		const __m128 normal_y = _mm_set1_ps(plane.normal.y);
+		const __m128 normal_z = _mm_set1_ps(plane.normal.z);
+		const __m128 d = _mm_set1_ps(plane.d);
+		const __m128 zero = _mm_setzero_ps();
+		for (uint32_t j = 0; j < block_count; j += 4) {
+			const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(normal_x, _mm_loadu_ps(x + j)), _mm_mul_ps(normal_y, _mm_loadu_ps(y + j))), _mm_mul_ps(normal_z, _mm_loadu_ps(z + j)));
+			const __m128 distance = _mm_sub_ps(dot, d);
+			const __m128 in_front = p_cull_touching ? _mm_cmpge_ps(distance, zero) : _mm_cmpgt_ps(distance, zero);
+			culled |= uint64_t(_mm_movemask_ps(in_front)) << j;
+		}
+#elif defined(INSTANCE_BOUNDS_NEON)
+		const float32x4_t normal_x = vdupq_n_f32(plane.normal.x);
+		const float32x4_t normal_y = vdupq_n_f32(plane.normal.y);
+		const float32x4_t normal_z = vdupq_n_f32(plane.normal.z);
+		const float32x4_t d = vdupq_n_f32(plane.d);
+		const float32x4_t zero = vdupq_n_f32(0.0f);
+		for (uint32_t j = 0; j < block_count; j += 4) {
+			const float32x4_t dot = vaddq_f32(vaddq_f32(vmulq_f32(normal_x, vld1q_f32(x + j)), vmulq_f32(normal_y, vld1q_f32(y + j))), vmulq_f32(normal_z, vld1q_f32(z + j)));
+			const float32x4_t distance = vsubq_f32(dot, d);
+			const uint32x4_t in_front = p_cull_touching ? vcgeq_f32(distance, zero) : vcgtq_f32(distance, zero);
+			culled |= uint64_t(_neon_movemask(in_front)) << j;
+		}
+#else
+		for (uint32_t j = 0; j < block_count; j++) {
+			const real_t distance = plane.distance_to(Vector3(x[j], y[j], z[j]));
+			if (p_cull_touching ? distance >= 0 : distance > 0) {
+				culled |= uint64_t(1) << j;
+			}
+		}
+#endif
+
+		inside &= ~culled;
+	}
+
+	return inside;
+}
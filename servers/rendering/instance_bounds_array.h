@@ -0,0 +1,72 @@
+/**************************************************************************/
+/*  instance_bounds_array.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/aabb.h"
+#include "core/math/plane.h"
+#include "core/templates/local_vector.h"
+
+// Instance bounds stored as a structure of arrays, to test blocks of instances against a set of planes at once.
+//
+// The tests process 8 instances at a time with AVX, 4 at a time with SSE2 or NEON, and one at a time otherwise
+// (including when `real_t` is a double). A box is culled by a plane when it is fully in front of it, which is
+// the test done by `RendererSceneCull::InstanceBounds::in_frustum()` for the camera frustum planes.
+class InstanceBoundsArray {
+public:
+	// Number of instances tested by `cull_planes()`, as the bits of its result.
+	static constexpr uint32_t BLOCK_SIZE = 64;
+
+private:
+	// Sized to a multiple of 8 instances, so full vectors can be loaded at the end of the arrays.
+	LocalVector<real_t> min_x;
+	LocalVector<real_t> min_y;
+	LocalVector<real_t> min_z;
+	LocalVector<real_t> max_x;
+	LocalVector<real_t> max_y;
+	LocalVector<real_t> max_z;
+	uint32_t count = 0;
+
+	void _resize_arrays(uint32_t p_size);
+
+public:
+	_FORCE_INLINE_ uint32_t size() const { return count; }
+
+	void push_back(const AABB &p_aabb);
+	void set(uint32_t p_index, const AABB &p_aabb);
+	// Replaces the bounds at `p_index` by the last ones, like `PagedArray::remove_at_unordered()`.
+	void remove_at_unordered(uint32_t p_index);
+	void clear();
+
+	// Returns a mask with bit `i` set when the bounds at `p_from + i` are not fully in front of any of the planes.
+	// `p_from` must be a multiple of 8. When `p_cull_touching` is true, bounds that touch a plane from the front are
+	// culled as well.
+	uint64_t cull_planes(uint32_t p_from, const Plane *p_planes, uint32_t p_plane_count, bool p_cull_touching = true) const;
+};
@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*  instance_cull_caches.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "instance_cull_caches.h"
+
+void InstanceCullCaches::mark_dirty(uint32_t p_index, uint32_t p_instance_count) {
+	if (caches.is_empty()) {
+		return;
+	}
+
+	dirty_log.push_back(p_index);
+	if (dirty_log.size() > MAX(4096u, p_instance_count / 4)) {
+		// Testing everything again is cheaper past this point, caches that did not catch up are rebuilt.
+		dirty_log_start += dirty_log.size();
+		dirty_log.clear();
+	}
+}
+
+InstanceCullCaches::Cache *InstanceCullCaches::get_cache(const LocalVector<Plane> &p_planes, const LocalVector<AABB> &p_regions, uint64_t p_render_pass) {
+	for (Cache &E : caches) {
+		if (E.planes.size() != p_planes.size() || E.regions.size() != p_regions.size()) {
+			continue;
+		}
+		bool same_volumes = true;
+		for (uint32_t i = 0; i < p_planes.size() && same_volumes; i++) {
+			same_volumes = E.planes[i] == p_planes[i];
+		}
+		for (uint32_t i = 0; i < p_regions.size() && same_volumes; i++) {
+			same_volumes = E.regions[i] == p_regions[i];
+		}
+		if (same_volumes) {
+			E.last_render_pass = p_render_pass;
+			return &E;
+		}
+	}
+
+	// Only remember the volumes, finding the candidates is worth it if they are used again.
+	Cache *cache = nullptr;
+	if (caches.size() < MAX_CACHES) {
+		caches.push_back(Cache());
+		cache = &caches[caches.size() - 1];
+	} else {
+		cache = &caches[0];
+		for (Cache &E : caches) {
+			if (E.last_render_pass < cache->last_render_pass) {
+				cache = &E;
+			}
+		}
+	}
+	cache->planes = p_planes;
+	cache->regions = p_regions;
+	cache->candidates.clear();
+	cache->candidate_count = 0;
+	cache->valid = false;
+	cache->last_render_pass = p_render_pass;
+	return nullptr;
+}
+
+bool InstanceCullCaches::get_dirty_words(const Cache *p_cache, uint32_t p_word_count, LocalVector<uint32_t> &r_words) const {
+	r_words.clear();
+	if (!p_cache->valid || p_cache->log_position < dirty_log_start) {
+		return true;
+	}
+
+	for (uint64_t i = p_cache->log_position - dirty_log_start; i < dirty_log.size(); i++) {
+		const uint32_t word = dirty_log[i] / 64;
+		if (word < p_word_count) {
+			r_words.push_back(word);
+		}
+	}
+	r_words.sort();
+
+	uint32_t unique_count = 0;
+	for (uint32_t i = 0; i < r_words.size(); i++) {
+		if (i == 0 || r_words[i] != r_words[unique_count - 1]) {
+			r_words[unique_count++] = r_words[i];
+		}
+	}
+	r_words.resize(unique_count);
+	return false;
+}
+
+void InstanceCullCaches::set_updated(Cache *p_cache) {
+	const uint64_t log_end = dirty_log_start + dirty_log.size();
+	p_cache->log_position = log_end;
+	p_cache->valid = true;
+
+	for (const Cache &E : caches) {
+		if (E.valid && E.log_position != log_end) {
+			return;
+		}
+	}
+	dirty_log_start = log_end;
+	dirty_log.clear();
+}
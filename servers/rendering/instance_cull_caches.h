@@ -0,0 +1,80 @@
+/**************************************************************************/
+/*  instance_cull_caches.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/aabb.h"
+#include "core/math/plane.h"
+#include "core/templates/local_vector.h"
+
+// Instances that can be visible from the culling volumes (camera frustum, directional shadow cascades and SDFGI
+// regions) of previous renders, so they are not all tested again while neither the volumes nor the instances move.
+//
+// Only the bookkeeping is done here: the owner finds the candidates of a cache, one bit per instance, and reports
+// the instances whose bounds or culling flags changed with `mark_dirty()`.
+class InstanceCullCaches {
+public:
+	static constexpr uint32_t MAX_CACHES = 8;
+
+	struct Cache {
+		LocalVector<Plane> planes;
+		LocalVector<AABB> regions;
+		// One bit per instance.
+		LocalVector<uint64_t> candidates;
+		uint32_t candidate_count = 0;
+		// Position in the dirty log up to which `candidates` is up to date.
+		uint64_t log_position = 0;
+		uint64_t last_render_pass = 0;
+		// The volumes were used by a single render so far, `candidates` was not computed.
+		bool valid = false;
+	};
+
+private:
+	LocalVector<Cache> caches;
+	// Instances that changed since the caches were updated.
+	LocalVector<uint32_t> dirty_log;
+	// Position of the first entry of `dirty_log`.
+	uint64_t dirty_log_start = 0;
+
+public:
+	_FORCE_INLINE_ uint32_t size() const { return caches.size(); }
+	_FORCE_INLINE_ uint32_t get_dirty_log_size() const { return dirty_log.size(); }
+
+	void mark_dirty(uint32_t p_index, uint32_t p_instance_count);
+
+	// Returns the cache of the volumes, or `nullptr` the first time they are used. They are remembered then, in place
+	// of the least recently used cache once there are `MAX_CACHES`.
+	Cache *get_cache(const LocalVector<Plane> &p_planes, const LocalVector<AABB> &p_regions, uint64_t p_render_pass);
+	// Returns `true` when the candidates of the cache must be found for all the instances. Otherwise, fills `r_words`
+	// with the sorted and unique words of `candidates` that changed since the cache was updated, below `p_word_count`.
+	bool get_dirty_words(const Cache *p_cache, uint32_t p_word_count, LocalVector<uint32_t> &r_words) const;
+	// Marks the candidates of the cache as up to date, the dirty log is cleared once all the caches are.
+	void set_updated(Cache *p_cache);
+};
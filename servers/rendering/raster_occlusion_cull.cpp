@@ -0,0 +1,694 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/math/projection.h"
+#include "core/object/worker_thread_pool.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RASTER_OCCLUSION_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RASTER_OCCLUSION_NEON
+#endif
+
+// Key of the pixels not covered by any occluder.
+static constexpr float EMPTY_DEPTH_KEY = -FLT_MAX;
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	tile_grid_size = Size2i();
+	column_slopes.clear();
+	row_slopes.clear();
+	visible_instances.clear();
+	instance_triangles.clear();
+	triangles.clear();
+	tile_triangles.clear();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	HZBuffer::resize(p_size);
+
+	if (is_empty()) {
+		return;
+	}
+
+	tile_grid_size = Size2i(Math::ceil(p_size.x / (float)TILE_SIZE), Math::ceil(p_size.y / (float)TILE_SIZE));
+	tile_triangles.resize(tile_grid_size.x * tile_grid_size.y);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_span(float *r_keys, int p_count, const float p_edges[3], const float p_edge_steps[3], float p_depth, float p_depth_step) {
+	// Only keeps the key of the triangle where it is closer and the pixel center is inside the triangle,
+	// without branching, four pixels at a time.
+#if defined(RASTER_OCCLUSION_SSE2)
+	const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 edge_0 = _mm_set1_ps(p_edges[0]);
+	const __m128 edge_1 = _mm_set1_ps(p_edges[1]);
+	const __m128 edge_2 = _mm_set1_ps(p_edges[2]);
+	const __m128 edge_step_0 = _mm_set1_ps(p_edge_steps[0]);
+	const __m128 edge_step_1 = _mm_set1_ps(p_edge_steps[1]);
+	const __m128 edge_step_2 = _mm_set1_ps(p_edge_steps[2]);
+	const __m128 depth = _mm_set1_ps(p_depth);
+	const __m128 depth_step = _mm_set1_ps(p_depth_step);
+
+	for (int i = 0; i < p_count; i += 4) {
+		const __m128 x = _mm_add_ps(_mm_set1_ps(float(i)), lanes);
+		const __m128 inside_0 = _mm_cmpge_ps(_mm_add_ps(edge_0, _mm_mul_ps(edge_step_0, x)), zero);
+		const __m128 inside_1 = _mm_cmpge_ps(_mm_add_ps(edge_1, _mm_mul_ps(edge_step_1, x)), zero);
+		const __m128 inside_2 = _mm_cmpge_ps(_mm_add_ps(edge_2, _mm_mul_ps(edge_step_2, x)), zero);
+		const __m128 inside = _mm_and_ps(inside_0, _mm_and_ps(inside_1, inside_2));
+
+		const __m128 previous = _mm_load_ps(r_keys + i);
+		const __m128 closest = _mm_max_ps(previous, _mm_add_ps(depth, _mm_mul_ps(depth_step, x)));
+		_mm_store_ps(r_keys + i, _mm_or_ps(_mm_and_ps(inside, closest), _mm_andnot_ps(inside, previous)));
+	}
+#elif defined(RASTER_OCCLUSION_NEON)
+	static const float lane_offsets[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+	const float32x4_t lanes = vld1q_f32(lane_offsets);
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float32x4_t edge_0 = vdupq_n_f32(p_edges[0]);
+	const float32x4_t edge_1 = vdupq_n_f32(p_edges[1]);
+	const float32x4_t edge_2 = vdupq_n_f32(p_edges[2]);
+	const float32x4_t edge_step_0 = vdupq_n_f32(p_edge_steps[0]);
+	const float32x4_t edge_step_1 = vdupq_n_f32(p_edge_steps[1]);
+	const float32x4_t edge_step_2 = vdupq_n_f32(p_edge_steps[2]);
+	const float32x4_t depth = vdupq_n_f32(p_depth);
+	const float32x4_t depth_step = vdupq_n_f32(p_depth_step);
+
+	for (int i = 0; i < p_count; i += 4) {
+		const float32x4_t x = vaddq_f32(vdupq_n_f32(float(i)), lanes);
+		const uint32x4_t inside_0 = vcgeq_f32(vmlaq_f32(edge_0, edge_step_0, x), zero);
+		const uint32x4_t inside_1 = vcgeq_f32(vmlaq_f32(edge_1, edge_step_1, x), zero);
+		const uint32x4_t inside_2 = vcgeq_f32(vmlaq_f32(edge_2, edge_step_2, x), zero);
+		const uint32x4_t inside = vandq_u32(inside_0, vandq_u32(inside_1, inside_2));
+
+		const float32x4_t previous = vld1q_f32(r_keys + i);
+		const float32x4_t closest = vmaxq_f32(previous, vmlaq_f32(depth, depth_step, x));
+		vst1q_f32(r_keys + i, vbslq_f32(inside, closest, previous));
+	}
+#else
+	for (int i = 0; i < p_count; i++) {
+		const float x = float(i);
+		const bool inside = (p_edges[0] + p_edge_steps[0] * x >= 0.0f) & (p_edges[1] + p_edge_steps[1] * x >= 0.0f) & (p_edges[2] + p_edge_steps[2] * x >= 0.0f);
+		const float closest = MAX(r_keys[i], p_depth + p_depth_step * x);
+		r_keys[i] = inside ? closest : r_keys[i];
+	}
+#endif
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_add_triangle(const Vector3 p_view[3], LocalVector<Triangle> &r_triangles) const {
+	// Clip the triangle against the near plane, and against a guard band around the buffer, which keeps
+	// the pixel coordinates small enough for the edge functions to be precise.
+	const Size2 buffer_size = sizes[0];
+	const Size2 guard_band = buffer_size;
+
+	Vector3 polygons[2][8];
+	int counts[2] = { 3, 0 };
+	polygons[0][0] = p_view[0];
+	polygons[0][1] = p_view[1];
+	polygons[0][2] = p_view[2];
+
+	int current = 0;
+	for (int plane = 0; plane < 5; plane++) {
+		const Vector3 *input = polygons[current];
+		const int input_count = counts[current];
+		Vector3 *output = polygons[1 - current];
+		int output_count = 0;
+
+		float distances[8];
+		bool all_inside = true;
+		for (int i = 0; i < input_count; i++) {
+			const Vector3 &v = input[i];
+			const float w = cam_orthogonal ? 1.0f : -v.z;
+			switch (plane) {
+				case 0: {
+					distances[i] = -v.z - z_near;
+				} break;
+				case 1: {
+					distances[i] = v.x * pixel_scale.x + (pixel_offset.x + guard_band.x) * w;
+				} break;
+				case 2: {
+					distances[i] = (buffer_size.x + guard_band.x - pixel_offset.x) * w - v.x * pixel_scale.x;
+				} break;
+				case 3: {
+					distances[i] = v.y * pixel_scale.y + (pixel_offset.y + guard_band.y) * w;
+				} break;
+				default: {
+					distances[i] = (buffer_size.y + guard_band.y - pixel_offset.y) * w - v.y * pixel_scale.y;
+				} break;
+			}
+			all_inside = all_inside && distances[i] >= 0.0f;
+		}
+
+		if (all_inside) {
+			continue;
+		}
+
+		for (int i = 0; i < input_count; i++) {
+			const int next = (i + 1) % input_count;
+			if (distances[i] >= 0.0f) {
+				output[output_count++] = input[i];
+			}
+			if ((distances[i] >= 0.0f) != (distances[next] >= 0.0f)) {
+				const float t = distances[i] / (distances[i] - distances[next]);
+				output[output_count++] = input[i].lerp(input[next], t);
+			}
+		}
+
+		if (output_count < 3) {
+			return;
+		}
+		counts[1 - current] = output_count;
+		current = 1 - current;
+	}
+
+	// Project the polygon on the buffer.
+	Vector2 points[8];
+	float keys[8];
+	for (int i = 0; i < counts[current]; i++) {
+		const Vector3 &v = polygons[current][i];
+		if (cam_orthogonal) {
+			points[i] = Vector2(v.x, v.y) * pixel_scale + pixel_offset;
+			keys[i] = v.z;
+		} else {
+			const float inv_w = 1.0f / -v.z;
+			points[i] = Vector2(v.x, v.y) * pixel_scale * inv_w + pixel_offset;
+			keys[i] = inv_w;
+		}
+	}
+
+	for (int i = 1; i + 1 < counts[current]; i++) {
+		const Vector2 v[3] = { points[0], points[i], points[i + 1] };
+		const float k[3] = { keys[0], keys[i], keys[i + 1] };
+
+		float area = (v[1] - v[0]).cross(v[2] - v[0]);
+		if (area == 0.0f) {
+			continue;
+		}
+		const float orientation = area > 0.0f ? 1.0f : -1.0f;
+		area *= orientation;
+
+		Triangle triangle;
+		triangle.depth_a = 0.0f;
+		triangle.depth_b = 0.0f;
+		triangle.depth_c = 0.0f;
+		for (int j = 0; j < 3; j++) {
+			// Edge opposite to vertex j, whose function is the area of the triangle at vertex j.
+			const Vector2 &from = v[(j + 1) % 3];
+			const Vector2 &to = v[(j + 2) % 3];
+			const float a = (from.y - to.y) * orientation;
+			const float b = (to.x - from.x) * orientation;
+			triangle.edge_a[j] = a;
+			triangle.edge_b[j] = b;
+			triangle.edge_c[j] = -(a * from.x + b * from.y);
+
+			triangle.depth_a += a * k[j];
+			triangle.depth_b += b * k[j];
+			triangle.depth_c += triangle.edge_c[j] * k[j];
+		}
+		triangle.depth_a /= area;
+		triangle.depth_b /= area;
+		triangle.depth_c /= area;
+
+		const Vector2 min = v[0].min(v[1]).min(v[2]);
+		const Vector2 max = v[0].max(v[1]).max(v[2]);
+		triangle.min_x = MAX(0, (int)Math::ceil(min.x - 0.5f));
+		triangle.min_y = MAX(0, (int)Math::ceil(min.y - 0.5f));
+		triangle.max_x = MIN(sizes[0].x - 1, (int)Math::floor(max.x - 0.5f));
+		triangle.max_y = MIN(sizes[0].y - 1, (int)Math::floor(max.y - 0.5f));
+
+		if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y) {
+			continue; // Between pixel centers.
+		}
+
+		r_triangles.push_back(triangle);
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_setup_instance_triangles(uint32_t p_index, void *p_userdata) {
+	const OccluderInstance *instance = visible_instances[p_index];
+	LocalVector<Triangle> &instance_tris = instance_triangles[p_index];
+	instance_tris.clear();
+
+	const Vector3 *vertices = instance->vertices.ptr();
+	const uint32_t *indices = instance->indices.ptr();
+	const uint32_t index_count = instance->indices.size();
+
+	for (uint32_t i = 0; i < index_count; i += 3) {
+		const Vector3 view[3] = {
+			cam_inv_transform.xform(vertices[indices[i]]),
+			cam_inv_transform.xform(vertices[indices[i + 1]]),
+			cam_inv_transform.xform(vertices[indices[i + 2]]),
+		};
+		_add_triangle(view, instance_tris);
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_bin_triangles() {
+	for (LocalVector<uint32_t> &tile : tile_triangles) {
+		tile.clear();
+	}
+
+	for (uint32_t i = 0; i < triangles.size(); i++) {
+		const Triangle &triangle = triangles[i];
+		const int from_x = triangle.min_x / TILE_SIZE;
+		const int to_x = triangle.max_x / TILE_SIZE;
+		const int from_y = triangle.min_y / TILE_SIZE;
+		const int to_y = triangle.max_y / TILE_SIZE;
+
+		for (int y = from_y; y <= to_y; y++) {
+			for (int x = from_x; x <= to_x; x++) {
+				tile_triangles[y * tile_grid_size.x + x].push_back(i);
+			}
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_tile(uint32_t p_tile, void *p_userdata) {
+	const Size2i &buffer_size = sizes[0];
+	const int tile_x = (p_tile % tile_grid_size.x) * TILE_SIZE;
+	const int tile_y = (p_tile / tile_grid_size.x) * TILE_SIZE;
+	const int tile_width = MIN(TILE_SIZE, buffer_size.x - tile_x);
+	const int tile_height = MIN(TILE_SIZE, buffer_size.y - tile_y);
+
+	alignas(16) float keys[TILE_SIZE * TILE_SIZE];
+	for (int i = 0; i < TILE_SIZE * TILE_SIZE; i++) {
+		keys[i] = EMPTY_DEPTH_KEY;
+	}
+
+	for (const uint32_t index : tile_triangles[p_tile]) {
+		const Triangle &triangle = triangles[index];
+
+		// Spans start on a multiple of four pixels, the extra pixels are rejected by the edge functions
+		// or are outside of the buffer and never read.
+		const int from_x = MAX(triangle.min_x - tile_x, 0) & ~3;
+		const int to_x = MIN(triangle.max_x - tile_x, tile_width - 1);
+		const int from_y = MAX(triangle.min_y - tile_y, 0);
+		const int to_y = MIN(triangle.max_y - tile_y, tile_height - 1);
+		const int count = (to_x - from_x + 4) & ~3;
+
+		const float x = tile_x + from_x + 0.5f;
+		for (int y = from_y; y <= to_y; y++) {
+			const float pixel_y = tile_y + y + 0.5f;
+			const float edges[3] = {
+				triangle.edge_a[0] * x + triangle.edge_b[0] * pixel_y + triangle.edge_c[0],
+				triangle.edge_a[1] * x + triangle.edge_b[1] * pixel_y + triangle.edge_c[1],
+				triangle.edge_a[2] * x + triangle.edge_b[2] * pixel_y + triangle.edge_c[2],
+			};
+			const float depth = triangle.depth_a * x + triangle.depth_b * pixel_y + triangle.depth_c;
+			_rasterize_span(keys + y * TILE_SIZE + from_x, count, edges, triangle.edge_a, depth, triangle.depth_a);
+		}
+	}
+
+	// Turn the keys into distances from the camera, like the ray-cast backend.
+	float *depths = mips[0];
+	for (int y = 0; y < tile_height; y++) {
+		float *row = depths + (tile_y + y) * buffer_size.x + tile_x;
+		const float *row_keys = keys + y * TILE_SIZE;
+		for (int x = 0; x < tile_width; x++) {
+			const float key = row_keys[x];
+			float distance = far_distance;
+			if (key != EMPTY_DEPTH_KEY) {
+				if (cam_orthogonal) {
+					distance = -key;
+				} else {
+					distance = Math::sqrt(1.0f + column_slopes[tile_x + x] + row_slopes[tile_y + y]) / key;
+				}
+			}
+			row[x] = MIN(distance, far_distance);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(const Scenario &p_scenario, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	ERR_FAIL_COND(is_empty());
+
+	const Size2i &buffer_size = sizes[0];
+
+	Rect2 vp_rect = _get_viewport_rect(p_cam_projection);
+	Vector2 bottom_left = vp_rect.position;
+	bottom_left += _get_jitter(vp_rect, buffer_size);
+
+	cam_inv_transform = p_cam_transform.affine_inverse();
+	cam_orthogonal = p_cam_orthogonal;
+	z_near = p_cam_projection.get_z_near();
+	far_distance = p_cam_projection.get_z_far() * 1.05f;
+	debug_tex_range = far_distance;
+
+	// Pixel centers are sampled, like the camera rays of the ray-cast backend.
+	const Vector2 pixels_per_unit = Vector2(buffer_size) / vp_rect.size;
+	pixel_scale = cam_orthogonal ? pixels_per_unit : pixels_per_unit * z_near;
+	pixel_offset = -bottom_left * pixels_per_unit;
+
+	if (!cam_orthogonal) {
+		column_slopes.resize(buffer_size.x);
+		for (int x = 0; x < buffer_size.x; x++) {
+			const float slope = (bottom_left.x + (x + 0.5f) / pixels_per_unit.x) / z_near;
+			column_slopes[x] = slope * slope;
+		}
+		row_slopes.resize(buffer_size.y);
+		for (int y = 0; y < buffer_size.y; y++) {
+			const float slope = (bottom_left.y + (y + 0.5f) / pixels_per_unit.y) / z_near;
+			row_slopes[y] = slope * slope;
+		}
+	}
+
+	Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	const Plane *planes_ptr = planes.ptr();
+	const int plane_count = planes.size();
+
+	visible_instances.clear();
+	uint32_t triangle_count = 0;
+	for (const KeyValue<RID, OccluderInstance> &E : p_scenario.instances) {
+		const OccluderInstance &instance = E.value;
+		if (!instance.enabled || instance.indices.is_empty()) {
+			continue;
+		}
+
+		bool outside = false;
+		for (int i = 0; i < plane_count && !outside; i++) {
+			// Corner of the AABB that is the furthest inside the plane.
+			const Vector3 &normal = planes_ptr[i].normal;
+			const Vector3 corner = instance.aabb.position + Vector3(normal.x > 0 ? 0 : instance.aabb.size.x, normal.y > 0 ? 0 : instance.aabb.size.y, normal.z > 0 ? 0 : instance.aabb.size.z);
+			outside = planes_ptr[i].is_point_over(corner);
+		}
+
+		if (!outside) {
+			visible_instances.push_back(&instance);
+			triangle_count += instance.indices.size() / 3;
+		}
+	}
+
+	instance_triangles.resize(visible_instances.size());
+	if (visible_instances.size() > 1 && triangle_count >= THREADED_SETUP_MIN_TRIANGLES) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_setup_instance_triangles, (void *)nullptr, visible_instances.size(), -1, true, SNAME("RasterOcclusionCullSetup"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < visible_instances.size(); i++) {
+			_setup_instance_triangles(i, nullptr);
+		}
+	}
+
+	triangles.clear();
+	for (const LocalVector<Triangle> &instance_tris : instance_triangles) {
+		const uint32_t from = triangles.size();
+		triangles.resize(from + instance_tris.size());
+		memcpy(triangles.ptr() + from, instance_tris.ptr(), instance_tris.size() * sizeof(Triangle));
+	}
+	visible_instances.clear();
+
+	if (triangles.is_empty()) {
+		float *depths = mips[0];
+		for (int i = 0; i < buffer_size.x * buffer_size.y; i++) {
+			depths[i] = far_distance;
+		}
+		return;
+	}
+
+	_bin_triangles();
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_tile, (void *)nullptr, tile_triangles.size(), -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		Scenario *scenario = scenarios.getptr(E.scenario);
+		ERR_CONTINUE(!scenario);
+		ERR_CONTINUE(!scenario->instances.has(E.instance));
+
+		if (!scenario->dirty_instances.has(E.instance)) {
+			scenario->dirty_instances.insert(E.instance);
+			scenario->dirty_instances_array.push_back(E.instance);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	// The instances using it stop occluding on their next update.
+	for (const InstanceID &E : occluder->users) {
+		Scenario *scenario = scenarios.getptr(E.scenario);
+		if (scenario && !scenario->dirty_instances.has(E.instance)) {
+			scenario->dirty_instances.insert(E.instance);
+			scenario->dirty_instances_array.push_back(E.instance);
+		}
+	}
+
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+	scenarios[p_scenario].owner = this;
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		Occluder *occluder = occluder_owner.get_or_null(E.value.occluder);
+		if (occluder) {
+			occluder->users.erase(InstanceID(p_scenario, E.key));
+		}
+	}
+
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	if (!scenario->instances.has(p_instance)) {
+		scenario->instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario->instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	// Disabled instances are skipped when rasterizing, they don't need an update.
+	instance.enabled = p_enabled;
+
+	if (changed && !scenario->dirty_instances.has(p_instance)) {
+		scenario->dirty_instances.insert(p_instance);
+		scenario->dirty_instances_array.push_back(p_instance);
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance *instance = scenario->instances.getptr(p_instance);
+	if (instance) {
+		Occluder *occluder = occluder_owner.get_or_null(instance->occluder);
+		if (occluder) {
+			occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		// Pending updates of the instance are skipped once it is gone.
+		scenario->instances.erase(p_instance);
+	}
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance(uint32_t p_idx, RID *p_instances) {
+	OccluderInstance *occ_inst = instances.getptr(p_instances[p_idx]);
+
+	if (!occ_inst) {
+		return;
+	}
+
+	const Occluder *occ = owner->occluder_owner.get_or_null(occ_inst->occluder);
+
+	if (!occ) {
+		occ_inst->vertices.clear();
+		occ_inst->indices.clear();
+		occ_inst->aabb = AABB();
+		return;
+	}
+
+	const uint32_t vertex_count = occ->vertices.size();
+	const Vector3 *read_ptr = occ->vertices.ptr();
+
+	occ_inst->vertices.resize(vertex_count);
+	AABB aabb;
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		const Vector3 p = occ_inst->xform.xform(read_ptr[i]);
+		occ_inst->vertices[i] = p;
+		if (i == 0) {
+			aabb.position = p;
+		} else {
+			aabb.expand_to(p);
+		}
+	}
+	occ_inst->aabb = aabb;
+
+	const uint32_t index_count = occ->indices.size() - occ->indices.size() % 3;
+	const int32_t *indices = occ->indices.ptr();
+
+	occ_inst->indices.resize(index_count);
+	for (uint32_t i = 0; i < index_count; i++) {
+		if (unlikely((uint32_t)indices[i] >= vertex_count)) {
+			occ_inst->indices.clear();
+			ERR_FAIL_MSG(vformat("Occluder index %d is out of range, the occluder has %d vertices.", indices[i], vertex_count));
+		}
+		occ_inst->indices[i] = indices[i];
+	}
+}
+
+void RasterOcclusionCull::Scenario::update() {
+	if (dirty_instances_array.is_empty()) {
+		return;
+	}
+
+	if (dirty_instances_array.size() / WorkerThreadPool::get_singleton()->get_thread_count() > 128) {
+		// Lots of instances, use per-instance threading
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_update_dirty_instance, dirty_instances_array.ptr(), dirty_instances_array.size(), -1, true, SNAME("RasterOcclusionCullUpdate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < dirty_instances_array.size(); i++) {
+			_update_dirty_instance(i, dirty_instances_array.ptr());
+		}
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	RasterHZBuffer *buffer = buffers.getptr(p_buffer);
+	if (!buffer || buffer->is_empty()) {
+		return;
+	}
+
+	Scenario *scenario = scenarios.getptr(buffer->scenario_rid);
+	if (!scenario) {
+		return;
+	}
+
+	scenario->update();
+	buffer->rasterize(*scenario, p_cam_transform, p_cam_projection, p_cam_orthogonal);
+	buffer->update_mips();
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	return buffers.getptr(p_buffer);
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RasterOcclusionCull::RasterOcclusionCull() {
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+}
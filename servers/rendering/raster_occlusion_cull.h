@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/aabb.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Occlusion culling backend that rasterizes the occluder meshes on the CPU.
+//
+// It fills the same buffer as the ray-cast backend of the raycast module (the distance from the camera to the
+// closest occluder at the center of each pixel), but does not need Embree, and does not have to rebuild a BVH
+// when occluders move. Every frame, the occluder triangles are clipped and projected on the buffer, binned into
+// tiles, and the tiles are rasterized in parallel on the WorkerThreadPool, four pixels at a time.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+	struct InstanceID {
+		RID scenario;
+		RID instance;
+
+		static uint32_t hash(const InstanceID &p_ins) {
+			uint32_t h = hash_murmur3_one_64(p_ins.scenario.get_id());
+			return hash_fmix32(hash_murmur3_one_64(p_ins.instance.get_id(), h));
+		}
+		bool operator==(const InstanceID &rhs) const {
+			return instance == rhs.instance && rhs.scenario == scenario;
+		}
+
+		InstanceID() {}
+		InstanceID(RID s, RID i) :
+				scenario(s), instance(i) {}
+	};
+
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		HashSet<InstanceID, InstanceID> users;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		Transform3D xform;
+		bool enabled = true;
+
+		// Occluder mesh in world space.
+		LocalVector<Vector3> vertices;
+		LocalVector<uint32_t> indices;
+		AABB aabb;
+	};
+
+	struct Scenario {
+		RasterOcclusionCull *owner = nullptr; // To look up the occluders of the instances.
+		HashMap<RID, OccluderInstance> instances;
+		HashSet<RID> dirty_instances; // To avoid duplicates
+		LocalVector<RID> dirty_instances_array; // To iterate and split into threads
+
+		void _update_dirty_instance(uint32_t p_idx, RID *p_instances);
+		void update();
+	};
+
+	// Triangle projected on the buffer, in pixels.
+	struct Triangle {
+		// Edge functions `a * x + b * y + c`, positive inside the triangle.
+		float edge_a[3];
+		float edge_b[3];
+		float edge_c[3];
+		// Depth key, as a linear function of the pixel position. Larger keys are closer to the camera.
+		float depth_a;
+		float depth_b;
+		float depth_c;
+		// Pixels whose center may be inside the triangle.
+		int min_x;
+		int min_y;
+		int max_x;
+		int max_y;
+	};
+
+public:
+	class RasterHZBuffer : public HZBuffer {
+		Size2i tile_grid_size;
+
+		// Camera of the frame being rasterized.
+		Transform3D cam_inv_transform;
+		bool cam_orthogonal = false;
+		float z_near = 0.0f;
+		float far_distance = 0.0f;
+		// Maps view space positions at unit depth (or in the view plane for orthogonal cameras) to pixels.
+		Vector2 pixel_scale;
+		Vector2 pixel_offset;
+		// Squared slope of the camera ray through the center of each column and row, to turn depths into distances.
+		LocalVector<float> column_slopes;
+		LocalVector<float> row_slopes;
+
+		LocalVector<const OccluderInstance *> visible_instances;
+		LocalVector<LocalVector<Triangle>> instance_triangles;
+		LocalVector<Triangle> triangles;
+		// Triangles overlapping each tile, as indices in `triangles`.
+		LocalVector<LocalVector<uint32_t>> tile_triangles;
+
+		static void _rasterize_span(float *r_keys, int p_count, const float p_edges[3], const float p_edge_steps[3], float p_depth, float p_depth_step);
+
+		void _add_triangle(const Vector3 p_view[3], LocalVector<Triangle> &r_triangles) const;
+		void _setup_instance_triangles(uint32_t p_index, void *p_userdata);
+		void _bin_triangles();
+		void _rasterize_tile(uint32_t p_tile, void *p_userdata);
+
+	public:
+		RID scenario_rid;
+
+		virtual void clear() override;
+		virtual void resize(const Size2i &p_size) override;
+		void rasterize(const Scenario &p_scenario, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal);
+	};
+
+private:
+	static constexpr int TILE_SIZE = 16; // Must be a multiple of 4.
+	// Below this number of occluder triangles in view, triangle setup is not split across threads.
+	static constexpr uint32_t THREADED_SETUP_MIN_TRIANGLES = 4096;
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	RasterOcclusionCull();
+	~RasterOcclusionCull();
+};
@@ -34,6 +34,7 @@
 #include "core/config/project_settings.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/transform_interpolator.h"
+#include "core/object/worker_thread_pool.h"
 #include "servers/rendering/renderer_viewport.h"
 #include "servers/rendering/rendering_server_default.h"
 #include "servers/rendering/rendering_server_globals.h"
@@ -71,41 +72,209 @@ void RendererCanvasCull::_dependency_deleted(const RID &p_dependency, Dependency
 void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RSE::CanvasItemTextureFilter p_default_filter, RSE::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingServerTypes::RenderInfo *r_render_info) {
 	RENDER_TIMESTAMP("Cull CanvasItem Tree");
 
+	RendererCanvasRender::Item *list = _cull_canvas_item_tree(p_child_items, p_child_item_count, p_transform, p_clip_rect, p_canvas_cull_mask);
+
+	RENDER_TIMESTAMP("Render CanvasItems");
+
+	bool sdf_flag;
+	RSG::canvas_render->canvas_render_items(p_to_render_target, list, p_modulate, p_lights, p_directional_lights, p_transform, p_default_filter, p_default_repeat, p_snap_2d_vertices_to_pixel, sdf_flag, r_render_info);
+	if (sdf_flag) {
+		sdf_used = true;
+	}
+}
+
+RendererCanvasRender::Item *RendererCanvasCull::_cull_canvas_item_tree(Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, uint32_t p_canvas_cull_mask) {
 	// This is used to avoid passing the camera transform down the rendering
 	// function calls, as it won't be used in 99% of cases, because the camera
 	// transform is normally concatenated with the item global transform.
 	_current_camera_transform = p_transform;
 
-	memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
-	memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+	CullTreeData cull_tree_data;
+	cull_tree_data.child_items = p_child_items;
+	cull_tree_data.transform = p_transform;
+	cull_tree_data.clip_rect = p_clip_rect;
+	cull_tree_data.canvas_cull_mask = p_canvas_cull_mask;
+
+	if (!_cull_canvas_item_tree_threaded(cull_tree_data, p_child_item_count)) {
+		_cull_canvas_item_range(cull_state, cull_tree_data, 0, p_child_item_count);
+	}
+
+	for (Item::VisibilityNotifierData *visibility_notifier : cull_state.visible_notifiers) {
+		if (!visibility_notifier->visible_element.in_list()) {
+			visibility_notifier_list.add(&visibility_notifier->visible_element);
+			visibility_notifier->just_visible = true;
+		}
+	}
+	cull_state.visible_notifiers.clear();
 
-	for (int i = 0; i < p_child_item_count; i++) {
-		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, false, p_canvas_cull_mask, Point2(), 1, nullptr);
+	if (cull_state.redraw_requested) {
+		RenderingServerDefault::redraw_request();
+		cull_state.redraw_requested = false;
 	}
 
 	RendererCanvasRender::Item *list = nullptr;
 	RendererCanvasRender::Item *list_end = nullptr;
 
-	for (int i = 0; i < z_range; i++) {
-		if (!z_list[i]) {
-			continue;
-		}
+	cull_state.z_used.sort();
+	for (int zidx : cull_state.z_used) {
 		if (!list) {
-			list = z_list[i];
-			list_end = z_last_list[i];
+			list = cull_state.z_list[zidx];
+			list_end = cull_state.z_last_list[zidx];
 		} else {
-			list_end->next = z_list[i];
-			list_end = z_last_list[i];
+			list_end->next = cull_state.z_list[zidx];
+			list_end = cull_state.z_last_list[zidx];
 		}
 	}
+	_cull_state_clear_z_lists(cull_state);
 
-	RENDER_TIMESTAMP("Render CanvasItems");
+	return list;
+}
 
-	bool sdf_flag;
-	RSG::canvas_render->canvas_render_items(p_to_render_target, list, p_modulate, p_lights, p_directional_lights, p_transform, p_default_filter, p_default_repeat, p_snap_2d_vertices_to_pixel, sdf_flag, r_render_info);
-	if (sdf_flag) {
-		sdf_used = true;
+RendererCanvasCull::CullState *RendererCanvasCull::_cull_state_create() {
+	CullState *state = memnew(CullState);
+	state->z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+	state->z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+	memset(state->z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+	memset(state->z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+	return state;
+}
+
+void RendererCanvasCull::_cull_state_clear_z_lists(CullState &r_state) {
+	for (int zidx : r_state.z_used) {
+		r_state.z_list[zidx] = nullptr;
+		r_state.z_last_list[zidx] = nullptr;
+	}
+	r_state.z_used.clear();
+}
+
+bool RendererCanvasCull::_item_rect_uses_storage(const Item *p_item) {
+	// Same conditions as `RendererCanvasRender::Item::get_rect()` to update the rect.
+	if (p_item->custom_rect || (!p_item->rect_dirty && !p_item->update_when_visible && p_item->skeleton == RID())) {
+		return false;
+	}
+
+	for (const Item::Command *c = p_item->commands; c; c = c->next) {
+		if (c->type == Item::Command::TYPE_MESH || c->type == Item::Command::TYPE_MULTIMESH || c->type == Item::Command::TYPE_PARTICLES) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool RendererCanvasCull::_cull_canvas_item_range(CullState &r_state, const CullTreeData &p_data, uint32_t p_from, uint32_t p_to) {
+	for (uint32_t i = p_from; i < p_to; i++) {
+		Item *item = p_data.child_items[i].item;
+		const uint32_t item_count = r_state.item_count;
+		r_state.storage_needed = false;
+
+		_cull_canvas_item(item, p_data.transform, p_data.clip_rect, Color(1, 1, 1, 1), 0, r_state, nullptr, nullptr, false, p_data.canvas_cull_mask, Point2(), 1, nullptr);
+
+		if (r_state.storage_needed && !r_state.storage_allowed) {
+			return false;
+		}
+		item->cull_subtree_item_count = r_state.item_count - item_count;
+		item->cull_uses_storage = r_state.storage_needed;
+	}
+	return true;
+}
+
+void RendererCanvasCull::_cull_canvas_item_range_threaded(uint32_t p_index, const CullTreeData *p_data) {
+	CullRange &range = cull_ranges[p_index];
+	if (!range.on_render_thread) {
+		range.aborted = !_cull_canvas_item_range(*range.state, *p_data, range.from, range.to);
+	}
+}
+
+bool RendererCanvasCull::_cull_canvas_item_tree_threaded(const CullTreeData &p_data, uint32_t p_child_item_count) {
+	// Use the item counts of the previous frame to decide whether threads are worth it, and to balance them.
+	uint32_t total_item_count = 0;
+	for (uint32_t i = 0; i < p_child_item_count; i++) {
+		total_item_count += p_data.child_items[i].item->cull_subtree_item_count;
+	}
+	if (p_child_item_count < 2 || total_item_count < thread_cull_threshold) {
+		return false;
+	}
+
+	// Two ranges per thread balance the work, as long as they are large enough to be worth a task.
+	const uint32_t thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	const uint32_t max_range_count = CLAMP(thread_count * 2, 2u, CULL_MAX_RANGES);
+	const uint32_t target_range_count = CLAMP(total_item_count / CULL_MIN_RANGE_ITEMS, 2u, max_range_count);
+	const uint32_t range_item_count = MAX(total_item_count / target_range_count, 1u);
+
+	// Ranges must be consecutive children, so their draw lists can be merged in the same order as when culling on a single thread.
+	// Subtrees needing the storage to compute their rect get their own ranges, culled on the render thread. Once there are
+	// `CULL_MAX_RANGES`, the remaining children go in the last range, which is then culled on the render thread if any of them needs the storage.
+	cull_ranges.clear();
+	uint32_t range_count = 0;
+	for (uint32_t i = 0; i < p_child_item_count; i++) {
+		const Item *item = p_data.child_items[i].item;
+		if (cull_ranges.is_empty() || (cull_ranges.size() < CULL_MAX_RANGES && (cull_ranges[cull_ranges.size() - 1].on_render_thread != item->cull_uses_storage || (!item->cull_uses_storage && range_count >= range_item_count)))) {
+			CullRange range;
+			range.from = i;
+			range.on_render_thread = item->cull_uses_storage;
+			cull_ranges.push_back(range);
+			range_count = 0;
+		}
+		CullRange &range = cull_ranges[cull_ranges.size() - 1];
+		range.to = i + 1;
+		range.on_render_thread = range.on_render_thread || item->cull_uses_storage;
+		range_count += item->cull_subtree_item_count;
+	}
+	if (cull_ranges.size() < 2) {
+		return false;
+	}
+
+	while (cull_range_states.size() < cull_ranges.size()) {
+		cull_range_states.push_back(_cull_state_create());
+	}
+	for (uint32_t i = 0; i < cull_ranges.size(); i++) {
+		CullState *state = cull_range_states[i];
+		state->item_count = 0;
+		state->storage_allowed = cull_ranges[i].on_render_thread;
+		cull_ranges[i].state = state;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_cull_canvas_item_range_threaded, &p_data, cull_ranges.size(), -1, true, SNAME("CullCanvasItemTree"));
+	for (const CullRange &range : cull_ranges) {
+		if (range.on_render_thread) {
+			_cull_canvas_item_range(*range.state, p_data, range.from, range.to);
+		}
 	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (CullRange &range : cull_ranges) {
+		CullState &state = *range.state;
+
+		if (range.aborted) {
+			// A rect needed the storage, cull the range again on this thread. Its items are culled here in the next frames.
+			_cull_state_clear_z_lists(state);
+			state.visible_notifiers.clear();
+			state.storage_allowed = true;
+			_cull_canvas_item_range(state, p_data, range.from, range.to);
+			range.aborted = false;
+		}
+
+		for (int zidx : state.z_used) {
+			if (cull_state.z_list[zidx]) {
+				cull_state.z_last_list[zidx]->next = state.z_list[zidx];
+			} else {
+				cull_state.z_list[zidx] = state.z_list[zidx];
+				cull_state.z_used.push_back(zidx);
+			}
+			cull_state.z_last_list[zidx] = state.z_last_list[zidx];
+		}
+		_cull_state_clear_z_lists(state);
+
+		for (Item::VisibilityNotifierData *visibility_notifier : state.visible_notifiers) {
+			cull_state.visible_notifiers.push_back(visibility_notifier);
+		}
+		state.visible_notifiers.clear();
+
+		cull_state.redraw_requested = cull_state.redraw_requested || state.redraw_requested;
+		state.redraw_requested = false;
+	}
+
+	return true;
 }
 
 void RendererCanvasCull::_collect_ysort_children(RendererCanvasCull::Item *p_canvas_item, RendererCanvasCull::Item *p_material_owner, const Color &p_modulate, RendererCanvasCull::Item **r_items, int &r_index, int &r_ysort_children_count, int p_z, uint32_t p_canvas_cull_mask) {
@@ -189,7 +358,7 @@ void RendererCanvasCull::_mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
-void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &p_modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from) {
+void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, CullState &r_state, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &p_modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from) {
 	if (ci->copy_back_buffer) {
 		ci->copy_back_buffer->screen_rect = p_transform.xform(ci->copy_back_buffer->rect).intersection(p_clip_rect);
 	}
@@ -198,7 +367,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		int zidx = p_z - RSE::CANVAS_ITEM_Z_MIN;
 		if (r_canvas_group_from == nullptr) {
 			// no list before processing this item, means must put stuff in group from the beginning of list.
-			r_canvas_group_from = r_z_list[zidx];
+			r_canvas_group_from = r_state.z_list[zidx];
 		} else {
 			// there was a list before processing, so begin group from this one.
 			r_canvas_group_from = r_canvas_group_from->next;
@@ -261,7 +430,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		// Something to draw?
 
 		if (ci->update_when_visible) {
-			RenderingServerDefault::redraw_request();
+			r_state.redraw_requested = true;
 		}
 
 		if (ci->commands != nullptr || ci->copy_back_buffer) {
@@ -273,13 +442,14 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 
 			int zidx = p_z - RSE::CANVAS_ITEM_Z_MIN;
 
-			if (r_z_last_list[zidx]) {
-				r_z_last_list[zidx]->next = ci;
-				r_z_last_list[zidx] = ci;
+			if (r_state.z_last_list[zidx]) {
+				r_state.z_last_list[zidx]->next = ci;
+				r_state.z_last_list[zidx] = ci;
 
 			} else {
-				r_z_list[zidx] = ci;
-				r_z_last_list[zidx] = ci;
+				r_state.z_list[zidx] = ci;
+				r_state.z_last_list[zidx] = ci;
+				r_state.z_used.push_back(zidx);
 			}
 
 			ci->z_final = p_z;
@@ -289,8 +459,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 
 		if (ci->visibility_notifier) {
 			if (!ci->visibility_notifier->visible_element.in_list()) {
-				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
-				ci->visibility_notifier->just_visible = true;
+				r_state.visible_notifiers.push_back(ci->visibility_notifier);
 			}
 
 			ci->visibility_notifier->visible_in_frame = RSG::rasterizer->get_frame_number();
@@ -301,7 +470,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 	}
 }
 
-void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool p_is_already_y_sorted, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item) {
+void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, CullState &r_state, Item *p_canvas_clip, Item *p_material_owner, bool p_is_already_y_sorted, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item) {
 	Item *ci = p_canvas_item;
 
 	if (!ci->visible) {
@@ -312,6 +481,11 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		return;
 	}
 
+	if (r_state.storage_needed && !r_state.storage_allowed) {
+		return; // The range is culled again on the render thread.
+	}
+	r_state.item_count++;
+
 	if (ci->children_order_dirty) {
 		ci->child_items.sort_custom<ItemIndexSort>();
 		ci->children_order_dirty = false;
@@ -330,6 +504,13 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		return;
 	}
 
+	if (_item_rect_uses_storage(ci)) {
+		r_state.storage_needed = true;
+		if (!r_state.storage_allowed) {
+			return;
+		}
+	}
+
 	Rect2 rect = ci->get_rect();
 
 	if (ci->visibility_notifier) {
@@ -344,26 +525,39 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 	// we can override the transform for rendering purposes for this item only.
 	Transform2D self_xform;
 	Transform2D final_xform;
+	bool use_cull_cache = false;
 	if (p_is_already_y_sorted) {
 		// Y-sorted item's final transform is calculated before y-sorting,
 		// and is passed as `p_parent_xform` afterwards. No need to recalculate.
 		final_xform = p_parent_xform;
 	} else {
-		if (!_interpolation_data.interpolation_enabled || !ci->interpolated || !ci->on_interpolate_transform_list) {
-			self_xform = ci->xform_curr;
+		const bool interpolate = _interpolation_data.interpolation_enabled && ci->interpolated && ci->on_interpolate_transform_list;
+		if (!interpolate && !ci->cull_xform_dirty && ci->cull_xform_snapped == snapping_2d_transforms_to_pixel && ci->cull_parent_xform == p_parent_xform) {
+			final_xform = ci->cull_final_xform;
+			use_cull_cache = true;
 		} else {
-			real_t f = Engine::get_singleton()->get_physics_interpolation_fraction();
-			TransformInterpolator::interpolate_transform_2d(ci->xform_prev, ci->xform_curr, self_xform, f);
-		}
+			if (!interpolate) {
+				self_xform = ci->xform_curr;
+			} else {
+				real_t f = Engine::get_singleton()->get_physics_interpolation_fraction();
+				TransformInterpolator::interpolate_transform_2d(ci->xform_prev, ci->xform_curr, self_xform, f);
+			}
 
-		Transform2D parent_xform = p_parent_xform;
+			Transform2D parent_xform = p_parent_xform;
 
-		if (snapping_2d_transforms_to_pixel) {
-			self_xform.columns[2] = (self_xform.columns[2] + Point2(0.5, 0.5)).floor();
-			parent_xform.columns[2] = (parent_xform.columns[2] + Point2(0.5, 0.5)).floor();
-		}
+			if (snapping_2d_transforms_to_pixel) {
+				self_xform.columns[2] = (self_xform.columns[2] + Point2(0.5, 0.5)).floor();
+				parent_xform.columns[2] = (parent_xform.columns[2] + Point2(0.5, 0.5)).floor();
+			}
 
-		final_xform = parent_xform * self_xform;
+			final_xform = parent_xform * self_xform;
+
+			// Interpolated transforms change every frame, don't cache them.
+			ci->cull_xform_dirty = interpolate;
+			ci->cull_xform_snapped = snapping_2d_transforms_to_pixel;
+			ci->cull_parent_xform = p_parent_xform;
+			ci->cull_final_xform = final_xform;
+		}
 	}
 
 	Point2 repeat_size = p_repeat_size;
@@ -382,7 +576,15 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 
 	Rect2 global_rect;
 	if (!p_canvas_item->use_identity_transform) {
-		global_rect = final_xform.xform(rect);
+		if (use_cull_cache && ci->cull_rect == rect) {
+			global_rect = ci->cull_global_rect;
+		} else {
+			global_rect = final_xform.xform(rect);
+			if (!p_is_already_y_sorted) {
+				ci->cull_rect = rect;
+				ci->cull_global_rect = global_rect;
+			}
+		}
 	} else {
 		global_rect = _current_camera_transform.xform(rect);
 	}
@@ -442,7 +644,10 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			}
 
 			child_item_count = ci->ysort_children_count + 1;
-			child_items = (Item **)alloca(child_item_count * sizeof(Item *));
+			// The stack of worker threads is too small for the items of large y-sorted subtrees.
+			const uint32_t ysort_from = r_state.ysort_items.size();
+			r_state.ysort_items.resize(ysort_from + child_item_count);
+			child_items = r_state.ysort_items.ptr() + ysort_from;
 
 			ci->ysort_xform = Transform2D();
 			ci->ysort_modulate = Color(ci->modulate[0] ? 1 / ci->modulate[0] : 0, ci->modulate[1] ? 1 / ci->modulate[1] : 0, ci->modulate[2] ? 1 / ci->modulate[2] : 0, ci->modulate[3] ? 1 / ci->modulate[3] : 0);
@@ -456,38 +661,41 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			sorter.sort(child_items, child_item_count);
 
 			for (i = 0; i < child_item_count; i++) {
-				_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, true, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item);
+				// Nested y-sorted subtrees can grow the stack, so the items are not accessed through `child_items`.
+				Item *child_item = r_state.ysort_items[ysort_from + i];
+				_cull_canvas_item(child_item, final_xform * child_item->ysort_xform, p_clip_rect, modulate * child_item->ysort_modulate, child_item->ysort_parent_abs_z_index, r_state, (Item *)ci->final_clip_owner, (Item *)child_item->material_owner, true, p_canvas_cull_mask, child_item->repeat_size, child_item->repeat_times, child_item->repeat_source_item);
 			}
+			r_state.ysort_items.resize(ysort_from);
 		} else {
 			RendererCanvasRender::Item *canvas_group_from = nullptr;
 			bool use_canvas_group = ci->canvas_group != nullptr && (ci->canvas_group->fit_empty || ci->commands != nullptr);
 			if (use_canvas_group) {
 				int zidx = p_z - RSE::CANVAS_ITEM_Z_MIN;
-				canvas_group_from = r_z_last_list[zidx];
+				canvas_group_from = r_state.z_last_list[zidx];
 			}
 
-			_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
+			_attach_canvas_item_for_draw(ci, p_canvas_clip, r_state, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
 		}
 	} else {
 		RendererCanvasRender::Item *canvas_group_from = nullptr;
 		bool use_canvas_group = ci->canvas_group != nullptr && (ci->canvas_group->fit_empty || ci->commands != nullptr);
 		if (use_canvas_group) {
 			int zidx = p_z - RSE::CANVAS_ITEM_Z_MIN;
-			canvas_group_from = r_z_last_list[zidx];
+			canvas_group_from = r_state.z_last_list[zidx];
 		}
 
 		for (int i = 0; i < child_item_count; i++) {
 			if (!child_items[i]->behind && !use_canvas_group) {
 				continue;
 			}
-			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, false, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
+			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_state, (Item *)ci->final_clip_owner, p_material_owner, false, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
 		}
-		_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
+		_attach_canvas_item_for_draw(ci, p_canvas_clip, r_state, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
 		for (int i = 0; i < child_item_count; i++) {
 			if (child_items[i]->behind || use_canvas_group) {
 				continue;
 			}
-			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, false, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
+			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_state, (Item *)ci->final_clip_owner, p_material_owner, false, p_canvas_cull_mask, repeat_size, repeat_times, repeat_source_item);
 		}
 	}
 }
@@ -647,6 +855,7 @@ void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D
 	}
 
 	canvas_item->xform_curr = p_transform;
+	canvas_item->cull_xform_dirty = true;
 }
 
 void RendererCanvasCull::canvas_item_set_visibility_layer(RID p_item, uint32_t p_visibility_layer) {
@@ -2067,6 +2276,7 @@ void RendererCanvasCull::canvas_item_transform_physics_interpolation(RID p_item,
 	ERR_FAIL_NULL(canvas_item);
 	canvas_item->xform_prev = p_transform * canvas_item->xform_prev;
 	canvas_item->xform_curr = p_transform * canvas_item->xform_curr;
+	canvas_item->cull_xform_dirty = true;
 }
 
 void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RSE::CanvasGroupMode p_mode, float p_clear_margin, bool p_fit_empty, float p_fit_margin, bool p_blur_mipmaps) {
@@ -2826,8 +3036,12 @@ void RendererCanvasCull::InterpolationData::notify_free_canvas_light_occluder(RI
 RendererCanvasCull::RendererCanvasCull() {
 	_canvas_cull_singleton = this;
 
-	z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
-	z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+	cull_state.z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+	cull_state.z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+	memset(cull_state.z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+	memset(cull_state.z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+
+	thread_cull_threshold = GLOBAL_GET("rendering/2d/culling/threaded_cull_minimum_items");
 
 	disable_scale = false;
 
@@ -2836,7 +3050,12 @@ RendererCanvasCull::RendererCanvasCull() {
 }
 
 RendererCanvasCull::~RendererCanvasCull() {
-	memfree(z_list);
-	memfree(z_last_list);
+	memfree(cull_state.z_list);
+	memfree(cull_state.z_last_list);
+	for (CullState *state : cull_range_states) {
+		memfree(state->z_list);
+		memfree(state->z_last_list);
+		memdelete(state);
+	}
 	_canvas_cull_singleton = nullptr;
 }
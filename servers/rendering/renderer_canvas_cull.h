@@ -38,6 +38,8 @@
 #include "servers/rendering/rendering_server_types.h"
 
 class RendererCanvasCull {
+	friend class TestRendererCanvasCullAccessor;
+
 	static void _dependency_changed(Dependency::DependencyChangedNotification p_notification, DependencyTracker *p_tracker);
 	static void _dependency_deleted(const RID &p_dependency, DependencyTracker *p_tracker);
 
@@ -77,6 +79,18 @@ public:
 
 		VisibilityNotifierData *visibility_notifier = nullptr;
 
+		// Transform and bounds computed the last time the item was culled, reused while neither the item nor its parent moved.
+		Transform2D cull_parent_xform;
+		Transform2D cull_final_xform;
+		Rect2 cull_rect;
+		Rect2 cull_global_rect;
+		bool cull_xform_dirty = true;
+		bool cull_xform_snapped = false;
+
+		// Measured the last time the item was culled as a direct child of its canvas, to split the canvas between threads.
+		uint32_t cull_subtree_item_count = 0;
+		bool cull_uses_storage = false;
+
 		DependencyTracker dependency_tracker;
 		InstanceUniforms instance_uniforms;
 		SelfList<Item> update_item;
@@ -203,11 +217,25 @@ public:
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
 
-	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from);
+	// Draw lists filled while culling canvas items. Each range of items culled on another thread fills its own.
+	struct CullState {
+		RendererCanvasRender::Item **z_list = nullptr;
+		RendererCanvasRender::Item **z_last_list = nullptr;
+		LocalVector<int> z_used; // Indices of the non-empty z lists, to merge or clear only those.
+		LocalVector<Item::VisibilityNotifierData *> visible_notifiers; // Added to `visibility_notifier_list` once culling is done.
+		LocalVector<Item *> ysort_items; // Items of the y-sorted subtrees being culled, used as a stack as they can be nested.
+		uint32_t item_count = 0;
+		bool redraw_requested = false;
+		// The rect of items drawing meshes, multimeshes or particles comes from the storage, which is only accessed on the render thread.
+		bool storage_allowed = true;
+		bool storage_needed = false;
+	};
+
+	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, CullState &r_state, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from);
 
 private:
 	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RSE::CanvasItemTextureFilter p_default_filter, RSE::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingServerTypes::RenderInfo *r_render_info = nullptr);
-	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool p_is_already_y_sorted, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item);
+	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, CullState &r_state, Item *p_canvas_clip, Item *p_material_owner, bool p_is_already_y_sorted, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times, RendererCanvasRender::Item *p_repeat_source_item);
 
 	void _collect_ysort_children(RendererCanvasCull::Item *p_canvas_item, RendererCanvasCull::Item *p_material_owner, const Color &p_modulate, RendererCanvasCull::Item **r_items, int &r_index, int &r_ysort_children_count, int p_z, uint32_t p_canvas_cull_mask);
 	int _count_ysort_children(RendererCanvasCull::Item *p_canvas_item);
@@ -215,8 +243,40 @@ private:
 
 	static constexpr int z_range = RSE::CANVAS_ITEM_Z_MAX - RSE::CANVAS_ITEM_Z_MIN + 1;
 
-	RendererCanvasRender::Item **z_list;
-	RendererCanvasRender::Item **z_last_list;
+	// Maximum number of item ranges a canvas is split into when culling it on multiple threads.
+	static constexpr uint32_t CULL_MAX_RANGES = 32;
+	// Minimum number of items in a range, so that culling it is worth a task.
+	static constexpr uint32_t CULL_MIN_RANGE_ITEMS = 128;
+
+	struct CullTreeData {
+		Canvas::ChildItem *child_items = nullptr;
+		Transform2D transform;
+		Rect2 clip_rect;
+		uint32_t canvas_cull_mask = 0;
+	};
+
+	// Consecutive direct children of a canvas, culled together.
+	struct CullRange {
+		uint32_t from = 0;
+		uint32_t to = 0;
+		bool on_render_thread = false;
+		bool aborted = false;
+		CullState *state = nullptr;
+	};
+
+	CullState cull_state;
+	LocalVector<CullState *> cull_range_states;
+	LocalVector<CullRange> cull_ranges;
+	uint32_t thread_cull_threshold = 0;
+
+	static CullState *_cull_state_create();
+	static void _cull_state_clear_z_lists(CullState &r_state);
+	static bool _item_rect_uses_storage(const Item *p_item);
+	bool _cull_canvas_item_range(CullState &r_state, const CullTreeData &p_data, uint32_t p_from, uint32_t p_to);
+	void _cull_canvas_item_range_threaded(uint32_t p_index, const CullTreeData *p_data);
+	bool _cull_canvas_item_tree_threaded(const CullTreeData &p_data, uint32_t p_child_item_count);
+	// Returns the items to draw, in draw order.
+	RendererCanvasRender::Item *_cull_canvas_item_tree(Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, uint32_t p_canvas_cull_mask);
 
 	Transform2D _current_camera_transform;
 
@@ -35,6 +35,7 @@
 #include "core/math/geometry_3d.h"
 #include "core/object/callable_mp.h"
 #include "core/object/worker_thread_pool.h"
+#include "servers/rendering/raster_occlusion_cull.h"
 #include "servers/rendering/rendering_light_culler.h"
 #include "servers/rendering/rendering_server.h"
 #include "servers/rendering/rendering_server_default.h"
@@ -1164,6 +1165,7 @@ void RendererSceneCull::instance_set_ignore_culling(RID p_instance, bool p_enabl
 		} else {
 			idata.flags &= ~InstanceData::FLAG_IGNORE_ALL_CULLING;
 		}
+		_scene_cull_cache_mark_dirty(instance->scenario, instance->array_index);
 	}
 }
 
@@ -1591,6 +1593,17 @@ uint32_t RendererSceneCull::get_pipeline_compilations(RSE::PipelineSource p_sour
 	return scene_render->get_pipeline_compilations(p_source);
 }
 
+uint64_t RendererSceneCull::get_rendering_info(RSE::RenderingInfo p_info) {
+	switch (p_info) {
+		case RSE::RENDERING_INFO_TOTAL_INSTANCES_CULLED_IN_FRAME:
+			return cull_stats.instances_tested;
+		case RSE::RENDERING_INFO_TOTAL_INSTANCES_REUSED_IN_FRAME:
+			return cull_stats.instances_reused;
+		default:
+			return 0;
+	}
+}
+
 void RendererSceneCull::instance_geometry_get_shader_parameter_list(RID p_instance, List<PropertyInfo> *p_parameters) const {
 	ERR_FAIL_NULL(p_parameters);
 	const Instance *instance = instance_owner.get_or_null(p_instance);
@@ -1844,6 +1857,8 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 
 		p_instance->scenario->instance_data.push_back(idata);
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
+		p_instance->scenario->instance_bounds.push_back(p_instance->transformed_aabb);
+		_scene_cull_cache_mark_dirty(p_instance->scenario, p_instance->array_index);
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
 		if ((1 << p_instance->base_type) & RSE::INSTANCE_GEOMETRY_MASK) {
@@ -1852,6 +1867,8 @@ void RendererSceneCull::_update_instance(Instance *p_instance) const {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		p_instance->scenario->instance_bounds.set(p_instance->array_index, p_instance->transformed_aabb);
+		_scene_cull_cache_mark_dirty(p_instance->scenario, p_instance->array_index);
 	}
 
 	if (p_instance->visibility_index != -1) {
@@ -1939,6 +1956,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		swapped_instance->array_index = p_instance->array_index; //swap
 		p_instance->scenario->instance_data[p_instance->array_index] = p_instance->scenario->instance_data[swap_with_index];
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = p_instance->scenario->instance_aabbs[swap_with_index];
+		_scene_cull_cache_mark_dirty(p_instance->scenario, p_instance->array_index);
 
 		if (swapped_instance->visibility_index != -1) {
 			swapped_instance->scenario->instance_visibility[swapped_instance->visibility_index].array_index = swapped_instance->array_index;
@@ -1955,6 +1973,8 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 	// pop last
 	p_instance->scenario->instance_data.pop_back();
 	p_instance->scenario->instance_aabbs.pop_back();
+	p_instance->scenario->instance_bounds.remove_at_unordered(p_instance->array_index);
+	_scene_cull_cache_mark_dirty(p_instance->scenario, swap_with_index);
 
 	//uninitialize
 	p_instance->array_index = -1;
@@ -2886,6 +2906,136 @@ bool RendererSceneCull::_visibility_parent_check(const CullData &p_cull_data, co
 	return ((parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK) == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE) || (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 }
 
+void RendererSceneCull::_scene_cull_cache_mark_dirty(Scenario *p_scenario, uint32_t p_index) {
+	p_scenario->cull_caches.mark_dirty(p_index, p_scenario->instance_data.size());
+}
+
+uint64_t RendererSceneCull::_scene_cull_cache_get_candidates(const Scenario *p_scenario, uint32_t p_word) const {
+	// Must accept every instance that `_scene_cull()` does something with, other than the visibility and occlusion checks.
+	static_assert(InstanceBoundsArray::BLOCK_SIZE == 64);
+	const uint32_t block_from = p_word * 64;
+	const InstanceBoundsArray &instance_bounds = p_scenario->instance_bounds;
+
+	uint64_t candidates = instance_bounds.cull_planes(block_from, cull.frustum.planes_ptr, cull.frustum.plane_count);
+	for (uint32_t i = 0; i < cull.shadow_count; i++) {
+		for (uint32_t j = 0; j < cull.shadows[i].cascade_count; j++) {
+			const Frustum &cascade_frustum = cull.shadows[i].cascades[j].frustum;
+			candidates |= instance_bounds.cull_planes(block_from, cascade_frustum.planes_ptr, cascade_frustum.plane_count);
+		}
+	}
+
+	// Instances outside of all the frustums can still be in an SDFGI region, or ignore culling.
+	const uint32_t block_to = MIN(block_from + 64, (uint32_t)p_scenario->instance_data.size());
+	for (uint32_t i = block_from; i < block_to; i++) {
+		const uint64_t bit = uint64_t(1) << (i - block_from);
+		if (candidates & bit) {
+			continue;
+		}
+		bool is_candidate = p_scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING;
+		for (uint32_t j = 0; j < cull.sdfgi.region_count && !is_candidate; j++) {
+			is_candidate = p_scenario->instance_aabbs[i].in_aabb(cull.sdfgi.region_aabb[j]);
+		}
+		candidates |= is_candidate ? bit : 0;
+	}
+	return candidates;
+}
+
+void RendererSceneCull::_scene_cull_cache_build_threaded(uint32_t p_task, CullCacheBuildData *p_build_data) {
+	uint64_t *candidates = p_build_data->cache->candidates.ptr();
+	const uint32_t word_from = p_task * p_build_data->words_per_task;
+	const uint32_t word_to = MIN(word_from + p_build_data->words_per_task, p_build_data->cache->candidates.size());
+	uint32_t candidate_count = 0;
+
+	for (uint32_t i = word_from; i < word_to; i++) {
+		candidates[i] = _scene_cull_cache_get_candidates(p_build_data->scenario, i);
+		candidate_count += Math::count_set_bits(candidates[i]);
+	}
+
+	p_build_data->task_candidate_counts[p_task] = candidate_count;
+}
+
+InstanceCullCaches::Cache *RendererSceneCull::_scene_cull_cache_prepare(Scenario *p_scenario) {
+	// The culling volumes must be set up in `cull` already.
+	cull_cache_planes.clear();
+	cull_cache_regions.clear();
+	for (uint32_t i = 0; i < cull.frustum.plane_count; i++) {
+		cull_cache_planes.push_back(cull.frustum.planes_ptr[i]);
+	}
+	for (uint32_t i = 0; i < cull.shadow_count; i++) {
+		for (uint32_t j = 0; j < cull.shadows[i].cascade_count; j++) {
+			const Frustum &frustum = cull.shadows[i].cascades[j].frustum;
+			for (uint32_t k = 0; k < frustum.plane_count; k++) {
+				cull_cache_planes.push_back(frustum.planes_ptr[k]);
+			}
+		}
+	}
+	for (uint32_t i = 0; i < cull.sdfgi.region_count; i++) {
+		cull_cache_regions.push_back(cull.sdfgi.region_aabb[i]);
+	}
+
+	const uint32_t instance_count = p_scenario->instance_data.size();
+
+	InstanceCullCaches::Cache *cache = p_scenario->cull_caches.get_cache(cull_cache_planes, cull_cache_regions, render_pass);
+	if (cache == nullptr) {
+		frame_cull_stats.instances_tested += instance_count;
+		return nullptr;
+	}
+
+	const uint32_t word_count = (instance_count + 63) / 64;
+
+	if (p_scenario->cull_caches.get_dirty_words(cache, word_count, cull_cache_dirty_words)) {
+		cache->candidates.resize(word_count);
+
+		CullCacheBuildData build_data;
+		build_data.scenario = p_scenario;
+		build_data.cache = cache;
+		if (instance_count > thread_cull_threshold) {
+			const uint32_t task_count = WorkerThreadPool::get_singleton()->get_thread_count();
+			build_data.words_per_task = (word_count + task_count - 1) / task_count;
+			build_data.task_candidate_counts.resize_initialized(task_count);
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_scene_cull_cache_build_threaded, &build_data, task_count, -1, true, SNAME("RenderCullCacheInstances"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			build_data.words_per_task = word_count;
+			build_data.task_candidate_counts.resize_initialized(1);
+			_scene_cull_cache_build_threaded(0, &build_data);
+		}
+
+		cache->candidate_count = 0;
+		for (uint32_t count : build_data.task_candidate_counts) {
+			cache->candidate_count += count;
+		}
+		frame_cull_stats.instances_tested += instance_count + cache->candidate_count;
+	} else {
+		// Find the candidates again in the blocks of the instances that changed. Words past the last instance are
+		// only kept until then, to remove their bits from the count.
+		const uint32_t previous_word_count = cache->candidates.size();
+		if (word_count > previous_word_count) {
+			cache->candidates.resize_initialized(word_count);
+		}
+
+		uint64_t *candidates = cache->candidates.ptr();
+		for (uint32_t word : cull_cache_dirty_words) {
+			const uint64_t word_candidates = _scene_cull_cache_get_candidates(p_scenario, word);
+			cache->candidate_count += Math::count_set_bits(word_candidates);
+			cache->candidate_count -= Math::count_set_bits(candidates[word]);
+			candidates[word] = word_candidates;
+			frame_cull_stats.instances_tested += 64;
+		}
+		for (uint32_t i = word_count; i < previous_word_count; i++) {
+			cache->candidate_count -= Math::count_set_bits(candidates[i]);
+		}
+
+		cache->candidates.resize(word_count);
+		frame_cull_stats.instances_tested += cache->candidate_count;
+		frame_cull_stats.instances_reused += instance_count - cache->candidate_count;
+	}
+
+	p_scenario->cull_caches.set_updated(cache);
+
+	return cache;
+}
+
 void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_data) {
 	uint32_t cull_total = cull_data->scenario->instance_data.size();
 	uint32_t total_threads = WorkerThreadPool::get_singleton()->get_thread_count();
@@ -2917,7 +3067,39 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	float z_near = cull_data.camera_matrix->get_z_near();
 	bool is_orthogonal = cull_data.camera_matrix->is_orthogonal();
 
+	// Frustum tests are done for a block of instances at a time, with the bits of the instances inside.
+	const InstanceBoundsArray &instance_bounds = cull_data.scenario->instance_bounds;
+	uint64_t block_from = UINT64_MAX;
+	uint64_t in_frustum_mask = 0;
+	uint64_t in_cascade_masks[RendererSceneRender::MAX_DIRECTIONAL_LIGHTS][RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES];
+
 	for (uint64_t i = p_from; i < p_to; i++) {
+		if (cull_data.cull_candidates != nullptr) {
+			const uint64_t candidates = cull_data.cull_candidates[i >> 6] >> (i & 63);
+			if (candidates == 0) {
+				i |= 63; // Nothing else to process in this word.
+				continue;
+			}
+			if ((candidates & 1) == 0) {
+				continue;
+			}
+		}
+
+		if ((i & ~uint64_t(InstanceBoundsArray::BLOCK_SIZE - 1)) != block_from) {
+			block_from = i & ~uint64_t(InstanceBoundsArray::BLOCK_SIZE - 1);
+			in_frustum_mask = instance_bounds.cull_planes(block_from, cull_data.cull->frustum.planes_ptr, cull_data.cull->frustum.plane_count);
+			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
+				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
+					const Frustum &cascade_frustum = cull_data.cull->shadows[j].cascades[k].frustum;
+					in_cascade_masks[j][k] = light_culler->cull_directional_light(instance_bounds, block_from, j, k);
+					if (in_cascade_masks[j][k] != 0) {
+						in_cascade_masks[j][k] &= instance_bounds.cull_planes(block_from, cascade_frustum.planes_ptr, cascade_frustum.plane_count);
+					}
+				}
+			}
+		}
+		const uint64_t instance_bit = uint64_t(1) << (i - block_from);
+
 		bool mesh_visible = false;
 
 		InstanceData &idata = cull_data.scenario->instance_data[i];
@@ -2926,14 +3108,14 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 #define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
 #define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
-#define IN_FRUSTUM(f) (cull_data.scenario->instance_aabbs[i].in_frustum(f))
+#define IN_FRUSTUM (in_frustum_mask & instance_bit)
 #define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check<false>(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
 #define VIS_PARENT_CHECK (_visibility_parent_check(cull_data, idata))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near, is_orthogonal, cull_data.scenario->instance_data[i].occlusion_timeout))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((LAYER_CHECK && IN_FRUSTUM && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RSE::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -3245,10 +3427,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
 				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
-					if (!light_culler->cull_directional_light(cull_data.scenario->instance_aabbs[i], j, k)) { // pass the cascade index
-						continue;
-					}
-					if (IN_FRUSTUM(cull_data.cull->shadows[j].cascades[k].frustum) && VIS_CHECK) {
+					if ((in_cascade_masks[j][k] & instance_bit) && VIS_CHECK) {
 						uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 
 						const bool is_inactive_particle = (base_type == RSE::INSTANCE_PARTICLES) && RSG::particles_storage->particles_is_inactive(idata.base_rid);
@@ -3442,7 +3621,14 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		uint64_t time_from = OS::get_singleton()->get_ticks_usec();
 #endif
 
-		if (cull_to > thread_cull_threshold) {
+		uint64_t cull_count = cull_to;
+		InstanceCullCaches::Cache *cull_cache = _scene_cull_cache_prepare(scenario);
+		if (cull_cache != nullptr) {
+			cull_data.cull_candidates = cull_cache->candidates.ptr();
+			cull_count = cull_cache->candidate_count;
+		}
+
+		if (cull_count > thread_cull_threshold) {
 			//multiple threads
 			for (InstanceCullResult &thread : scene_cull_result_threads) {
 				thread.clear();
@@ -4371,6 +4557,9 @@ void RendererSceneCull::update_dirty_instances() const {
 }
 
 void RendererSceneCull::update() {
+	cull_stats = frame_cull_stats;
+	frame_cull_stats = CullStats();
+
 	//optimize bvhs
 
 	uint32_t rid_count = scenario_owner.get_rid_count();
@@ -4524,7 +4713,8 @@ RendererSceneCull::RendererSceneCull() {
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	// Replaced by the ray-cast occlusion culling of the raycast module when it is enabled.
+	raster_occlusion_culling = memnew(RasterOcclusionCull);
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4550,7 +4740,7 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	memdelete(dummy_occlusion_culling);
+	memdelete(raster_occlusion_culling);
 
 	if (light_culler) {
 		memdelete(light_culler);
@@ -39,6 +39,8 @@
 #include "core/templates/pass_func.h"
 #include "core/templates/rid_owner.h"
 #include "core/templates/self_list.h"
+#include "servers/rendering/instance_bounds_array.h"
+#include "servers/rendering/instance_cull_caches.h"
 #include "servers/rendering/instance_uniforms.h"
 #include "servers/rendering/renderer_scene_occlusion_cull.h"
 #include "servers/rendering/renderer_scene_render.h"
@@ -126,7 +128,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *raster_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -350,9 +352,14 @@ public:
 		LocalVector<RID> dynamic_lights;
 
 		PagedArray<InstanceBounds> instance_aabbs;
+		// Same bounds as `instance_aabbs`, for the culling tests done on blocks of instances.
+		InstanceBoundsArray instance_bounds;
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
+		// Candidates of previous renders, one bit per entry of `instance_data`.
+		InstanceCullCaches cull_caches;
+
 		Scenario() {
 			indexers[INDEXER_GEOMETRY].set_index(INDEXER_GEOMETRY);
 			indexers[INDEXER_VOLUMES].set_index(INDEXER_VOLUMES);
@@ -1069,6 +1076,8 @@ public:
 	virtual void mesh_generate_pipelines(RID p_mesh, bool p_background_compilation);
 	virtual uint32_t get_pipeline_compilations(RSE::PipelineSource p_source);
 
+	virtual uint64_t get_rendering_info(RSE::RenderingInfo p_info);
+
 	_FORCE_INLINE_ void _update_instance(Instance *p_instance) const;
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance) const;
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance) const;
@@ -1144,8 +1153,34 @@ public:
 		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer;
 		const Projection *camera_matrix;
 		uint64_t visibility_viewport_mask;
+		// Bits of the instances to process, all instances are processed when null.
+		const uint64_t *cull_candidates = nullptr;
+	};
+
+	struct CullCacheBuildData {
+		Scenario *scenario = nullptr;
+		InstanceCullCaches::Cache *cache = nullptr;
+		uint32_t words_per_task = 0;
+		LocalVector<uint32_t> task_candidate_counts;
+	};
+
+	struct CullStats {
+		uint64_t instances_tested = 0;
+		uint64_t instances_reused = 0;
 	};
 
+	// Key of the cull cache used by the current render.
+	LocalVector<Plane> cull_cache_planes;
+	LocalVector<AABB> cull_cache_regions;
+	LocalVector<uint32_t> cull_cache_dirty_words;
+	CullStats cull_stats;
+	CullStats frame_cull_stats;
+
+	static void _scene_cull_cache_mark_dirty(Scenario *p_scenario, uint32_t p_index);
+	uint64_t _scene_cull_cache_get_candidates(const Scenario *p_scenario, uint32_t p_word) const;
+	void _scene_cull_cache_build_threaded(uint32_t p_task, CullCacheBuildData *p_build_data);
+	InstanceCullCaches::Cache *_scene_cull_cache_prepare(Scenario *p_scenario);
+
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
 	static void _scene_particles_set_view_axis(RID p_particles, const Vector3 &p_axis, const Vector3 &p_up_axis);
@@ -41,6 +41,11 @@ class RendererSceneOcclusionCull {
 protected:
 	static RendererSceneOcclusionCull *singleton;
 
+	// Rectangle of the camera near plane, in view space.
+	static Rect2 _get_viewport_rect(const Projection &p_cam_projection);
+	// Sub-pixel offset of the buffer samples on the near plane for this frame, when jittering is enabled.
+	static Vector2 _get_jitter(const Rect2 &p_viewport_rect, const Size2i &p_buffer_size);
+
 public:
 	class HZBuffer {
 	protected:
@@ -143,32 +143,27 @@ bool RenderingLightCuller::_prepare_light(const RendererSceneCull::Instance &p_i
 	return true;
 }
 
-bool RenderingLightCuller::cull_directional_light(const RendererSceneCull::InstanceBounds &p_bound, int32_t p_directional_light_id, int32_t p_cascade) {
+uint64_t RenderingLightCuller::cull_directional_light(const InstanceBoundsArray &p_bounds, uint32_t p_from, int32_t p_directional_light_id, int32_t p_cascade) {
 	if (!data.is_active() || !is_caster_culling_active()) {
-		return true;
+		return UINT64_MAX;
 	}
 
-	ERR_FAIL_INDEX_V(p_directional_light_id, (int32_t)data.directional_cull_planes.size(), true);
+	ERR_FAIL_INDEX_V(p_directional_light_id, (int32_t)data.directional_cull_planes.size(), UINT64_MAX);
 
 	LightCullPlanes &cull_planes = data.directional_cull_planes[p_directional_light_id].planes[p_cascade];
 
-	Vector3 mins = Vector3(p_bound.bounds[0], p_bound.bounds[1], p_bound.bounds[2]);
-	Vector3 maxs = Vector3(p_bound.bounds[3], p_bound.bounds[4], p_bound.bounds[5]);
-	AABB bb(mins, maxs - mins);
+	const uint64_t visible = p_bounds.cull_planes(p_from, cull_planes.cull_planes, cull_planes.num_cull_planes, false);
 
-	real_t r_min, r_max;
-	for (int p = 0; p < cull_planes.num_cull_planes; p++) {
-		bb.project_range_in_plane(cull_planes.cull_planes[p], r_min, r_max);
-		if (r_min > 0.0f) {
 #ifdef LIGHT_CULLER_DEBUG_DIRECTIONAL_LIGHT
+	const uint32_t block_count = MIN(InstanceBoundsArray::BLOCK_SIZE, p_bounds.size() - MIN(p_from, p_bounds.size()));
+	for (uint32_t i = 0; i < block_count; i++) {
+		if (!(visible & (uint64_t(1) << i))) {
 			cull_planes.rejected_count++;
-#endif
-
-			return false;
 		}
 	}
+#endif
 
-	return true;
+	return visible;
 }
 
 void RenderingLightCuller::cull_regular_light(PagedArray<RendererSceneCull::Instance *> &r_instance_shadow_cull_result) {
@@ -189,47 +184,31 @@ void RenderingLightCuller::cull_regular_light(PagedArray<RendererSceneCull::Inst
 	uint32_t count_before = r_instance_shadow_cull_result.size();
 #endif
 
-	// Go through all the casters in the list (the list will hopefully shrink as we go).
-	for (int n = 0; n < (int)list.size(); n++) {
-		// World space aabb.
-		const AABB &bb = list[n]->transformed_aabb;
-
-#ifdef LIGHT_CULLER_DEBUG_LOGGING
-		if (is_logging()) {
-			print_line("bb : " + String(bb));
-		}
-#endif
-
-		real_t r_min, r_max;
-		bool show = true;
-
-		for (int p = 0; p < data.regular_cull_planes.num_cull_planes; p++) {
-			// As we only need r_min, could this be optimized?
-			bb.project_range_in_plane(data.regular_cull_planes.cull_planes[p], r_min, r_max);
-
-#ifdef LIGHT_CULLER_DEBUG_LOGGING
-			if (is_logging()) {
-				print_line("\tplane " + itos(p) + " : " + String(data.regular_cull_planes.cull_planes[p]) + " r_min " + String(Variant(r_min)) + " r_max " + String(Variant(r_max)));
-			}
-#endif
+	// Copy the world space AABBs of the casters, to cull them a block at a time.
+	InstanceBoundsArray &bounds = data.regular_caster_bounds;
+	bounds.clear();
+	for (uint64_t n = 0; n < list.size(); n++) {
+		bounds.push_back(list[n]->transformed_aabb);
+	}
 
-			if (r_min > 0.0f) {
-				show = false;
-				break;
+	// Keep the casters that are not culled, in order.
+	uint64_t kept_count = 0;
+	for (uint32_t from = 0; from < bounds.size(); from += InstanceBoundsArray::BLOCK_SIZE) {
+		const uint64_t visible = bounds.cull_planes(from, data.regular_cull_planes.cull_planes, data.regular_cull_planes.num_cull_planes, false);
+		const uint32_t block_count = MIN(InstanceBoundsArray::BLOCK_SIZE, bounds.size() - from);
+		for (uint32_t i = 0; i < block_count; i++) {
+			if (visible & (uint64_t(1) << i)) {
+				list[kept_count++] = list[from + i];
 			}
 		}
-
-		// Remove.
-		if (!show) {
-			list.remove_at_unordered(n);
-
-			// Repeat this element next iteration of the loop as it has been removed and replaced by the last.
-			n--;
+	}
 
 #ifdef LIGHT_CULLER_DEBUG_REGULAR_LIGHT
-			data.regular_rejected_count++;
+	data.regular_rejected_count += list.size() - kept_count;
 #endif
-		}
+
+	while (list.size() > kept_count) {
+		list.pop_back();
 	}
 
 #ifdef LIGHT_CULLER_DEBUG_LOGGING
@@ -156,8 +156,9 @@ public:
 	void prepare_directional_light_begin(const RendererSceneCull::Instance *p_instance, int32_t p_directional_light_id);
 	void prepare_directional_light_cascade(int32_t p_directional_light_id, int32_t p_cascade, const Vector<Plane> &p_receiver_frustum_planes, const Vector3 *p_receiver_frustum_points);
 
-	// Return false if the instance is to be culled.
-	bool cull_directional_light(const RendererSceneCull::InstanceBounds &p_bound, int32_t p_directional_light_id, int32_t p_cascade);
+	// Returns the mask of the block of instances starting at `p_from` that are not culled,
+	// see `InstanceBoundsArray::cull_planes()`.
+	uint64_t cull_directional_light(const InstanceBoundsArray &p_bounds, uint32_t p_from, int32_t p_directional_light_id, int32_t p_cascade);
 
 	// Can turn on and off from the engine if desired.
 	void set_caster_culling_active(bool p_active) { data.caster_culling_active = p_active; }
@@ -262,6 +263,8 @@ private:
 		// Single threaded cull planes for regular lights
 		// (OMNI, SPOT). These lights reuse the same set of cull plane data.
 		LightCullPlanes regular_cull_planes;
+		// Bounds of the casters being culled for a regular light.
+		InstanceBoundsArray regular_caster_bounds;
 
 #ifdef LIGHT_CULLER_DEBUG_REGULAR_LIGHT
 		uint32_t regular_rejected_count = 0;
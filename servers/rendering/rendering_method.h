@@ -126,6 +126,10 @@ public:
 	virtual void mesh_generate_pipelines(RID p_mesh, bool p_background_compilation) = 0;
 	virtual uint32_t get_pipeline_compilations(RSE::PipelineSource p_source) = 0;
 
+	/* STATUS INFORMATION */
+
+	virtual uint64_t get_rendering_info(RSE::RenderingInfo p_info) = 0;
+
 	/* SKY API */
 
 	virtual RID sky_allocate() = 0;
@@ -321,6 +321,8 @@ uint64_t RenderingServerDefault::get_rendering_info(RSE::RenderingInfo p_info) {
 		return RSG::canvas_render->get_pipeline_compilations(RSE::PIPELINE_SOURCE_DRAW) + RSG::scene->get_pipeline_compilations(RSE::PIPELINE_SOURCE_DRAW);
 	} else if (p_info == RSE::RENDERING_INFO_PIPELINE_COMPILATIONS_SPECIALIZATION) {
 		return RSG::canvas_render->get_pipeline_compilations(RSE::PIPELINE_SOURCE_SPECIALIZATION) + RSG::scene->get_pipeline_compilations(RSE::PIPELINE_SOURCE_SPECIALIZATION);
+	} else if (p_info == RSE::RENDERING_INFO_TOTAL_INSTANCES_CULLED_IN_FRAME || p_info == RSE::RENDERING_INFO_TOTAL_INSTANCES_REUSED_IN_FRAME) {
+		return RSG::scene->get_rendering_info(p_info);
 	}
 	return RSG::utilities->get_rendering_info(p_info);
 }
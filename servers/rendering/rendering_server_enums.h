@@ -919,6 +919,8 @@ enum RenderingInfo {
 	RENDERING_INFO_PIPELINE_COMPILATIONS_SURFACE,
 	RENDERING_INFO_PIPELINE_COMPILATIONS_DRAW,
 	RENDERING_INFO_PIPELINE_COMPILATIONS_SPECIALIZATION,
+	RENDERING_INFO_TOTAL_INSTANCES_CULLED_IN_FRAME,
+	RENDERING_INFO_TOTAL_INSTANCES_REUSED_IN_FRAME,
 	RENDERING_INFO_MAX,
 };
 
@@ -34,6 +34,7 @@ TEST_FORCE_LINK(test_file_access)
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
 #include "tests/test_utils.h"
 
 namespace TestFileAccess {
@@ -250,6 +251,70 @@ TEST_CASE("[FileAccess] Get/Store floating point half precision values") {
 	}
 }
 
+TEST_CASE("[FileAccess] Read compressed files in blocks") {
+	const String file_path = TestUtils::get_temp_path("compressed_blocks.bin");
+
+	Vector<uint8_t> data;
+	data.resize(100000);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = (i / 7) % 23 + (i % 3);
+	}
+
+	// Use small blocks so that the file is made of many of them.
+	Ref<FileAccessCompressed> fcw;
+	fcw.instantiate();
+	fcw->configure("GCPF", Compression::MODE_ZSTD, 1024);
+	REQUIRE(fcw->open_internal(file_path, FileAccess::WRITE) == OK);
+	Ref<FileAccess> fw = fcw;
+	fw->store_buffer(data);
+	fw->close();
+
+	for (uint32_t read_ahead : { 0u, FileAccessCompressed::DEFAULT_READ_AHEAD }) {
+		FileAccessCompressed::clear_block_cache();
+
+		Ref<FileAccessCompressed> fc;
+		fc.instantiate();
+		fc->configure("GCPF");
+		fc->set_read_ahead(read_ahead);
+		REQUIRE(fc->open_internal(file_path, FileAccess::READ) == OK);
+		Ref<FileAccess> f = fc;
+		CHECK(f->get_length() == uint64_t(data.size()));
+
+		// Sequential reads crossing block boundaries.
+		Vector<uint8_t> read_data;
+		while (!f->eof_reached()) {
+			read_data.append_array(f->get_buffer(3000));
+		}
+		CHECK(read_data == data);
+		// Only the first block is cached, the ones streamed after it are not.
+		CHECK(FileAccessCompressed::get_block_cache_size() == 1);
+
+		// Seeking backwards and forwards, to blocks that may have been decompressed in advance.
+		for (uint64_t position : { 5000u, 1023u, 1024u, 60000u, 61025u, 99999u, 0u }) {
+			f->seek(position);
+			CHECK(f->get_position() == position);
+			CHECK(f->get_8() == data[position]);
+		}
+		f->seek(2000);
+		CHECK(f->get_buffer(5000) == data.slice(2000, 7000));
+		// The blocks reached by seeking are cached.
+		CHECK(FileAccessCompressed::get_block_cache_size() > 1);
+
+		// A second handle of the same file reads the whole content, using the cached blocks where it can, while the first one keeps its position.
+		Ref<FileAccessCompressed> fc2;
+		fc2.instantiate();
+		fc2->configure("GCPF");
+		fc2->set_read_ahead(read_ahead);
+		REQUIRE(fc2->open_internal(file_path, FileAccess::READ) == OK);
+		Ref<FileAccess> f2 = fc2;
+		CHECK(f2->get_buffer(data.size()) == data);
+		CHECK(f->get_buffer(3000) == data.slice(7000, 10000));
+	}
+
+	FileAccessCompressed::clear_block_cache();
+	DirAccess::remove_file_or_error(file_path);
+}
+
 TEST_CASE("[FileAccess] Cursor positioning") {
 	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
 	REQUIRE(f.is_valid());
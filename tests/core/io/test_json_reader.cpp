@@ -0,0 +1,179 @@
+/**************************************************************************/
+/*  test_json_reader.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_json_reader)
+
+#include "core/io/json.h"
+#include "core/io/json_reader.h"
+
+namespace TestJSONReader {
+
+static Vector<uint8_t> _to_buffer(const String &p_json) {
+	return p_json.to_utf8_buffer();
+}
+
+TEST_CASE("[JSONReader] Read tokens") {
+	Ref<JSONReader> reader;
+	reader.instantiate();
+	reader->open_buffer(_to_buffer(R"({"name": "Godot", "list": [1, true, null], "empty": {}})"));
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_OBJECT_BEGIN);
+	CHECK(reader->get_depth() == 1);
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_KEY);
+	CHECK(reader->get_key() == "name");
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_VALUE);
+	CHECK(reader->get_value() == "Godot");
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_key() == "list");
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_ARRAY_BEGIN);
+	CHECK(reader->get_depth() == 2);
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == Variant(1.0));
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == Variant(true));
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_value() == Variant());
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_ARRAY_END);
+	CHECK(reader->get_depth() == 1);
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_key() == "empty");
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_OBJECT_BEGIN);
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_OBJECT_END);
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_OBJECT_END);
+	CHECK(reader->get_depth() == 0);
+	CHECK(reader->read() == ERR_FILE_EOF);
+	CHECK(reader->get_error_message().is_empty());
+}
+
+TEST_CASE("[JSONReader] Read values and skip sections") {
+	Ref<JSONReader> reader;
+	reader.instantiate();
+	reader->open_buffer(_to_buffer(R"({"skipped": [1, {"a": "]}\"{"}], "kept": {"b": [2, "c"]}})"));
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_key() == "skipped");
+	CHECK(reader->read() == OK);
+	CHECK(reader->skip_section() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_ARRAY_END);
+	CHECK(reader->get_depth() == 1);
+
+	Variant kept;
+	CHECK(reader->read_value(kept) == OK);
+	CHECK(reader->get_key() == "kept");
+	CHECK(JSON::stringify(kept) == R"({"b":[2.0,"c"]})");
+
+	CHECK(reader->read() == OK);
+	CHECK(reader->get_token_type() == JSONReader::TOKEN_OBJECT_END);
+	CHECK(reader->read() == ERR_FILE_EOF);
+}
+
+TEST_CASE("[JSONReader] Strings") {
+	Ref<JSONReader> reader;
+	reader.instantiate();
+	Variant value;
+
+	// Long enough to go through the word-at-a-time scanning.
+	reader->open_buffer(_to_buffer(U"\"Déjà vu, this string is longer than eight bytes\""));
+	CHECK(reader->read_value(value) == OK);
+	CHECK(value == U"Déjà vu, this string is longer than eight bytes");
+
+	reader->open_buffer(_to_buffer(U"\"tab\\tquote\\\"slash\\/é😀 end\""));
+	CHECK(reader->read_value(value) == OK);
+	CHECK(value == U"tab\tquote\"slash/é😀 end");
+
+	ERR_PRINT_OFF
+	reader->open_buffer(_to_buffer(R"("unterminated)"));
+	CHECK(reader->read_value(value) == ERR_PARSE_ERROR);
+	CHECK(reader->get_error_message() == "Unterminated string");
+
+	reader->open_buffer(_to_buffer(R"("\ud83d")"));
+	CHECK(reader->read_value(value) == ERR_PARSE_ERROR);
+	ERR_PRINT_ON
+}
+
+TEST_CASE("[JSONReader] Errors") {
+	Ref<JSONReader> reader;
+	reader.instantiate();
+	Variant value;
+
+	reader->open_buffer(_to_buffer("[\n1,\n2\n3]"));
+	CHECK(reader->read_value(value) == ERR_PARSE_ERROR);
+	CHECK(reader->get_error_message() == "Expected ','");
+	CHECK(reader->get_error_line() == 3);
+	// Errors are sticky.
+	CHECK(reader->read() == ERR_PARSE_ERROR);
+
+	reader->open_buffer(_to_buffer("[1] 2"));
+	CHECK(reader->read_value(value) == OK);
+	CHECK(reader->read() == ERR_PARSE_ERROR);
+	CHECK(reader->get_error_message() == "Expected 'EOF'");
+
+	reader->open_buffer(_to_buffer("{\"a\": nope}"));
+	CHECK(reader->read_value(value) == ERR_PARSE_ERROR);
+
+	reader->open_buffer(Vector<uint8_t>());
+	CHECK(reader->read() == ERR_PARSE_ERROR);
+}
+
+TEST_CASE("[JSON] Parse buffer") {
+	const String source = R"({"name": "Godot Engine", "is_free": true, "bugs": null, "apples": {"red": 500, "green": 0, "blue": -20.5e1}, "list": [1, "two", [3],]})";
+
+	JSON json_text;
+	CHECK(json_text.parse(source) == OK);
+
+	JSON json_buffer;
+	CHECK(json_buffer.parse_buffer(_to_buffer(source), true) == OK);
+	CHECK(json_buffer.get_error_line() == 0);
+	CHECK(JSON::stringify(json_buffer.get_data()) == JSON::stringify(json_text.get_data()));
+	CHECK(json_buffer.get_parsed_text() == source);
+
+	ERR_PRINT_OFF
+	CHECK(json_buffer.parse_buffer(_to_buffer("{\n\"a\": 1,\n\"b\" 2}")) == ERR_PARSE_ERROR);
+	CHECK(json_buffer.get_error_line() == 2);
+	CHECK(json_buffer.get_error_message() == "Expected ':'");
+	ERR_PRINT_ON
+}
+
+} // namespace TestJSONReader
@@ -34,6 +34,9 @@ TEST_FORCE_LINK(test_marshalls)
 
 #include "core/io/marshalls.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/variant/typed_array.h"
+#include "core/variant/variant_internal.h"
 
 namespace TestMarshalls {
 
@@ -490,4 +493,192 @@ TEST_CASE("[Marshalls] Typed dictionary decoding") {
 	CHECK(dictionary[Variant(uint64_t(0x0f123456789abcdef))] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+static Array _make_encoder_values() {
+	Array values;
+	values.push_back(Variant());
+	values.push_back(true);
+	values.push_back(42);
+	values.push_back(int64_t(0x0f123456789abcdef));
+	values.push_back(0.5);
+	values.push_back(0.1);
+	values.push_back(String::utf8("Ünïcødé 😀"));
+	values.push_back(StringName("name"));
+	values.push_back(NodePath("../a/b:c:d"));
+	values.push_back(Vector2(1, 2));
+	values.push_back(Vector3i(1, 2, 3));
+	values.push_back(Transform3D(Basis(Vector3(0, 1, 0), 0.5), Vector3(1, 2, 3)));
+	values.push_back(Projection());
+	values.push_back(Color(0.1, 0.2, 0.3, 0.4));
+	values.push_back(RID());
+	values.push_back(PackedByteArray({ 1, 2, 3, 4, 5 }));
+	values.push_back(PackedInt64Array({ 1, 2, 3 }));
+	values.push_back(PackedStringArray({ "a", "bc", String::utf8("défg") }));
+	values.push_back(PackedVector3Array({ Vector3(1, 2, 3), Vector3(4, 5, 6) }));
+	values.push_back(PackedColorArray({ Color(1, 0, 0) }));
+	Dictionary dict;
+	dict["key"] = Array({ 1, "two", Vector2(3, 4) });
+	dict[5] = Dictionary();
+	values.push_back(dict);
+	TypedArray<int> typed;
+	typed.push_back(7);
+	values.push_back(typed);
+	return values;
+}
+
+TEST_CASE("[Marshalls] VariantEncoder writes the same bytes as encode_variant") {
+	const Array values = _make_encoder_values();
+	VariantEncoder encoder;
+	Vector<uint8_t> expected;
+	for (const Variant &value : values) {
+		int len = 0;
+		REQUIRE(encode_variant(value, nullptr, len) == OK);
+		const int offset = expected.size();
+		expected.resize(offset + len);
+		REQUIRE(encode_variant(value, expected.ptrw() + offset, len) == OK);
+		CHECK(encoder.encode(value) == OK);
+	}
+	REQUIRE(encoder.get_size() == expected.size());
+	CHECK(memcmp(encoder.get_data(), expected.ptr(), expected.size()) == 0);
+
+	// The memory is kept between uses.
+	const uint8_t *data = encoder.get_data();
+	encoder.clear();
+	CHECK(encoder.get_size() == 0);
+	CHECK(encoder.encode(values[0]) == OK);
+	CHECK(encoder.get_data() == data);
+}
+
+TEST_CASE("[Marshalls] VariantEncoder max size") {
+	VariantEncoder encoder;
+
+	SUBCASE("Fails before allocating when the Variant is too big") {
+		PackedByteArray bytes;
+		bytes.resize(1024 * 1024);
+		CHECK(encoder.encode(bytes, false, 1024) == ERR_OUT_OF_MEMORY);
+		CHECK(encoder.get_size() == 0);
+		CHECK(encoder.get_data() == nullptr);
+	}
+
+	SUBCASE("Accepts a Variant that fits even when its size bound does not") {
+		// ASCII characters take a single byte, but up to four are reserved for each.
+		const String string = String("abc").repeat(100);
+		CHECK(encoder.encode(string, false, 400) == OK);
+		CHECK(encoder.get_size() == 8 + 300);
+		encoder.clear();
+		CHECK(encoder.encode(string, false, 300) == ERR_OUT_OF_MEMORY);
+		CHECK(encoder.get_size() == 0);
+	}
+}
+
+TEST_CASE("[Marshalls] VariantDecoder decoding") {
+	const Array values = _make_encoder_values();
+	VariantEncoder encoder;
+	for (const Variant &value : values) {
+		REQUIRE(encoder.encode(value) == OK);
+	}
+
+	SUBCASE("Decodes the same values as decode_variant") {
+		VariantDecoder decoder(encoder.get_data(), encoder.get_size());
+		for (const Variant &value : values) {
+			Variant decoded;
+			CHECK(decoder.decode(decoded) == OK);
+			CHECK(decoded == value);
+		}
+		CHECK(decoder.get_available_bytes() == 0);
+
+		Variant decoded;
+		ERR_PRINT_OFF;
+		CHECK(decoder.decode(decoded) == ERR_INVALID_DATA);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Reuses the containers and packed arrays it decodes into") {
+		encoder.clear();
+		REQUIRE(encoder.encode(Array({ PackedFloat32Array({ 1, 2, 3 }), 4 })) == OK);
+		REQUIRE(encoder.encode(Array({ PackedFloat32Array({ 5, 6, 7 }), 8 })) == OK);
+		VariantDecoder decoder(encoder.get_data(), encoder.get_size());
+
+		Variant decoded;
+		CHECK(decoder.decode(decoded) == OK);
+		const Array array = decoded;
+		const float *floats = VariantInternal::get_float32_array(&array[0])->ptr();
+
+		CHECK(decoder.decode(decoded) == OK);
+		CHECK(decoded == Variant(Array({ PackedFloat32Array({ 5, 6, 7 }), 8 })));
+		// The same array is updated in place.
+		CHECK(array == Array({ PackedFloat32Array({ 5, 6, 7 }), 8 }));
+		CHECK(VariantInternal::get_float32_array(&array[0])->ptr() == floats);
+	}
+
+	SUBCASE("Does not update typed or read-only containers in place") {
+		encoder.clear();
+		REQUIRE(encoder.encode(Array({ 1, 2 })) == OK);
+		VariantDecoder decoder(encoder.get_data(), encoder.get_size());
+
+		Array read_only = Array({ 3 });
+		read_only.make_read_only();
+		Variant decoded = read_only;
+		CHECK(decoder.decode(decoded) == OK);
+		CHECK(decoded == Variant(Array({ 1, 2 })));
+		CHECK(read_only == Array({ 3 }));
+	}
+
+	SUBCASE("Reads byte arrays without copying them") {
+		encoder.clear();
+		REQUIRE(encoder.encode(PackedByteArray({ 1, 2, 3, 4, 5 })) == OK);
+		REQUIRE(encoder.encode(6) == OK);
+		VariantDecoder decoder(encoder.get_data(), encoder.get_size());
+
+		Span<uint8_t> bytes;
+		CHECK(decoder.decode_bytes(bytes) == OK);
+		CHECK(bytes.size() == 5);
+		CHECK(bytes.ptr() == encoder.get_data() + 8);
+		CHECK(bytes[4] == 5);
+
+		Variant decoded;
+		CHECK(decoder.decode(decoded) == OK);
+		CHECK(decoded == Variant(6));
+		CHECK(decoder.get_available_bytes() == 0);
+	}
+}
+
+TEST_CASE_PENDING("[Marshalls][Benchmark] VariantEncoder compared to encode_variant") {
+	// A typical RPC or save file payload.
+	Array values;
+	for (int i = 0; i < 64; i++) {
+		Dictionary entry;
+		entry["name"] = vformat("Entity %d", i);
+		entry["position"] = Vector3(i, i * 2, i * 3);
+		entry["tags"] = PackedStringArray({ "enemy", "flying" });
+		entry["health"] = 100 - i;
+		values.push_back(entry);
+	}
+	const int iterations = 2000;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		int len = 0;
+		encode_variant(values, nullptr, len);
+		Vector<uint8_t> buffer;
+		buffer.resize(len);
+		encode_variant(values, buffer.ptrw(), len);
+		Variant decoded;
+		decode_variant(decoded, buffer.ptr(), len);
+	}
+	const uint64_t two_pass_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	VariantEncoder encoder;
+	Variant decoded;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		encoder.clear();
+		encoder.encode(values);
+		VariantDecoder decoder(encoder.get_data(), encoder.get_size());
+		decoder.decode(decoded);
+	}
+	const uint64_t single_pass_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("encode_variant and decode_variant: %d usec, VariantEncoder and VariantDecoder: %d usec.", two_pass_usec, single_pass_usec));
+}
+
 } // namespace TestMarshalls
@@ -33,6 +33,7 @@
 TEST_FORCE_LINK(test_pck_packer)
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
 #include "core/os/os.h"
 #include "tests/test_utils.h"
@@ -120,4 +121,72 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			"The generated non-empty PCK file shouldn't be too large.");
 }
 
+TEST_CASE("[PCKPacker] Read the files of a loaded PCK file") {
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_read.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+
+	Vector<uint8_t> large_data;
+	large_data.resize(100000);
+	for (int i = 0; i < large_data.size(); i++) {
+		large_data.write[i] = (i * 7) % 251;
+	}
+	const Vector<uint8_t> small_data = String("Hello world!").to_utf8_buffer();
+	REQUIRE(pck_packer.add_file_from_buffer("test_pck_read/large.bin", large_data) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("test_pck_read/small.txt", small_data) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, false, 0) == OK);
+
+	Ref<FileAccess> large = FileAccess::open("res://test_pck_read/large.bin", FileAccess::READ);
+	Ref<FileAccess> small = FileAccess::open("res://test_pck_read/small.txt", FileAccess::READ);
+	REQUIRE(large.is_valid());
+	REQUIRE(small.is_valid());
+	CHECK(large->get_length() == uint64_t(large_data.size()));
+	CHECK(small->get_length() == uint64_t(small_data.size()));
+
+	// Files opened from the same pack keep their own position.
+	large->seek(1000);
+	CHECK(small->get_as_utf8_string() == "Hello world!");
+	CHECK(large->get_8() == large_data[1000]);
+	CHECK(large->get_buffer(large_data.size()) == large_data.slice(1001));
+	CHECK(large->eof_reached());
+
+	large->seek(40000);
+	large->set_big_endian(true);
+	const uint32_t expected = (uint32_t(large_data[40000]) << 24) | (uint32_t(large_data[40001]) << 16) | (uint32_t(large_data[40002]) << 8) | uint32_t(large_data[40003]);
+	CHECK(large->get_32() == expected);
+	CHECK(large->get_position() == 40004);
+
+	// The content is only accessible directly when the platform maps the pack in memory, but ranges out of the file never are.
+	const uint8_t *mapped = large->get_mapped_range(0, large_data.size());
+	if (mapped) {
+		CHECK(memcmp(mapped, large_data.ptr(), large_data.size()) == 0);
+		CHECK(large->get_mapped_range(99990, 10) == mapped + 99990);
+	}
+	CHECK(large->get_mapped_range(99990, 11) == nullptr);
+	CHECK(small->get_mapped_range(0, small_data.size() + 1) == nullptr);
+
+	large->close();
+	small->close();
+
+	// Unload the files so that other tests don't see them. The pack stays mapped, but nothing reads from it anymore.
+	PackedData::get_singleton()->remove_path("res://test_pck_read/large.bin");
+	PackedData::get_singleton()->remove_path("res://test_pck_read/small.txt");
+
+	// Ranges of a mapped file that was truncated since are no longer accessible.
+	Ref<FileAccess> pack = FileAccess::open(output_pck_path, FileAccess::READ);
+	REQUIRE(pack.is_valid());
+	const uint64_t pack_length = pack->get_length();
+	if (pack->map_to_memory() == OK) {
+		REQUIRE(pack->get_mapped_range(0, pack_length) != nullptr);
+		Ref<FileAccess> truncated = FileAccess::open(output_pck_path, FileAccess::WRITE);
+		REQUIRE(truncated.is_valid());
+		truncated->store_buffer(small_data);
+		truncated->close();
+		CHECK(pack->get_mapped_range(0, pack_length) == nullptr);
+		CHECK(pack->get_mapped_range(0, small_data.size()) != nullptr);
+	}
+}
+
 } // namespace TestPCKPacker
@@ -33,6 +33,8 @@
 TEST_FORCE_LINK(test_astar)
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
+#include "core/math/geometry_3d.h"
 
 namespace TestAStar {
 
@@ -234,4 +236,159 @@ TEST_CASE("[AStar3D] Path from disabled point is empty") {
 	CHECK(a.get_point_path(1, 2).is_empty());
 }
 
+TEST_CASE("[AStar3D] Closest point and segment queries match brute force") {
+	AStar3D a;
+	Math::seed(1);
+
+	const int point_count = 64;
+	for (int i = 0; i < point_count; i++) {
+		// Integer coordinates, so that distance ties actually happen.
+		a.add_point(i, Vector3(Math::rand() % 8, Math::rand() % 8, Math::rand() % 2));
+	}
+	for (int i = 0; i < point_count * 2; i++) {
+		int u = Math::rand() % point_count;
+		int v = Math::rand() % point_count;
+		if (u != v) {
+			a.connect_points(u, v, Math::rand() % 2 == 1);
+		}
+	}
+
+	for (int i = 0; i < 500; i++) {
+		// Mutate the graph, so the spatial indices have to keep up.
+		int u = Math::rand() % point_count;
+		int v = Math::rand() % point_count;
+		switch (Math::rand() % 4) {
+			case 0: {
+				if (a.has_point(u)) {
+					a.set_point_position(u, Vector3(Math::rand() % 8, Math::rand() % 8, Math::rand() % 2));
+				}
+			} break;
+			case 1: {
+				if (a.has_point(u)) {
+					a.set_point_disabled(u, !a.is_point_disabled(u));
+				}
+			} break;
+			case 2: {
+				if (a.has_point(u)) {
+					a.remove_point(u);
+				} else {
+					a.add_point(u, Vector3(Math::rand() % 8, Math::rand() % 8, Math::rand() % 2));
+				}
+			} break;
+			case 3: {
+				if (u != v && a.has_point(u) && a.has_point(v)) {
+					if (Math::rand() % 2 == 1) {
+						a.connect_points(u, v, Math::rand() % 2 == 1);
+					} else {
+						a.disconnect_points(u, v, Math::rand() % 2 == 1);
+					}
+				}
+			} break;
+		}
+
+		Vector3 query(Math::randf() * 8, Math::randf() * 8, Math::randf() * 2);
+		bool include_disabled = Math::rand() % 2 == 1;
+
+		int64_t expected_id = -1;
+		real_t expected_dist = 1e20;
+		real_t expected_segment_dist = 1e20;
+		for (int j = 0; j < point_count; j++) {
+			if (!a.has_point(j)) {
+				continue;
+			}
+			if (include_disabled || !a.is_point_disabled(j)) {
+				real_t d = query.distance_squared_to(a.get_point_position(j));
+				if (d < expected_dist) {
+					expected_dist = d;
+					expected_id = j;
+				}
+			}
+			for (int k = j + 1; k < point_count; k++) {
+				if (!a.has_point(k) || a.is_point_disabled(j) || a.is_point_disabled(k) || !a.are_points_connected(j, k)) {
+					continue;
+				}
+				Vector3 p = Geometry3D::get_closest_point_to_segment(query, a.get_point_position(j), a.get_point_position(k));
+				expected_segment_dist = MIN(expected_segment_dist, query.distance_squared_to(p));
+			}
+		}
+
+		CHECK(a.get_closest_point(query, include_disabled) == expected_id);
+		if (expected_segment_dist < 1e20) {
+			CHECK(query.distance_squared_to(a.get_closest_position_in_segment(query)) == doctest::Approx(expected_segment_dist));
+		}
+	}
+}
+
+TEST_CASE("[AStar3D] Batched id paths match single queries") {
+	AStar3D a;
+	Math::seed(2);
+
+	const int point_count = 200;
+	for (int i = 0; i < point_count; i++) {
+		a.add_point(i, Vector3(Math::randf() * 100, Math::randf() * 100, 0));
+	}
+	for (int i = 0; i < point_count * 3; i++) {
+		int u = Math::rand() % point_count;
+		int v = Math::rand() % point_count;
+		if (u != v) {
+			a.connect_points(u, v, Math::rand() % 4 != 0);
+		}
+	}
+	for (int i = 0; i < 10; i++) {
+		a.set_point_disabled(Math::rand() % point_count);
+	}
+
+	PackedInt64Array from_ids;
+	PackedInt64Array to_ids;
+	for (int i = 0; i < 64; i++) {
+		from_ids.push_back(Math::rand() % point_count);
+		to_ids.push_back(Math::rand() % point_count);
+	}
+
+	for (bool allow_partial_path : { false, true }) {
+		TypedArray<PackedInt64Array> paths = a.get_id_paths(from_ids, to_ids, allow_partial_path);
+		REQUIRE(paths.size() == from_ids.size());
+		for (int i = 0; i < from_ids.size(); i++) {
+			CHECK(PackedInt64Array(paths[i]) == a.get_id_path(from_ids[i], to_ids[i], allow_partial_path));
+		}
+	}
+
+	ERR_PRINT_OFF;
+	CHECK(a.get_id_paths(from_ids, PackedInt64Array()).is_empty());
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[AStarGrid2D] Batched id paths match single queries") {
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_region(Rect2i(-4, -2, 40, 30));
+	grid->update();
+	Math::seed(3);
+	for (int i = 0; i < 250; i++) {
+		grid->set_point_solid(Vector2i(Math::rand() % 40 - 4, Math::rand() % 30 - 2));
+	}
+
+	TypedArray<Vector2i> from_ids;
+	TypedArray<Vector2i> to_ids;
+	for (int i = 0; i < 64; i++) {
+		from_ids.push_back(Vector2i(Math::rand() % 40 - 4, Math::rand() % 30 - 2));
+		to_ids.push_back(Vector2i(Math::rand() % 40 - 4, Math::rand() % 30 - 2));
+	}
+
+	for (bool jumping_enabled : { false, true }) {
+		grid->set_jumping_enabled(jumping_enabled);
+		for (bool allow_partial_path : { false, true }) {
+			TypedArray<Array> paths = grid->get_id_paths(from_ids, to_ids, allow_partial_path);
+			REQUIRE(paths.size() == from_ids.size());
+			for (int i = 0; i < from_ids.size(); i++) {
+				CHECK(Array(paths[i]) == Array(grid->get_id_path(from_ids[i], to_ids[i], allow_partial_path)));
+			}
+		}
+	}
+
+	ERR_PRINT_OFF;
+	CHECK(grid->get_id_paths(from_ids, TypedArray<Vector2i>()).is_empty());
+	ERR_PRINT_ON;
+}
+
 } // namespace TestAStar
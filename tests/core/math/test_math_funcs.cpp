@@ -91,6 +91,14 @@ TEST_CASE("[Math] Power of two functions") {
 	static_assert(Math::nearest_shift((uint32_t)65535) == 16);
 }
 
+TEST_CASE("[Math] count_set_bits") {
+	static_assert(Math::count_set_bits(0) == 0);
+	static_assert(Math::count_set_bits(1) == 1);
+	static_assert(Math::count_set_bits(0xf0f0) == 8);
+	static_assert(Math::count_set_bits(uint64_t(1) << 63) == 1);
+	static_assert(Math::count_set_bits(UINT64_MAX) == 64);
+}
+
 TEST_CASE_TEMPLATE("[Math] abs", T, int, float, double) {
 	static_assert(Math::abs((T)-1) == (T)1);
 	static_assert(Math::abs((T)0) == (T)0);
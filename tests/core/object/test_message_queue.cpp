@@ -0,0 +1,227 @@
+/**************************************************************************/
+/*  test_message_queue.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_message_queue)
+
+#include "core/object/callable_mp.h"
+#include "core/object/message_queue.h"
+#include "core/os/thread.h"
+
+namespace TestMessageQueue {
+
+class _TestCallQueueRecorder : public Object {
+public:
+	LocalVector<Vector2i> calls;
+
+	void record(int p_thread, int p_index) {
+		calls.push_back(Vector2i(p_thread, p_index));
+	}
+};
+
+TEST_CASE("[CallQueue] Flush calls in order and count them") {
+	CallQueue queue;
+	_TestCallQueueRecorder *recorder = memnew(_TestCallQueueRecorder);
+
+	CHECK_FALSE(queue.has_messages());
+	for (int i = 0; i < 100; i++) {
+		queue.push_callable(callable_mp(recorder, &_TestCallQueueRecorder::record), 0, i);
+	}
+	CHECK(queue.has_messages());
+
+	CHECK(queue.flush() == OK);
+	CHECK_FALSE(queue.has_messages());
+	REQUIRE(recorder->calls.size() == 100);
+	bool in_order = true;
+	for (uint32_t i = 0; i < recorder->calls.size(); i++) {
+		in_order &= recorder->calls[i].y == int(i);
+	}
+	CHECK(in_order);
+
+	CHECK_MESSAGE(queue.get_frame_flushed_messages() == 0, "Statistics should only be published once per frame.");
+	queue.update_frame_statistics();
+	CHECK(queue.get_frame_flushed_messages() == 100);
+	CHECK(queue.get_frame_flushed_bytes() >= 100 * 3 * sizeof(Variant));
+	queue.update_frame_statistics();
+	CHECK(queue.get_frame_flushed_messages() == 0);
+	CHECK(queue.get_frame_flushed_bytes() == 0);
+
+	memdelete(recorder);
+}
+
+struct ThreadPushData {
+	CallQueue *queue = nullptr;
+	_TestCallQueueRecorder *recorder = nullptr;
+	int thread = 0;
+	int count = 0;
+};
+
+static void push_from_thread(void *p_userdata) {
+	ThreadPushData *data = static_cast<ThreadPushData *>(p_userdata);
+	for (int i = 0; i < data->count; i++) {
+		data->queue->push_callable(callable_mp(data->recorder, &_TestCallQueueRecorder::record), data->thread, i);
+	}
+}
+
+TEST_CASE("[CallQueue] Thread buffers keep the order of each thread") {
+	const int thread_count = 4;
+	// Enough to span several pages per thread.
+	const int call_count = 1000;
+
+	CallQueue queue;
+	queue.set_thread_buffers_enabled(true);
+	_TestCallQueueRecorder *recorder = memnew(_TestCallQueueRecorder);
+
+	// Calls from the flushing thread go to the queue directly.
+	queue.push_callable(callable_mp(recorder, &_TestCallQueueRecorder::record), thread_count, 0);
+
+	ThreadPushData data[thread_count];
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		data[i].queue = &queue;
+		data[i].recorder = recorder;
+		data[i].thread = i;
+		data[i].count = call_count;
+		threads[i].start(push_from_thread, &data[i]);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	CHECK(queue.has_messages());
+	CHECK(queue.flush() == OK);
+	CHECK_FALSE(queue.has_messages());
+
+	REQUIRE(recorder->calls.size() == thread_count * call_count + 1);
+	int next_index[thread_count + 1] = {};
+	bool in_order = true;
+	for (const Vector2i &call : recorder->calls) {
+		in_order &= call.y == next_index[call.x];
+		next_index[call.x]++;
+	}
+	CHECK(in_order);
+
+	queue.update_frame_statistics();
+	CHECK(queue.get_frame_flushed_messages() == thread_count * call_count + 1);
+
+	// Buffers are reused after being merged.
+	recorder->calls.clear();
+	threads[0].start(push_from_thread, &data[0]);
+	threads[0].wait_to_finish();
+	CHECK(queue.flush() == OK);
+	CHECK(recorder->calls.size() == call_count);
+
+	memdelete(recorder);
+}
+
+static void push_until_out_of_memory(void *p_userdata) {
+	ThreadPushData *data = static_cast<ThreadPushData *>(p_userdata);
+	for (int i = 0; i < data->count; i++) {
+		if (data->queue->push_callable(callable_mp(data->recorder, &_TestCallQueueRecorder::record), data->thread, i) != OK) {
+			break;
+		}
+	}
+}
+
+TEST_CASE("[CallQueue] Thread buffers of threads that stopped sending messages are recycled") {
+	const int thread_count = 4;
+	const int call_count = 1000;
+
+	CallQueue queue;
+	queue.set_thread_buffers_enabled(true);
+	_TestCallQueueRecorder *recorder = memnew(_TestCallQueueRecorder);
+
+	ThreadPushData data[thread_count];
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		data[i].queue = &queue;
+		data[i].recorder = recorder;
+		data[i].thread = i;
+		data[i].count = call_count;
+		threads[i].start(push_from_thread, &data[i]);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+	CHECK(queue.flush() == OK);
+	const int busy_usage = queue.get_max_buffer_usage();
+
+	// Nothing was sent since the previous flush, so the thread buffers let go of their pages.
+	CHECK(queue.flush() == OK);
+	const int idle_usage = queue.get_max_buffer_usage();
+	CHECK(idle_usage < busy_usage);
+
+	// New threads take over the idle buffers instead of adding their own.
+	recorder->calls.clear();
+	for (int round = 0; round < 16; round++) {
+		data[0].count = 10;
+		threads[0].start(push_from_thread, &data[0]);
+		threads[0].wait_to_finish();
+		CHECK(queue.flush() == OK);
+		CHECK(queue.flush() == OK);
+	}
+	CHECK(recorder->calls.size() == 16 * 10);
+	CHECK(queue.get_max_buffer_usage() == idle_usage);
+
+	memdelete(recorder);
+}
+
+TEST_CASE("[CallQueue] Thread buffers share the page budget of their queue") {
+	const int thread_count = 4;
+	const uint32_t max_pages = 8;
+
+	CallQueue queue(nullptr, max_pages);
+	queue.set_thread_buffers_enabled(true);
+	_TestCallQueueRecorder *recorder = memnew(_TestCallQueueRecorder);
+
+	ThreadPushData data[thread_count];
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		data[i].queue = &queue;
+		data[i].recorder = recorder;
+		data[i].thread = i;
+		data[i].count = 100000;
+		threads[i].start(push_until_out_of_memory, &data[i]);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+	CHECK(queue.flush() == OK);
+
+	// Each call takes at least the room of its two arguments.
+	const uint32_t max_calls_per_page = CallQueue::PAGE_SIZE_BYTES / (2 * sizeof(Variant));
+	CHECK(recorder->calls.size() > 0);
+	CHECK(recorder->calls.size() <= max_pages * max_calls_per_page);
+
+	memdelete(recorder);
+}
+
+} // namespace TestMessageQueue
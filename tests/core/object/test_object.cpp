@@ -57,6 +57,29 @@ public:
 	int get_property() const { return property_value; }
 };
 
+class _TestCallpOverrideObject : public Object {
+	GDCLASS(_TestCallpOverrideObject, Object);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("free_self"), &_TestCallpOverrideObject::free_self);
+	}
+
+public:
+	void free_self() {
+		Callable::CallError call_error;
+		Object::callp(CoreStringName(free_), nullptr, 0, call_error);
+	}
+
+	Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) override {
+		return Object::callp(p_method, p_args, p_argcount, r_error);
+	}
+};
+
+class _TestCallpOverrideDerivedObject : public _TestCallpOverrideObject {
+	GDCLASS(_TestCallpOverrideDerivedObject, _TestCallpOverrideObject);
+};
+
 class _MockScriptInstance : public ScriptInstance {
 	StringName property_name = "NO_NAME";
 	Variant property_value;
@@ -653,6 +676,35 @@ TEST_CASE("[Object] Destruction at the end of the call chain is safe") {
 			"Object was tail-deleted without crashes.");
 }
 
+TEST_CASE("[Object] Types know whether callp() is overridden") {
+	CHECK_FALSE(Object::get_gdtype_static().is_callp_overridden());
+	CHECK_FALSE(_TestDerivedObject::get_gdtype_static().is_callp_overridden());
+	CHECK(_TestCallpOverrideObject::get_gdtype_static().is_callp_overridden());
+	CHECK_MESSAGE(
+			_TestCallpOverrideDerivedObject::get_gdtype_static().is_callp_overridden(),
+			"The override should be inherited.");
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Object] Calling a resolved method locks the object") {
+	_TestCallpOverrideObject *object = memnew(_TestCallpOverrideObject);
+	ObjectID obj_id = object->get_instance_id();
+	MethodBind *method = ClassDB::get_method(_TestCallpOverrideObject::get_class_static(), "free_self");
+	REQUIRE(method);
+
+	Callable::CallError call_error;
+	ERR_PRINT_OFF;
+	object->callp_method_bind(method, nullptr, 0, call_error);
+	ERR_PRINT_ON;
+	CHECK(call_error.error == Callable::CallError::CALL_OK);
+	CHECK_MESSAGE(
+			ObjectDB::get_instance(obj_id) == object,
+			"The object can't be freed while one of its methods runs.");
+
+	memdelete(object);
+}
+#endif // DEBUG_ENABLED
+
 int required_param_compare(const Ref<RefCounted> &p_ref, const RequiredParam<RefCounted> &rp_required) {
 	EXTRACT_PARAM_OR_FAIL_V(p_required, rp_required, false);
 	ERR_FAIL_COND_V(p_ref->get_reference_count() != p_required->get_reference_count(), -1);
@@ -173,4 +173,230 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static SafeNumeric<int> sequence;
+
+static void static_sequenced_task(void *p_arg) {
+	// Record the order in which tasks ran.
+	*((int *)p_arg) = sequence.increment();
+}
+
+static void static_sequenced_group_task(void *p_arg, uint32_t p_index) {
+	((int *)p_arg)[p_index] = sequence.increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Run tasks and group tasks after their dependencies") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	for (int iterations = 0; iterations < 50; iterations++) {
+		sequence.set(0);
+		const bool low_priority = Math::rand() % 2;
+
+		int first = 0;
+		int second = 0;
+		int group_order[8] = {};
+		int last = 0;
+
+		WorkerThreadPool::TaskID first_id = pool->add_native_task(static_sequenced_task, &first, !low_priority);
+		const LocalVector<WorkerThreadPool::TaskID> after_first = { first_id };
+		WorkerThreadPool::TaskID second_id = pool->add_native_task_after(static_sequenced_task, &second, after_first, !low_priority);
+		const LocalVector<WorkerThreadPool::TaskID> after_second = { second_id };
+		WorkerThreadPool::GroupID group_id = pool->add_native_group_task_after(static_sequenced_group_task, group_order, 8, after_second, -1, low_priority);
+		const LocalVector<WorkerThreadPool::TaskID> after_all = { first_id, group_id };
+		WorkerThreadPool::TaskID last_id = pool->add_native_task_after(static_sequenced_task, &last, after_all, !low_priority);
+
+		pool->wait_for_task_completion(last_id);
+		pool->wait_for_group_task_completion(group_id);
+		pool->wait_for_task_completion(second_id);
+		pool->wait_for_task_completion(first_id);
+
+		CHECK(first == 1);
+		CHECK(second == 2);
+		bool group_in_order = true;
+		for (int i = 0; i < 8; i++) {
+			group_in_order &= group_order[i] > 2 && group_order[i] < 11;
+		}
+		CHECK(group_in_order);
+		CHECK(last == 11);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Dependencies that already completed or are invalid") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	sequence.set(0);
+
+	int first = 0;
+	int second = 0;
+	WorkerThreadPool::TaskID first_id = pool->add_native_task(static_sequenced_task, &first, true);
+	while (!pool->is_task_completed(first_id)) {
+		OS::get_singleton()->delay_usec(1);
+	}
+	const LocalVector<WorkerThreadPool::TaskID> after_first = { first_id };
+	WorkerThreadPool::TaskID second_id = pool->add_native_task_after(static_sequenced_task, &second, after_first, true);
+	pool->wait_for_task_completion(second_id);
+	pool->wait_for_task_completion(first_id);
+	CHECK(second == 2);
+
+	// Tasks that were already waited for are gone, so they can't be depended on.
+	const LocalVector<WorkerThreadPool::TaskID> deps = { second_id };
+	ERR_PRINT_OFF;
+	CHECK(pool->add_native_task_after(static_sequenced_task, &second, deps) == WorkerThreadPool::INVALID_TASK_ID);
+	CHECK(pool->add_native_group_task_after(static_sequenced_group_task, nullptr, 0, deps) == WorkerThreadPool::INVALID_TASK_ID);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[WorkerThreadPool] Empty groups wait for their dependencies") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	sequence.set(0);
+	exit.clear();
+
+	int last = 0;
+	WorkerThreadPool::TaskID busy_id = pool->add_native_task(static_busy_task, nullptr, true);
+	const LocalVector<WorkerThreadPool::TaskID> after_busy = { busy_id };
+	WorkerThreadPool::GroupID group_id = pool->add_native_group_task_after(static_sequenced_group_task, nullptr, 0, after_busy);
+	const LocalVector<WorkerThreadPool::TaskID> after_group = { group_id };
+	WorkerThreadPool::TaskID last_id = pool->add_native_task_after(static_sequenced_task, &last, after_group, true);
+
+	OS::get_singleton()->delay_usec(1000);
+	CHECK_FALSE(pool->is_group_task_completed(group_id));
+	CHECK_FALSE(pool->is_task_completed(last_id));
+
+	exit.set();
+	pool->wait_for_task_completion(last_id);
+	pool->wait_for_group_task_completion(group_id);
+	pool->wait_for_task_completion(busy_id);
+	CHECK(last == 1);
+}
+
+struct FanOutData {
+	WorkerThreadPool *pool = nullptr;
+	int children = 0;
+};
+
+static void static_fan_out_leaf(void *p_arg) {
+	counter[0].increment();
+}
+
+static void static_fan_out_root(void *p_arg) {
+	// Tasks posted from a pool thread land in that thread's deque and may be stolen by the others.
+	FanOutData *data = (FanOutData *)p_arg;
+	LocalVector<WorkerThreadPool::TaskID> children;
+	children.resize(data->children);
+	for (int i = 0; i < data->children; i++) {
+		children[i] = data->pool->add_native_task(static_fan_out_leaf, nullptr, true);
+	}
+	for (int i = 0; i < data->children; i++) {
+		data->pool->wait_for_task_completion(children[i]);
+	}
+	counter[1].increment();
+}
+
+static void run_fan_out(FanOutData &p_data, int p_roots) {
+	LocalVector<WorkerThreadPool::TaskID> roots;
+	roots.resize(p_roots);
+	for (int i = 0; i < p_roots; i++) {
+		roots[i] = p_data.pool->add_native_task(static_fan_out_root, &p_data, true);
+	}
+	for (int i = 0; i < p_roots; i++) {
+		p_data.pool->wait_for_task_completion(roots[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Process tasks posted from within other tasks") {
+	for (int iterations = 0; iterations < 50; iterations++) {
+		// More children than fit in a deque, so some spill over to the shared queue.
+		const int roots = Math::pow(2.0f, Math::random(0.0f, 4.0f));
+		const int children = Math::pow(2.0f, Math::random(0.0f, 9.0f));
+
+		counter.clear();
+		counter.resize(2);
+
+		FanOutData data;
+		data.pool = WorkerThreadPool::get_singleton();
+		data.children = children;
+		run_fan_out(data, roots);
+
+		CHECK(counter[0].get() == roots * children);
+		CHECK(counter[1].get() == roots);
+	}
+}
+
+struct StarvationData {
+	WorkerThreadPool *pool = nullptr;
+	SafeFlag first_child_ran;
+	bool first_child_ran_while_busy = false;
+};
+
+static void static_starvation_first_child(void *p_arg) {
+	((StarvationData *)p_arg)->first_child_ran.set();
+}
+
+static void static_starvation_child(void *p_arg) {
+}
+
+static void static_starvation_root(void *p_arg) {
+	StarvationData *data = (StarvationData *)p_arg;
+	WorkerThreadPool::TaskID children[16];
+	children[0] = data->pool->add_native_task(static_starvation_first_child, data, true);
+	for (int i = 1; i < 16; i++) {
+		children[i] = data->pool->add_native_task(static_starvation_child, data, true);
+	}
+
+	// Keep this thread busy without waiting collaboratively, so the children posted to its deque
+	// can only make progress if other threads steal them.
+	const uint64_t begin = OS::get_singleton()->get_ticks_msec();
+	while (!data->first_child_ran.is_set() && OS::get_singleton()->get_ticks_msec() - begin < 5000) {
+		OS::get_singleton()->delay_usec(100);
+	}
+	data->first_child_ran_while_busy = data->first_child_ran.is_set();
+
+	for (int i = 0; i < 16; i++) {
+		data->pool->wait_for_task_completion(children[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Tasks posted from within a busy task are not starved") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pool->get_thread_count() < 2) {
+		return;
+	}
+
+	for (int iterations = 0; iterations < 20; iterations++) {
+		StarvationData data;
+		data.pool = pool;
+		WorkerThreadPool::TaskID root = pool->add_native_task(static_starvation_root, &data, true);
+		pool->wait_for_task_completion(root);
+
+		CHECK(data.first_child_ran_while_busy);
+	}
+}
+
+TEST_CASE_PENDING("[WorkerThreadPool] Benchmark task throughput by thread count") {
+	const int roots = 64;
+	const int children = 256;
+	const int max_threads = OS::get_singleton()->get_default_thread_pool_size();
+
+	for (int thread_count = 1; thread_count <= max_threads; thread_count = thread_count < max_threads ? MIN(thread_count * 2, max_threads) : thread_count + 1) {
+		WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+		pool->init(thread_count);
+
+		counter.clear();
+		counter.resize(2);
+
+		FanOutData data;
+		data.pool = pool;
+		data.children = children;
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		run_fan_out(data, roots);
+		const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+
+		const int task_count = roots * (children + 1);
+		CHECK(counter[0].get() == roots * children);
+		MESSAGE(vformat("%d threads: %d tasks in %d usec, %d tasks/sec.", thread_count, task_count, elapsed, (int64_t)(task_count * 1000000.0 / elapsed)));
+
+		pool->finish();
+		memdelete(pool);
+	}
+}
+
 } // namespace TestWorkerThreadPool
@@ -32,6 +32,7 @@
 
 TEST_FORCE_LINK(test_animation)
 
+#include "core/math/random_pcg.h"
 #include "scene/resources/animation.h"
 
 namespace TestAnimation {
@@ -308,4 +309,68 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+TEST_CASE("[Animation] Key cursors give the same results as searching the keys") {
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(4.0);
+	const int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+	const int rotation_track = animation->add_track(Animation::TYPE_ROTATION_3D);
+	RandomPCG rng(42);
+	double time = -0.1;
+	for (int i = 0; i < 40; i++) {
+		animation->position_track_insert_key(position_track, time, Vector3(rng.randf(), rng.randf(), rng.randf()));
+		animation->rotation_track_insert_key(rotation_track, time, Quaternion::from_euler(Vector3(rng.randf(), rng.randf(), rng.randf())));
+		// Includes a key past the end of the animation.
+		time += rng.random(0.01, 0.2);
+	}
+	animation->track_set_interpolation_type(rotation_track, Animation::INTERPOLATION_CUBIC);
+
+	SUBCASE("No loop") {
+		animation->set_loop_mode(Animation::LOOP_NONE);
+	}
+	SUBCASE("Linear loop") {
+		animation->set_loop_mode(Animation::LOOP_LINEAR);
+	}
+	SUBCASE("Ping-pong loop") {
+		animation->set_loop_mode(Animation::LOOP_PINGPONG);
+	}
+
+	// Playing forward, backward, then seeking to random times and to the keys. The cursors start out of range.
+	LocalVector<double> times;
+	LocalVector<bool> backwards;
+	for (double t = -0.2; t < 4.2; t += 1.0 / 60.0) {
+		times.push_back(t);
+		backwards.push_back(false);
+	}
+	for (double t = 4.2; t > -0.2; t -= 1.0 / 60.0) {
+		times.push_back(t);
+		backwards.push_back(true);
+	}
+	for (int i = 0; i < 200; i++) {
+		times.push_back(rng.random(-0.5, 4.5));
+		backwards.push_back(rng.randf() < 0.5f);
+	}
+	for (int i = 0; i < animation->track_get_key_count(position_track); i++) {
+		times.push_back(animation->track_get_key_time(position_track, i));
+		backwards.push_back(i % 2 == 0);
+	}
+
+	int32_t position_cursor = 1000;
+	int32_t rotation_cursor = -5;
+	int mismatch_count = 0;
+	for (uint32_t i = 0; i < times.size(); i++) {
+		Vector3 position;
+		Vector3 position_from_cursor;
+		CHECK(animation->try_position_track_interpolate(position_track, times[i], &position, backwards[i]) == OK);
+		CHECK(animation->try_position_track_interpolate(position_track, times[i], &position_from_cursor, backwards[i], &position_cursor) == OK);
+		mismatch_count += position != position_from_cursor ? 1 : 0;
+
+		Quaternion rotation;
+		Quaternion rotation_from_cursor;
+		CHECK(animation->try_rotation_track_interpolate(rotation_track, times[i], &rotation, backwards[i]) == OK);
+		CHECK(animation->try_rotation_track_interpolate(rotation_track, times[i], &rotation_from_cursor, backwards[i], &rotation_cursor) == OK);
+		mismatch_count += rotation != rotation_from_cursor ? 1 : 0;
+	}
+	CHECK_MESSAGE(mismatch_count == 0, "Interpolating with key cursors should give the same results.");
+}
+
 } // namespace TestAnimation
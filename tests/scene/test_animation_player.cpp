@@ -32,9 +32,16 @@
 
 TEST_FORCE_LINK(test_animation_player)
 
+#include "core/os/os.h"
 #include "scene/animation/animation_player.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
 #include "scene/resources/animation.h"
 
+#ifndef _3D_DISABLED
+#include "scene/3d/skeleton_3d.h"
+#endif // _3D_DISABLED
+
 namespace TestAnimationPlayer {
 
 TEST_CASE("[AnimationPlayer] get & set default_blend_time") {
@@ -62,4 +69,107 @@ TEST_CASE("[AnimationPlayer] get & set blend_time") {
 	memdelete(animation_player);
 }
 
+#ifndef _3D_DISABLED
+
+TEST_CASE_PENDING("[SceneTree][AnimationPlayer][Benchmark] Updating a character with 300 bones and 100 tracks") {
+	const int bone_count = 300;
+	const int track_count = 100;
+	const int update_count = 600;
+	const double frame_time = 1.0 / 60.0;
+
+	Node *character = memnew(Node);
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	skeleton->set_name("Skeleton3D");
+	for (int i = 0; i < bone_count; i++) {
+		skeleton->add_bone(vformat("bone_%d", i));
+		if (i > 0) {
+			skeleton->set_bone_parent(i, (i - 1) / 2);
+		}
+	}
+	character->add_child(skeleton);
+
+	// Keys at 30 FPS on 10 seconds, on rotation tracks for most of the animated bones, like motion capture data.
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(10.0);
+	animation->set_loop_mode(Animation::LOOP_LINEAR);
+	for (int i = 0; i < track_count; i++) {
+		const Animation::TrackType type = i % 5 == 0 ? Animation::TYPE_POSITION_3D : (i % 5 == 1 ? Animation::TYPE_SCALE_3D : Animation::TYPE_ROTATION_3D);
+		const int track = animation->add_track(type);
+		animation->track_set_path(track, NodePath(vformat("Skeleton3D:bone_%d", i * bone_count / track_count)));
+		for (int j = 0; j <= 300; j++) {
+			const double time = j / 30.0;
+			if (type == Animation::TYPE_POSITION_3D) {
+				animation->position_track_insert_key(track, time, Vector3(Math::sin(time + i), Math::cos(time), 0.0));
+			} else if (type == Animation::TYPE_SCALE_3D) {
+				animation->scale_track_insert_key(track, time, Vector3(1, 1, 1) * (1.0 + 0.1 * Math::sin(time)));
+			} else {
+				animation->rotation_track_insert_key(track, time, Quaternion(Vector3(0, 1, 0), Math::sin(time + i)));
+			}
+		}
+	}
+	Ref<AnimationLibrary> animation_library = memnew(AnimationLibrary);
+	animation_library->add_animation("walk", animation);
+
+	AnimationPlayer *animation_player = memnew(AnimationPlayer);
+	animation_player->set_callback_mode_process(AnimationMixer::ANIMATION_CALLBACK_MODE_PROCESS_MANUAL);
+	animation_player->add_animation_library("", animation_library);
+	character->add_child(animation_player);
+	SceneTree::get_singleton()->get_root()->add_child(character);
+
+	animation_player->play("walk");
+	animation_player->advance(0.0);
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < update_count; i++) {
+		animation_player->advance(frame_time);
+	}
+	const uint64_t mixer_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	// The same lookups as the mixer, with and without key cursors.
+	Vector3 position;
+	Quaternion rotation;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < update_count; i++) {
+		for (int j = 0; j < track_count; j++) {
+			switch (animation->track_get_type(j)) {
+				case Animation::TYPE_POSITION_3D: {
+					animation->try_position_track_interpolate(j, i * frame_time, &position);
+				} break;
+				case Animation::TYPE_SCALE_3D: {
+					animation->try_scale_track_interpolate(j, i * frame_time, &position);
+				} break;
+				default: {
+					animation->try_rotation_track_interpolate(j, i * frame_time, &rotation);
+				} break;
+			}
+		}
+	}
+	const uint64_t search_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	LocalVector<int32_t> key_cursors;
+	key_cursors.resize_initialized(track_count);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < update_count; i++) {
+		for (int j = 0; j < track_count; j++) {
+			switch (animation->track_get_type(j)) {
+				case Animation::TYPE_POSITION_3D: {
+					animation->try_position_track_interpolate(j, i * frame_time, &position, false, &key_cursors[j]);
+				} break;
+				case Animation::TYPE_SCALE_3D: {
+					animation->try_scale_track_interpolate(j, i * frame_time, &position, false, &key_cursors[j]);
+				} break;
+				default: {
+					animation->try_rotation_track_interpolate(j, i * frame_time, &rotation, false, &key_cursors[j]);
+				} break;
+			}
+		}
+	}
+	const uint64_t cursor_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("%d bones, %d tracks, %d updates. Mixer: %.2f usec per update. Key lookups without cursors: %.2f usec per update, with cursors: %.2f usec per update.", bone_count, track_count, update_count, double(mixer_usec) / update_count, double(search_usec) / update_count, double(cursor_usec) / update_count));
+
+	memdelete(character);
+}
+
+#endif // _3D_DISABLED
+
 } // namespace TestAnimationPlayer
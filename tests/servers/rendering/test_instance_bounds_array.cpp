@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*  test_instance_bounds_array.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_instance_bounds_array)
+
+#include "core/math/projection.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/rendering/instance_bounds_array.h"
+
+namespace TestInstanceBoundsArray {
+
+// Tests the bounds one at a time, like `RendererSceneCull::InstanceBounds::in_frustum()`.
+bool is_inside_planes(const AABB &p_aabb, const Vector<Plane> &p_planes, bool p_cull_touching) {
+	const Vector3 end = p_aabb.get_end();
+	for (const Plane &plane : p_planes) {
+		const Vector3 corner(plane.normal.x > 0 ? p_aabb.position.x : end.x, plane.normal.y > 0 ? p_aabb.position.y : end.y, plane.normal.z > 0 ? p_aabb.position.z : end.z);
+		const real_t distance = plane.distance_to(corner);
+		if (p_cull_touching ? distance >= 0 : distance > 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+AABB random_aabb(RandomPCG &p_rng, real_t p_extent) {
+	const Vector3 position(p_rng.random(-p_extent, p_extent), p_rng.random(-p_extent, p_extent), p_rng.random(-p_extent, p_extent));
+	const Vector3 size(p_rng.random(0.1, 4.0), p_rng.random(0.1, 4.0), p_rng.random(0.1, 4.0));
+	return AABB(position, size);
+}
+
+Vector<Plane> camera_planes() {
+	Projection projection;
+	projection.set_perspective(70, 16.0 / 9.0, 0.05, 60);
+	return projection.get_projection_planes(Transform3D(Basis(Vector3(0, 1, 0), 0.7) * Basis(Vector3(1, 0, 0), -0.2), Vector3(1, 2, 3)));
+}
+
+TEST_CASE("[InstanceBoundsArray] Same results as testing the bounds one by one") {
+	RandomPCG rng(42);
+	const Vector<Plane> planes = camera_planes();
+
+	// Not a multiple of the block size, to test the last partial block.
+	const uint32_t count = 1000;
+	LocalVector<AABB> aabbs;
+	InstanceBoundsArray bounds;
+	for (uint32_t i = 0; i < count; i++) {
+		aabbs.push_back(random_aabb(rng, 50));
+		bounds.push_back(aabbs[i]);
+	}
+	CHECK(bounds.size() == count);
+
+	int mismatch_count = 0;
+	int inside_count = 0;
+	for (uint32_t from = 0; from < count; from += InstanceBoundsArray::BLOCK_SIZE) {
+		const uint64_t inside = bounds.cull_planes(from, planes.ptr(), planes.size());
+		for (uint32_t i = 0; i < InstanceBoundsArray::BLOCK_SIZE; i++) {
+			const bool expected = from + i < count && is_inside_planes(aabbs[from + i], planes, true);
+			const bool result = inside & (uint64_t(1) << i);
+			mismatch_count += result != expected ? 1 : 0;
+			inside_count += result ? 1 : 0;
+		}
+	}
+	CHECK_MESSAGE(inside_count > 0, "Some bounds should be inside the frustum.");
+	CHECK_MESSAGE(inside_count < int(count), "Some bounds should be outside of the frustum.");
+	CHECK_MESSAGE(mismatch_count == 0, "The block tests should match the one by one tests.");
+
+	CHECK_MESSAGE(bounds.cull_planes(count & ~63u, nullptr, 0) == (uint64_t(1) << (count & 63)) - 1, "Without planes, all the bounds of the block should be inside.");
+	CHECK(bounds.cull_planes(1024, planes.ptr(), planes.size()) == 0);
+}
+
+TEST_CASE("[InstanceBoundsArray] Bounds touching a plane") {
+	const Plane plane(Vector3(1, 0, 0), 0);
+	InstanceBoundsArray bounds;
+	bounds.push_back(AABB(Vector3(0, 0, 0), Vector3(1, 1, 1)));
+	bounds.push_back(AABB(Vector3(-1, 0, 0), Vector3(1, 1, 1)));
+	bounds.push_back(AABB(Vector3(-2, 0, 0), Vector3(1, 1, 1)));
+
+	CHECK(bounds.cull_planes(0, &plane, 1, true) == 0b110);
+	CHECK(bounds.cull_planes(0, &plane, 1, false) == 0b111);
+}
+
+TEST_CASE("[InstanceBoundsArray] Updating and removing bounds") {
+	const Plane plane(Vector3(1, 0, 0), 0);
+	InstanceBoundsArray bounds;
+	for (int i = 0; i < 10; i++) {
+		// Only the bounds at odd indices are behind the plane.
+		bounds.push_back(AABB(Vector3(i % 2 == 0 ? 1 : -2, 0, 0), Vector3(1, 1, 1)));
+	}
+	CHECK(bounds.cull_planes(0, &plane, 1) == 0b1010101010);
+
+	bounds.set(0, AABB(Vector3(-2, 0, 0), Vector3(1, 1, 1)));
+	CHECK(bounds.cull_planes(0, &plane, 1) == 0b1010101011);
+
+	// The last bounds replace the removed ones.
+	bounds.remove_at_unordered(2);
+	CHECK(bounds.size() == 9);
+	CHECK(bounds.cull_planes(0, &plane, 1) == 0b010101111);
+
+	bounds.remove_at_unordered(8);
+	CHECK(bounds.size() == 8);
+	CHECK(bounds.cull_planes(0, &plane, 1) == 0b10101111);
+
+	bounds.clear();
+	CHECK(bounds.size() == 0);
+	CHECK(bounds.cull_planes(0, &plane, 1) == 0);
+}
+
+TEST_CASE_PENDING("[InstanceBoundsArray][Benchmark] Frustum culling one million instances") {
+	RandomPCG rng(7);
+	const Vector<Plane> planes = camera_planes();
+	const uint32_t count = 1000000;
+	const int iterations = 20;
+
+	LocalVector<AABB> aabbs;
+	aabbs.reserve(count);
+	InstanceBoundsArray bounds;
+	for (uint32_t i = 0; i < count; i++) {
+		aabbs.push_back(random_aabb(rng, 500));
+		bounds.push_back(aabbs[i]);
+	}
+
+	uint32_t one_by_one_inside = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		for (uint32_t j = 0; j < count; j++) {
+			one_by_one_inside += is_inside_planes(aabbs[j], planes, true) ? 1 : 0;
+		}
+	}
+	const uint64_t one_by_one_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	uint32_t block_inside = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		for (uint32_t from = 0; from < count; from += InstanceBoundsArray::BLOCK_SIZE) {
+			uint64_t inside = bounds.cull_planes(from, planes.ptr(), planes.size());
+			while (inside != 0) {
+				inside &= inside - 1;
+				block_inside++;
+			}
+		}
+	}
+	const uint64_t block_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(one_by_one_inside == block_inside);
+	MESSAGE(vformat("%d instances, %d iterations. One by one: %d usec, in blocks: %d usec.", count, iterations, one_by_one_usec, block_usec));
+}
+
+} // namespace TestInstanceBoundsArray
@@ -0,0 +1,190 @@
+/**************************************************************************/
+/*  test_instance_cull_caches.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_instance_cull_caches)
+
+#include "servers/rendering/instance_cull_caches.h"
+
+namespace TestInstanceCullCaches {
+
+// Culling volumes of a camera at `p_distance` along the Z axis.
+LocalVector<Plane> camera_planes(real_t p_distance) {
+	LocalVector<Plane> planes;
+	planes.push_back(Plane(Vector3(0, 0, 1), p_distance));
+	planes.push_back(Plane(Vector3(0, 0, -1), -p_distance - 100));
+	return planes;
+}
+
+// Returns the cache of the volumes, as if its candidates were found for all the instances when needed.
+InstanceCullCaches::Cache *update_cache(InstanceCullCaches &p_caches, const LocalVector<Plane> &p_planes, uint64_t p_render_pass, uint32_t p_word_count) {
+	InstanceCullCaches::Cache *cache = p_caches.get_cache(p_planes, LocalVector<AABB>(), p_render_pass);
+	if (cache) {
+		LocalVector<uint32_t> words;
+		if (p_caches.get_dirty_words(cache, p_word_count, words)) {
+			cache->candidates.resize_initialized(p_word_count);
+		}
+		p_caches.set_updated(cache);
+	}
+	return cache;
+}
+
+bool words_equal(const LocalVector<uint32_t> &p_words, const LocalVector<uint32_t> &p_expected) {
+	if (p_words.size() != p_expected.size()) {
+		return false;
+	}
+	for (uint32_t i = 0; i < p_words.size(); i++) {
+		if (p_words[i] != p_expected[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[InstanceCullCaches] Volumes are cached once used again") {
+	InstanceCullCaches caches;
+	const LocalVector<Plane> planes = camera_planes(0);
+
+	CHECK_MESSAGE(update_cache(caches, planes, 1, 4) == nullptr, "Volumes used for the first time should not have candidates yet.");
+	InstanceCullCaches::Cache *cache = caches.get_cache(planes, LocalVector<AABB>(), 2);
+	REQUIRE(cache != nullptr);
+
+	LocalVector<uint32_t> words;
+	CHECK_MESSAGE(caches.get_dirty_words(cache, 4, words), "The candidates of new caches should be found for all the instances.");
+	caches.set_updated(cache);
+	CHECK(cache->valid);
+	CHECK_FALSE(caches.get_dirty_words(cache, 4, words));
+	CHECK(words.is_empty());
+
+	LocalVector<AABB> regions;
+	regions.push_back(AABB(Vector3(), Vector3(10, 10, 10)));
+	CHECK_MESSAGE(caches.get_cache(planes, regions, 3) == nullptr, "Different volumes should not share a cache.");
+	CHECK(caches.get_cache(camera_planes(1), LocalVector<AABB>(), 4) == nullptr);
+	CHECK(caches.size() == 3);
+	cache = caches.get_cache(planes, LocalVector<AABB>(), 5);
+	REQUIRE(cache != nullptr);
+	CHECK(cache->valid);
+}
+
+TEST_CASE("[InstanceCullCaches] Dirty log") {
+	InstanceCullCaches caches;
+	LocalVector<uint32_t> words;
+
+	caches.mark_dirty(3, 160);
+	CHECK_MESSAGE(caches.get_dirty_log_size() == 0, "Changes should not be logged while there are no caches.");
+
+	const LocalVector<Plane> planes_a = camera_planes(0);
+	const LocalVector<Plane> planes_b = camera_planes(50);
+	update_cache(caches, planes_a, 1, 3);
+	update_cache(caches, planes_b, 1, 3);
+	InstanceCullCaches::Cache *cache_a = update_cache(caches, planes_a, 2, 3);
+	InstanceCullCaches::Cache *cache_b = update_cache(caches, planes_b, 2, 3);
+	REQUIRE(cache_a != nullptr);
+	REQUIRE(cache_b != nullptr);
+
+	SUBCASE("Static instance moving") {
+		// Instances that did not change for several renders move, and one past the last instance is removed.
+		update_cache(caches, planes_a, 3, 3);
+		update_cache(caches, planes_b, 3, 3);
+		caches.mark_dirty(130, 160);
+		caches.mark_dirty(5, 160);
+		caches.mark_dirty(140, 160);
+		caches.mark_dirty(170, 160);
+		CHECK(caches.get_dirty_log_size() == 4);
+
+		CHECK_FALSE(caches.get_dirty_words(cache_a, 3, words));
+		CHECK_MESSAGE(words_equal(words, { 0, 2 }), "Only the words of the instances that changed should be found again, once each and in order, ignoring the ones past the last instance.");
+		caches.set_updated(cache_a);
+		CHECK_MESSAGE(caches.get_dirty_log_size() == 4, "The log should be kept until every cache caught up.");
+
+		CHECK_FALSE(caches.get_dirty_words(cache_a, 3, words));
+		CHECK(words.is_empty());
+		CHECK_FALSE(caches.get_dirty_words(cache_b, 3, words));
+		CHECK(words_equal(words, { 0, 2 }));
+		caches.set_updated(cache_b);
+		CHECK(caches.get_dirty_log_size() == 0);
+
+		caches.mark_dirty(70, 160);
+		CHECK_FALSE(caches.get_dirty_words(cache_a, 3, words));
+		CHECK(words_equal(words, { 1 }));
+	}
+
+	SUBCASE("Too many changes") {
+		for (uint32_t i = 0; i <= 4096; i++) {
+			caches.mark_dirty(i % 160, 160);
+		}
+		CHECK_MESSAGE(caches.get_dirty_log_size() == 0, "The log should be dropped once it grows past the point where testing everything again is cheaper.");
+		CHECK_MESSAGE(caches.get_dirty_words(cache_a, 3, words), "Caches that missed dropped changes should find their candidates again.");
+		CHECK(caches.get_dirty_words(cache_b, 3, words));
+
+		caches.set_updated(cache_a);
+		caches.mark_dirty(7, 160);
+		CHECK_FALSE(caches.get_dirty_words(cache_a, 3, words));
+		CHECK(words_equal(words, { 0 }));
+		CHECK(caches.get_dirty_words(cache_b, 3, words));
+	}
+}
+
+TEST_CASE("[InstanceCullCaches] Least recently used caches are evicted") {
+	InstanceCullCaches caches;
+	uint64_t render_pass = 0;
+
+	for (uint32_t i = 0; i < InstanceCullCaches::MAX_CACHES; i++) {
+		render_pass++;
+		CHECK(update_cache(caches, camera_planes(i), render_pass, 4) == nullptr);
+	}
+	CHECK(caches.size() == InstanceCullCaches::MAX_CACHES);
+
+	// Use the first volumes again, the second ones are now the least recently used.
+	render_pass++;
+	InstanceCullCaches::Cache *first = update_cache(caches, camera_planes(0), render_pass, 4);
+	REQUIRE(first != nullptr);
+	CHECK(first->valid);
+
+	render_pass++;
+	CHECK(update_cache(caches, camera_planes(100), render_pass, 4) == nullptr);
+	CHECK(caches.size() == InstanceCullCaches::MAX_CACHES);
+
+	render_pass++;
+	CHECK_MESSAGE(update_cache(caches, camera_planes(0), render_pass, 4) == first, "Recently used caches should be kept.");
+	CHECK(first->valid);
+	render_pass++;
+	CHECK(update_cache(caches, camera_planes(2), render_pass, 4) != nullptr);
+	render_pass++;
+	InstanceCullCaches::Cache *replaced = update_cache(caches, camera_planes(100), render_pass, 4);
+	REQUIRE(replaced != nullptr);
+	CHECK_MESSAGE(replaced->valid, "The new volumes should be cached once used again.");
+
+	render_pass++;
+	CHECK_MESSAGE(update_cache(caches, camera_planes(1), render_pass, 4) == nullptr, "The least recently used cache should have been evicted.");
+}
+
+} // namespace TestInstanceCullCaches
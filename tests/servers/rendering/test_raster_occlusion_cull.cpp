@@ -0,0 +1,254 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_raster_occlusion_cull)
+
+#include "core/config/project_settings.h"
+#include "core/math/projection.h"
+#include "core/os/os.h"
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "modules/modules_enabled.gen.h" // For raycast.
+
+namespace TestRasterOcclusionCull {
+
+// Gives the occlusion culling singleton back to its owner once the backend created by a test is freed.
+class OcclusionCullSingleton : public RendererSceneOcclusionCull {
+public:
+	static void set(RendererSceneOcclusionCull *p_singleton) {
+		singleton = p_singleton;
+	}
+};
+
+const Size2i BUFFER_SIZE = Size2i(128, 96);
+
+struct OcclusionScene {
+	RendererSceneOcclusionCull *backend = nullptr;
+	RID scenario = RID::from_uint64(1);
+	RID buffer = RID::from_uint64(2);
+	LocalVector<RID> occluders;
+
+	Transform3D cam_transform;
+	Projection cam_projection;
+	bool cam_orthogonal = false;
+
+	// Adds an occluder instance with a rectangle of `p_size` centered on the origin, facing the Z axis.
+	RID add_rectangle(const Size2 &p_size, const Transform3D &p_xform) {
+		const Vector2 half = p_size * 0.5;
+		PackedVector3Array vertices = { Vector3(-half.x, -half.y, 0), Vector3(half.x, -half.y, 0), Vector3(half.x, half.y, 0), Vector3(-half.x, half.y, 0) };
+		PackedInt32Array indices = { 0, 1, 2, 0, 2, 3 };
+
+		RID occluder = backend->occluder_allocate();
+		backend->occluder_initialize(occluder);
+		backend->occluder_set_mesh(occluder, vertices, indices);
+		occluders.push_back(occluder);
+
+		RID instance = RID::from_uint64(100 + occluders.size());
+		backend->scenario_set_instance(scenario, instance, occluder, p_xform, true);
+		return instance;
+	}
+
+	void setup(RendererSceneOcclusionCull *p_backend) {
+		backend = p_backend;
+		backend->add_scenario(scenario);
+		backend->add_buffer(buffer);
+		backend->buffer_set_scenario(buffer, scenario);
+		backend->buffer_set_size(buffer, BUFFER_SIZE);
+	}
+
+	void set_perspective() {
+		cam_projection.set_perspective(70, real_t(BUFFER_SIZE.x) / BUFFER_SIZE.y, 0.05, 100);
+		cam_orthogonal = false;
+	}
+
+	void set_orthogonal() {
+		cam_projection.set_orthogonal(-16, 16, -12, 12, 0.05, 100);
+		cam_orthogonal = true;
+	}
+
+	void update() {
+		backend->buffer_update(buffer, cam_transform, cam_projection, cam_orthogonal);
+	}
+
+	bool is_occluded(const AABB &p_aabb) const {
+		const RendererSceneOcclusionCull::HZBuffer *hz_buffer = backend->buffer_get_ptr(buffer);
+		const Vector3 end = p_aabb.get_end();
+		const real_t bounds[6] = { p_aabb.position.x, p_aabb.position.y, p_aabb.position.z, end.x, end.y, end.z };
+		uint64_t occlusion_timeout = 0;
+		return hz_buffer->is_occluded(bounds, cam_transform.origin, cam_transform.affine_inverse(), cam_projection, cam_projection.get_z_near(), cam_orthogonal, occlusion_timeout);
+	}
+
+	void clear() {
+		backend->remove_buffer(buffer);
+		backend->remove_scenario(scenario);
+		for (const RID &occluder : occluders) {
+			backend->free_occluder(occluder);
+		}
+		occluders.clear();
+	}
+};
+
+AABB box_at(const Vector3 &p_center, real_t p_size = 1.0) {
+	return AABB(p_center - Vector3(p_size, p_size, p_size) * 0.5, Vector3(p_size, p_size, p_size));
+}
+
+TEST_CASE("[RasterOcclusionCull] Occluders hide what is behind them") {
+	RendererSceneOcclusionCull *previous_singleton = RendererSceneOcclusionCull::get_singleton();
+	RasterOcclusionCull *raster = memnew(RasterOcclusionCull);
+
+	OcclusionScene scene;
+	scene.setup(raster);
+	RID wall = scene.add_rectangle(Size2(10, 8), Transform3D(Basis(), Vector3(0, 0, -10)));
+
+	SUBCASE("Perspective camera") {
+		scene.set_perspective();
+	}
+	SUBCASE("Orthogonal camera") {
+		scene.set_orthogonal();
+	}
+
+	scene.update();
+	CHECK_MESSAGE(scene.is_occluded(box_at(Vector3(0, 0, -20))), "Box behind the wall should be occluded.");
+	CHECK_MESSAGE(scene.is_occluded(box_at(Vector3(2, -2, -30), 2)), "Box behind the wall should be occluded.");
+	CHECK_FALSE_MESSAGE(scene.is_occluded(box_at(Vector3(0, 0, -5))), "Box in front of the wall should not be occluded.");
+	CHECK_FALSE_MESSAGE(scene.is_occluded(box_at(Vector3(9, 0, -20))), "Box beside the wall should not be occluded.");
+	CHECK_FALSE_MESSAGE(scene.is_occluded(box_at(Vector3(0, 0, -10), 3)), "Box going through the wall should not be occluded.");
+
+	scene.backend->scenario_set_instance(scene.scenario, wall, scene.occluders[0], Transform3D(Basis(), Vector3(-20, 0, -10)), true);
+	scene.update();
+	CHECK_FALSE_MESSAGE(scene.is_occluded(box_at(Vector3(0, 0, -20))), "Box should not be occluded after the wall moved away.");
+
+	scene.backend->scenario_set_instance(scene.scenario, wall, scene.occluders[0], Transform3D(Basis(), Vector3(0, 0, -10)), false);
+	scene.update();
+	CHECK_FALSE_MESSAGE(scene.is_occluded(box_at(Vector3(0, 0, -20))), "Box should not be occluded by a disabled wall.");
+
+	scene.backend->scenario_set_instance(scene.scenario, wall, scene.occluders[0], Transform3D(Basis(), Vector3(0, 0, -10)), true);
+	scene.update();
+	CHECK(scene.is_occluded(box_at(Vector3(0, 0, -20))));
+
+	scene.backend->scenario_remove_instance(scene.scenario, wall);
+	scene.update();
+	CHECK_FALSE_MESSAGE(scene.is_occluded(box_at(Vector3(0, 0, -20))), "Box should not be occluded after the wall was removed.");
+
+	scene.clear();
+	memdelete(raster);
+	OcclusionCullSingleton::set(previous_singleton);
+}
+
+TEST_CASE("[RasterOcclusionCull] Occluders crossing the near plane") {
+	RendererSceneOcclusionCull *previous_singleton = RendererSceneOcclusionCull::get_singleton();
+	RasterOcclusionCull *raster = memnew(RasterOcclusionCull);
+
+	OcclusionScene scene;
+	scene.setup(raster);
+	scene.set_perspective();
+	// Floor going from behind the camera to far in front of it.
+	scene.add_rectangle(Size2(200, 200), Transform3D(Basis(Vector3(1, 0, 0), -Math::PI / 2), Vector3(0, -2, 0)));
+
+	scene.update();
+	CHECK_MESSAGE(scene.is_occluded(box_at(Vector3(0, -5, -20))), "Box under the floor should be occluded.");
+	CHECK_MESSAGE(scene.is_occluded(box_at(Vector3(3, -4, -6))), "Box under the floor should be occluded.");
+	CHECK_FALSE_MESSAGE(scene.is_occluded(box_at(Vector3(0, 0, -20))), "Box above the floor should not be occluded.");
+
+	scene.clear();
+	memdelete(raster);
+	OcclusionCullSingleton::set(previous_singleton);
+}
+
+#ifdef MODULE_RAYCAST_ENABLED
+
+TEST_CASE("[RasterOcclusionCull] Same culling results as the ray-cast backend") {
+	RendererSceneOcclusionCull *raycast = RendererSceneOcclusionCull::get_singleton();
+	if (raycast == nullptr || int(GLOBAL_GET("rendering/occlusion_culling/backend")) != 0) {
+		return; // The ray-cast backend is not in use.
+	}
+
+	RasterOcclusionCull *raster = memnew(RasterOcclusionCull);
+
+	OcclusionScene scenes[2];
+	scenes[0].setup(raster);
+	scenes[1].setup(raycast);
+	for (OcclusionScene &scene : scenes) {
+		scene.add_rectangle(Size2(10, 8), Transform3D(Basis(), Vector3(0, 0, -10)));
+		scene.add_rectangle(Size2(6, 12), Transform3D(Basis(Vector3(0, 1, 0), Math::PI / 4), Vector3(10, 1, -18)));
+		scene.add_rectangle(Size2(200, 200), Transform3D(Basis(Vector3(1, 0, 0), -Math::PI / 2), Vector3(0, -4, 0)));
+		scene.cam_transform = Transform3D(Basis(Vector3(0, 1, 0), 0.1), Vector3(0.3, 0.2, 0));
+	}
+
+	SUBCASE("Perspective camera") {
+		for (OcclusionScene &scene : scenes) {
+			scene.set_perspective();
+		}
+	}
+	SUBCASE("Orthogonal camera") {
+		for (OcclusionScene &scene : scenes) {
+			scene.set_orthogonal();
+		}
+	}
+
+	// The ray-cast backend builds its BVH in the background, it is used by the next updates once it's done.
+	const AABB reference_box = box_at(Vector3(0, 0, -20));
+	scenes[0].update();
+	for (int i = 0; i < 5000 && !scenes[1].is_occluded(reference_box); i++) {
+		OS::get_singleton()->delay_usec(1000);
+		scenes[1].update();
+	}
+	REQUIRE(scenes[1].is_occluded(reference_box));
+
+	int box_count = 0;
+	int occluded_count = 0;
+	int mismatch_count = 0;
+	for (real_t z = -6; z >= -40; z -= 4) {
+		for (real_t y = -9; y <= 9; y += 1.5) {
+			for (real_t x = -15; x <= 15; x += 1.5) {
+				const AABB box = box_at(Vector3(x, y, z), 0.5);
+				const bool raster_occluded = scenes[0].is_occluded(box);
+				box_count++;
+				occluded_count += raster_occluded ? 1 : 0;
+				mismatch_count += raster_occluded != scenes[1].is_occluded(box) ? 1 : 0;
+			}
+		}
+	}
+
+	CHECK_MESSAGE(occluded_count > box_count / 10, "Many boxes should be occluded.");
+	CHECK_MESSAGE(mismatch_count == 0, "Both backends should cull the same boxes.");
+
+	for (OcclusionScene &scene : scenes) {
+		scene.clear();
+	}
+	memdelete(raster);
+	OcclusionCullSingleton::set(raycast);
+}
+
+#endif // MODULE_RAYCAST_ENABLED
+
+} // namespace TestRasterOcclusionCull
@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_renderer_canvas_cull)
+
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+class TestRendererCanvasCullAccessor {
+public:
+	// Returns the items to draw for the canvas, in draw order, culled on threads when it has at least `p_thread_cull_threshold` items.
+	static LocalVector<const RendererCanvasRender::Item *> cull_canvas(RID p_canvas, const Rect2 &p_clip_rect, uint32_t p_thread_cull_threshold, uint32_t &r_range_count) {
+		RendererCanvasCull *canvas_cull = RSG::canvas;
+		RendererCanvasCull::Canvas *canvas = canvas_cull->canvas_owner.get_or_null(p_canvas);
+		if (canvas->children_order_dirty) {
+			canvas->child_items.sort();
+			canvas->children_order_dirty = false;
+		}
+
+		const uint32_t thread_cull_threshold = canvas_cull->thread_cull_threshold;
+		canvas_cull->thread_cull_threshold = p_thread_cull_threshold;
+		canvas_cull->cull_ranges.clear();
+		const RendererCanvasRender::Item *list = canvas_cull->_cull_canvas_item_tree(canvas->child_items.ptrw(), canvas->child_items.size(), Transform2D(), p_clip_rect, UINT32_MAX);
+		canvas_cull->thread_cull_threshold = thread_cull_threshold;
+		r_range_count = canvas_cull->cull_ranges.size();
+
+		LocalVector<const RendererCanvasRender::Item *> items;
+		for (const RendererCanvasRender::Item *item = list; item; item = item->next) {
+			items.push_back(item);
+		}
+		return items;
+	}
+};
+
+namespace TestRendererCanvasCull {
+
+RID create_item(LocalVector<RID> &r_items, RID p_parent, const Vector2 &p_position) {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID item = rs->canvas_item_create();
+	rs->canvas_item_set_parent(item, p_parent);
+	rs->canvas_item_set_transform(item, Transform2D(0, p_position));
+	rs->canvas_item_add_rect(item, Rect2(0, 0, 30, 30), Color(1, 1, 1));
+	r_items.push_back(item);
+	return item;
+}
+
+bool items_equal(const LocalVector<const RendererCanvasRender::Item *> &p_items, const LocalVector<const RendererCanvasRender::Item *> &p_expected) {
+	if (p_items.size() != p_expected.size()) {
+		return false;
+	}
+	for (uint32_t i = 0; i < p_items.size(); i++) {
+		if (p_items[i] != p_expected[i] || p_items[i]->z_final != p_expected[i]->z_final || p_items[i]->final_transform != p_expected[i]->final_transform) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Threaded culling draws in the same order as serial culling") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID canvas = rs->canvas_create();
+	LocalVector<RID> items;
+
+	// Items spread over several Z indices, with y-sorted subtrees (one nesting another), children drawn behind
+	// their parent, clipping, and items outside of the clip rect.
+	for (int i = 0; i < 400; i++) {
+		RID item = create_item(items, canvas, Vector2((i % 20) * 40, (i / 20) * 40));
+		rs->canvas_item_set_z_index(item, i % 5 - 2);
+
+		if (i % 10 == 0) {
+			rs->canvas_item_set_sort_children_by_y(item, true);
+			for (int j = 0; j < 4; j++) {
+				RID child = create_item(items, item, Vector2(j * 5, ((j * 7) % 4) * 5));
+				if (j == 1) {
+					rs->canvas_item_set_z_as_relative_to_parent(child, false);
+					rs->canvas_item_set_z_index(child, 3);
+				} else if (j == 2) {
+					RID sorted = create_item(items, child, Vector2(0, 10));
+					rs->canvas_item_set_sort_children_by_y(sorted, true);
+					for (int k = 0; k < 3; k++) {
+						create_item(items, sorted, Vector2(k * 5, (2 - k) * 5));
+					}
+				}
+			}
+		}
+		if (i % 7 == 3) {
+			RID child = create_item(items, item, Vector2(5, 5));
+			rs->canvas_item_set_draw_behind_parent(child, true);
+		}
+		if (i % 13 == 5) {
+			rs->canvas_item_set_clip(item, true);
+			create_item(items, item, Vector2(20, 20));
+		}
+	}
+
+	const Rect2 clip_rect = Rect2(0, 0, 800, 600);
+	uint32_t range_count = 0;
+
+	// The item counts of the previous cull decide whether to use threads and how to split the items.
+	TestRendererCanvasCullAccessor::cull_canvas(canvas, clip_rect, UINT32_MAX, range_count);
+	const LocalVector<const RendererCanvasRender::Item *> serial_items = TestRendererCanvasCullAccessor::cull_canvas(canvas, clip_rect, UINT32_MAX, range_count);
+	CHECK(range_count == 0);
+	REQUIRE_FALSE(serial_items.is_empty());
+	CHECK_MESSAGE(serial_items.size() < items.size(), "Items outside of the clip rect should be culled.");
+
+	const LocalVector<const RendererCanvasRender::Item *> threaded_items = TestRendererCanvasCullAccessor::cull_canvas(canvas, clip_rect, 1, range_count);
+	CHECK_MESSAGE(range_count >= 2, "The items should be culled on several threads.");
+	CHECK_MESSAGE(items_equal(threaded_items, serial_items), "Culling on threads should draw the same items, in the same order.");
+
+	CHECK(items_equal(TestRendererCanvasCullAccessor::cull_canvas(canvas, clip_rect, UINT32_MAX, range_count), serial_items));
+
+	for (const RID &item : items) {
+		rs->free_rid(item);
+	}
+	rs->free_rid(canvas);
+}
+
+} // namespace TestRendererCanvasCull
@@ -36,6 +36,8 @@ TEST_FORCE_LINK(test_navigation_server_2d)
 
 #ifdef MODULE_NAVIGATION_2D_ENABLED
 
+#include "core/math/geometry_2d.h"
+#include "core/math/random_pcg.h"
 #include "core/object/callable_mp.h"
 #include "scene/2d/polygon_2d.h"
 #include "scene/main/scene_tree.h"
@@ -89,6 +91,38 @@ struct RegisterHeapIndexes {
 	}
 };
 
+// A triangle of the regions of a map, to check the map queries against testing every triangle.
+struct MapTriangle {
+	Vector2 vertices[3];
+	RID owner;
+	uint32_t navigation_layers = 1;
+};
+
+// Returns the squared distance from the closest triangle with one of `p_navigation_layers`, or infinity when there is none.
+real_t map_triangles_get_distance_squared(const LocalVector<MapTriangle> &p_triangles, const Vector2 &p_point, uint32_t p_navigation_layers = UINT32_MAX, RID *r_owner = nullptr) {
+	real_t closest_distance_squared = Math::INF;
+	for (const MapTriangle &map_triangle : p_triangles) {
+		if ((map_triangle.navigation_layers & p_navigation_layers) == 0) {
+			continue;
+		}
+		const Vector2 *vertices = map_triangle.vertices;
+		real_t distance_squared = 0.0;
+		if (!Geometry2D::is_point_in_triangle(p_point, vertices[0], vertices[1], vertices[2])) {
+			distance_squared = Math::INF;
+			for (int i = 0; i < 3; i++) {
+				distance_squared = MIN(distance_squared, Geometry2D::get_closest_point_to_segment(p_point, vertices[i], vertices[(i + 1) % 3]).distance_squared_to(p_point));
+			}
+		}
+		if (distance_squared < closest_distance_squared) {
+			closest_distance_squared = distance_squared;
+			if (r_owner) {
+				*r_owner = map_triangle.owner;
+			}
+		}
+	}
+	return closest_distance_squared;
+}
+
 TEST_SUITE("[Navigation2D]") {
 	TEST_CASE("[NavigationServer2D] Server should be empty when initialized") {
 		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
@@ -751,6 +785,141 @@ TEST_SUITE("[Navigation2D]") {
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer2D] Closest point queries should match testing every triangle") {
+		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
+
+		const RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+
+		LocalVector<RID> regions;
+		LocalVector<MapTriangle> triangles;
+		const auto add_region = [&](const Ref<NavigationPolygon> &p_navigation_polygon, const Transform2D &p_transform, uint32_t p_navigation_layers) {
+			const RID region = navigation_server->region_create();
+			navigation_server->region_set_use_async_iterations(region, false);
+			navigation_server->region_set_transform(region, p_transform);
+			navigation_server->region_set_navigation_layers(region, p_navigation_layers);
+			navigation_server->region_set_map(region, map);
+			if (p_navigation_polygon.is_valid()) {
+				navigation_server->region_set_navigation_polygon(region, p_navigation_polygon);
+				const Vector<Vector2> vertices = p_navigation_polygon->get_vertices();
+				for (int i = 0; i < p_navigation_polygon->get_polygon_count(); i++) {
+					const Vector<int> polygon = p_navigation_polygon->get_polygon(i);
+					for (int j = 2; j < polygon.size(); j++) {
+						triangles.push_back({ { p_transform.xform(vertices[polygon[0]]), p_transform.xform(vertices[polygon[j - 1]]), p_transform.xform(vertices[polygon[j]]) }, region, p_navigation_layers });
+					}
+				}
+			}
+			regions.push_back(region);
+		};
+
+		// A grid of many polygons, with uneven triangles in one half and square cells in the other.
+		const int grid_size = 10;
+		const real_t cell_size = 20.0;
+		Ref<NavigationPolygon> grid_polygon;
+		grid_polygon.instantiate();
+		Vector<Vector2> grid_vertices;
+		for (int x = 0; x <= grid_size; x++) {
+			for (int y = 0; y <= grid_size; y++) {
+				const Vector2 offset = x <= 4 || y == 0 || y == grid_size || x == grid_size ? Vector2() : Vector2(Math::sin(1.7 * x * y), Math::cos(1.1 * x + y)) * 0.3;
+				grid_vertices.push_back((Vector2(x, y) + offset) * cell_size);
+			}
+		}
+		grid_polygon->set_vertices(grid_vertices);
+		for (int x = 0; x < grid_size; x++) {
+			for (int y = 0; y < grid_size; y++) {
+				const int v00 = x * (grid_size + 1) + y;
+				const int v01 = v00 + 1;
+				const int v10 = v00 + grid_size + 1;
+				const int v11 = v10 + 1;
+				if (x < 4) {
+					grid_polygon->add_polygon({ v00, v01, v11, v10 });
+				} else {
+					grid_polygon->add_polygon({ v00, v01, v11 });
+					grid_polygon->add_polygon({ v00, v11, v10 });
+				}
+			}
+		}
+		// Degenerate polygons: a triangle without area along an edge of the grid, and a polygon with two vertices.
+		grid_polygon->add_polygon({ 0, 1, 2 });
+		grid_polygon->add_polygon({ 0, 1 });
+
+		Ref<NavigationPolygon> empty_polygon;
+		empty_polygon.instantiate();
+		Ref<NavigationPolygon> degenerate_polygon;
+		degenerate_polygon.instantiate();
+		degenerate_polygon->set_vertices({ Vector2(0, 0), Vector2(20, 0) });
+		degenerate_polygon->add_polygon({ 0, 1 });
+
+		// Regions some distance apart, so that no point is at the same distance from two of them, including one
+		// on other navigation layers and regions without polygons.
+		add_region(grid_polygon, Transform2D(), 1);
+		add_region(grid_polygon, Transform2D(0.5, Vector2(290, 50)), 1);
+		add_region(grid_polygon, Transform2D(0.0, Size2(2, 2), 0.0, Vector2(-80, 270)), 2);
+		add_region(empty_polygon, Transform2D(), 1);
+		add_region(degenerate_polygon, Transform2D(0.0, Vector2(100, 100)), 1);
+		add_region(Ref<NavigationPolygon>(), Transform2D(), 1);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		RandomPCG rng(42);
+		LocalVector<Vector2> points;
+		for (int i = 0; i < 300; i++) {
+			points.push_back(Vector2(rng.random(-160.0, 600.0), rng.random(-160.0, 800.0)));
+		}
+		points.push_back(Vector2());
+		points.push_back(Vector2(20, 20));
+		points.push_back(Vector2(20000, 0));
+		points.push_back(Vector2(-20000, -20000));
+
+		SUBCASE("Closest points and owners") {
+			for (const Vector2 &point : points) {
+				RID owner;
+				const real_t distance = Math::sqrt(map_triangles_get_distance_squared(triangles, point, UINT32_MAX, &owner));
+				const Vector2 closest_point = navigation_server->map_get_closest_point(map, point);
+				CHECK_MESSAGE(Math::is_equal_approx(closest_point.distance_to(point), distance, real_t(1e-2)), "Closest point to ", point, " should be as close as the closest triangle.");
+				CHECK_MESSAGE(map_triangles_get_distance_squared(triangles, closest_point) < 1e-4, "Closest point to ", point, " should be on a triangle.");
+				CHECK_MESSAGE(navigation_server->map_get_closest_point_owner(map, point) == owner, "Closest point owner of ", point, " should own the closest triangle.");
+			}
+		}
+
+		SUBCASE("Path start and end positions") {
+			// Paths use the regions of the first navigation layer only.
+			for (uint32_t i = 0; i + 1 < points.size(); i += 2) {
+				const Vector2 &start = points[i];
+				const Vector2 &end = points[i + 1];
+				RID start_owner;
+				RID end_owner;
+				const real_t start_distance = Math::sqrt(map_triangles_get_distance_squared(triangles, start, 1, &start_owner));
+				const real_t end_distance = Math::sqrt(map_triangles_get_distance_squared(triangles, end, 1, &end_owner));
+
+				const Vector<Vector2> path = navigation_server->map_get_path(map, start, end, true);
+				REQUIRE_FALSE(path.is_empty());
+				CHECK_MESSAGE(Math::is_equal_approx(path[0].distance_to(start), start_distance, real_t(1e-2)), "Path from ", start, " should start on the closest triangle.");
+				if (start_owner == end_owner) {
+					// Paths to other regions end as close as they can get.
+					CHECK_MESSAGE(Math::is_equal_approx(path[path.size() - 1].distance_to(end), end_distance, real_t(1e-2)), "Path to ", end, " should end on the closest triangle.");
+				}
+			}
+		}
+
+		SUBCASE("Maps without polygons") {
+			for (uint32_t i = 0; i < 3; i++) {
+				navigation_server->region_set_map(regions[i], RID());
+			}
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->map_get_closest_point(map, Vector2(20, 20)), Vector2());
+			CHECK_FALSE(navigation_server->map_get_closest_point_owner(map, Vector2(20, 20)).is_valid());
+			CHECK(navigation_server->map_get_path(map, Vector2(20, 20), Vector2(40, 40), true).is_empty());
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free_rid(region);
+		}
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
 	TEST_CASE("[NavigationServer2D] Server should simplify path properly") {
 		real_t simplify_epsilon = 0.2;
 		Vector<Vector2> source_path;
@@ -36,7 +36,11 @@ TEST_FORCE_LINK(test_navigation_server_3d)
 
 #ifdef MODULE_NAVIGATION_3D_ENABLED
 
+#include "core/config/project_settings.h"
+#include "core/math/geometry_3d.h"
+#include "core/math/random_pcg.h"
 #include "core/object/callable_mp.h"
+#include "core/os/os.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/main/scene_tree.h"
 #include "scene/main/window.h"
@@ -55,15 +59,74 @@ class CallableMock : public Object {
 	GDCLASS(CallableMock, Object);
 
 public:
+	void function0() {
+		function0_calls++;
+	}
+
 	void function1(Variant arg0) {
 		function1_calls++;
 		function1_latest_arg0 = arg0;
 	}
 
+	unsigned function0_calls{ 0 };
 	unsigned function1_calls{ 0 };
 	Variant function1_latest_arg0;
 };
 
+// A face of the regions of a map, to check the map queries against testing every face.
+struct MapFace {
+	Face3 face;
+	RID owner;
+	uint32_t navigation_layers = 1;
+};
+
+// Returns the squared distance from the closest face with one of `p_navigation_layers`, or infinity when there is none.
+real_t map_faces_get_distance_squared(const LocalVector<MapFace> &p_faces, const Vector3 &p_point, uint32_t p_navigation_layers = UINT32_MAX, RID *r_owner = nullptr) {
+	real_t closest_distance_squared = Math::INF;
+	for (const MapFace &map_face : p_faces) {
+		if ((map_face.navigation_layers & p_navigation_layers) == 0) {
+			continue;
+		}
+		const real_t distance_squared = map_face.face.get_closest_point_to(p_point).distance_squared_to(p_point);
+		if (distance_squared < closest_distance_squared) {
+			closest_distance_squared = distance_squared;
+			if (r_owner) {
+				*r_owner = map_face.owner;
+			}
+		}
+	}
+	return closest_distance_squared;
+}
+
+// Returns the distance from `p_from` to the closest intersection of the segment with the faces, or the distance
+// between the segment and the faces when it does not intersect any.
+real_t map_faces_get_segment_distance(const LocalVector<MapFace> &p_faces, const Vector3 &p_from, const Vector3 &p_to, bool &r_intersects) {
+	real_t closest_distance = Math::INF;
+	r_intersects = false;
+	for (const MapFace &map_face : p_faces) {
+		Vector3 intersection;
+		if (map_face.face.intersects_segment(p_from, p_to, &intersection)) {
+			closest_distance = MIN(closest_distance, p_from.distance_to(intersection));
+			r_intersects = true;
+		}
+	}
+	if (r_intersects) {
+		return closest_distance;
+	}
+
+	for (const MapFace &map_face : p_faces) {
+		closest_distance = MIN(closest_distance, p_from.distance_to(map_face.face.get_closest_point_to(p_from)));
+		closest_distance = MIN(closest_distance, p_to.distance_to(map_face.face.get_closest_point_to(p_to)));
+		for (int i = 0; i < 3; i++) {
+			Vector3 on_segment;
+			Vector3 on_edge;
+			Geometry3D::get_closest_points_between_segments(p_from, p_to, map_face.face.vertex[i], map_face.face.vertex[(i + 1) % 3], on_segment, on_edge);
+			closest_distance = MIN(closest_distance, on_segment.distance_to(on_edge));
+		}
+	}
+	return closest_distance;
+}
+
 TEST_SUITE("[Navigation3D]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -529,6 +592,167 @@ TEST_SUITE("[Navigation3D]") {
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Batched avoidance solver should match the default avoidance") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A crowd of agents that cannot move and a few agents walking through it, one map per solver.
+		// The default solver moves each agent as soon as its velocity is computed, so the walking agents
+		// are further apart than the neighbor distance for the order of the agents not to matter.
+		const int crowd_size = 12;
+		const int walker_count = 4;
+		const int agent_count = crowd_size * crowd_size + walker_count;
+		RID maps[2];
+		LocalVector<RID> agents[2];
+		CallableMock callback_mocks[2][agent_count];
+		for (int m = 0; m < 2; m++) {
+			// The setting is read when the map is created.
+			ProjectSettings::get_singleton()->set_setting("navigation/avoidance/use_batched_solver", m == 1);
+			maps[m] = navigation_server->map_create();
+			navigation_server->map_set_active(maps[m], true);
+
+			for (int i = 0; i < agent_count; i++) {
+				RID agent = navigation_server->agent_create();
+				navigation_server->agent_set_map(agent, maps[m]);
+				navigation_server->agent_set_avoidance_enabled(agent, true);
+				navigation_server->agent_set_radius(agent, 0.5);
+				navigation_server->agent_set_max_neighbors(agent, 5);
+				navigation_server->agent_set_neighbor_distance(agent, 4.0);
+				if (i < crowd_size * crowd_size) {
+					const int x = i % crowd_size;
+					const int z = i / crowd_size;
+					navigation_server->agent_set_position(agent, Vector3(x * 1.5 + (z % 2) * 0.25, 0, z * 1.5));
+					navigation_server->agent_set_max_speed(agent, 0.0);
+				} else {
+					const int walker = i - crowd_size * crowd_size;
+					navigation_server->agent_set_position(agent, Vector3(2.1 + (walker % 2) * 9.0, 0, 2.4 + (walker / 2) * 9.0));
+					navigation_server->agent_set_velocity(agent, Vector3(1, 0, 0.5));
+				}
+				navigation_server->agent_set_avoidance_callback(agent, callable_mp(&callback_mocks[m][i], &CallableMock::function1));
+				agents[m].push_back(agent);
+			}
+		}
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/use_batched_solver", false);
+
+		navigation_server->physics_process(1.0 / 60.0); // Give server some cycles to commit.
+		bool any_avoided = false;
+		for (int i = 0; i < agent_count; i++) {
+			CHECK_EQ(callback_mocks[0][i].function1_calls, 1);
+			CHECK_EQ(callback_mocks[1][i].function1_calls, 1);
+			const Vector3 default_safe_velocity = callback_mocks[0][i].function1_latest_arg0;
+			const Vector3 batched_safe_velocity = callback_mocks[1][i].function1_latest_arg0;
+			CHECK_MESSAGE(default_safe_velocity.is_equal_approx(batched_safe_velocity), "Both solvers should compute the same safe velocity.");
+			if (i >= crowd_size * crowd_size) {
+				any_avoided = any_avoided || !batched_safe_velocity.is_equal_approx(Vector3(1, 0, 0.5));
+			}
+		}
+		CHECK_MESSAGE(any_avoided, "Some agents should change their velocity to avoid the others.");
+
+		for (int m = 0; m < 2; m++) {
+			for (const RID &agent : agents[m]) {
+				navigation_server->free_rid(agent);
+			}
+			navigation_server->free_rid(maps[m]);
+		}
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Batched avoidance solver should not depend on threads") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// Enough agents for several tasks, packed so that cells hold several agents.
+		const int crowd_size = 16;
+		const int agent_count = crowd_size * crowd_size;
+		RID maps[2];
+		LocalVector<RID> agents[2];
+		CallableMock callback_mocks[2][agent_count];
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/use_batched_solver", true);
+		for (int m = 0; m < 2; m++) {
+			// The settings are read when the map is created.
+			ProjectSettings::get_singleton()->set_setting("navigation/avoidance/thread_model/avoidance_use_multiple_threads", m == 1);
+			maps[m] = navigation_server->map_create();
+			navigation_server->map_set_active(maps[m], true);
+
+			for (int i = 0; i < agent_count; i++) {
+				const int x = i % crowd_size;
+				const int z = i / crowd_size;
+				RID agent = navigation_server->agent_create();
+				navigation_server->agent_set_map(agent, maps[m]);
+				navigation_server->agent_set_avoidance_enabled(agent, true);
+				navigation_server->agent_set_position(agent, Vector3(x * 0.75 + (z % 3) * 0.2, 0, z * 0.75));
+				navigation_server->agent_set_radius(agent, 0.3);
+				navigation_server->agent_set_max_neighbors(agent, 5);
+				navigation_server->agent_set_neighbor_distance(agent, 3.0);
+				navigation_server->agent_set_velocity(agent, Vector3(x < crowd_size / 2 ? 1 : -1, 0, 0.5));
+				navigation_server->agent_set_avoidance_callback(agent, callable_mp(&callback_mocks[m][i], &CallableMock::function1));
+				agents[m].push_back(agent);
+			}
+		}
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/use_batched_solver", false);
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/thread_model/avoidance_use_multiple_threads", true);
+
+		for (int step = 0; step < 3; step++) {
+			navigation_server->physics_process(1.0 / 60.0); // Give server some cycles to commit.
+			for (int i = 0; i < agent_count; i++) {
+				CHECK_EQ(callback_mocks[0][i].function1_calls, step + 1);
+				CHECK_EQ(callback_mocks[1][i].function1_calls, step + 1);
+				const Vector3 serial_safe_velocity = callback_mocks[0][i].function1_latest_arg0;
+				const Vector3 threaded_safe_velocity = callback_mocks[1][i].function1_latest_arg0;
+				CHECK_MESSAGE(serial_safe_velocity == threaded_safe_velocity, "Threads should not change the safe velocities.");
+			}
+		}
+
+		for (int m = 0; m < 2; m++) {
+			for (const RID &agent : agents[m]) {
+				navigation_server->free_rid(agent);
+			}
+			navigation_server->free_rid(maps[m]);
+		}
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE_PENDING("[NavigationServer3D] Benchmark avoidance solvers") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		const int agent_counts[] = { 1000, 10000, 50000 };
+		for (const int agent_count : agent_counts) {
+			for (int batched = 0; batched < 2; batched++) {
+				ProjectSettings::get_singleton()->set_setting("navigation/avoidance/use_batched_solver", batched == 1);
+				RID map = navigation_server->map_create();
+				navigation_server->map_set_active(map, true);
+
+				// Agents on a grid with about two agents per square meter, all moving to the center.
+				const int side = int(Math::sqrt(double(agent_count)));
+				LocalVector<RID> agents;
+				for (int i = 0; i < agent_count; i++) {
+					const Vector3 position = Vector3((i % side) * 0.7, 0, (i / side) * 0.7);
+					RID agent = navigation_server->agent_create();
+					navigation_server->agent_set_map(agent, map);
+					navigation_server->agent_set_avoidance_enabled(agent, true);
+					navigation_server->agent_set_position(agent, position);
+					navigation_server->agent_set_radius(agent, 0.25);
+					navigation_server->agent_set_velocity(agent, (Vector3(side * 0.35, 0, side * 0.35) - position).normalized());
+					agents.push_back(agent);
+				}
+				navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+				const int steps = 10;
+				const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+				for (int step = 0; step < steps; step++) {
+					navigation_server->physics_process(1.0 / 60.0);
+				}
+				const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+				MESSAGE(vformat("%d agents, %s solver: %.2f ms per step.", agent_count, batched == 1 ? "batched" : "default", elapsed / 1000.0 / steps));
+
+				for (const RID &agent : agents) {
+					navigation_server->free_rid(agent);
+				}
+				navigation_server->free_rid(map);
+				navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			}
+		}
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/use_batched_solver", false);
+	}
+
 #ifndef DISABLE_DEPRECATED
 	// This test case uses only public APIs on purpose - other test cases use simplified baking.
 	// FIXME: Remove once deprecated `region_bake_navigation_mesh()` is removed.
@@ -812,11 +1036,415 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_EQ(query_result->get_path().size(), 0);
 		}
 
+		SUBCASE("Batched queries should yield the same results as single queries") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			TypedArray<NavigationPathQueryResult3D> batch_results;
+			for (int i = 0; i < 8; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters;
+				query_parameters.instantiate();
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(i, 0, 0));
+				query_parameters->set_target_position(Vector3(10, 0, 10 - i));
+				batch_parameters.push_back(query_parameters);
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				batch_results.push_back(query_result);
+			}
+
+			CallableMock batch_callback_mock;
+			int64_t batch_id = navigation_server->query_path_batch(batch_parameters, batch_results, callable_mp(&batch_callback_mock, &CallableMock::function0));
+			CHECK_NE(batch_id, -1);
+			while (!navigation_server->is_path_query_batch_completed(batch_id)) {
+				OS::get_singleton()->delay_usec(100);
+			}
+			CHECK_EQ(batch_callback_mock.function0_calls, 0);
+			navigation_server->process(0.0); // Callbacks are dispatched during sync.
+			CHECK_EQ(batch_callback_mock.function0_calls, 1);
+
+			for (int i = 0; i < 8; i++) {
+				const Ref<NavigationPathQueryParameters3D> query_parameters = batch_parameters[i];
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				navigation_server->query_path(query_parameters, query_result);
+				const Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+				CHECK_NE(batch_result->get_path().size(), 0);
+				CHECK_EQ(batch_result->get_path(), query_result->get_path());
+				CHECK_EQ(batch_result->get_path_length(), query_result->get_path_length());
+			}
+		}
+
+		SUBCASE("Batched queries with mismatching results should fail") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			Ref<NavigationPathQueryParameters3D> query_parameters;
+			query_parameters.instantiate();
+			query_parameters->set_map(map);
+			batch_parameters.push_back(query_parameters);
+			ERR_PRINT_OFF;
+			CHECK_EQ(navigation_server->query_path_batch(batch_parameters, TypedArray<NavigationPathQueryResult3D>()), -1);
+			ERR_PRINT_ON;
+		}
+
 		navigation_server->free_rid(region);
 		navigation_server->free_rid(map);
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should find paths through path clusters") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A grid of quads with a wall in the middle that paths need to go around.
+		Ref<NavigationMesh> navigation_mesh;
+		navigation_mesh.instantiate();
+		Vector<Vector3> vertices;
+		for (int x = 0; x <= 12; x++) {
+			for (int z = 0; z <= 12; z++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int x = 0; x < 12; x++) {
+			for (int z = 0; z < 12; z++) {
+				if (z == 6 && x < 10) {
+					continue;
+				}
+				Vector<int> polygon;
+				polygon.push_back(x * 13 + z);
+				polygon.push_back(x * 13 + z + 1);
+				polygon.push_back((x + 1) * 13 + z + 1);
+				polygon.push_back((x + 1) * 13 + z);
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID maps[2];
+		RID regions[2];
+		for (int i = 0; i < 2; i++) {
+			// The cluster size is only read when a map is created.
+			ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/path_cluster_size", i == 0 ? 0 : 4);
+			maps[i] = navigation_server->map_create();
+			regions[i] = navigation_server->region_create();
+			navigation_server->map_set_active(maps[i], true);
+			navigation_server->map_set_use_async_iterations(maps[i], false);
+			navigation_server->region_set_use_async_iterations(regions[i], false);
+			navigation_server->region_set_map(regions[i], maps[i]);
+			navigation_server->region_set_navigation_mesh(regions[i], navigation_mesh);
+		}
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/path_cluster_size", 0);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		const Vector3 targets[4] = { Vector3(1.5, 0, 11.5), Vector3(11.5, 0, 11.5), Vector3(5.5, 0, 6.5), Vector3(20.0, 0, 20.0) };
+		for (const Vector3 &target : targets) {
+			const Vector<Vector3> flat_path = navigation_server->map_get_path(maps[0], Vector3(1.5, 0, 0.5), target, true);
+			const Vector<Vector3> cluster_path = navigation_server->map_get_path(maps[1], Vector3(1.5, 0, 0.5), target, true);
+			REQUIRE_FALSE(flat_path.is_empty());
+			REQUIRE_FALSE(cluster_path.is_empty());
+			CHECK(flat_path[flat_path.size() - 1].is_equal_approx(cluster_path[cluster_path.size() - 1]));
+		}
+
+		for (int i = 0; i < 2; i++) {
+			navigation_server->free_rid(regions[i]);
+			navigation_server->free_rid(maps[i]);
+		}
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Incremental map builds should match full builds") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A single quad, used by a row of regions that either share edges or are a small gap apart.
+		// The gaps are wider than a merge rasterizer cell, so they are bridged by edge connection margin connections.
+		Ref<NavigationMesh> navigation_mesh;
+		navigation_mesh.instantiate();
+		navigation_mesh->set_vertices({ Vector3(0, 0, 0), Vector3(0, 0, 2), Vector3(2, 0, 2), Vector3(2, 0, 0) });
+		navigation_mesh->add_polygon({ 0, 1, 2, 3 });
+
+		const auto create_map = [&]() {
+			const RID map = navigation_server->map_create();
+			navigation_server->map_set_active(map, true);
+			navigation_server->map_set_use_async_iterations(map, false);
+			navigation_server->map_set_edge_connection_margin(map, 0.5);
+			return map;
+		};
+		const auto create_region = [&](const RID &p_map, const Vector3 &p_origin) {
+			const RID region = navigation_server->region_create();
+			navigation_server->region_set_use_async_iterations(region, false);
+			navigation_server->region_set_transform(region, Transform3D(Basis(), p_origin));
+			navigation_server->region_set_map(region, p_map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			return region;
+		};
+
+		// Builds the same regions in a new map and compares the connections and paths of both maps.
+		const auto check_matches_full_build = [&](const RID &p_map, const LocalVector<RID> &p_regions, const LocalVector<Vector3> &p_origins) {
+			const RID full_map = create_map();
+			LocalVector<RID> full_regions;
+			for (const Vector3 &origin : p_origins) {
+				full_regions.push_back(create_region(full_map, origin));
+			}
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+			for (uint32_t i = 0; i < p_regions.size(); i++) {
+				const int connection_count = navigation_server->region_get_connections_count(p_regions[i]);
+				REQUIRE_EQ(connection_count, navigation_server->region_get_connections_count(full_regions[i]));
+				for (int j = 0; j < connection_count; j++) {
+					const Vector3 start = navigation_server->region_get_connection_pathway_start(p_regions[i], j);
+					const Vector3 end = navigation_server->region_get_connection_pathway_end(p_regions[i], j);
+					bool found = false;
+					for (int k = 0; k < connection_count && !found; k++) {
+						found = start.is_equal_approx(navigation_server->region_get_connection_pathway_start(full_regions[i], k)) &&
+								end.is_equal_approx(navigation_server->region_get_connection_pathway_end(full_regions[i], k));
+					}
+					CHECK_MESSAGE(found, "Connection of region ", i, " should also exist after a full build.");
+				}
+			}
+
+			for (const Vector3 &from : p_origins) {
+				for (const Vector3 &to : p_origins) {
+					const Vector<Vector3> path = navigation_server->map_get_path(p_map, from + Vector3(1, 0, 1), to + Vector3(1, 0, 1), true);
+					const Vector<Vector3> full_path = navigation_server->map_get_path(full_map, from + Vector3(1, 0, 1), to + Vector3(1, 0, 1), true);
+					REQUIRE_EQ(path.size(), full_path.size());
+					for (int i = 0; i < path.size(); i++) {
+						CHECK(path[i].is_equal_approx(full_path[i]));
+					}
+				}
+			}
+
+			for (const RID &region : full_regions) {
+				navigation_server->free_rid(region);
+			}
+			navigation_server->free_rid(full_map);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		};
+
+		const RID map = create_map();
+		LocalVector<RID> regions;
+		LocalVector<Vector3> origins;
+
+		SUBCASE("Adding regions") {
+			const real_t offsets[5] = { 0.0, 2.0, 4.3, 6.6, 8.6 };
+			for (const real_t offset : offsets) {
+				origins.push_back(Vector3(offset, 0, 0));
+				regions.push_back(create_region(map, origins[origins.size() - 1]));
+				navigation_server->physics_process(0.0); // Give server some cycles to commit.
+				check_matches_full_build(map, regions, origins);
+			}
+			CHECK_GT(navigation_server->region_get_connections_count(regions[2]), 0);
+		}
+
+		SUBCASE("Moving and removing regions") {
+			const real_t offsets[5] = { 0.0, 2.0, 4.3, 6.6, 8.6 };
+			for (const real_t offset : offsets) {
+				origins.push_back(Vector3(offset, 0, 0));
+				regions.push_back(create_region(map, origins[origins.size() - 1]));
+			}
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			check_matches_full_build(map, regions, origins);
+
+			// Moving a region away drops its connections, moving it back restores them.
+			origins[2] = Vector3(4.3, 0, 10);
+			navigation_server->region_set_transform(regions[2], Transform3D(Basis(), origins[2]));
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			check_matches_full_build(map, regions, origins);
+			CHECK_EQ(navigation_server->region_get_connections_count(regions[2]), 0);
+
+			origins[2] = Vector3(4.3, 0, 0);
+			navigation_server->region_set_transform(regions[2], Transform3D(Basis(), origins[2]));
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			check_matches_full_build(map, regions, origins);
+
+			// Removing a region drops the connections of its neighbors to it.
+			navigation_server->free_rid(regions[3]);
+			regions.remove_at(3);
+			origins.remove_at(3);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			check_matches_full_build(map, regions, origins);
+
+			const RID detached_region = regions[0];
+			navigation_server->region_set_map(detached_region, RID());
+			regions.remove_at(0);
+			origins.remove_at(0);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			check_matches_full_build(map, regions, origins);
+			navigation_server->free_rid(detached_region);
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free_rid(region);
+		}
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Closest point queries should match testing every face") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		const RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+
+		LocalVector<RID> regions;
+		LocalVector<MapFace> faces;
+		const auto add_region = [&](const Ref<NavigationMesh> &p_navigation_mesh, const Transform3D &p_transform, uint32_t p_navigation_layers) {
+			const RID region = navigation_server->region_create();
+			navigation_server->region_set_use_async_iterations(region, false);
+			navigation_server->region_set_transform(region, p_transform);
+			navigation_server->region_set_navigation_layers(region, p_navigation_layers);
+			navigation_server->region_set_map(region, map);
+			if (p_navigation_mesh.is_valid()) {
+				navigation_server->region_set_navigation_mesh(region, p_navigation_mesh);
+				const Vector<Vector3> vertices = p_navigation_mesh->get_vertices();
+				for (int i = 0; i < p_navigation_mesh->get_polygon_count(); i++) {
+					const Vector<int> polygon = p_navigation_mesh->get_polygon(i);
+					for (int j = 2; j < polygon.size(); j++) {
+						faces.push_back({ Face3(p_transform.xform(vertices[polygon[0]]), p_transform.xform(vertices[polygon[j - 1]]), p_transform.xform(vertices[polygon[j]])), region, p_navigation_layers });
+					}
+				}
+			}
+			regions.push_back(region);
+		};
+
+		// A bumpy grid of many polygons, split in triangles except where it is flat.
+		const int grid_size = 10;
+		Ref<NavigationMesh> grid_mesh;
+		grid_mesh.instantiate();
+		Vector<Vector3> grid_vertices;
+		for (int x = 0; x <= grid_size; x++) {
+			for (int z = 0; z <= grid_size; z++) {
+				const real_t height = x <= 4 ? 0.0 : 0.3 * Math::sin(1.7 * x) + 0.2 * Math::cos(1.1 * z);
+				grid_vertices.push_back(Vector3(x, height, z));
+			}
+		}
+		grid_mesh->set_vertices(grid_vertices);
+		for (int x = 0; x < grid_size; x++) {
+			for (int z = 0; z < grid_size; z++) {
+				const int v00 = x * (grid_size + 1) + z;
+				const int v01 = v00 + 1;
+				const int v10 = v00 + grid_size + 1;
+				const int v11 = v10 + 1;
+				if (x < 4) {
+					grid_mesh->add_polygon({ v00, v01, v11, v10 });
+				} else {
+					grid_mesh->add_polygon({ v00, v01, v11 });
+					grid_mesh->add_polygon({ v00, v11, v10 });
+				}
+			}
+		}
+		// Degenerate polygons: a triangle without area along an edge of the grid, and a polygon with two vertices.
+		grid_mesh->add_polygon({ 0, 1, 2 });
+		grid_mesh->add_polygon({ 0, 1 });
+
+		Ref<NavigationMesh> empty_mesh;
+		empty_mesh.instantiate();
+		Ref<NavigationMesh> degenerate_mesh;
+		degenerate_mesh.instantiate();
+		degenerate_mesh->set_vertices({ Vector3(0, 0, 0), Vector3(1, 0, 0) });
+		degenerate_mesh->add_polygon({ 0, 1 });
+
+		// Regions a few units apart, so that no point is at the same distance from two of them, including one
+		// on other navigation layers and regions without polygons.
+		add_region(grid_mesh, Transform3D(), 1);
+		add_region(grid_mesh, Transform3D(Basis(Vector3(0, 1, 0), 0.5), Vector3(14, 2, 3)), 1);
+		add_region(grid_mesh, Transform3D(Basis().scaled(Vector3(2, 1, 2)), Vector3(-4, -3, 14)), 2);
+		add_region(empty_mesh, Transform3D(), 1);
+		add_region(degenerate_mesh, Transform3D(Basis(), Vector3(5, 1, 5)), 1);
+		add_region(Ref<NavigationMesh>(), Transform3D(), 1);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		RandomPCG rng(42);
+		LocalVector<Vector3> points;
+		for (int i = 0; i < 300; i++) {
+			points.push_back(Vector3(rng.random(-8.0, 30.0), rng.random(-8.0, 8.0), rng.random(-8.0, 40.0)));
+		}
+		points.push_back(Vector3());
+		points.push_back(Vector3(1, 0, 1));
+		points.push_back(Vector3(1000, 0, 0));
+		points.push_back(Vector3(-1000, 1000, -1000));
+
+		SUBCASE("Closest points and owners") {
+			for (const Vector3 &point : points) {
+				RID owner;
+				const real_t distance = Math::sqrt(map_faces_get_distance_squared(faces, point, UINT32_MAX, &owner));
+				const Vector3 closest_point = navigation_server->map_get_closest_point(map, point);
+				CHECK_MESSAGE(Math::is_equal_approx(closest_point.distance_to(point), distance, real_t(1e-3)), "Closest point to ", point, " should be as close as the closest face.");
+				CHECK_MESSAGE(map_faces_get_distance_squared(faces, closest_point) < 1e-6, "Closest point to ", point, " should be on a face.");
+				CHECK_MESSAGE(navigation_server->map_get_closest_point_owner(map, point) == owner, "Closest point owner of ", point, " should own the closest face.");
+			}
+		}
+
+		SUBCASE("Closest points to segments") {
+			LocalVector<Vector3> segments;
+			for (uint32_t i = 0; i + 1 < points.size(); i += 2) {
+				segments.push_back(points[i]);
+				segments.push_back(points[i + 1]);
+			}
+			// Vertical segments through the regions, and segments of zero length.
+			for (int i = 0; i < 20; i++) {
+				const Vector3 point = Vector3(rng.random(0.0, 10.0), 0, rng.random(0.0, 10.0));
+				segments.push_back(point + Vector3(0, 5, 0));
+				segments.push_back(point - Vector3(0, 5, 0));
+			}
+			segments.push_back(Vector3(3, 2, 3));
+			segments.push_back(Vector3(3, 2, 3));
+			segments.push_back(Vector3(2, 0, 2));
+			segments.push_back(Vector3(2, 0, 2));
+
+			for (uint32_t i = 0; i < segments.size(); i += 2) {
+				const Vector3 &from = segments[i];
+				const Vector3 &to = segments[i + 1];
+				bool intersects = false;
+				const real_t distance = map_faces_get_segment_distance(faces, from, to, intersects);
+
+				const Vector3 closest_point = navigation_server->map_get_closest_point_to_segment(map, from, to, false);
+				if (intersects) {
+					CHECK_MESSAGE(Math::is_equal_approx(closest_point.distance_to(from), distance, real_t(1e-3)), "Closest point to ", from, " - ", to, " should be the intersection closest to the start.");
+					CHECK(navigation_server->map_get_closest_point_to_segment(map, from, to, true).is_equal_approx(closest_point));
+				} else {
+					const Vector3 on_segment = Geometry3D::get_closest_point_to_segment(closest_point, from, to);
+					CHECK_MESSAGE(Math::is_equal_approx(closest_point.distance_to(on_segment), distance, real_t(1e-3)), "Closest point to ", from, " - ", to, " should be as close as the closest face.");
+					CHECK(navigation_server->map_get_closest_point_to_segment(map, from, to, true) == Vector3());
+				}
+			}
+		}
+
+		SUBCASE("Path start and end positions") {
+			// Paths use the regions of the first navigation layer only.
+			for (uint32_t i = 0; i + 1 < points.size(); i += 2) {
+				const Vector3 &start = points[i];
+				const Vector3 &end = points[i + 1];
+				RID start_owner;
+				RID end_owner;
+				const real_t start_distance = Math::sqrt(map_faces_get_distance_squared(faces, start, 1, &start_owner));
+				const real_t end_distance = Math::sqrt(map_faces_get_distance_squared(faces, end, 1, &end_owner));
+
+				const Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+				REQUIRE_FALSE(path.is_empty());
+				CHECK_MESSAGE(Math::is_equal_approx(path[0].distance_to(start), start_distance, real_t(1e-3)), "Path from ", start, " should start on the closest face.");
+				if (start_owner == end_owner) {
+					// Paths to other regions end as close as they can get.
+					CHECK_MESSAGE(Math::is_equal_approx(path[path.size() - 1].distance_to(end), end_distance, real_t(1e-3)), "Path to ", end, " should end on the closest face.");
+				}
+			}
+		}
+
+		SUBCASE("Maps without polygons") {
+			for (uint32_t i = 0; i < 3; i++) {
+				navigation_server->region_set_map(regions[i], RID());
+			}
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->map_get_closest_point(map, Vector3(1, 1, 1)), Vector3());
+			CHECK_FALSE(navigation_server->map_get_closest_point_owner(map, Vector3(1, 1, 1)).is_valid());
+			CHECK_EQ(navigation_server->map_get_closest_point_to_segment(map, Vector3(1, 1, 1), Vector3(1, -1, 1), false), Vector3());
+			CHECK(navigation_server->map_get_path(map, Vector3(1, 1, 1), Vector3(2, 1, 2), true).is_empty());
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free_rid(region);
+		}
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
@@ -52,11 +52,9 @@ namespace RVO2D {
 		}
 	}
 
-	/* Search for the best new velocity. */
-	void Agent2D::computeNewVelocity(RVOSimulator2D *sim_)
+	/* Create the ORCA lines of the obstacle neighbors. */
+	void Agent2D::computeObstacleOrcaLines()
 	{
-		orcaLines_.clear();
-
 		const float invTimeHorizonObst = 1.0f / timeHorizonObst_;
 
 		/* Create obstacle ORCA lines. */
@@ -280,6 +278,14 @@ namespace RVO2D {
 				continue;
 			}
 		}
+	}
+
+	/* Search for the best new velocity. */
+	void Agent2D::computeNewVelocity(RVOSimulator2D *sim_)
+	{
+		orcaLines_.clear();
+
+		computeObstacleOrcaLines();
 
 		const size_t numObstLines = orcaLines_.size();
 
@@ -63,6 +63,12 @@ namespace RVO2D {
 		 */
 		void computeNewVelocity(RVOSimulator2D *sim_);
 
+		/**
+		 * \brief      Appends the ORCA lines of the obstacle neighbors of this
+		 *             agent to its ORCA lines.
+		 */
+		void computeObstacleOrcaLines();
+
 		/**
 		 * \brief      Inserts an agent neighbor into the set of neighbors of
 		 *             this agent.